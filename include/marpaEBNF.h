@@ -5,19 +5,264 @@
 #include "marpaWrapper.h"
 #include "marpaEBNF/export.h"
 
+/* Allocator hooks: userDatavp is the allocatorUserDatavp option */
+typedef void *(*marpaEBNFMallocCallback_t)(void *userDatavp, size_t sizel);
+typedef void *(*marpaEBNFReallocCallback_t)(void *userDatavp, void *p, size_t sizel);
+typedef void  (*marpaEBNFFreeCallback_t)(void *userDatavp, void *p);
+
+typedef struct marpaEBNFCache marpaEBNFCache_t;
+
 typedef struct marpaEBNFOption {
-  genericLogger_t *genericLoggerp;
+  genericLogger_t           *genericLoggerp;
+  short                      scannerlessb;         /* Parse with the character-level grammar instead of the token-level one */
+  marpaEBNFMallocCallback_t  mallocp;              /* Allocator hooks: all three, or NULL for the system allocator */
+  marpaEBNFReallocCallback_t reallocp;
+  marpaEBNFFreeCallback_t    freep;
+  void                      *allocatorUserDatavp;  /* Passed as-is to the allocator hooks */
+  marpaEBNFCache_t          *cachep;               /* Grammar cache, NULL for none: see marpaEBNFCache_newp() */
+  short                      recoverb;             /* Go on after a syntax error: see marpaEBNF_diagnosticsl() */
+  short                      utf8b;                /* Allow UTF-8 in comments, terminal strings and special sequences, token-level grammar only */
 } marpaEBNFOption_t;
 
+/* Memory accounting of an instance, from its creation */
+typedef struct marpaEBNFMemory {
+  size_t liveBytel;           /* Bytes currently allocated */
+  size_t peakBytel;           /* Maximum of liveBytel */
+  size_t totalBytel;          /* Bytes ever allocated */
+  size_t allocationl;         /* Number of calls to the malloc and realloc hooks */
+} marpaEBNFMemory_t;
+
+/* Statistics of the last parse */
+typedef struct marpaEBNFStats {
+  size_t expectedCacheHitl;   /* Expected terminals found in the cache */
+  size_t expectedCacheMissl;  /* Expected terminals that had to be analysed */
+  size_t earleySetl;          /* Earley sets completed by the recognizer */
+  size_t characterScannedl;   /* Input bytes consumed by the reader */
+  size_t characterDiscardedl; /* Of which gap separators and comments that never reached the recognizer */
+  size_t tokenl;              /* Lexemes submitted to the recognizer */
+  size_t alternativel;        /* Alternatives submitted, at least one per lexeme */
+  size_t ambiguousPositionl;  /* Lexemes submitted as more than one alternative */
+  size_t asfNodeVisitedl;     /* Rules and symbols visited while pruning the ASF */
+  size_t symbolRejectedl;     /* Alternatives and ASF symbols rejected by the scanner context or by an exception */
+  size_t arenaSizel;          /* Bytes held by the per-parse arena, kept for the next parse */
+  size_t singleTreel;         /* Parses valued as a single tree, since the creation of the instance */
+  size_t asfl;                /* Parses valued by pruning an ASF, since the creation of the instance */
+  double recognizeSecondsd;   /* Wall time lexing and recognizing */
+  double asfSecondsd;         /* Wall time building the ASF, or the single tree */
+  double valueSecondsd;       /* Wall time pruning and valuing, AST included */
+  double compileSecondsd;     /* Wall time compiling the AST, token-level grammars only */
+  size_t eventLostl;          /* Trace events overwritten before being drained */
+  size_t cacheHitl;           /* 1 when the AST came from the grammar cache: nothing was parsed */
+} marpaEBNFStats_t;
+
+/* Trace events are recorded in binary form during a parse, and only */
+/* described when drained: see marpaEBNF_eventsl().                   */
+typedef enum marpaEBNFEventKind {
+  MARPAEBNF_EVENT_EXCEPTION = 0,       /* symboli is an exception of rulei */
+  MARPAEBNF_EVENT_CONTEXT,             /* symboli was rejected by the scanner context: string, special sequence or comment */
+  MARPAEBNF_EVENT_AMBIGUOUS            /* symboli is one of several alternatives at the same position */
+} marpaEBNFEventKind_t;
+
+#define MARPAEBNF_EVENT_NO_POSITION ((size_t) -1)
+typedef struct marpaEBNFEvent {
+  int    eventi;              /* A marpaEBNFEventKind_t */
+  int    symboli;             /* Symbol of the internal grammar */
+  int    rulei;               /* Rule of the internal grammar, -1 if none */
+  size_t positionl;           /* Absolute offset in the grammar, or MARPAEBNF_EVENT_NO_POSITION */
+} marpaEBNFEvent_t;
+
+/* A syntax error of a parse with the recoverb option */
+#define MARPAEBNF_DIAGNOSTIC_EXPECTED_SIZE 16
+typedef struct marpaEBNFDiagnostic {
+  size_t offsetl;             /* Absolute offset of the text in error */
+  size_t lengthl;             /* Its length, 0 at the end of the grammar */
+  size_t linel;               /* Its line, starting at 1 */
+  size_t columnl;             /* Its column, starting at 1 */
+  size_t expectedl;           /* Symbols expected there, at most MARPAEBNF_DIAGNOSTIC_EXPECTED_SIZE */
+  char  *expectedsp[MARPAEBNF_DIAGNOSTIC_EXPECTED_SIZE]; /* Their descriptions */
+} marpaEBNFDiagnostic_t;
+
+/* Kinds of the AST nodes. Node 0 is the root, of kind MARPAEBNF_AST_SYNTAX. */
+/* Terms and factors without an exception or a repetition are their         */
+/* primary, so that only the nodes below exist.                             */
+typedef enum marpaEBNFAstKind {
+  MARPAEBNF_AST_SYNTAX = 0,            /* Children: syntax rules */
+  MARPAEBNF_AST_SYNTAX_RULE,           /* Children: meta identifier, definitions list */
+  MARPAEBNF_AST_DEFINITIONS_LIST,      /* Children: single definitions */
+  MARPAEBNF_AST_SINGLE_DEFINITION,     /* Children: terms, i.e. any of the kinds below */
+  MARPAEBNF_AST_EXCEPTION,             /* Children: factor, exception */
+  MARPAEBNF_AST_REPETITION,            /* Children: integer, primary */
+  MARPAEBNF_AST_OPTIONAL_SEQUENCE,     /* Child: definitions list */
+  MARPAEBNF_AST_REPEATED_SEQUENCE,     /* Child: definitions list */
+  MARPAEBNF_AST_GROUPED_SEQUENCE,      /* Child: definitions list */
+  MARPAEBNF_AST_META_IDENTIFIER,       /* Leaf, text without gap separators */
+  MARPAEBNF_AST_INTEGER,               /* Leaf, text without gap separators */
+  MARPAEBNF_AST_TERMINAL_STRING,       /* Leaf, text without the quotes */
+  MARPAEBNF_AST_SPECIAL_SEQUENCE,      /* Leaf, text without the special sequence symbols */
+  MARPAEBNF_AST_EMPTY_SEQUENCE         /* Leaf, with an empty span */
+} marpaEBNFAstKind_t;
+
+/* One grammar of a batch: grammars is parsed, okb and diagnostics are set */
+#define MARPAEBNF_BATCH_DIAGNOSTICS_SIZE 1024
+typedef struct marpaEBNFBatchItem {
+  char  *grammars;            /* Grammar buffer, no NUL terminator is needed */
+  size_t grammarl;            /* Its length */
+  short  okb;                 /* Result of the parse */
+  char   diagnostics[MARPAEBNF_BATCH_DIAGNOSTICS_SIZE]; /* Warnings and errors, one per line, truncated when full */
+} marpaEBNFBatchItem_t;
+
+/* Aggregate throughput of a batch is bytel / secondsd and iteml / secondsd */
+typedef struct marpaEBNFBatchStats {
+  size_t threadl;             /* Number of workers */
+  size_t iteml;               /* Number of items */
+  size_t okl;                 /* Number of items successfully parsed */
+  size_t bytel;               /* Sum of the item lengths */
+  double secondsd;            /* Wall clock time of the batch */
+  size_t stolenl;             /* Items that moved to another worker than the one first given */
+} marpaEBNFBatchStats_t;
+
+/* A grammar cache keeps the AST of successfully parsed grammars, by the    */
+/* SHA-256 of their text: a grammar seen before is only compiled again.      */
+/* Entries are kept in memory, least recently used first out, and, with a   */
+/* directory, in one file per grammar there, that survives the process.     */
+#define MARPAEBNF_CACHE_DEFAULT_ENTRIES 64
+typedef struct marpaEBNFCacheOption {
+  genericLogger_t *genericLoggerp;
+  size_t           maxEntryl;   /* Entries in memory, 0 for MARPAEBNF_CACHE_DEFAULT_ENTRIES */
+  size_t           maxBytel;    /* Bytes of the entries in memory, 0 for no limit */
+  char            *directorys;  /* Existing directory of the persistent tier, NULL for none */
+} marpaEBNFCacheOption_t;
+
+typedef struct marpaEBNFCacheStats {
+  size_t hitl;                /* Lookups answered from memory */
+  size_t diskHitl;            /* Lookups answered from the directory */
+  size_t missl;               /* Lookups that had to parse */
+  size_t entryl;              /* Entries in memory */
+  size_t bytel;               /* Their bytes */
+  size_t evictionl;           /* Entries dropped from memory to respect the bounds */
+  size_t diskWritel;          /* Files written to the directory */
+  size_t diskErrorl;          /* Files that could not be written, or were not an AST when read */
+} marpaEBNFCacheStats_t;
+
+/* A compiled grammar as static tables, as marpaEBNF_generateb() writes them. */
+/* Symbols and rules are numbered from 0, in the order of the tables.        */
+#define MARPAEBNF_GENERATED_VERSION 1
+typedef struct marpaEBNFGeneratedSymbol {
+  short       terminalb;
+  const char *descriptions;
+} marpaEBNFGeneratedSymbol_t;
+
+typedef struct marpaEBNFGeneratedRule {
+  marpaWrapperGrammarRuleOption_t option;
+  int                             lhsSymboli;
+  size_t                          rhsSymboll;  /* Right-hand sides follow each other in rhsSymbolip */
+} marpaEBNFGeneratedRule_t;
+
+typedef struct marpaEBNFGenerated {
+  int                               versioni;     /* MARPAEBNF_GENERATED_VERSION */
+  const marpaEBNFGeneratedSymbol_t *symbolp;
+  size_t                            symboll;
+  const marpaEBNFGeneratedRule_t   *rulep;
+  size_t                            rulel;
+  const int                        *rhsSymbolip;
+  size_t                            rhsSymboll;
+  int                               startSymboli;
+  const int                        *byteSymbolip; /* 256 entries: terminal of every byte, -1 for none */
+} marpaEBNFGenerated_t;
+
 typedef struct marpaEBNF marpaEBNF_t;
+typedef struct marpaEBNFAst marpaEBNFAst_t;
 typedef struct marpaEBNFGrammar marpaEBNFGrammar_t;
 
 #ifdef __cplusplus
 extern "C" {
 #endif
   marpaEBNF_EXPORT marpaEBNF_t *marpaEBNF_newp(marpaEBNFOption_t *marpaEBNFOptionp);
+  /* The internal grammars are built by the first instance that needs them and kept */
+  /* for the next ones. This releases them, once all the instances are freed: the   */
+  /* destructor of the library also does, where the compiler supports it.          */
+  marpaEBNF_EXPORT void         marpaEBNF_shutdownv(void);
+
+  /* A grammar is read-only: any number of parse contexts, each used by one thread */
+  /* at a time, can parse with the same grammar concurrently. marpaEBNF_newp() is  */
+  /* a context on a private grammar. A grammar lives until it is freed and all its */
+  /* contexts are freed, in any order.                                              */
+  marpaEBNF_EXPORT marpaEBNFGrammar_t *marpaEBNFGrammar_newp(marpaEBNFOption_t *marpaEBNFOptionp);
+  marpaEBNF_EXPORT void                marpaEBNFGrammar_freev(marpaEBNFGrammar_t *marpaEBNFGrammarp);
+  marpaEBNF_EXPORT marpaEBNF_t        *marpaEBNF_contextNewp(marpaEBNFGrammar_t *marpaEBNFGrammarp);
+  /* Parses iteml grammars on threadl workers, 0 meaning one per processor, each  */
+  /* with its own context on the grammar. Returns 0 only if the batch could not   */
+  /* run: the result of each grammar is in its item. marpaEBNFBatchStatsp can be  */
+  /* NULL.                                                                        */
+  marpaEBNF_EXPORT short               marpaEBNFGrammar_batchb(marpaEBNFGrammar_t *marpaEBNFGrammarp, marpaEBNFBatchItem_t *itemp, size_t iteml, size_t threadl, marpaEBNFBatchStats_t *marpaEBNFBatchStatsp);
+
+  /* A cache is shared by any number of instances and threads. It must outlive */
+  /* the instances whose option refer to it. Only the token-level grammar uses */
+  /* it, and neither streaming nor marpaEBNF_parseb() do.                       */
+  marpaEBNF_EXPORT marpaEBNFCache_t *marpaEBNFCache_newp(marpaEBNFCacheOption_t *marpaEBNFCacheOptionp);
+  marpaEBNF_EXPORT short             marpaEBNFCache_statsb(marpaEBNFCache_t *marpaEBNFCachep, marpaEBNFCacheStats_t *marpaEBNFCacheStatsp);
+  /* Forgets a grammar, in memory and in the directory */
+  marpaEBNF_EXPORT short             marpaEBNFCache_removeb(marpaEBNFCache_t *marpaEBNFCachep, char *grammars, size_t grammarl);
+  marpaEBNF_EXPORT void              marpaEBNFCache_freev(marpaEBNFCache_t *marpaEBNFCachep);
+
   marpaEBNF_EXPORT short        marpaEBNF_grammarb(marpaEBNF_t *marpaEBNFp, char *grammars);
+  /* Same, without the need of a NUL terminator */
+  marpaEBNF_EXPORT short        marpaEBNF_grammarBufferb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl);
+  /* Same, on the content of a file, memory-mapped when the system supports it */
+  marpaEBNF_EXPORT short        marpaEBNF_grammarFileb(marpaEBNF_t *marpaEBNFp, char *filenames);
+  /* Same, with the grammar cut after syntax rules and the pieces parsed on threadl */
+  /* threads, 0 meaning one per processor: for large grammars. Positions in the     */
+  /* messages are those of the whole grammar. The allocator hooks, if any, must be  */
+  /* thread-safe.                                                                   */
+  marpaEBNF_EXPORT short        marpaEBNF_grammarParallelb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl, size_t threadl);
+  /* Replaces removedl bytes at offsetl by the insertedl ones of inserteds in the grammar */
+  /* last given to one of the four functions above or to this one, whether it parsed  */
+  /* or not, and parses the result as they do. Only the syntax rules that the edit    */
+  /* touches are parsed again, when the rest of the grammar had parsed: the first     */
+  /* edit after a parse also counts the lines of the whole grammar once. The grammar  */
+  /* is still compiled and precomputed as a whole, at a cost that grows with it.      */
+  marpaEBNF_EXPORT short        marpaEBNF_editb(marpaEBNF_t *marpaEBNFp, size_t offsetl, size_t removedl, char *inserteds, size_t insertedl);
+  /* Streaming alternative to marpaEBNF_grammarb: the grammar is given by chunks of any size */
+  marpaEBNF_EXPORT short        marpaEBNF_beginb(marpaEBNF_t *marpaEBNFp);
+  marpaEBNF_EXPORT short        marpaEBNF_feedb(marpaEBNF_t *marpaEBNFp, char *chunks, size_t chunkl);
+  marpaEBNF_EXPORT short        marpaEBNF_endb(marpaEBNF_t *marpaEBNFp);
+  /* A successful parse with the token-level grammar also compiles it: inputs are */
+  /* then parsed against it, as many times as needed. Both sides of an exception  */
+  /* must be finite languages: ISO/IEC 14977 only requires the excepted one.      */
+  marpaEBNF_EXPORT short        marpaEBNF_parseb(marpaEBNF_t *marpaEBNFp, char *inputs, size_t inputl);
+  /* Writes the compiled grammar to filenames as C source: static tables and the */
+  /* constructor marpaEBNF_t *<names>_newp(marpaEBNFOption_t *), an instance that */
+  /* parses inputs as after marpaEBNF_grammarb() on the grammar, without parsing  */
+  /* it. names must be a C identifier. The marpaEBNFGenerate program calls it.   */
+  marpaEBNF_EXPORT short        marpaEBNF_generateb(marpaEBNF_t *marpaEBNFp, char *names, char *filenames);
+  /* What the generated constructor calls: the tables must outlive the call only */
+  marpaEBNF_EXPORT short        marpaEBNF_generatedb(marpaEBNF_t *marpaEBNFp, const marpaEBNFGenerated_t *marpaEBNFGeneratedp);
+  marpaEBNF_EXPORT short        marpaEBNF_statsb(marpaEBNF_t *marpaEBNFp, marpaEBNFStats_t *marpaEBNFStatsp);
+  marpaEBNF_EXPORT short        marpaEBNF_memoryb(marpaEBNF_t *marpaEBNFp, marpaEBNFMemory_t *marpaEBNFMemoryp);
+  /* Syntax errors of the last parse, in order, with the recoverb option: the      */
+  /* token-level grammar resumes after the next terminator symbol, and so reports */
+  /* at most one error per syntax rule. The character-level grammar stops at the  */
+  /* first one. *diagnosticpp is valid until the next parse.                      */
+  marpaEBNF_EXPORT size_t       marpaEBNF_diagnosticsl(marpaEBNF_t *marpaEBNFp, marpaEBNFDiagnostic_t **diagnosticpp);
+  /* Moves up to eventl trace events of the last parse, oldest first, to eventp and */
+  /* returns how many. The instance keeps the most recent ones only: see the        */
+  /* eventLostl statistic. marpaEBNF_eventFormats() describes one in buffers, that  */
+  /* is always NUL terminated, and returns buffers.                                 */
+  marpaEBNF_EXPORT size_t       marpaEBNF_eventsl(marpaEBNF_t *marpaEBNFp, marpaEBNFEvent_t *eventp, size_t eventl);
+  marpaEBNF_EXPORT char        *marpaEBNF_eventFormats(marpaEBNF_t *marpaEBNFp, marpaEBNFEvent_t *eventp, char *buffers, size_t bufferl);
   marpaEBNF_EXPORT void         marpaEBNF_freev(marpaEBNF_t *marpaEBNFp);
+
+  /* AST of the last successful parse with the token-level grammar, NULL otherwise. */
+  /* It belongs to the instance and lives until the next parse.                     */
+  marpaEBNF_EXPORT marpaEBNFAst_t *marpaEBNF_astp(marpaEBNF_t *marpaEBNFp);
+  marpaEBNF_EXPORT size_t          marpaEBNFAst_nodel(marpaEBNFAst_t *marpaEBNFAstp);
+  marpaEBNF_EXPORT int             marpaEBNFAst_kindi(marpaEBNFAst_t *marpaEBNFAstp, size_t nodel);
+  /* Children of a node are the consecutive nodes *firstChildlp .. *firstChildlp + *childlp - 1: */
+  /* for a leaf, *firstChildlp is where they would start in breadth-first order.               */
+  marpaEBNF_EXPORT short           marpaEBNFAst_childrenb(marpaEBNFAst_t *marpaEBNFAstp, size_t nodel, size_t *firstChildlp, size_t *childlp);
+  marpaEBNF_EXPORT short           marpaEBNFAst_spanb(marpaEBNFAst_t *marpaEBNFAstp, size_t nodel, size_t *offsetlp, size_t *lengthlp);
+  /* NUL terminated text of a leaf, NULL for the other nodes */
+  marpaEBNF_EXPORT char           *marpaEBNFAst_texts(marpaEBNFAst_t *marpaEBNFAstp, size_t nodel, size_t *lengthlp);
 #ifdef __cplusplus
 }
 #endif
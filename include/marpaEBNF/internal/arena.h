@@ -0,0 +1,34 @@
+#ifndef MARPAEBNF_INTERNAL_ARENA_H
+#define MARPAEBNF_INTERNAL_ARENA_H
+
+#include <stddef.h>
+#include <genericLogger.h>
+#include "marpaEBNF/internal/memory.h"
+
+/* Bump allocator for everything that lives as long as one parse: memory is  */
+/* never given back individually, _marpaEBNF_arenaResetv() makes it all      */
+/* available again in O(1) and chunks are kept for the next parse, so that  */
+/* repeated parses reach a steady state without any call to malloc().       */
+
+#define MARPAEBNF_ARENA_CHUNK_SIZE 65536
+
+typedef struct marpaEBNFArenaChunk {
+  struct marpaEBNFArenaChunk *nextp;
+  size_t                      sizel;   /* Usable size, the data follows the header */
+} marpaEBNFArenaChunk_t;
+
+typedef struct marpaEBNFArena {
+  genericLogger_t       *genericLoggerp;
+  marpaEBNFAllocator_t  *marpaEBNFAllocatorp;
+  marpaEBNFArenaChunk_t *headp;        /* First chunk */
+  marpaEBNFArenaChunk_t *currentp;     /* Chunk being filled, NULL when none is allocated yet */
+  size_t                 usedl;        /* Used bytes in currentp */
+  size_t                 allocatedl;   /* Sum of all chunk sizes */
+} marpaEBNFArena_t;
+
+void  _marpaEBNF_arenaInitv(marpaEBNFArena_t *marpaEBNFArenap, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp);
+void *_marpaEBNF_arenaAllocp(marpaEBNFArena_t *marpaEBNFArenap, size_t sizel);
+void  _marpaEBNF_arenaResetv(marpaEBNFArena_t *marpaEBNFArenap);
+void  _marpaEBNF_arenaFreev(marpaEBNFArena_t *marpaEBNFArenap);
+
+#endif /* MARPAEBNF_INTERNAL_ARENA_H */
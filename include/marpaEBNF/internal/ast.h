@@ -0,0 +1,69 @@
+#ifndef MARPAEBNF_INTERNAL_AST_H
+#define MARPAEBNF_INTERNAL_AST_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <genericLogger.h>
+#include "marpaEBNF.h"
+#include "marpaEBNF/internal/memory.h"
+#include "marpaEBNF/internal/arena.h"
+
+/* The valuation builds a tree of nodes in the per-parse arena; once it is    */
+/* complete, the tree is laid out breadth-first into the arrays of a single   */
+/* block. Breadth-first order makes the children of a node consecutive node   */
+/* indices, so that a node is just its kind, first child, number of children */
+/* and source span: there is no pointer to follow.                           */
+
+#define MARPAEBNF_AST_PUNCTUATION -1   /* Kind of the nodes that only carry a span to their parent */
+
+typedef struct marpaEBNFAstNode {
+  int                       kindi;       /* marpaEBNFAstKind_t or MARPAEBNF_AST_PUNCTUATION */
+  short                     positionb;   /* False for empty sequences until the layout */
+  size_t                    offsetl;     /* Absolute source offset */
+  size_t                    lengthl;     /* Source length */
+  char                     *texts;       /* Leaf text, NUL terminated, NULL for the others */
+  size_t                    textl;
+  struct marpaEBNFAstNode **childpp;
+  size_t                    childl;
+  size_t                    childAllocl;
+} marpaEBNFAstNode_t;
+
+typedef struct marpaEBNFAstBuilder {
+  marpaEBNFArena_t *marpaEBNFArenap;
+  size_t            nodel;               /* Created nodes, an upper bound of the AST size */
+  size_t            textl;               /* Bytes of leaf texts, NUL terminators included */
+} marpaEBNFAstBuilder_t;
+
+struct marpaEBNFAst {
+  size_t  nodel;
+  int    *kindip;
+  size_t *firstChildlp;
+  size_t *childlp;
+  size_t *offsetlp;
+  size_t *lengthlp;
+  size_t *textOffsetlp;                  /* In texts, for leaves */
+  size_t *textLengthlp;                  /* 0 for inner nodes */
+  char   *texts;
+  size_t  textl;                         /* Bytes of texts */
+  size_t  nodeAllocl;                    /* Room of the block, in nodes */
+  size_t  textAllocl;                    /* Room of the block, in bytes of texts */
+};
+
+void                _marpaEBNF_astBuilderInitv(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, marpaEBNFArena_t *marpaEBNFArenap);
+marpaEBNFAstNode_t *_marpaEBNF_astNodeNewp(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, int kindi);
+marpaEBNFAstNode_t *_marpaEBNF_astLeafNewp(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, int kindi, size_t offsetl, char *texts, size_t textl);
+short               _marpaEBNF_astNodeAppendb(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, marpaEBNFAstNode_t *parentp, marpaEBNFAstNode_t *childp);
+marpaEBNFAst_t     *_marpaEBNF_astNewp(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFAstNode_t *rootp);
+marpaEBNFAst_t     *_marpaEBNF_astMergep(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFAst_t **astpp, size_t astl);
+/* Replaces the syntax rules firstRulel .. firstRulel + rulel - 1 of *astpp by */
+/* those of pieceAstp, and moves the offsets of the rules after them by deltal: */
+/* in place when the block has room, else *astpp is a new block.               */
+short               _marpaEBNF_astSpliceb(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFAst_t **astpp, size_t firstRulel, size_t rulel, marpaEBNFAst_t *pieceAstp, size_t deltal);
+/* Copies of an AST, in memory or in a file: the grammar cache */
+marpaEBNFAst_t     *_marpaEBNF_astClonep(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFAst_t *marpaEBNFAstp);
+size_t              _marpaEBNF_astSizel(marpaEBNFAst_t *marpaEBNFAstp);
+short               _marpaEBNF_astWriteb(marpaEBNFAst_t *marpaEBNFAstp, FILE *fp);
+marpaEBNFAst_t     *_marpaEBNF_astReadp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, FILE *fp);
+void                _marpaEBNF_astFreev(marpaEBNFAst_t *marpaEBNFAstp, marpaEBNFAllocator_t *marpaEBNFAllocatorp);
+
+#endif /* MARPAEBNF_INTERNAL_AST_H */
@@ -0,0 +1,158 @@
+#ifndef MARPAEBNF_INTERNAL_BYTECLASS_H
+#define MARPAEBNF_INTERNAL_BYTECLASS_H
+
+#include <limits.h>
+#include <string.h>
+#include "marpaEBNF/internal/symbol.h"
+
+/* ------------------------------------------------------------------------ */
+/* Table-driven lexing of the internal (scannerless) grammar.               */
+/*                                                                          */
+/* Every byte is mapped to the set of terminals it can start. The lexer     */
+/* then only has to intersect that set with the set of expected terminals.  */
+/* Two-characters lexemes are the intersection of a first-byte and a        */
+/* second-byte table: all of them are distinct pairs of characters.         */
+/* ------------------------------------------------------------------------ */
+
+typedef unsigned long marpaEBNFSymbolSetWord_t;
+
+#define MARPAEBNF_SYMBOLSET_WORDBIT (sizeof(marpaEBNFSymbolSetWord_t) * CHAR_BIT)
+#define MARPAEBNF_SYMBOLSET_NWORD   ((_MARPAEBNF_NSYMBOL + (sizeof(marpaEBNFSymbolSetWord_t) * CHAR_BIT) - 1) / (sizeof(marpaEBNFSymbolSetWord_t) * CHAR_BIT))
+
+typedef struct marpaEBNFSymbolSet {
+  marpaEBNFSymbolSetWord_t wordp[MARPAEBNF_SYMBOLSET_NWORD];
+} marpaEBNFSymbolSet_t;
+
+#define MARPAEBNF_SYMBOLSET_ZERO(setp)           memset((setp), 0, sizeof(marpaEBNFSymbolSet_t))
+#define MARPAEBNF_SYMBOLSET_SET(setp, symboli)   ((setp)->wordp[(symboli) / MARPAEBNF_SYMBOLSET_WORDBIT] |=  (((marpaEBNFSymbolSetWord_t) 1) << ((symboli) % MARPAEBNF_SYMBOLSET_WORDBIT)))
+#define MARPAEBNF_SYMBOLSET_CLR(setp, symboli)   ((setp)->wordp[(symboli) / MARPAEBNF_SYMBOLSET_WORDBIT] &= ~(((marpaEBNFSymbolSetWord_t) 1) << ((symboli) % MARPAEBNF_SYMBOLSET_WORDBIT)))
+#define MARPAEBNF_SYMBOLSET_ISSET(setp, symboli) (((setp)->wordp[(symboli) / MARPAEBNF_SYMBOLSET_WORDBIT] &   (((marpaEBNFSymbolSetWord_t) 1) << ((symboli) % MARPAEBNF_SYMBOLSET_WORDBIT))) != 0)
+
+#if defined(__GNUC__)
+#define MARPAEBNF_SYMBOLSET_CTZ(w) __builtin_ctzl(w)
+#else
+#define MARPAEBNF_SYMBOLSET_CTZ(w) _marpaEBNF_symbolSetCtzi(w)
+static inline int _marpaEBNF_symbolSetCtzi(marpaEBNFSymbolSetWord_t w)
+{
+  int i = 0;
+
+  while ((w & 1) == 0) {
+    w >>= 1;
+    i++;
+  }
+  return i;
+}
+#endif
+
+/* Iterates over all the symbols of a set: MARPAEBNF_SYMBOLSET_FOREACH(setp, wordi, w, symboli) { ... } */
+#define MARPAEBNF_SYMBOLSET_FOREACH(setp, wordi, w, symboli)            \
+  for (wordi = 0; wordi < MARPAEBNF_SYMBOLSET_NWORD; wordi++)           \
+    for (w = (setp)->wordp[wordi];                                      \
+         (w != 0) && ((symboli = (int) (wordi * MARPAEBNF_SYMBOLSET_WORDBIT) + MARPAEBNF_SYMBOLSET_CTZ(w)), 1); \
+         w &= w - 1)
+
+/* A lexeme is a terminal of the internal grammar, with the bytes it can start with */
+typedef struct marpaEBNFLexeme {
+  marpaEBNFSymbolEnum_t symboli;
+  char                 *firsts;    /* Bytes that can start the lexeme */
+  char                  second;    /* Second byte of a two-characters lexeme, '\0' if none */
+} marpaEBNFLexeme_t;
+
+static marpaEBNFLexeme_t marpaEBNFLexemeArray[] = {
+  /* ------------------------------------------------------------------------------------------
+  {symboli,                       firsts                                                 , second
+  --------------------------------------------------------------------------------------------- */
+  {LETTER                         , "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", '\0' },
+  {DECIMAL_DIGIT                  , "0123456789"                                          , '\0' },
+  {CONCATENATE_SYMBOL             , ","                                                   , '\0' },
+  {DEFINING_SYMBOL                , "="                                                   , '\0' },
+  {DEFINITION_SEPARATOR_SYMBOL    , "|/!"                                                 , '\0' },
+  {END_COMMENT_SYMBOL             , "*"                                                   , ')'  },
+  {END_GROUP_SYMBOL               , ")"                                                   , '\0' },
+  {_END_OPTION_SYMBOL_0           , "]"                                                   , '\0' },
+  {_END_OPTION_SYMBOL_1           , "/"                                                   , ')'  },
+  {_END_REPEAT_SYMBOL_0           , "}"                                                   , '\0' },
+  {_END_REPEAT_SYMBOL_1           , ":"                                                   , ')'  },
+  {EXCEPT_SYMBOL                  , "-"                                                   , '\0' },
+  {FIRST_QUOTE_SYMBOL             , "'"                                                   , '\0' },
+  {REPETITION_SYMBOL              , "*"                                                   , '\0' },
+  {SECOND_QUOTE_SYMBOL            , "\""                                                  , '\0' },
+  {SPECIAL_SEQUENCE_SYMBOL        , "?"                                                   , '\0' },
+  {START_COMMENT_SYMBOL           , "("                                                   , '*'  },
+  {START_GROUP_SYMBOL             , "("                                                   , '\0' },
+  {_START_OPTION_SYMBOL_0         , "["                                                   , '\0' },
+  {_START_OPTION_SYMBOL_1         , "("                                                   , '/'  },
+  {_START_REPEAT_SYMBOL_0         , "{"                                                   , '\0' },
+  {_START_REPEAT_SYMBOL_1         , "("                                                   , ':'  },
+  {TERMINATOR_SYMBOL              , ";."                                                  , '\0' },
+  {OTHER_CHARACTER                , " :+_%@&#$<>\\^`~"                                    , '\0' },
+  {SPACE_CHARACTER                , " "                                                   , '\0' },
+  {HORIZONTAL_TABULATION_CHARACTER, "\t"                                                  , '\0' },
+  {_CARRIAGE_RETURN               , "\r"                                                  , '\0' },
+  {_LINE_FEED                     , "\n"                                                  , '\0' },
+  {VERTICAL_TABULATION_CHARACTER  , "\v"                                                  , '\0' },
+  {FORM_FEED                      , "\f"                                                  , '\0' }
+};
+
+typedef struct marpaEBNFByteClass {
+  marpaEBNFSymbolSet_t singlep[256];       /* Single-byte lexemes, by byte */
+  marpaEBNFSymbolSet_t pairFirstp[256];    /* Two-bytes lexemes, by first byte */
+  marpaEBNFSymbolSet_t pairSecondp[256];   /* Two-bytes lexemes, by second byte */
+  marpaEBNFSymbolSet_t lexemeSet;          /* All lexemes */
+  marpaEBNFSymbolSet_t pairSet;            /* All two-bytes lexemes */
+} marpaEBNFByteClass_t;
+
+/****************************************************************************/
+static inline void _marpaEBNF_byteClassInitv(marpaEBNFByteClass_t *byteClassp)
+/****************************************************************************/
+{
+  size_t         i;
+  unsigned char *p;
+
+  memset(byteClassp, 0, sizeof(marpaEBNFByteClass_t));
+
+  for (i = 0; i < sizeof(marpaEBNFLexemeArray) / sizeof(marpaEBNFLexemeArray[0]); i++) {
+    MARPAEBNF_SYMBOLSET_SET(&(byteClassp->lexemeSet), marpaEBNFLexemeArray[i].symboli);
+    for (p = (unsigned char *) marpaEBNFLexemeArray[i].firsts; *p != '\0'; p++) {
+      if (marpaEBNFLexemeArray[i].second != '\0') {
+        MARPAEBNF_SYMBOLSET_SET(&(byteClassp->pairFirstp[*p]), marpaEBNFLexemeArray[i].symboli);
+      } else {
+        MARPAEBNF_SYMBOLSET_SET(&(byteClassp->singlep[*p]), marpaEBNFLexemeArray[i].symboli);
+      }
+    }
+    if (marpaEBNFLexemeArray[i].second != '\0') {
+      MARPAEBNF_SYMBOLSET_SET(&(byteClassp->pairSet), marpaEBNFLexemeArray[i].symboli);
+      MARPAEBNF_SYMBOLSET_SET(&(byteClassp->pairSecondp[(unsigned char) marpaEBNFLexemeArray[i].second]), marpaEBNFLexemeArray[i].symboli);
+    }
+  }
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_byteClassLexl(marpaEBNFByteClass_t *byteClassp, marpaEBNFSymbolSet_t *expectedSetp, short pairb, unsigned char c1, unsigned char c2, marpaEBNFSymbolSet_t *acceptedSetp)
+/****************************************************************************/
+/* Fills acceptedSetp with the expected lexemes that match at c1 (c2 being  */
+/* the lookahead byte, '\0' at the end) and returns their length: a match   */
+/* on a two-characters lexeme hides all the single-character ones.          */
+/* pairb says if expectedSetp contains any two-characters lexeme.           */
+/****************************************************************************/
+{
+  marpaEBNFSymbolSetWord_t anyw = 0;
+  size_t                   i;
+
+  if (pairb) {
+    for (i = 0; i < MARPAEBNF_SYMBOLSET_NWORD; i++) {
+      anyw |= (acceptedSetp->wordp[i] = expectedSetp->wordp[i] & byteClassp->pairFirstp[c1].wordp[i] & byteClassp->pairSecondp[c2].wordp[i]);
+    }
+    if (anyw != 0) {
+      return 2;
+    }
+  }
+
+  for (i = 0; i < MARPAEBNF_SYMBOLSET_NWORD; i++) {
+    anyw |= (acceptedSetp->wordp[i] = expectedSetp->wordp[i] & byteClassp->singlep[c1].wordp[i]);
+  }
+
+  return (anyw != 0) ? 1 : 0;
+}
+
+#endif /* MARPAEBNF_INTERNAL_BYTECLASS_H */
@@ -0,0 +1,62 @@
+#ifndef MARPAEBNF_INTERNAL_CACHE_H
+#define MARPAEBNF_INTERNAL_CACHE_H
+
+#include <stddef.h>
+#include <genericLogger.h>
+#include "marpaEBNF.h"
+#include "marpaEBNF/internal/memory.h"
+#include "marpaEBNF/internal/thread.h"
+#include "marpaEBNF/internal/sha256.h"
+
+/* ------------------------------------------------------------------------ */
+/* Grammar cache: ASTs by content.                                          */
+/*                                                                          */
+/* The key is the SHA-256 of a format version and of the grammar without    */
+/* its trailing gap separators: anything else that changes the text may     */
+/* change the offsets kept in the AST. The AST, not the compiled grammar,   */
+/* is what is kept: it is a single block without pointers, that is copied   */
+/* or written as is, while the compiled grammar belongs to its instance.    */
+/* Compiling again is what a hit costs. A grammar that is only valid with  */
+/* the utf8b option must not be a hit without it: the option is in the key. */
+/*                                                                          */
+/* Entries are in a hash table of chained buckets and in a recency list.    */
+/* A lookup copies the AST out while holding the mutex. Files are read and  */
+/* written without it: a file is written under a temporary name, then      */
+/* renamed, so that a reader never sees a partial one.                      */
+/* ------------------------------------------------------------------------ */
+
+#define MARPAEBNF_CACHE_KEY_SIZE    MARPAEBNF_SHA256_SIZE
+#define MARPAEBNF_CACHE_KEY_VERSION "marpaEBNF AST 1\n"
+#define MARPAEBNF_CACHE_KEY_UTF8    "utf8\n"
+
+typedef struct marpaEBNFCacheEntry {
+  unsigned char               keyp[MARPAEBNF_CACHE_KEY_SIZE];
+  marpaEBNFAst_t             *astp;        /* In the allocator of the cache */
+  size_t                      bytel;
+  struct marpaEBNFCacheEntry *hashNextp;   /* Next in the same bucket */
+  struct marpaEBNFCacheEntry *newerp;      /* Recency list */
+  struct marpaEBNFCacheEntry *olderp;
+} marpaEBNFCacheEntry_t;
+
+struct marpaEBNFCache {
+  genericLogger_t        *genericLoggerp;
+  marpaEBNFAllocator_t    marpaEBNFAllocator;  /* Entries, accounted apart from the instances */
+  marpaEBNFMutex_t        mutex;               /* Protects everything below */
+  size_t                  maxEntryl;
+  size_t                  maxBytel;            /* 0 for no limit */
+  char                   *directorys;          /* Persistent tier, NULL for none */
+  marpaEBNFCacheEntry_t **bucketpp;
+  size_t                  bucketl;             /* A power of two */
+  marpaEBNFCacheEntry_t  *newestp;
+  marpaEBNFCacheEntry_t  *oldestp;
+  marpaEBNFCacheStats_t   stats;
+  unsigned long           temporaryl;          /* Temporary files so far, for their names */
+};
+
+void            _marpaEBNF_cacheKeyv(char *grammars, size_t grammarl, short utf8b, unsigned char *keyp);
+/* A copy of the AST in marpaEBNFAllocatorp, NULL on a miss */
+marpaEBNFAst_t *_marpaEBNF_cacheGetp(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp);
+/* Keeps a copy of the AST: failures only mean that the next lookup misses */
+void            _marpaEBNF_cachePutv(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp, marpaEBNFAst_t *marpaEBNFAstp);
+
+#endif /* MARPAEBNF_INTERNAL_CACHE_H */
@@ -0,0 +1,49 @@
+#ifndef MARPAEBNF_INTERNAL_COMPILE_H
+#define MARPAEBNF_INTERNAL_COMPILE_H
+
+#include <stddef.h>
+#include <genericLogger.h>
+#include <marpaWrapper.h>
+#include "marpaEBNF.h"
+#include "marpaEBNF/internal/memory.h"
+#include "marpaEBNF/internal/arena.h"
+#include "marpaEBNF/internal/ast.h"
+
+/* Compilation of an AST into a precomputed marpaWrapperGrammar_t. Input is  */
+/* read byte per byte: every byte that appears in a terminal string or a     */
+/* special sequence is a terminal. Meta identifiers are nonterminals, the    */
+/* first one defined is the start symbol. Optional, repeated and grouped     */
+/* sequences get a symbol of their own. Exceptions are computed at compile   */
+/* time, as differences of finite languages. ISO/IEC 14977 4.7 requires the  */
+/* excepted side to be finite, not the factor: an infinite factor, e.g. in   */
+/* letter, {letter} - keyword, is a deviation that is not supported.         */
+/*                                                                           */
+/* Symbols and rules are first collected as the tables that marpaEBNF.h      */
+/* describes for generated grammars, then declared from them: a grammar      */
+/* compiled from an AST and one loaded from generated tables are built by    */
+/* the same code.                                                            */
+
+#define MARPAEBNF_COMPILE_NBYTE 256
+
+typedef struct marpaEBNFCompiled {
+  marpaWrapperGrammar_t    *marpaWrapperGrammarp;
+  int                       startSymboli;
+  int                       byteSymbolip[MARPAEBNF_COMPILE_NBYTE]; /* Terminal of every byte, -1 when it is not in the grammar */
+  size_t                    nSymboll;
+  size_t                    nRulel;
+  size_t                   *descriptionOffsetlp;                     /* Per symbol, in descriptions */
+  char                     *descriptions;                            /* NUL separated symbol descriptions */
+  size_t                    descriptionl;                            /* Bytes used in descriptions */
+  short                    *terminalbp;                              /* Per symbol */
+  marpaEBNFGeneratedRule_t *rulep;                                   /* Per rule */
+  int                      *rhsSymbolip;                             /* Right-hand sides of the rules, in rule order */
+  size_t                    rhsSymboll;
+} marpaEBNFCompiled_t;
+
+marpaEBNFCompiled_t *_marpaEBNF_compileNewp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFArena_t *marpaEBNFArenap, marpaEBNFAst_t *marpaEBNFAstp);
+/* From tables that marpaEBNF_generateb() wrote, checked before use */
+marpaEBNFCompiled_t *_marpaEBNF_compiledNewp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, const marpaEBNFGenerated_t *marpaEBNFGeneratedp);
+char                *_marpaEBNF_compiledDescriptions(marpaEBNFCompiled_t *marpaEBNFCompiledp, int symboli);
+void                 _marpaEBNF_compiledFreev(marpaEBNFCompiled_t *marpaEBNFCompiledp, marpaEBNFAllocator_t *marpaEBNFAllocatorp);
+
+#endif /* MARPAEBNF_INTERNAL_COMPILE_H */
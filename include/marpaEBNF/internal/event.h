@@ -0,0 +1,78 @@
+#ifndef MARPAEBNF_INTERNAL_EVENT_H
+#define MARPAEBNF_INTERNAL_EVENT_H
+
+#include <stddef.h>
+#include "marpaEBNF.h"
+
+/* ------------------------------------------------------------------------ */
+/* Per-instance ring of binary trace events.                                */
+/*                                                                          */
+/* Writing an event is a copy of four integers: no description is looked   */
+/* up and nothing is formatted until the events are drained. When the ring  */
+/* is full, the oldest event is overwritten and counted as lost.            */
+/* ------------------------------------------------------------------------ */
+
+#define MARPAEBNF_EVENT_RING_SIZE 256   /* A power of two */
+
+typedef struct marpaEBNFEventRing {
+  marpaEBNFEvent_t eventp[MARPAEBNF_EVENT_RING_SIZE];
+  size_t           writel;    /* Events ever written */
+  size_t           readl;     /* Events ever drained or lost */
+  size_t           lostl;     /* Events overwritten before being drained */
+} marpaEBNFEventRing_t;
+
+/****************************************************************************/
+static inline void _marpaEBNF_eventRingResetv(marpaEBNFEventRing_t *eventRingp)
+/****************************************************************************/
+{
+  eventRingp->writel = 0;
+  eventRingp->readl  = 0;
+  eventRingp->lostl  = 0;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_eventPushv(marpaEBNFEventRing_t *eventRingp, int eventi, int symboli, int rulei, size_t positionl)
+/****************************************************************************/
+{
+  marpaEBNFEvent_t *eventp = &(eventRingp->eventp[eventRingp->writel & (MARPAEBNF_EVENT_RING_SIZE - 1)]);
+
+  eventp->eventi    = eventi;
+  eventp->symboli   = symboli;
+  eventp->rulei     = rulei;
+  eventp->positionl = positionl;
+  if (++eventRingp->writel - eventRingp->readl > MARPAEBNF_EVENT_RING_SIZE) {
+    eventRingp->readl++;
+    eventRingp->lostl++;
+  }
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_eventDrainl(marpaEBNFEventRing_t *eventRingp, marpaEBNFEvent_t *eventp, size_t eventl)
+/****************************************************************************/
+/* Moves up to eventl events, oldest first, and returns how many            */
+/****************************************************************************/
+{
+  size_t i;
+
+  for (i = 0; (i < eventl) && (eventRingp->readl < eventRingp->writel); i++) {
+    eventp[i] = eventRingp->eventp[eventRingp->readl++ & (MARPAEBNF_EVENT_RING_SIZE - 1)];
+  }
+
+  return i;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_eventAppendv(marpaEBNFEventRing_t *eventRingp, marpaEBNFEventRing_t *fromEventRingp)
+/****************************************************************************/
+/* Moves all the events of another ring, e.g. of a piece of a parse         */
+/****************************************************************************/
+{
+  marpaEBNFEvent_t event;
+
+  eventRingp->lostl += fromEventRingp->lostl;
+  while (_marpaEBNF_eventDrainl(fromEventRingp, &event, 1) > 0) {
+    _marpaEBNF_eventPushv(eventRingp, event.eventi, event.symboli, event.rulei, event.positionl);
+  }
+}
+
+#endif /* MARPAEBNF_INTERNAL_EVENT_H */
@@ -0,0 +1,21 @@
+#ifndef MARPAEBNF_INTERNAL_FILE_H
+#define MARPAEBNF_INTERNAL_FILE_H
+
+#include <stddef.h>
+#include <genericLogger.h>
+#include "marpaEBNF/internal/memory.h"
+
+/* Read-only view of a whole grammar file. Where available the file is       */
+/* memory-mapped, and the parser reads straight from the mapping; elsewhere  */
+/* it is read into a buffer. The view is not NUL terminated.                 */
+
+typedef struct marpaEBNFFile {
+  char   *inputs;
+  size_t  inputl;
+  short   mappedb;   /* inputs is a mapping, else it comes from the allocator */
+} marpaEBNFFile_t;
+
+short _marpaEBNF_fileOpenb(marpaEBNFFile_t *marpaEBNFFilep, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, char *filenames);
+void  _marpaEBNF_fileClosev(marpaEBNFFile_t *marpaEBNFFilep, marpaEBNFAllocator_t *marpaEBNFAllocatorp);
+
+#endif /* MARPAEBNF_INTERNAL_FILE_H */
@@ -0,0 +1,22 @@
+#ifndef MARPAEBNF_INTERNAL_GENERATE_H
+#define MARPAEBNF_INTERNAL_GENERATE_H
+
+#include <genericLogger.h>
+#include "marpaEBNF.h"
+#include "marpaEBNF/internal/compile.h"
+
+/* ------------------------------------------------------------------------ */
+/* C source of a compiled grammar.                                          */
+/*                                                                          */
+/* The tables of the compiled grammar are written as static const arrays   */
+/* of the types of marpaEBNF.h, prefixed by the name, followed by a         */
+/* constructor <name>_newp(). The file only depends on marpaEBNF.h: it is   */
+/* compiled and linked with the program that uses the grammar. Loading it   */
+/* declares the same symbols and rules in the same order as the compiler,   */
+/* so that symbol numbers and descriptions in messages are the same.        */
+/* ------------------------------------------------------------------------ */
+
+/* Writes filenames, that is removed on failure */
+short _marpaEBNF_generateb(marpaEBNFCompiled_t *marpaEBNFCompiledp, genericLogger_t *genericLoggerp, char *names, char *filenames);
+
+#endif /* MARPAEBNF_INTERNAL_GENERATE_H */
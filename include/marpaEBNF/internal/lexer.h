@@ -0,0 +1,43 @@
+#ifndef MARPAEBNF_INTERNAL_LEXER_H
+#define MARPAEBNF_INTERNAL_LEXER_H
+
+#include <stddef.h>
+#include <genericLogger.h>
+#include "marpaEBNF/internal/symbol.h"
+
+/* Tokenizer of the token-level internal grammar: it emits whole lexemes (meta   */
+/* identifier, integer, terminal string, special sequence and the punctuation    */
+/* symbols) and discards gap separators and bracketed textual comments.          */
+
+#define MARPAEBNF_TOKEN_EOF  -1
+#define MARPAEBNF_TOKEN_MORE -2   /* Lexeme reaches the end of a chunk that is not the last one */
+
+typedef struct marpaEBNFToken {
+  int    symboli;    /* A marpaEBNFTokenSymbolEnum_t lexeme, MARPAEBNF_TOKEN_EOF or MARPAEBNF_TOKEN_MORE */
+  size_t offsetl;    /* Offset of the lexeme in the current buffer */
+  size_t lengthl;    /* Length of the lexeme in bytes */
+  size_t linel;      /* Line of the lexeme, starting at 1 */
+  size_t columnl;    /* Column of the lexeme, starting at 1 */
+} marpaEBNFToken_t;
+
+typedef struct marpaEBNFLexer {
+  genericLogger_t *genericLoggerp;
+  char            *inputs;     /* Input, not necessarily NUL terminated */
+  size_t           inputl;     /* Input length */
+  short            eofb;       /* Is the current buffer the end of the input */
+  size_t           baseOffsetl; /* Absolute offset of the current buffer */
+  size_t           offsetl;    /* Current position in the current buffer */
+  size_t           linel;      /* Current line, starting at 1 */
+  size_t           columnl;    /* Current column, starting at 1 */
+  size_t           discardedl; /* Bytes of gap separators and comments discarded */
+  short            utf8b;      /* UTF-8 characters in comments, terminal strings and special sequences; columns count them */
+  short            utf8Crossedb; /* A run went over UTF-8 characters since the last advance */
+} marpaEBNFLexer_t;
+
+void  _marpaEBNF_lexerInitv(marpaEBNFLexer_t *marpaEBNFLexerp, genericLogger_t *genericLoggerp, char *inputs, size_t inputl);
+void  _marpaEBNF_lexerChunkv(marpaEBNFLexer_t *marpaEBNFLexerp, char *inputs, size_t inputl, short eofb);
+/* On failure the token is the text in error, that the caller may skip */
+short _marpaEBNF_lexerNextb(marpaEBNFLexer_t *marpaEBNFLexerp, marpaEBNFToken_t *marpaEBNFTokenp);
+void  _marpaEBNF_lexerSkipv(marpaEBNFLexer_t *marpaEBNFLexerp, size_t lengthl);
+
+#endif /* MARPAEBNF_INTERNAL_LEXER_H */
@@ -0,0 +1,24 @@
+#ifndef MARPAEBNF_INTERNAL_MEMORY_H
+#define MARPAEBNF_INTERNAL_MEMORY_H
+
+#include <stddef.h>
+#include "marpaEBNF.h"
+
+/* All the allocations of marpaEBNF go through the allocator hooks of the    */
+/* option, with the system allocator as default. Every block is prefixed by */
+/* its size so that live, peak and total bytes can be accounted for.        */
+
+typedef struct marpaEBNFAllocator {
+  marpaEBNFMallocCallback_t  mallocp;
+  marpaEBNFReallocCallback_t reallocp;
+  marpaEBNFFreeCallback_t    freep;
+  void                      *userDatavp;
+  marpaEBNFMemory_t          memory;
+} marpaEBNFAllocator_t;
+
+void  _marpaEBNF_memoryInitv(marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFOption_t *marpaEBNFOptionp);
+void *_marpaEBNF_memoryMallocp(marpaEBNFAllocator_t *marpaEBNFAllocatorp, size_t sizel);
+void *_marpaEBNF_memoryReallocp(marpaEBNFAllocator_t *marpaEBNFAllocatorp, void *p, size_t sizel);
+void  _marpaEBNF_memoryFreev(marpaEBNFAllocator_t *marpaEBNFAllocatorp, void *p);
+
+#endif /* MARPAEBNF_INTERNAL_MEMORY_H */
@@ -0,0 +1,19 @@
+#ifndef MARPAEBNF_INTERNAL_POOL_H
+#define MARPAEBNF_INTERNAL_POOL_H
+
+#include <stddef.h>
+#include <genericLogger.h>
+#include "marpaEBNF/internal/memory.h"
+
+/* Work-stealing pool: items 0 .. iteml - 1 are dealt to the workers in     */
+/* contiguous ranges. A worker takes its items from the front of its range; */
+/* once it is empty, it steals the back half of the largest range left. A   */
+/* single worker runs in the calling thread.                                */
+
+/* Processes item itemi on worker workeri. A return value of 0 is fatal: no */
+/* other item is started.                                                   */
+typedef short (*marpaEBNFPoolCallback_t)(void *userDatavp, size_t workeri, size_t itemi);
+
+short _marpaEBNF_poolRunb(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, size_t workerl, size_t iteml, marpaEBNFPoolCallback_t callbackp, void *userDatavp, size_t *stolenlp);
+
+#endif /* MARPAEBNF_INTERNAL_POOL_H */
@@ -0,0 +1,68 @@
+#ifndef MARPAEBNF_INTERNAL_RULE_H
+#define MARPAEBNF_INTERNAL_RULE_H
+
+#include <stddef.h>
+#include <marpaWrapper.h>
+#include "marpaEBNF/internal/byteClass.h"
+
+/* ------------------------------------------------------------------------ */
+/* Rules of the internal grammars.                                          */
+/*                                                                          */
+/* The right-hand sides and the exceptions of all the rules of a grammar    */
+/* are packed in a single array of symbols, in rule order: rule i owns the  */
+/* entries offsetlp[i] .. offsetlp[i+1] - 1, its right-hand side first,     */
+/* then its exceptions. Exceptions are also precomputed as one symbol set   */
+/* per rule, so that checking one is a single bit test.                     */
+/* ------------------------------------------------------------------------ */
+
+typedef struct marpaEBNFRule {
+  marpaWrapperGrammarRuleOption_t   option;
+  int                               lhsSymboli;
+  size_t                            rhsSymboll;
+  size_t                            rhsExceptl;
+} marpaEBNFRule_t;
+
+typedef struct marpaEBNFRuleTable {
+  marpaEBNFRule_t      *rulep;
+  size_t                rulel;
+  int                  *symbolip;      /* Right-hand sides and exceptions */
+  size_t                symboll;
+  size_t               *offsetlp;      /* rulel + 1 entries, filled by _marpaEBNF_ruleTableInitb */
+  marpaEBNFSymbolSet_t *exceptSetp;    /* rulel entries, ditto */
+  marpaEBNFSymbolSet_t  exceptSet;     /* Symbols that are an exception of any rule, ditto */
+} marpaEBNFRuleTable_t;
+
+#define MARPAEBNF_RULE_RHSP(tablep, rulei)     ((tablep)->symbolip + (tablep)->offsetlp[rulei])
+#define MARPAEBNF_RULE_EXCEPTP(tablep, rulei)  ((tablep)->symbolip + (tablep)->offsetlp[rulei] + (tablep)->rulep[rulei].rhsSymboll)
+
+/****************************************************************************/
+static inline short _marpaEBNF_ruleTableInitb(marpaEBNFRuleTable_t *ruleTablep)
+/****************************************************************************/
+/* Returns 0 if the symbols do not add up to what the rules declare         */
+/****************************************************************************/
+{
+  size_t  offsetl = 0;
+  size_t  rulei;
+  size_t  i;
+  int    *exceptip;
+
+  MARPAEBNF_SYMBOLSET_ZERO(&(ruleTablep->exceptSet));
+  for (rulei = 0; rulei < ruleTablep->rulel; rulei++) {
+    ruleTablep->offsetlp[rulei] = offsetl;
+    offsetl += ruleTablep->rulep[rulei].rhsSymboll + ruleTablep->rulep[rulei].rhsExceptl;
+    if (offsetl > ruleTablep->symboll) {
+      return 0;
+    }
+    MARPAEBNF_SYMBOLSET_ZERO(&(ruleTablep->exceptSetp[rulei]));
+    exceptip = MARPAEBNF_RULE_EXCEPTP(ruleTablep, rulei);
+    for (i = 0; i < ruleTablep->rulep[rulei].rhsExceptl; i++) {
+      MARPAEBNF_SYMBOLSET_SET(&(ruleTablep->exceptSetp[rulei]), exceptip[i]);
+      MARPAEBNF_SYMBOLSET_SET(&(ruleTablep->exceptSet), exceptip[i]);
+    }
+  }
+  ruleTablep->offsetlp[rulei] = offsetl;
+
+  return (offsetl == ruleTablep->symboll) ? 1 : 0;
+}
+
+#endif /* MARPAEBNF_INTERNAL_RULE_H */
@@ -0,0 +1,470 @@
+#ifndef MARPAEBNF_INTERNAL_SCAN_H
+#define MARPAEBNF_INTERNAL_SCAN_H
+
+#include <stddef.h>
+
+/* ------------------------------------------------------------------------ */
+/* Bulk scanning of the lexemes that are long runs of "uninteresting"       */
+/* bytes: bracketed textual comments, terminal strings, special sequences   */
+/* and gap separators. The tokenizer only needs the position of the next    */
+/* delimiter, or of the next byte that is not allowed in the run, so this   */
+/* is a search of 16 (SSE2) or 32 (AVX2) bytes at a time. The scalar        */
+/* versions are always available: they are the reference implementation,   */
+/* and the fallback on other architectures or with MARPAEBNF_SCAN_SCALAR.   */
+/*                                                                          */
+/* With the utf8b option, a scan that stops on a byte above 0x7F goes on    */
+/* with the UTF-8 validator: it consumes well-formed sequences until the    */
+/* next ASCII byte, so that pure ASCII never leaves the search above. The   */
+/* vector version is the lookup algorithm of Keiser and Lemire, that needs  */
+/* a byte shuffle: AVX2, or SSSE3 next to SSE2. When the compiler does not  */
+/* target them, GCC and clang on x86 build both versions for their own CPU  */
+/* and the one the CPU supports is chosen at run time.                      */
+/* ------------------------------------------------------------------------ */
+
+#if !defined(MARPAEBNF_SCAN_SCALAR)
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#    define MARPAEBNF_SCAN_AVX2
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#    include <emmintrin.h>
+#    define MARPAEBNF_SCAN_SSE2
+#    if defined(__SSSE3__)
+#      include <tmmintrin.h>
+#      define MARPAEBNF_SCAN_SSSE3
+#    endif
+#  endif
+#  if !defined(MARPAEBNF_SCAN_AVX2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    include <immintrin.h>
+#    define MARPAEBNF_SCAN_DISPATCH
+#  endif
+#endif
+
+#if defined(MARPAEBNF_SCAN_DISPATCH)
+#  define MARPAEBNF_SCAN_TARGET_AVX2  __attribute__((target("avx2")))
+#  define MARPAEBNF_SCAN_TARGET_SSSE3 __attribute__((target("ssse3")))
+#  if defined(MARPAEBNF_SCAN_SSSE3)
+#    define MARPAEBNF_SCAN_CPU_SSSE3  1
+#  else
+#    define MARPAEBNF_SCAN_CPU_SSSE3  __builtin_cpu_supports("ssse3")
+#  endif
+#else
+#  define MARPAEBNF_SCAN_TARGET_AVX2
+#  define MARPAEBNF_SCAN_TARGET_SSSE3
+#endif
+
+/* Gap separators: space, horizontal tabulation, new line, vertical tabulation, carriage return and form feed */
+#define MARPAEBNF_SCAN_IS_GAP(c)      (((c) == ' ') || (((c) >= 0x09) && ((c) <= 0x0D)))
+#define MARPAEBNF_SCAN_IS_TERMINAL(c) (((c) >= 0x20) && ((c) <= 0x7E))
+/* Bytes that follow the first one of a multi-byte UTF-8 sequence */
+#define MARPAEBNF_SCAN_IS_CONTINUATION(c) (((c) & 0xC0) == 0x80)
+/* Length of the UTF-8 sequence that starts with a byte above 0xC1 */
+#define MARPAEBNF_SCAN_UTF8_LENGTH(c) (((c) >= 0xF0) ? 4 : (((c) >= 0xE0) ? 3 : 2))
+
+#if defined(MARPAEBNF_SCAN_AVX2) || defined(MARPAEBNF_SCAN_SSE2)
+#  if defined(__GNUC__)
+#    define MARPAEBNF_SCAN_CTZ(w) __builtin_ctz(w)
+#  else
+#    define MARPAEBNF_SCAN_CTZ(w) _marpaEBNF_scanCtzi(w)
+static inline int _marpaEBNF_scanCtzi(unsigned int w)
+{
+  int i = 0;
+
+  while ((w & 1) == 0) {
+    w >>= 1;
+    i++;
+  }
+  return i;
+}
+#  endif
+#endif
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_scanGapEndScalarl(const char *inputs, size_t offsetl, size_t inputl)
+/****************************************************************************/
+{
+  unsigned char c;
+
+  while (offsetl < inputl) {
+    c = (unsigned char) inputs[offsetl];
+    if (! MARPAEBNF_SCAN_IS_GAP(c)) {
+      break;
+    }
+    offsetl++;
+  }
+
+  return offsetl;
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_scanStopScalarl(const char *inputs, size_t offsetl, size_t inputl, char delimiter1, char delimiter2, short gapb)
+/****************************************************************************/
+{
+  unsigned char c;
+
+  while (offsetl < inputl) {
+    c = (unsigned char) inputs[offsetl];
+    if ((c == (unsigned char) delimiter1) || (c == (unsigned char) delimiter2)) {
+      break;
+    }
+    if (! (MARPAEBNF_SCAN_IS_TERMINAL(c) || (gapb && MARPAEBNF_SCAN_IS_GAP(c)))) {
+      break;
+    }
+    offsetl++;
+  }
+
+  return offsetl;
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_scanUtf8EndScalarl(const char *inputs, size_t offsetl, size_t inputl)
+/****************************************************************************/
+/* Well-formed sequences as per table 3-7 of the Unicode standard: no       */
+/* overlong form, no surrogate, nothing above U+10FFFF.                     */
+/****************************************************************************/
+{
+  const unsigned char *bytep = (const unsigned char *) inputs;
+  unsigned char        c;
+  unsigned char        lowc;
+  unsigned char        highc;
+  size_t               lengthl;
+  size_t               i;
+
+  while (offsetl < inputl) {
+    c     = bytep[offsetl];
+    lowc  = 0x80;
+    highc = 0xBF;
+    if ((c < 0xC2) || (c > 0xF4)) {
+      break;
+    }
+    lengthl = MARPAEBNF_SCAN_UTF8_LENGTH(c);
+    if (c == 0xE0) {
+      lowc = 0xA0;
+    } else if (c == 0xED) {
+      highc = 0x9F;
+    } else if (c == 0xF0) {
+      lowc = 0x90;
+    } else if (c == 0xF4) {
+      highc = 0x8F;
+    }
+    if ((offsetl + lengthl > inputl) || (bytep[offsetl + 1] < lowc) || (bytep[offsetl + 1] > highc)) {
+      break;
+    }
+    for (i = 2; i < lengthl; i++) {
+      if (! MARPAEBNF_SCAN_IS_CONTINUATION(bytep[offsetl + i])) {
+        break;
+      }
+    }
+    if (i < lengthl) {
+      break;
+    }
+    offsetl += lengthl;
+  }
+
+  return offsetl;
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_scanUtf8Boundaryl(const char *inputs, size_t offsetl, size_t endl)
+/****************************************************************************/
+/* [offsetl, endl[ is valid but for a sequence that may be cut at endl:    */
+/* returns where that sequence starts, endl if none is.                     */
+/****************************************************************************/
+{
+  const unsigned char *bytep = (const unsigned char *) inputs;
+  size_t               i;
+
+  for (i = endl; (i > offsetl) && (i + 3 >= endl); i--) {
+    if (! MARPAEBNF_SCAN_IS_CONTINUATION(bytep[i - 1])) {
+      return ((i - 1) + MARPAEBNF_SCAN_UTF8_LENGTH(bytep[i - 1]) > endl) ? (i - 1) : endl;
+    }
+  }
+
+  return endl;
+}
+
+/* Error bits of the lookup algorithm: a pair of bytes is in error when the */
+/* three tables, indexed by the high and low nibbles of the previous byte   */
+/* and by the high nibble of the current one, share a bit.                  */
+#define MARPAEBNF_SCAN_UTF8_TOO_SHORT      0x01   /* Lead byte not followed by a continuation */
+#define MARPAEBNF_SCAN_UTF8_TOO_LONG       0x02   /* ASCII followed by a continuation */
+#define MARPAEBNF_SCAN_UTF8_OVERLONG_3     0x04
+#define MARPAEBNF_SCAN_UTF8_TOO_LARGE      0x08
+#define MARPAEBNF_SCAN_UTF8_SURROGATE      0x10
+#define MARPAEBNF_SCAN_UTF8_OVERLONG_2     0x20
+#define MARPAEBNF_SCAN_UTF8_TOO_LARGE_1000 0x40
+#define MARPAEBNF_SCAN_UTF8_OVERLONG_4     0x40
+#define MARPAEBNF_SCAN_UTF8_TWO_CONTS      0x80   /* Continuation after a continuation: fine within a sequence */
+#define MARPAEBNF_SCAN_UTF8_CARRY          (MARPAEBNF_SCAN_UTF8_TOO_SHORT | MARPAEBNF_SCAN_UTF8_TOO_LONG | MARPAEBNF_SCAN_UTF8_TWO_CONTS)
+
+#define MARPAEBNF_SCAN_UTF8_BYTE_1_HIGH                                 \
+  MARPAEBNF_SCAN_UTF8_TOO_LONG, MARPAEBNF_SCAN_UTF8_TOO_LONG, MARPAEBNF_SCAN_UTF8_TOO_LONG, MARPAEBNF_SCAN_UTF8_TOO_LONG, \
+  MARPAEBNF_SCAN_UTF8_TOO_LONG, MARPAEBNF_SCAN_UTF8_TOO_LONG, MARPAEBNF_SCAN_UTF8_TOO_LONG, MARPAEBNF_SCAN_UTF8_TOO_LONG, \
+  MARPAEBNF_SCAN_UTF8_TWO_CONTS, MARPAEBNF_SCAN_UTF8_TWO_CONTS, MARPAEBNF_SCAN_UTF8_TWO_CONTS, MARPAEBNF_SCAN_UTF8_TWO_CONTS, \
+  MARPAEBNF_SCAN_UTF8_TOO_SHORT | MARPAEBNF_SCAN_UTF8_OVERLONG_2,       \
+  MARPAEBNF_SCAN_UTF8_TOO_SHORT,                                        \
+  MARPAEBNF_SCAN_UTF8_TOO_SHORT | MARPAEBNF_SCAN_UTF8_OVERLONG_3 | MARPAEBNF_SCAN_UTF8_SURROGATE, \
+  MARPAEBNF_SCAN_UTF8_TOO_SHORT | MARPAEBNF_SCAN_UTF8_TOO_LARGE | MARPAEBNF_SCAN_UTF8_TOO_LARGE_1000 | MARPAEBNF_SCAN_UTF8_OVERLONG_4
+
+#define MARPAEBNF_SCAN_UTF8_LARGE (MARPAEBNF_SCAN_UTF8_CARRY | MARPAEBNF_SCAN_UTF8_TOO_LARGE | MARPAEBNF_SCAN_UTF8_TOO_LARGE_1000)
+#define MARPAEBNF_SCAN_UTF8_BYTE_1_LOW                                  \
+  MARPAEBNF_SCAN_UTF8_CARRY | MARPAEBNF_SCAN_UTF8_OVERLONG_3 | MARPAEBNF_SCAN_UTF8_OVERLONG_2 | MARPAEBNF_SCAN_UTF8_OVERLONG_4, \
+  MARPAEBNF_SCAN_UTF8_CARRY | MARPAEBNF_SCAN_UTF8_OVERLONG_2,           \
+  MARPAEBNF_SCAN_UTF8_CARRY, MARPAEBNF_SCAN_UTF8_CARRY,                 \
+  MARPAEBNF_SCAN_UTF8_CARRY | MARPAEBNF_SCAN_UTF8_TOO_LARGE,            \
+  MARPAEBNF_SCAN_UTF8_LARGE, MARPAEBNF_SCAN_UTF8_LARGE, MARPAEBNF_SCAN_UTF8_LARGE, \
+  MARPAEBNF_SCAN_UTF8_LARGE, MARPAEBNF_SCAN_UTF8_LARGE, MARPAEBNF_SCAN_UTF8_LARGE, MARPAEBNF_SCAN_UTF8_LARGE, MARPAEBNF_SCAN_UTF8_LARGE, \
+  MARPAEBNF_SCAN_UTF8_LARGE | MARPAEBNF_SCAN_UTF8_SURROGATE,            \
+  MARPAEBNF_SCAN_UTF8_LARGE, MARPAEBNF_SCAN_UTF8_LARGE
+
+#define MARPAEBNF_SCAN_UTF8_CONT (MARPAEBNF_SCAN_UTF8_TOO_LONG | MARPAEBNF_SCAN_UTF8_OVERLONG_2 | MARPAEBNF_SCAN_UTF8_TWO_CONTS)
+#define MARPAEBNF_SCAN_UTF8_BYTE_2_HIGH                                 \
+  MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT, \
+  MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT, \
+  MARPAEBNF_SCAN_UTF8_CONT | MARPAEBNF_SCAN_UTF8_OVERLONG_3 | MARPAEBNF_SCAN_UTF8_TOO_LARGE_1000 | MARPAEBNF_SCAN_UTF8_OVERLONG_4, \
+  MARPAEBNF_SCAN_UTF8_CONT | MARPAEBNF_SCAN_UTF8_OVERLONG_3 | MARPAEBNF_SCAN_UTF8_TOO_LARGE, \
+  MARPAEBNF_SCAN_UTF8_CONT | MARPAEBNF_SCAN_UTF8_SURROGATE | MARPAEBNF_SCAN_UTF8_TOO_LARGE, \
+  MARPAEBNF_SCAN_UTF8_CONT | MARPAEBNF_SCAN_UTF8_SURROGATE | MARPAEBNF_SCAN_UTF8_TOO_LARGE, \
+  MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT, MARPAEBNF_SCAN_UTF8_TOO_SHORT
+
+#if defined(MARPAEBNF_SCAN_AVX2) || defined(MARPAEBNF_SCAN_DISPATCH)
+/****************************************************************************/
+MARPAEBNF_SCAN_TARGET_AVX2
+static inline size_t _marpaEBNF_scanUtf8EndAvx2l(const char *inputs, size_t offsetl, size_t inputl)
+/****************************************************************************/
+/* Blocks of 32 bytes of _marpaEBNF_scanUtf8Endl(): returns where the      */
+/* scalar version takes over.                                               */
+/****************************************************************************/
+{
+  const __m256i byte1High = _mm256_setr_epi8(MARPAEBNF_SCAN_UTF8_BYTE_1_HIGH, MARPAEBNF_SCAN_UTF8_BYTE_1_HIGH);
+  const __m256i byte1Low  = _mm256_setr_epi8(MARPAEBNF_SCAN_UTF8_BYTE_1_LOW, MARPAEBNF_SCAN_UTF8_BYTE_1_LOW);
+  const __m256i byte2High = _mm256_setr_epi8(MARPAEBNF_SCAN_UTF8_BYTE_2_HIGH, MARPAEBNF_SCAN_UTF8_BYTE_2_HIGH);
+  const __m256i nibble    = _mm256_set1_epi8(0x0F);
+  const __m256i third     = _mm256_set1_epi8((char) (0xE0 - 0x80));
+  const __m256i fourth    = _mm256_set1_epi8((char) (0xF0 - 0x80));
+  const __m256i high      = _mm256_set1_epi8((char) 0x80);
+  __m256i       v;
+  __m256i       before;
+  __m256i       prev1;
+  __m256i       errors;
+
+  while (offsetl + 32 <= inputl) {
+    v = _mm256_loadu_si256((const __m256i *) (inputs + offsetl));
+    if ((unsigned int) _mm256_movemask_epi8(v) != 0xFFFFFFFFU) {
+      break;
+    }
+    /* The 16 bytes before each lane: zeroes, then the low lane */
+    before = _mm256_permute2x128_si256(v, v, 0x08);
+    prev1  = _mm256_alignr_epi8(v, before, 15);
+    errors = _mm256_and_si256(_mm256_and_si256(_mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                                               _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble))),
+                              _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble)));
+    errors = _mm256_xor_si256(errors, _mm256_and_si256(_mm256_or_si256(_mm256_subs_epu8(_mm256_alignr_epi8(v, before, 14), third),
+                                                                       _mm256_subs_epu8(_mm256_alignr_epi8(v, before, 13), fourth)),
+                                                       high));
+    if (! _mm256_testz_si256(errors, errors)) {
+      break;
+    }
+    offsetl = _marpaEBNF_scanUtf8Boundaryl(inputs, offsetl, offsetl + 32);
+  }
+
+  return offsetl;
+}
+#endif
+
+#if defined(MARPAEBNF_SCAN_SSSE3) || defined(MARPAEBNF_SCAN_DISPATCH)
+/****************************************************************************/
+MARPAEBNF_SCAN_TARGET_SSSE3
+static inline size_t _marpaEBNF_scanUtf8EndSsse3l(const char *inputs, size_t offsetl, size_t inputl)
+/****************************************************************************/
+/* Blocks of 16 bytes of _marpaEBNF_scanUtf8Endl()                          */
+/****************************************************************************/
+{
+  const __m128i byte1High = _mm_setr_epi8(MARPAEBNF_SCAN_UTF8_BYTE_1_HIGH);
+  const __m128i byte1Low  = _mm_setr_epi8(MARPAEBNF_SCAN_UTF8_BYTE_1_LOW);
+  const __m128i byte2High = _mm_setr_epi8(MARPAEBNF_SCAN_UTF8_BYTE_2_HIGH);
+  const __m128i nibble    = _mm_set1_epi8(0x0F);
+  const __m128i third     = _mm_set1_epi8((char) (0xE0 - 0x80));
+  const __m128i fourth    = _mm_set1_epi8((char) (0xF0 - 0x80));
+  const __m128i high      = _mm_set1_epi8((char) 0x80);
+  const __m128i zero      = _mm_setzero_si128();
+  __m128i       v;
+  __m128i       prev1;
+  __m128i       errors;
+
+  while (offsetl + 16 <= inputl) {
+    v = _mm_loadu_si128((const __m128i *) (inputs + offsetl));
+    if ((unsigned int) _mm_movemask_epi8(v) != 0xFFFFU) {
+      break;
+    }
+    prev1  = _mm_alignr_epi8(v, zero, 15);
+    errors = _mm_and_si128(_mm_and_si128(_mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                                         _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble))),
+                           _mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(v, 4), nibble)));
+    errors = _mm_xor_si128(errors, _mm_and_si128(_mm_or_si128(_mm_subs_epu8(_mm_alignr_epi8(v, zero, 14), third),
+                                                              _mm_subs_epu8(_mm_alignr_epi8(v, zero, 13), fourth)),
+                                                 high));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(errors, zero)) != 0xFFFF) {
+      break;
+    }
+    offsetl = _marpaEBNF_scanUtf8Boundaryl(inputs, offsetl, offsetl + 16);
+  }
+
+  return offsetl;
+}
+#endif
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_scanUtf8Endl(const char *inputs, size_t offsetl, size_t inputl)
+/****************************************************************************/
+/* offsetl is at the start of a sequence. Returns the offset of the first   */
+/* byte at or after offsetl that is ASCII or that does not start a          */
+/* well-formed UTF-8 sequence entirely before inputl, inputl if there is    */
+/* none. Blocks are checked as if they followed an ASCII byte, each one     */
+/* from the start of the last sequence of the previous one. A block with    */
+/* an ASCII byte or an error is left to the scalar version, that finds      */
+/* where exactly the run ends.                                              */
+/****************************************************************************/
+{
+#if defined(MARPAEBNF_SCAN_AVX2)
+  offsetl = _marpaEBNF_scanUtf8EndAvx2l(inputs, offsetl, inputl);
+#elif defined(MARPAEBNF_SCAN_DISPATCH)
+  if (__builtin_cpu_supports("avx2")) {
+    offsetl = _marpaEBNF_scanUtf8EndAvx2l(inputs, offsetl, inputl);
+  } else if (MARPAEBNF_SCAN_CPU_SSSE3) {
+    offsetl = _marpaEBNF_scanUtf8EndSsse3l(inputs, offsetl, inputl);
+  }
+#elif defined(MARPAEBNF_SCAN_SSSE3)
+  offsetl = _marpaEBNF_scanUtf8EndSsse3l(inputs, offsetl, inputl);
+#endif
+
+  return _marpaEBNF_scanUtf8EndScalarl(inputs, offsetl, inputl);
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_scanColumnl(const char *inputs, size_t offsetl, size_t endl, short utf8b)
+/****************************************************************************/
+/* Columns taken by [offsetl, endl[, that has no new line: bytes, or UTF-8  */
+/* characters, i.e. bytes that are not continuations.                       */
+/****************************************************************************/
+{
+  size_t columnl;
+
+  if (! utf8b) {
+    return endl - offsetl;
+  }
+  for (columnl = 0; offsetl < endl; offsetl++) {
+    if (! MARPAEBNF_SCAN_IS_CONTINUATION((unsigned char) inputs[offsetl])) {
+      columnl++;
+    }
+  }
+
+  return columnl;
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_scanGapEndl(const char *inputs, size_t offsetl, size_t inputl)
+/****************************************************************************/
+/* Returns the offset of the first byte at or after offsetl that is not a   */
+/* gap separator, inputl if there is none.                                  */
+/****************************************************************************/
+{
+#if defined(MARPAEBNF_SCAN_AVX2)
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i low   = _mm256_set1_epi8(0x09);
+  const __m256i high  = _mm256_set1_epi8(0x0D);
+  __m256i       v;
+  unsigned int  maski;
+
+  while (offsetl + 32 <= inputl) {
+    v     = _mm256_loadu_si256((const __m256i *) (inputs + offsetl));
+    maski = ~ (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, space),
+                                                                  _mm256_cmpeq_epi8(_mm256_min_epu8(_mm256_max_epu8(v, low), high), v)));
+    if (maski != 0) {
+      return offsetl + MARPAEBNF_SCAN_CTZ(maski);
+    }
+    offsetl += 32;
+  }
+#elif defined(MARPAEBNF_SCAN_SSE2)
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i low   = _mm_set1_epi8(0x09);
+  const __m128i high  = _mm_set1_epi8(0x0D);
+  __m128i       v;
+  unsigned int  maski;
+
+  while (offsetl + 16 <= inputl) {
+    v     = _mm_loadu_si128((const __m128i *) (inputs + offsetl));
+    maski = (~ (unsigned int) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, space),
+                                                             _mm_cmpeq_epi8(_mm_min_epu8(_mm_max_epu8(v, low), high), v)))) & 0xFFFF;
+    if (maski != 0) {
+      return offsetl + MARPAEBNF_SCAN_CTZ(maski);
+    }
+    offsetl += 16;
+  }
+#endif
+
+  return _marpaEBNF_scanGapEndScalarl(inputs, offsetl, inputl);
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_scanStopl(const char *inputs, size_t offsetl, size_t inputl, char delimiter1, char delimiter2, short gapb)
+/****************************************************************************/
+/* Returns the offset of the first byte at or after offsetl that is either  */
+/* delimiter1, delimiter2, or not a terminal character (nor a gap separator */
+/* when gapb is true), inputl if there is none. The caller decides what the */
+/* stop byte means.                                                         */
+/****************************************************************************/
+{
+#if defined(MARPAEBNF_SCAN_AVX2)
+  const __m256i d1    = _mm256_set1_epi8(delimiter1);
+  const __m256i d2    = _mm256_set1_epi8(delimiter2);
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i del   = _mm256_set1_epi8(0x7F);
+  const __m256i low   = _mm256_set1_epi8(0x09);
+  const __m256i high  = _mm256_set1_epi8(0x0D);
+  __m256i       v;
+  __m256i       invalid;
+  unsigned int  maski;
+
+  while (offsetl + 32 <= inputl) {
+    v       = _mm256_loadu_si256((const __m256i *) (inputs + offsetl));
+    /* Signed comparison: bytes >= 0x80 are negative, hence below space */
+    invalid = _mm256_or_si256(_mm256_cmpgt_epi8(space, v), _mm256_cmpeq_epi8(v, del));
+    if (gapb) {
+      invalid = _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(_mm256_max_epu8(v, low), high), v), invalid);
+    }
+    maski = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(invalid, _mm256_or_si256(_mm256_cmpeq_epi8(v, d1), _mm256_cmpeq_epi8(v, d2))));
+    if (maski != 0) {
+      return offsetl + MARPAEBNF_SCAN_CTZ(maski);
+    }
+    offsetl += 32;
+  }
+#elif defined(MARPAEBNF_SCAN_SSE2)
+  const __m128i d1    = _mm_set1_epi8(delimiter1);
+  const __m128i d2    = _mm_set1_epi8(delimiter2);
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i del   = _mm_set1_epi8(0x7F);
+  const __m128i low   = _mm_set1_epi8(0x09);
+  const __m128i high  = _mm_set1_epi8(0x0D);
+  __m128i       v;
+  __m128i       invalid;
+  unsigned int  maski;
+
+  while (offsetl + 16 <= inputl) {
+    v       = _mm_loadu_si128((const __m128i *) (inputs + offsetl));
+    /* Signed comparison: bytes >= 0x80 are negative, hence below space */
+    invalid = _mm_or_si128(_mm_cmplt_epi8(v, space), _mm_cmpeq_epi8(v, del));
+    if (gapb) {
+      invalid = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_min_epu8(_mm_max_epu8(v, low), high), v), invalid);
+    }
+    maski = (unsigned int) _mm_movemask_epi8(_mm_or_si128(invalid, _mm_or_si128(_mm_cmpeq_epi8(v, d1), _mm_cmpeq_epi8(v, d2))));
+    if (maski != 0) {
+      return offsetl + MARPAEBNF_SCAN_CTZ(maski);
+    }
+    offsetl += 16;
+  }
+#endif
+
+  return _marpaEBNF_scanStopScalarl(inputs, offsetl, inputl, delimiter1, delimiter2, gapb);
+}
+
+#endif /* MARPAEBNF_INTERNAL_SCAN_H */
@@ -0,0 +1,21 @@
+#ifndef MARPAEBNF_INTERNAL_SHA256_H
+#define MARPAEBNF_INTERNAL_SHA256_H
+
+#include <stddef.h>
+
+/* SHA-256 (FIPS 180-4), enough to name grammars by their content */
+
+#define MARPAEBNF_SHA256_SIZE 32   /* Bytes of a digest */
+
+typedef struct marpaEBNFSha256 {
+  unsigned long  statep[8];        /* Only the low 32 bits are used */
+  unsigned char  blockp[64];
+  size_t         blockl;           /* Bytes pending in blockp */
+  size_t         lengthl;          /* Bytes ever given */
+} marpaEBNFSha256_t;
+
+void _marpaEBNF_sha256Initv(marpaEBNFSha256_t *marpaEBNFSha256p);
+void _marpaEBNF_sha256Updatev(marpaEBNFSha256_t *marpaEBNFSha256p, const void *p, size_t l);
+void _marpaEBNF_sha256Finalv(marpaEBNFSha256_t *marpaEBNFSha256p, unsigned char *digestp);
+
+#endif /* MARPAEBNF_INTERNAL_SHA256_H */
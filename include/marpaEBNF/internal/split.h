@@ -0,0 +1,31 @@
+#ifndef MARPAEBNF_INTERNAL_SPLIT_H
+#define MARPAEBNF_INTERNAL_SPLIT_H
+
+#include <stddef.h>
+
+/* A syntax is a sequence of syntax rules, each ending with a terminator     */
+/* symbol: the input can be cut right after any terminator that is outside   */
+/* of a terminal string, a special sequence or a comment, and every piece    */
+/* parses on its own. Pieces know where they start so that positions remain  */
+/* those of the whole input.                                                 */
+
+/* Below this size a piece is not worth a recognizer of its own */
+#define MARPAEBNF_SPLIT_MIN_SIZE 4096
+
+typedef struct marpaEBNFPiece {
+  size_t offsetl;    /* Absolute offset */
+  size_t lengthl;
+  size_t linel;      /* Line of the first byte, starting at 1 */
+  size_t columnl;    /* Column of the first byte, starting at 1 */
+} marpaEBNFPiece_t;
+
+/* Cuts inputs in at most maxPiecel pieces of about the same size. The last */
+/* piece always contains a terminator, unless there is a single piece.      */
+/* Returns the number of pieces, at least 1. Columns count UTF-8 characters */
+/* with utf8b, as the tokenizer does.                                       */
+size_t _marpaEBNF_splitl(char *inputs, size_t inputl, marpaEBNFPiece_t *piecep, size_t maxPiecel, short utf8b);
+/* Starts piecep at offsetl, that is after the start of previousp: its line */
+/* and column are counted from those of previousp.                          */
+void   _marpaEBNF_splitPiecev(char *inputs, marpaEBNFPiece_t *previousp, marpaEBNFPiece_t *piecep, size_t offsetl, short utf8b);
+
+#endif /* MARPAEBNF_INTERNAL_SPLIT_H */
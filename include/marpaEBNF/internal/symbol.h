@@ -0,0 +1,143 @@
+#ifndef MARPAEBNF_INTERNAL_SYMBOL_H
+#define MARPAEBNF_INTERNAL_SYMBOL_H
+
+/* Convenience enum, also used to make sure that symbol id is the enum -; */
+typedef enum marpaEBNFSymbolEnum {
+  _START,          /* Just because the default is to set start symbol to the first symbol */
+
+  LETTER,
+  DECIMAL_DIGIT,
+  CONCATENATE_SYMBOL,
+  DEFINING_SYMBOL,
+  DEFINITION_SEPARATOR_SYMBOL,
+  END_COMMENT_SYMBOL,
+  END_GROUP_SYMBOL,
+  END_OPTION_SYMBOL,
+  END_REPEAT_SYMBOL,
+  EXCEPT_SYMBOL,
+  FIRST_QUOTE_SYMBOL,
+  REPETITION_SYMBOL,
+  SECOND_QUOTE_SYMBOL,
+  SPECIAL_SEQUENCE_SYMBOL,
+  START_COMMENT_SYMBOL,
+  START_GROUP_SYMBOL,
+  START_OPTION_SYMBOL,
+  START_REPEAT_SYMBOL,
+  TERMINATOR_SYMBOL,
+  OTHER_CHARACTER,
+  SPACE_CHARACTER,
+  HORIZONTAL_TABULATION_CHARACTER,
+  NEW_LINE,
+  VERTICAL_TABULATION_CHARACTER,
+  FORM_FEED,
+  TERMINAL_CHARACTER,
+  GAP_FREE_SYMBOL,
+  TERMINAL_STRING,
+  FIRST_TERMINAL_CHARACTER,
+  SECOND_TERMINAL_CHARACTER,
+  GAP_SEPARATOR,
+  SYNTAX,
+  COMMENTLESS_SYMBOL,
+  INTEGER,
+  META_IDENTIFIER,
+  META_IDENTIFIER_CHARACTER,
+  SPECIAL_SEQUENCE,
+  SPECIAL_SEQUENCE_CHARACTER,
+  COMMENT_SYMBOL,
+  BRACKETED_TEXTUAL_COMMENT,
+  SYNTAX_RULE,
+  DEFINITIONS_LIST,
+  SINGLE_DEFINITION,
+  SYNTACTIC_TERM,
+  SYNTACTIC_EXCEPTION,
+  SYNTACTIC_FACTOR,
+  SYNTACTIC_PRIMARY,
+  OPTIONAL_SEQUENCE,
+  REPEATED_SEQUENCE,
+  GROUPED_SEQUENCE,
+  EMPTY_SEQUENCE,
+  COMMENT,
+
+  /* Internal symbols */
+
+  _CARRIAGE_RETURN,
+  _CARRIAGE_RETURN_ANY,
+  _LINE_FEED,
+
+  _START_REPEAT_SYMBOL_0,
+  _START_REPEAT_SYMBOL_1,
+
+  _END_REPEAT_SYMBOL_0,
+  _END_REPEAT_SYMBOL_1,
+
+  _START_OPTION_SYMBOL_0,
+  _START_OPTION_SYMBOL_1,
+
+  _END_OPTION_SYMBOL_0,
+  _END_OPTION_SYMBOL_1,
+
+  _FIRST_TERMINAL_CHARACTER_MANY,
+  _SECOND_TERMINAL_CHARACTER_MANY,
+
+  _GAP_SEPARATOR_ANY,
+  _GAP_SYMBOL_UNIT,
+  _GAP_SYMBOL_UNIT_MANY,
+
+  _COMMENTLESS_SYMBOL_TERMINAL_CHARACTER,
+
+  _META_IDENTIFIER_CHARACTER_ANY,
+
+  _SPECIAL_SEQUENCE_CHARACTER_ANY,
+
+  _COMMENT_SYMBOL_ANY,
+
+  _BRACKETED_TEXTUAL_COMMENT_ANY,
+  _COMMENTLESS_SYMBOL_UNIT,
+  _COMMENTLESS_SYMBOL_UNIT_MANY,
+
+  _DEFINITIONS_SEQUENCE,
+
+  _MARPAEBNF_NSYMBOL               /* Not a symbol: number of symbols */
+} marpaEBNFSymbolEnum_t;
+
+/* Symbols of the token-level internal grammar: lexemes are recognized by the */
+/* tokenizer (c.f. lexer.h), gap separators and comments are discarded.      */
+typedef enum marpaEBNFTokenSymbolEnum {
+  _TOKEN_START,    /* Just because the default is to set start symbol to the first symbol */
+
+  /* Lexemes */
+  TOKEN_META_IDENTIFIER,
+  TOKEN_INTEGER,
+  TOKEN_TERMINAL_STRING,
+  TOKEN_SPECIAL_SEQUENCE,
+  TOKEN_CONCATENATE_SYMBOL,
+  TOKEN_DEFINING_SYMBOL,
+  TOKEN_DEFINITION_SEPARATOR_SYMBOL,
+  TOKEN_END_GROUP_SYMBOL,
+  TOKEN_END_OPTION_SYMBOL,
+  TOKEN_END_REPEAT_SYMBOL,
+  TOKEN_EXCEPT_SYMBOL,
+  TOKEN_REPETITION_SYMBOL,
+  TOKEN_START_GROUP_SYMBOL,
+  TOKEN_START_OPTION_SYMBOL,
+  TOKEN_START_REPEAT_SYMBOL,
+  TOKEN_TERMINATOR_SYMBOL,
+
+  /* Structure */
+  TOKEN_SYNTAX,
+  TOKEN_SYNTAX_RULE,
+  TOKEN_DEFINITIONS_LIST,
+  TOKEN_SINGLE_DEFINITION,
+  TOKEN_SYNTACTIC_TERM,
+  TOKEN_SYNTACTIC_EXCEPTION,
+  TOKEN_SYNTACTIC_FACTOR,
+  TOKEN_SYNTACTIC_PRIMARY,
+  TOKEN_OPTIONAL_SEQUENCE,
+  TOKEN_REPEATED_SEQUENCE,
+  TOKEN_GROUPED_SEQUENCE,
+  TOKEN_EMPTY_SEQUENCE,
+
+  _MARPAEBNF_NTOKENSYMBOL          /* Not a symbol: number of symbols */
+} marpaEBNFTokenSymbolEnum_t;
+
+#endif /* MARPAEBNF_INTERNAL_SYMBOL_H */
@@ -0,0 +1,84 @@
+#ifndef MARPAEBNF_INTERNAL_THREAD_H
+#define MARPAEBNF_INTERNAL_THREAD_H
+
+#include <stddef.h>
+#include <errno.h>
+
+/* Minimal portable threads and mutexes, the latter statically              */
+/* initializable: Windows threads and slim reader/writer locks, POSIX       */
+/* threads elsewhere. Thread creation returns 0 or an errno value, as       */
+/* pthread_create() does.                                                   */
+
+#ifdef _WIN32
+#include <windows.h>
+typedef SRWLOCK marpaEBNFMutex_t;
+#define MARPAEBNF_MUTEX_INITIALIZER    SRWLOCK_INIT
+#define MARPAEBNF_MUTEX_INIT(mutexp)   InitializeSRWLock(mutexp)
+#define MARPAEBNF_MUTEX_DESTROY(mutexp)
+#define MARPAEBNF_MUTEX_LOCK(mutexp)   AcquireSRWLockExclusive(mutexp)
+#define MARPAEBNF_MUTEX_UNLOCK(mutexp) ReleaseSRWLockExclusive(mutexp)
+
+typedef HANDLE marpaEBNFThread_t;
+#define MARPAEBNF_THREAD_RETURN        DWORD WINAPI
+#define MARPAEBNF_THREAD_RETURN_VALUE  0
+/* CreateThread() does not set errno: its failure is reported as EAGAIN */
+#define MARPAEBNF_THREAD_CREATEI(threadp, startp, argvp) (((*(threadp) = CreateThread(NULL, 0, (startp), (argvp), 0, NULL)) != NULL) ? 0 : EAGAIN)
+#define MARPAEBNF_THREAD_JOIN(thread)  do { WaitForSingleObject((thread), INFINITE); CloseHandle(thread); } while (0)
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+typedef pthread_mutex_t marpaEBNFMutex_t;
+#define MARPAEBNF_MUTEX_INITIALIZER    PTHREAD_MUTEX_INITIALIZER
+#define MARPAEBNF_MUTEX_INIT(mutexp)   pthread_mutex_init((mutexp), NULL)
+#define MARPAEBNF_MUTEX_DESTROY(mutexp) pthread_mutex_destroy(mutexp)
+#define MARPAEBNF_MUTEX_LOCK(mutexp)   pthread_mutex_lock(mutexp)
+#define MARPAEBNF_MUTEX_UNLOCK(mutexp) pthread_mutex_unlock(mutexp)
+
+typedef pthread_t marpaEBNFThread_t;
+#define MARPAEBNF_THREAD_RETURN        void *
+#define MARPAEBNF_THREAD_RETURN_VALUE  NULL
+#define MARPAEBNF_THREAD_CREATEI(threadp, startp, argvp) pthread_create((threadp), NULL, (startp), (argvp))
+#define MARPAEBNF_THREAD_JOIN(thread)  pthread_join((thread), NULL)
+#endif
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_threadCpul(void)
+/****************************************************************************/
+/* Number of online processors, at least 1                                  */
+/****************************************************************************/
+{
+#ifdef _WIN32
+  SYSTEM_INFO systemInfo;
+
+  GetSystemInfo(&systemInfo);
+  return (systemInfo.dwNumberOfProcessors > 0) ? (size_t) systemInfo.dwNumberOfProcessors : 1;
+#else
+  long cpul = sysconf(_SC_NPROCESSORS_ONLN);
+
+  return (cpul > 0) ? (size_t) cpul : 1;
+#endif
+}
+
+/****************************************************************************/
+static inline double _marpaEBNF_threadSecondsd(void)
+/****************************************************************************/
+/* Monotonic wall clock, in seconds                                         */
+/****************************************************************************/
+{
+#ifdef _WIN32
+  LARGE_INTEGER counter;
+  LARGE_INTEGER frequency;
+
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+  struct timespec timespec;
+
+  clock_gettime(CLOCK_MONOTONIC, &timespec);
+  return (double) timespec.tv_sec + (double) timespec.tv_nsec / 1e9;
+#endif
+}
+
+#endif /* MARPAEBNF_INTERNAL_THREAD_H */
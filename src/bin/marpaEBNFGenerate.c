@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "marpaEBNF.h"
+#include "genericLogger.h"
+
+/* Compiles a grammar file and writes it as C source: see                    */
+/* marpaEBNF_generateb(). The program that links the result gets its         */
+/* instances from <name>_newp(), without parsing the grammar.                */
+/* Usage: marpaEBNFGenerate [-u] [-n name] [-o output.c] grammar.ebnf        */
+/*   -u  the grammar uses UTF-8, as with the utf8b option                    */
+/*   -n  name of the tables and of the constructor, by default the name of  */
+/*       the grammar file without directory and extension, where any other  */
+/*       character than [A-Za-z0-9_] is _                                    */
+/*   -o  output file, by default <name>.c                                    */
+
+/****************************************************************************/
+static void _marpaEBNFGenerate_usagev(char *programs)
+/****************************************************************************/
+{
+  fprintf(stderr, "Usage: %s [-u] [-n name] [-o output.c] grammar.ebnf\n", programs);
+}
+
+/****************************************************************************/
+static char *_marpaEBNFGenerate_names(char *filenames)
+/****************************************************************************/
+/* Default name: NULL on allocation failure                                 */
+/****************************************************************************/
+{
+  char   *basenames = filenames;
+  char   *p;
+  char   *names;
+  size_t  namel;
+  size_t  i;
+
+  for (p = filenames; *p != '\0'; p++) {
+    if ((*p == '/') || (*p == '\\')) {
+      basenames = p + 1;
+    }
+  }
+  p = strchr(basenames, '.');
+  namel = (p != NULL) ? (size_t) (p - basenames) : strlen(basenames);
+
+  /* One more for a leading _, and one for the NUL */
+  names = (char *) malloc(namel + 2);
+  if (names == NULL) {
+    return NULL;
+  }
+  i = 0;
+  if ((namel <= 0) || ((basenames[0] >= '0') && (basenames[0] <= '9'))) {
+    names[i++] = '_';
+  }
+  for (p = basenames; p < basenames + namel; p++) {
+    if (((*p >= 'a') && (*p <= 'z')) || ((*p >= 'A') && (*p <= 'Z')) || ((*p >= '0') && (*p <= '9'))) {
+      names[i++] = *p;
+    } else {
+      names[i++] = '_';
+    }
+  }
+  names[i] = '\0';
+
+  return names;
+}
+
+/****************************************************************************/
+int main(int argc, char **argv) {
+/****************************************************************************/
+  genericLogger_t   *genericLoggerp         = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_WARNING);
+  marpaEBNFOption_t  marpaEBNFOption;
+  marpaEBNF_t       *marpaEBNFp             = NULL;
+  char              *grammarFilenames       = NULL;
+  char              *names                  = NULL;
+  char              *outputFilenames        = NULL;
+  char              *defaultNames           = NULL;
+  char              *defaultOutputFilenames = NULL;
+  short              utf8b                  = 0;
+  int                argi;
+  int                rci                    = 1;
+
+  for (argi = 1; argi < argc; argi++) {
+    if (strcmp(argv[argi], "-u") == 0) {
+      utf8b = 1;
+    } else if ((strcmp(argv[argi], "-n") == 0) && (argi + 1 < argc)) {
+      names = argv[++argi];
+    } else if ((strcmp(argv[argi], "-o") == 0) && (argi + 1 < argc)) {
+      outputFilenames = argv[++argi];
+    } else if ((argv[argi][0] != '-') && (grammarFilenames == NULL)) {
+      grammarFilenames = argv[argi];
+    } else {
+      _marpaEBNFGenerate_usagev(argv[0]);
+      goto end;
+    }
+  }
+  if (grammarFilenames == NULL) {
+    _marpaEBNFGenerate_usagev(argv[0]);
+    goto end;
+  }
+
+  if (names == NULL) {
+    names = defaultNames = _marpaEBNFGenerate_names(grammarFilenames);
+    if (names == NULL) {
+      perror("malloc");
+      goto end;
+    }
+  }
+  if (outputFilenames == NULL) {
+    outputFilenames = defaultOutputFilenames = (char *) malloc(strlen(names) + 3);
+    if (outputFilenames == NULL) {
+      perror("malloc");
+      goto end;
+    }
+    sprintf(outputFilenames, "%s.c", names);
+  }
+
+  marpaEBNFOption.genericLoggerp      = genericLoggerp;
+  marpaEBNFOption.scannerlessb        = 0;
+  marpaEBNFOption.mallocp             = NULL;
+  marpaEBNFOption.reallocp            = NULL;
+  marpaEBNFOption.freep               = NULL;
+  marpaEBNFOption.allocatorUserDatavp = NULL;
+  marpaEBNFOption.cachep              = NULL;
+  marpaEBNFOption.recoverb            = 1;
+  marpaEBNFOption.utf8b               = utf8b;
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  if (marpaEBNFp == NULL) {
+    goto end;
+  }
+
+  /* Syntax errors are all reported, by the logger */
+  if (marpaEBNF_grammarFileb(marpaEBNFp, grammarFilenames) == 0) {
+    goto end;
+  }
+  if (marpaEBNF_generateb(marpaEBNFp, names, outputFilenames) == 0) {
+    goto end;
+  }
+
+  rci = 0;
+
+ end:
+  if (marpaEBNFp != NULL) {
+    marpaEBNF_freev(marpaEBNFp);
+  }
+  if (defaultNames != NULL) {
+    free(defaultNames);
+  }
+  if (defaultOutputFilenames != NULL) {
+    free(defaultOutputFilenames);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  return rci;
+}
@@ -9,193 +9,101 @@
 #include <marpaWrapper.h>
 #include "marpaEBNF.h"
 #include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/symbol.h"
+#include "marpaEBNF/internal/byteClass.h"
+#include "marpaEBNF/internal/rule.h"
+#include "marpaEBNF/internal/lexer.h"
+#include "marpaEBNF/internal/memory.h"
+#include "marpaEBNF/internal/arena.h"
+#include "marpaEBNF/internal/file.h"
+#include "marpaEBNF/internal/ast.h"
+#include "marpaEBNF/internal/compile.h"
+#include "marpaEBNF/internal/thread.h"
+#include "marpaEBNF/internal/pool.h"
+#include "marpaEBNF/internal/split.h"
+#include "marpaEBNF/internal/event.h"
+#include "marpaEBNF/internal/cache.h"
+#include "marpaEBNF/internal/generate.h"
 
 #define MARPAEBNF_LENGTH_ARRAY(x) (sizeof(x)/sizeof((x)[0]))
 
-/* Convenience enum, also used to make sure that symbol id is the enum -; */
-typedef enum marpaEBNFSymbolEnum {
-  _START,          /* Just because the default is to set start symbol to the first symbol */
-
-  LETTER,
-  DECIMAL_DIGIT,
-  CONCATENATE_SYMBOL,
-  DEFINING_SYMBOL,
-  DEFINITION_SEPARATOR_SYMBOL,
-  END_COMMENT_SYMBOL,
-  END_GROUP_SYMBOL,
-  END_OPTION_SYMBOL,
-  END_REPEAT_SYMBOL,
-  EXCEPT_SYMBOL,
-  FIRST_QUOTE_SYMBOL,
-  REPETITION_SYMBOL,
-  SECOND_QUOTE_SYMBOL,
-  SPECIAL_SEQUENCE_SYMBOL,
-  START_COMMENT_SYMBOL,
-  START_GROUP_SYMBOL,
-  START_OPTION_SYMBOL,
-  START_REPEAT_SYMBOL,
-  TERMINATOR_SYMBOL,
-  OTHER_CHARACTER,
-  SPACE_CHARACTER,
-  HORIZONTAL_TABULATION_CHARACTER,
-  NEW_LINE,
-  VERTICAL_TABULATION_CHARACTER,
-  FORM_FEED,
-  TERMINAL_CHARACTER,
-  GAP_FREE_SYMBOL,
-  TERMINAL_STRING,
-  FIRST_TERMINAL_CHARACTER,
-  SECOND_TERMINAL_CHARACTER,
-  GAP_SEPARATOR,
-  SYNTAX,
-  COMMENTLESS_SYMBOL,
-  INTEGER,
-  META_IDENTIFIER,
-  META_IDENTIFIER_CHARACTER,
-  SPECIAL_SEQUENCE,
-  SPECIAL_SEQUENCE_CHARACTER,
-  COMMENT_SYMBOL,
-  BRACKETED_TEXTUAL_COMMENT,
-  SYNTAX_RULE,
-  DEFINITIONS_LIST,
-  SINGLE_DEFINITION,
-  SYNTACTIC_TERM,
-  SYNTACTIC_EXCEPTION,
-  SYNTACTIC_FACTOR,
-  SYNTACTIC_PRIMARY,
-  OPTIONAL_SEQUENCE,
-  REPEATED_SEQUENCE,
-  GROUPED_SEQUENCE,
-  EMPTY_SEQUENCE,
-  COMMENT,
-
-  /* Internal symbols */
-
-  _CARRIAGE_RETURN,
-  _CARRIAGE_RETURN_ANY,
-  _LINE_FEED,
-
-  _START_REPEAT_SYMBOL_0,
-  _START_REPEAT_SYMBOL_1,
-
-  _END_REPEAT_SYMBOL_0,
-  _END_REPEAT_SYMBOL_1,
-
-  _START_OPTION_SYMBOL_0,
-  _START_OPTION_SYMBOL_1,
-
-  _END_OPTION_SYMBOL_0,
-  _END_OPTION_SYMBOL_1,
-
-  _FIRST_TERMINAL_CHARACTER_MANY,
-  _SECOND_TERMINAL_CHARACTER_MANY,
-
-  _GAP_SEPARATOR_ANY,
-  _GAP_SYMBOL_UNIT,
-  _GAP_SYMBOL_UNIT_MANY,
-
-  _COMMENTLESS_SYMBOL_TERMINAL_CHARACTER,
-
-  _META_IDENTIFIER_CHARACTER_ANY,
-
-  _SPECIAL_SEQUENCE_CHARACTER_ANY,
-
-  _COMMENT_SYMBOL_ANY,
-
-  _BRACKETED_TEXTUAL_COMMENT_ANY,
-  _COMMENTLESS_SYMBOL_UNIT,
-  _COMMENTLESS_SYMBOL_UNIT_MANY,
-
-  _DEFINITIONS_SEQUENCE,
-} marpaEBNFSymbolEnum_t;
-
 typedef struct marpaEBNFSymbol {
   marpaEBNFSymbolEnum_t symboli;
-  short                 isInAnExceptionb;
   char                 *descriptions;
 } marpaEBNFSymbol_t;
 
-typedef struct marpaEBNFRule {
-  marpaWrapperGrammarRuleOption_t   option;
-  int                               lhsSymboli;
-  size_t                            rhsSymboll;
-  int                               rhsSymbolip[20]; /* Flexible array and ANSI-C are not friends */
-  size_t                            rhsExceptl;
-  int                               rhsExceptp[20]; /* Ditto */
-} marpaEBNFRule_t;
-
 /* List of all symbols of the EBNF grammar as per ISO/IEC 14977:1996 */
 static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
   /* -----------------------------------------------------------
-  {symboli,                       isInAnExceptionb, descriptions
+  {symboli,                       descriptions
   -------------------------------------------------------------- */
-  {_START                         , 0             , "[:start:]" },
-  {LETTER                         , 0             , "<letter>" },
-  {DECIMAL_DIGIT                  , 0             , "<decimal digit>" },
-  {CONCATENATE_SYMBOL             , 0             , "<concatenate symbol>" },
-  {DEFINING_SYMBOL                , 0             , "<defining symbol>" },
-  {DEFINITION_SEPARATOR_SYMBOL    , 0             , "<definition separator symbol>" },
-  {END_COMMENT_SYMBOL             , 0             , "<end comment symbol>" },
-  {END_GROUP_SYMBOL               , 0             , "<end group symbol>" },
-  {END_OPTION_SYMBOL              , 0             , "<end option symbol>" },
-  {END_REPEAT_SYMBOL              , 0             , "<end repeat symbol>" },
-  {EXCEPT_SYMBOL                  , 0             , "<except symbol>" },
-  {FIRST_QUOTE_SYMBOL             , 0             , "<first quote symbol>" },
-  {REPETITION_SYMBOL              , 0             , "<repetition symbol>" },
-  {SECOND_QUOTE_SYMBOL            , 0             , "<second quote symbol>" },
-  {SPECIAL_SEQUENCE_SYMBOL        , 0             , "<special sequence symbol>" },
-  {START_COMMENT_SYMBOL           , 0             , "<start comment symbol>" },
-  {START_GROUP_SYMBOL             , 0             , "<start group symbol>" },
-  {START_OPTION_SYMBOL            , 0             , "<start option symbol>" },
-  {START_REPEAT_SYMBOL            , 0             , "<start repeat symbol>" },
-  {TERMINATOR_SYMBOL              , 0             , "<terminator symbol>" },
-  {OTHER_CHARACTER                , 0             , "<other character>" },
-  {SPACE_CHARACTER                , 0             , "<space character>" },
-  {HORIZONTAL_TABULATION_CHARACTER, 0             , "<horizontal tabulation character>" },
-  {NEW_LINE                       , 0             , "<new line>" },
-  {VERTICAL_TABULATION_CHARACTER  , 0             , "<vertical tabulation character>" },
-  {FORM_FEED                      , 0             , "<form feed>" },
-  {TERMINAL_CHARACTER             , 0             , "<terminal character>" },
-  {GAP_FREE_SYMBOL                , 0             , "<gap free symbol>" },
-  {TERMINAL_STRING                , 0             , "<terminal string>" },
-  {FIRST_TERMINAL_CHARACTER       , 0             , "<first terminal character>" },
-  {SECOND_TERMINAL_CHARACTER      , 0             , "<second terminal character>" },
-  {GAP_SEPARATOR                  , 0             , "<gap separator>" },
-  {SYNTAX                         , 0             , "<syntax>" },
-  {COMMENTLESS_SYMBOL             , 0             , "<commentless symbol>" },
-  {INTEGER                        , 0             , "<integer>" },
-  {META_IDENTIFIER                , 0             , "<meta identifier>" },
-  {META_IDENTIFIER_CHARACTER      , 0             , "<meta identifier character>" },
-  {SPECIAL_SEQUENCE               , 0             , "<special sequence>" },
-  {SPECIAL_SEQUENCE_CHARACTER     , 0             , "<special sequence character>" },
-  {COMMENT_SYMBOL                 , 0             , "<comment symbol>" },
-  {BRACKETED_TEXTUAL_COMMENT      , 0             , "<bracketed textual comment>" },
-  {SYNTAX_RULE                    , 0             , "<syntax rule>" },
-  {DEFINITIONS_LIST               , 0             , "<definitions list>" },
-  {SINGLE_DEFINITION              , 0             , "<single definition>" },
-  {SYNTACTIC_TERM                 , 0             , "<syntactic term>" },
-  {SYNTACTIC_EXCEPTION            , 0             , "<syntactic exception>" },
-  {SYNTACTIC_FACTOR               , 0             , "<syntactic factor>" },
-  {SYNTACTIC_PRIMARY              , 0             , "<syntactic primary>" },
-  {OPTIONAL_SEQUENCE              , 0             , "<optional sequence>" },
-  {REPEATED_SEQUENCE              , 0             , "<repeated sequence>" },
-  {GROUPED_SEQUENCE               , 0             , "<grouped sequence>" },
-  {EMPTY_SEQUENCE                 , 0             , "<empty sequence>" },
-  {COMMENT                        , 0             , "<comment>" },
+  {_START                         , "[:start:]" },
+  {LETTER                         , "<letter>" },
+  {DECIMAL_DIGIT                  , "<decimal digit>" },
+  {CONCATENATE_SYMBOL             , "<concatenate symbol>" },
+  {DEFINING_SYMBOL                , "<defining symbol>" },
+  {DEFINITION_SEPARATOR_SYMBOL    , "<definition separator symbol>" },
+  {END_COMMENT_SYMBOL             , "<end comment symbol>" },
+  {END_GROUP_SYMBOL               , "<end group symbol>" },
+  {END_OPTION_SYMBOL              , "<end option symbol>" },
+  {END_REPEAT_SYMBOL              , "<end repeat symbol>" },
+  {EXCEPT_SYMBOL                  , "<except symbol>" },
+  {FIRST_QUOTE_SYMBOL             , "<first quote symbol>" },
+  {REPETITION_SYMBOL              , "<repetition symbol>" },
+  {SECOND_QUOTE_SYMBOL            , "<second quote symbol>" },
+  {SPECIAL_SEQUENCE_SYMBOL        , "<special sequence symbol>" },
+  {START_COMMENT_SYMBOL           , "<start comment symbol>" },
+  {START_GROUP_SYMBOL             , "<start group symbol>" },
+  {START_OPTION_SYMBOL            , "<start option symbol>" },
+  {START_REPEAT_SYMBOL            , "<start repeat symbol>" },
+  {TERMINATOR_SYMBOL              , "<terminator symbol>" },
+  {OTHER_CHARACTER                , "<other character>" },
+  {SPACE_CHARACTER                , "<space character>" },
+  {HORIZONTAL_TABULATION_CHARACTER, "<horizontal tabulation character>" },
+  {NEW_LINE                       , "<new line>" },
+  {VERTICAL_TABULATION_CHARACTER  , "<vertical tabulation character>" },
+  {FORM_FEED                      , "<form feed>" },
+  {TERMINAL_CHARACTER             , "<terminal character>" },
+  {GAP_FREE_SYMBOL                , "<gap free symbol>" },
+  {TERMINAL_STRING                , "<terminal string>" },
+  {FIRST_TERMINAL_CHARACTER       , "<first terminal character>" },
+  {SECOND_TERMINAL_CHARACTER      , "<second terminal character>" },
+  {GAP_SEPARATOR                  , "<gap separator>" },
+  {SYNTAX                         , "<syntax>" },
+  {COMMENTLESS_SYMBOL             , "<commentless symbol>" },
+  {INTEGER                        , "<integer>" },
+  {META_IDENTIFIER                , "<meta identifier>" },
+  {META_IDENTIFIER_CHARACTER      , "<meta identifier character>" },
+  {SPECIAL_SEQUENCE               , "<special sequence>" },
+  {SPECIAL_SEQUENCE_CHARACTER     , "<special sequence character>" },
+  {COMMENT_SYMBOL                 , "<comment symbol>" },
+  {BRACKETED_TEXTUAL_COMMENT      , "<bracketed textual comment>" },
+  {SYNTAX_RULE                    , "<syntax rule>" },
+  {DEFINITIONS_LIST               , "<definitions list>" },
+  {SINGLE_DEFINITION              , "<single definition>" },
+  {SYNTACTIC_TERM                 , "<syntactic term>" },
+  {SYNTACTIC_EXCEPTION            , "<syntactic exception>" },
+  {SYNTACTIC_FACTOR               , "<syntactic factor>" },
+  {SYNTACTIC_PRIMARY              , "<syntactic primary>" },
+  {OPTIONAL_SEQUENCE              , "<optional sequence>" },
+  {REPEATED_SEQUENCE              , "<repeated sequence>" },
+  {GROUPED_SEQUENCE               , "<grouped sequence>" },
+  {EMPTY_SEQUENCE                 , "<empty sequence>" },
+  {COMMENT                        , "<comment>" },
   /*
     some symbols are explicitely splitted into their two letters
   */
-  {_CARRIAGE_RETURN               , 0             , "<carriage return>" },
-  {_CARRIAGE_RETURN_ANY           , 0             , "<carriage return any*>" },
-  {_LINE_FEED                     , 0             , "<line feed>" },
-  {_START_REPEAT_SYMBOL_0         , 0             , "<start repeat symbol 0>" },
-  {_START_REPEAT_SYMBOL_1         , 0             , "<start repeat symbol 1>" },
-  {_END_REPEAT_SYMBOL_0           , 0             , "<end repeat symbol 0>" },
-  {_END_REPEAT_SYMBOL_1           , 0             , "<end repeat symbol 1>" },
-  {_START_OPTION_SYMBOL_0         , 0             , "<start option symbol 0>" },
-  {_START_OPTION_SYMBOL_1         , 0             , "<start option symbol 1>" },
-  {_END_OPTION_SYMBOL_0           , 0             , "<end option symbol 0>" },
-  {_END_OPTION_SYMBOL_1           , 0             , "<end option symbol 1>" },
+  {_CARRIAGE_RETURN               , "<carriage return>" },
+  {_CARRIAGE_RETURN_ANY           , "<carriage return any*>" },
+  {_LINE_FEED                     , "<line feed>" },
+  {_START_REPEAT_SYMBOL_0         , "<start repeat symbol 0>" },
+  {_START_REPEAT_SYMBOL_1         , "<start repeat symbol 1>" },
+  {_END_REPEAT_SYMBOL_0           , "<end repeat symbol 0>" },
+  {_END_REPEAT_SYMBOL_1           , "<end repeat symbol 1>" },
+  {_START_OPTION_SYMBOL_0         , "<start option symbol 0>" },
+  {_START_OPTION_SYMBOL_1         , "<start option symbol 1>" },
+  {_END_OPTION_SYMBOL_0           , "<end option symbol 0>" },
+  {_END_OPTION_SYMBOL_1           , "<end option symbol 1>" },
 
   /*
    * ------------------------------------------
@@ -247,10 +155,10 @@ static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
    *
    */
   /* -------------------------------------------
-  {symboli,                       isInAnExceptionb, descriptions
+  {symboli,                       descriptions
   ---------------------------------------------- */
-  {_FIRST_TERMINAL_CHARACTER_MANY , 0             , "<first terminal character many>" },
-  {_SECOND_TERMINAL_CHARACTER_MANY, 0             , "<second terminal character many>" },
+  {_FIRST_TERMINAL_CHARACTER_MANY , "<first terminal character many>" },
+  {_SECOND_TERMINAL_CHARACTER_MANY, "<second terminal character many>" },
   /*
    * syntax = {gap separator}, gap free symbol, {gap separator}, {gap free symbol, {gap separator}}
    *
@@ -263,11 +171,11 @@ static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
    *
    */
   /* ----------------------------------------------
-  {symboli,                       isInAnExceptionb, descriptions
+  {symboli,                       descriptions
   -------------------------------------------------- */
-  {_GAP_SEPARATOR_ANY       , 0             , "<gap separator any>" },
-  {_GAP_SYMBOL_UNIT         , 0             , "<gap symbol unit>" },
-  {_GAP_SYMBOL_UNIT_MANY    , 0             , "<gap symbol unit many>" },
+  {_GAP_SEPARATOR_ANY       , "<gap separator any>" },
+  {_GAP_SYMBOL_UNIT         , "<gap symbol unit>" },
+  {_GAP_SYMBOL_UNIT_MANY    , "<gap symbol unit many>" },
   /*
    * commentless symbol = terminal character
    *                       - (letter
@@ -293,7 +201,7 @@ static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
    *                     | special sequence
    *
    */
-  {_COMMENTLESS_SYMBOL_TERMINAL_CHARACTER , 0             , "<commentless symbol terminal character>" },
+  {_COMMENTLESS_SYMBOL_TERMINAL_CHARACTER , "<commentless symbol terminal character>" },
   /*
    * integer = decimal digit, {decimal digit}
    *
@@ -311,9 +219,9 @@ static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
    *
    */
   /* ------------------------------------------
-  {symboli,                       isInAnExceptionb, descriptions
+  {symboli,                       descriptions
   --------------------------------------------- */
-  {_META_IDENTIFIER_CHARACTER_ANY, 0             , "<meta identifier character any>" },
+  {_META_IDENTIFIER_CHARACTER_ANY, "<meta identifier character any>" },
   /*
    * special sequence = special sequence symbol, {special sequence character}, special sequence symbol
    *
@@ -323,9 +231,9 @@ static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
    * <special sequence> = <special sequence symbol> <special sequence character any> <special sequence symbol>
    */
   /* -------------------------------------------
-  {symboli,                       isInAnExceptionb, descriptions
+  {symboli,                       descriptions
   ---------------------------------------------- */
-  {_SPECIAL_SEQUENCE_CHARACTER_ANY, 0             , "<special sequence character any>" },
+  {_SPECIAL_SEQUENCE_CHARACTER_ANY, "<special sequence character any>" },
   /*
    * special sequence character = terminal character - special sequence symbol
    *
@@ -344,9 +252,9 @@ static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
    * <bracketed textual comment> = <start comment symbol> <comment symbol any> <end comment symbol>
    */
   /* -------------------------------
-  {symboli,                       isInAnExceptionb, descriptions
+  {symboli,                       descriptions
   ---------------------------------- */
-  {_COMMENT_SYMBOL_ANY, 0             , "<comment symbol any>" },
+  {_COMMENT_SYMBOL_ANY, "<comment symbol any>" },
   /*
    * syntax = {bracketed textual comment}, commentless symbol, {bracketed textual comment}, {commentless symbol, {bracketed textual comment}}
    *
@@ -358,11 +266,11 @@ static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
    * <syntax> = <bracketed textual comment any> <commentless symbol unit many>
    */
   /* ------------------------------------------
-  {symboli,                       isInAnExceptionb, descriptions
+  {symboli,                       descriptions
   --------------------------------------------- */
-  {_BRACKETED_TEXTUAL_COMMENT_ANY, 0             , "<bracketed textual comment any>" },
-  {_COMMENTLESS_SYMBOL_UNIT      , 0             , "<commentless symbol unit>" },
-  {_COMMENTLESS_SYMBOL_UNIT_MANY , 0             , "<commentless symbol unit many>" },
+  {_BRACKETED_TEXTUAL_COMMENT_ANY, "<bracketed textual comment any>" },
+  {_COMMENTLESS_SYMBOL_UNIT      , "<commentless symbol unit>" },
+  {_COMMENTLESS_SYMBOL_UNIT_MANY , "<commentless symbol unit many>" },
   /*
    * syntax = syntax rule, {syntax rule}
    *
@@ -391,796 +299,3186 @@ static marpaEBNFSymbol_t marpaEBNFSymbolArray[] = {
   /* ---------------------------------
   {symboli              , descriptions
   ------------------------------------ */
-  {_DEFINITIONS_SEQUENCE, 0             , "<definitions sequence>" },
+  {_DEFINITIONS_SEQUENCE, "<definitions sequence>" },
 };
 
 static marpaEBNFRule_t marpaEBNFRuleArray[] = {
-  { { 0, 0, 0,            -1, 0, 0 },             _START,               1, { SYNTAX }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { DECIMAL_DIGIT }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { CONCATENATE_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { DEFINING_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { DEFINITION_SEPARATOR_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { END_COMMENT_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { END_GROUP_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { END_OPTION_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { END_REPEAT_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { EXCEPT_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { FIRST_QUOTE_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { REPETITION_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { SECOND_QUOTE_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { SPECIAL_SEQUENCE_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { START_COMMENT_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { START_GROUP_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { START_OPTION_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { START_REPEAT_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { TERMINATOR_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, { OTHER_CHARACTER }, 0, { -1 } },
+  { { 0, 0, 0,            -1, 0, 0 },             _START,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_CHARACTER,               1, 0 },
   /* -------------> Exception <----------------- */
-  { { 0, 0, 0,            -1, 0, 0 }, GAP_FREE_SYMBOL,                  1, { TERMINAL_CHARACTER }, 2, {  FIRST_QUOTE_SYMBOL, SECOND_QUOTE_SYMBOL } },
-  { { 0, 0, 0,            -1, 0, 0 }, GAP_FREE_SYMBOL,                  1, { TERMINAL_STRING }, 0, { -1 } },
+  { { 0, 0, 0,            -1, 0, 0 }, GAP_FREE_SYMBOL,                  1, 2 },
+  { { 0, 0, 0,            -1, 0, 0 }, GAP_FREE_SYMBOL,                  1, 0 },
   /* -------------> Exception <----------------- */
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_STRING,                  3, { FIRST_QUOTE_SYMBOL, _FIRST_TERMINAL_CHARACTER_MANY, FIRST_QUOTE_SYMBOL }, 0, { -1 } },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_STRING,                  3, 0 },
   /* -------------> Exception <----------------- */
-  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_STRING,                  3, { SECOND_QUOTE_SYMBOL, _SECOND_TERMINAL_CHARACTER_MANY, SECOND_QUOTE_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, NEW_LINE,                         3, { _CARRIAGE_RETURN_ANY, _LINE_FEED, _CARRIAGE_RETURN_ANY }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 0 }, _CARRIAGE_RETURN_ANY,             1, { _CARRIAGE_RETURN }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, START_REPEAT_SYMBOL,              1, { _START_REPEAT_SYMBOL_0 }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, START_REPEAT_SYMBOL,              1, { _START_REPEAT_SYMBOL_1 }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, END_REPEAT_SYMBOL,                1, { _END_REPEAT_SYMBOL_0 }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, END_REPEAT_SYMBOL,                1, { _END_REPEAT_SYMBOL_1 }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, START_OPTION_SYMBOL,              1, { _START_OPTION_SYMBOL_0 }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, START_OPTION_SYMBOL,              1, { _START_OPTION_SYMBOL_1 }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, END_OPTION_SYMBOL,                1, { _END_OPTION_SYMBOL_0 }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, END_OPTION_SYMBOL,                1, { _END_OPTION_SYMBOL_1 }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 1 }, _FIRST_TERMINAL_CHARACTER_MANY,   1, { FIRST_TERMINAL_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 1 }, _SECOND_TERMINAL_CHARACTER_MANY,  1, { SECOND_TERMINAL_CHARACTER }, 0, { -1 } },
+  { { 0, 0, 0,            -1, 0, 0 }, TERMINAL_STRING,                  3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, NEW_LINE,                         3, 0 },
+  { { 0, 0, 1,            -1, 0, 0 }, _CARRIAGE_RETURN_ANY,             1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, START_REPEAT_SYMBOL,              1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, START_REPEAT_SYMBOL,              1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, END_REPEAT_SYMBOL,                1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, END_REPEAT_SYMBOL,                1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, START_OPTION_SYMBOL,              1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, START_OPTION_SYMBOL,              1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, END_OPTION_SYMBOL,                1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, END_OPTION_SYMBOL,                1, 0 },
+  { { 0, 0, 1,            -1, 0, 1 }, _FIRST_TERMINAL_CHARACTER_MANY,   1, 0 },
+  { { 0, 0, 1,            -1, 0, 1 }, _SECOND_TERMINAL_CHARACTER_MANY,  1, 0 },
   /* -------------> Exception <----------------- */
-  { { 0, 0, 0,            -1, 0, 0 }, FIRST_TERMINAL_CHARACTER,         1, { TERMINAL_CHARACTER }, 1, { FIRST_QUOTE_SYMBOL } },
+  { { 0, 0, 0,            -1, 0, 0 }, FIRST_TERMINAL_CHARACTER,         1, 1 },
   /* -------------> Exception <----------------- */
-  { { 0, 0, 0,            -1, 0, 0 }, SECOND_TERMINAL_CHARACTER,        1, { TERMINAL_CHARACTER }, 1, { SECOND_QUOTE_SYMBOL } },
-  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, { SPACE_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, { HORIZONTAL_TABULATION_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, { NEW_LINE }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, { VERTICAL_TABULATION_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, { FORM_FEED }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 0 }, _GAP_SEPARATOR_ANY,               1, { GAP_SEPARATOR }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, _GAP_SYMBOL_UNIT,                 2, { GAP_FREE_SYMBOL, _GAP_SEPARATOR_ANY }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 1 }, _GAP_SYMBOL_UNIT_MANY,            1, { _GAP_SYMBOL_UNIT }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTAX,                           2, { _GAP_SEPARATOR_ANY, _GAP_SYMBOL_UNIT_MANY }, 0, { -1 } },
+  { { 0, 0, 0,            -1, 0, 0 }, SECOND_TERMINAL_CHARACTER,        1, 1 },
+  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, GAP_SEPARATOR,                    1, 0 },
+  { { 0, 0, 1,            -1, 0, 0 }, _GAP_SEPARATOR_ANY,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, _GAP_SYMBOL_UNIT,                 2, 0 },
+  { { 0, 0, 1,            -1, 0, 1 }, _GAP_SYMBOL_UNIT_MANY,            1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTAX,                           2, 0 },
   /* -------------> Exception <----------------- */
-  { { 0, 0, 0,            -1, 0, 0 }, _COMMENTLESS_SYMBOL_TERMINAL_CHARACTER, 1, { TERMINAL_CHARACTER }, 8, { LETTER, DECIMAL_DIGIT, FIRST_QUOTE_SYMBOL, SECOND_QUOTE_SYMBOL, START_COMMENT_SYMBOL, END_COMMENT_SYMBOL, SPECIAL_SEQUENCE_SYMBOL, OTHER_CHARACTER } },
-  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, { _COMMENTLESS_SYMBOL_TERMINAL_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, { META_IDENTIFIER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, { INTEGER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, { TERMINAL_STRING }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, { SPECIAL_SEQUENCE }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 1 }, INTEGER,                          1, { DECIMAL_DIGIT }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, META_IDENTIFIER,                  2, { LETTER, _META_IDENTIFIER_CHARACTER_ANY }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 0 }, _META_IDENTIFIER_CHARACTER_ANY,   1, { META_IDENTIFIER_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, META_IDENTIFIER_CHARACTER,        1, { LETTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, META_IDENTIFIER_CHARACTER,        1, { DECIMAL_DIGIT }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 0 }, _SPECIAL_SEQUENCE_CHARACTER_ANY,  1, { SPECIAL_SEQUENCE_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SPECIAL_SEQUENCE,                 3, { SPECIAL_SEQUENCE_SYMBOL, _SPECIAL_SEQUENCE_CHARACTER_ANY, SPECIAL_SEQUENCE_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SPECIAL_SEQUENCE_CHARACTER,       1, { TERMINAL_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, COMMENT_SYMBOL,                   1, { BRACKETED_TEXTUAL_COMMENT }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, COMMENT_SYMBOL,                   1, { OTHER_CHARACTER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, COMMENT_SYMBOL,                   1, { COMMENTLESS_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 0 }, _COMMENT_SYMBOL_ANY,              1, { COMMENT_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, BRACKETED_TEXTUAL_COMMENT,        3, { START_COMMENT_SYMBOL, _COMMENT_SYMBOL_ANY, END_COMMENT_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 0 }, _BRACKETED_TEXTUAL_COMMENT_ANY,   1, { BRACKETED_TEXTUAL_COMMENT }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, _COMMENTLESS_SYMBOL_UNIT,         2, { COMMENTLESS_SYMBOL, _BRACKETED_TEXTUAL_COMMENT_ANY }, 0, { -1 } },
-  { { 0, 0, 1,            -1, 0, 1 }, _COMMENTLESS_SYMBOL_UNIT_MANY,    1, { _COMMENTLESS_SYMBOL_UNIT }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTAX,                           2, { _BRACKETED_TEXTUAL_COMMENT_ANY, _COMMENTLESS_SYMBOL_UNIT_MANY }, 0, { -1 } },
-  { { 1, 0, 0,            -1, 0, 0 }, SYNTAX,                           2, { SYNTAX_RULE, SYNTAX }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTAX,                           1, { SYNTAX_RULE }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTAX_RULE,                      4, { META_IDENTIFIER, DEFINING_SYMBOL, DEFINITIONS_LIST, TERMINATOR_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 1, DEFINITION_SEPARATOR_SYMBOL, 0, 1 }, _DEFINITIONS_SEQUENCE, 1, { SINGLE_DEFINITION }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, DEFINITIONS_LIST,                 1, { _DEFINITIONS_SEQUENCE }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, DEFINITIONS_LIST,                 1, { EMPTY_SEQUENCE }, 0, { -1 } },
-  { { 0, 0, 1, CONCATENATE_SYMBOL,          0, 1 }, SINGLE_DEFINITION,            1, { SYNTACTIC_TERM }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_TERM,                   1, { SYNTACTIC_FACTOR }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_TERM,                   3, { SYNTACTIC_FACTOR, EXCEPT_SYMBOL, SYNTACTIC_EXCEPTION }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_FACTOR,                 3, { INTEGER, REPETITION_SYMBOL, SYNTACTIC_PRIMARY }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_FACTOR,                 1, { SYNTACTIC_PRIMARY }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, { OPTIONAL_SEQUENCE }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, { REPEATED_SEQUENCE }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, { GROUPED_SEQUENCE }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, { META_IDENTIFIER }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, { TERMINAL_STRING }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, { SPECIAL_SEQUENCE }, 0, { -1 } },
+  { { 0, 0, 0,            -1, 0, 0 }, _COMMENTLESS_SYMBOL_TERMINAL_CHARACTER, 1, 8 },
+  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, COMMENTLESS_SYMBOL,               1, 0 },
+  { { 0, 0, 1,            -1, 0, 1 }, INTEGER,                          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, META_IDENTIFIER,                  2, 0 },
+  { { 0, 0, 1,            -1, 0, 0 }, _META_IDENTIFIER_CHARACTER_ANY,   1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, META_IDENTIFIER_CHARACTER,        1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, META_IDENTIFIER_CHARACTER,        1, 0 },
+  { { 0, 0, 1,            -1, 0, 0 }, _SPECIAL_SEQUENCE_CHARACTER_ANY,  1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SPECIAL_SEQUENCE,                 3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SPECIAL_SEQUENCE_CHARACTER,       1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, COMMENT_SYMBOL,                   1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, COMMENT_SYMBOL,                   1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, COMMENT_SYMBOL,                   1, 0 },
+  { { 0, 0, 1,            -1, 0, 0 }, _COMMENT_SYMBOL_ANY,              1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, BRACKETED_TEXTUAL_COMMENT,        3, 0 },
+  { { 0, 0, 1,            -1, 0, 0 }, _BRACKETED_TEXTUAL_COMMENT_ANY,   1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, _COMMENTLESS_SYMBOL_UNIT,         2, 0 },
+  { { 0, 0, 1,            -1, 0, 1 }, _COMMENTLESS_SYMBOL_UNIT_MANY,    1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTAX,                           2, 0 },
+  { { 1, 0, 0,            -1, 0, 0 }, SYNTAX,                           2, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTAX,                           1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTAX_RULE,                      4, 0 },
+  { { 0, 0, 1, DEFINITION_SEPARATOR_SYMBOL, 0, 1 }, _DEFINITIONS_SEQUENCE, 1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, DEFINITIONS_LIST,                 1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, DEFINITIONS_LIST,                 1, 0 },
+  { { 0, 0, 1, CONCATENATE_SYMBOL,          0, 1 }, SINGLE_DEFINITION,            1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_TERM,                   1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_TERM,                   3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_FACTOR,                 3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_FACTOR,                 1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, 0 },
   /*
-  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, { EMPTY_SEQUENCE }, 0, { -1 } },
+  { { 0, 0, 0,            -1, 0, 0 }, SYNTACTIC_PRIMARY,                1, 0 },
   */
-  { { 0, 0, 0,            -1, 0, 0 }, OPTIONAL_SEQUENCE,                3, { START_OPTION_SYMBOL, DEFINITIONS_LIST, END_OPTION_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, REPEATED_SEQUENCE,                3, { START_REPEAT_SYMBOL, DEFINITIONS_LIST, END_REPEAT_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, GROUPED_SEQUENCE,                 3, { START_GROUP_SYMBOL, DEFINITIONS_LIST, END_GROUP_SYMBOL }, 0, { -1 } },
-  { { 0, 0, 0,            -1, 0, 0 }, EMPTY_SEQUENCE,                   0, { -1 } } /* Some compilers like cl does not like an empty [] */
+  { { 0, 0, 0,            -1, 0, 0 }, OPTIONAL_SEQUENCE,                3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, REPEATED_SEQUENCE,                3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, GROUPED_SEQUENCE,                 3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, EMPTY_SEQUENCE,                   0, 0 }
+};
+
+/* Right-hand sides of the rules above, each followed by its exceptions, in rule order */
+static int marpaEBNFRuleSymbolArray[] = {
+  /* _START ::= */                            SYNTAX,
+  /* TERMINAL_CHARACTER ::= */                DECIMAL_DIGIT,
+  /* TERMINAL_CHARACTER ::= */                CONCATENATE_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                DEFINING_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                DEFINITION_SEPARATOR_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                END_COMMENT_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                END_GROUP_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                END_OPTION_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                END_REPEAT_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                EXCEPT_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                FIRST_QUOTE_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                REPETITION_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                SECOND_QUOTE_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                SPECIAL_SEQUENCE_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                START_COMMENT_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                START_GROUP_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                START_OPTION_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                START_REPEAT_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                TERMINATOR_SYMBOL,
+  /* TERMINAL_CHARACTER ::= */                OTHER_CHARACTER,
+  /* GAP_FREE_SYMBOL ::= */                   TERMINAL_CHARACTER, /* - */ FIRST_QUOTE_SYMBOL, SECOND_QUOTE_SYMBOL,
+  /* GAP_FREE_SYMBOL ::= */                   TERMINAL_STRING,
+  /* TERMINAL_STRING ::= */                   FIRST_QUOTE_SYMBOL, _FIRST_TERMINAL_CHARACTER_MANY, FIRST_QUOTE_SYMBOL,
+  /* TERMINAL_STRING ::= */                   SECOND_QUOTE_SYMBOL, _SECOND_TERMINAL_CHARACTER_MANY, SECOND_QUOTE_SYMBOL,
+  /* NEW_LINE ::= */                          _CARRIAGE_RETURN_ANY, _LINE_FEED, _CARRIAGE_RETURN_ANY,
+  /* _CARRIAGE_RETURN_ANY ::= */              _CARRIAGE_RETURN,
+  /* START_REPEAT_SYMBOL ::= */               _START_REPEAT_SYMBOL_0,
+  /* START_REPEAT_SYMBOL ::= */               _START_REPEAT_SYMBOL_1,
+  /* END_REPEAT_SYMBOL ::= */                 _END_REPEAT_SYMBOL_0,
+  /* END_REPEAT_SYMBOL ::= */                 _END_REPEAT_SYMBOL_1,
+  /* START_OPTION_SYMBOL ::= */               _START_OPTION_SYMBOL_0,
+  /* START_OPTION_SYMBOL ::= */               _START_OPTION_SYMBOL_1,
+  /* END_OPTION_SYMBOL ::= */                 _END_OPTION_SYMBOL_0,
+  /* END_OPTION_SYMBOL ::= */                 _END_OPTION_SYMBOL_1,
+  /* _FIRST_TERMINAL_CHARACTER_MANY ::= */    FIRST_TERMINAL_CHARACTER,
+  /* _SECOND_TERMINAL_CHARACTER_MANY ::= */   SECOND_TERMINAL_CHARACTER,
+  /* FIRST_TERMINAL_CHARACTER ::= */          TERMINAL_CHARACTER, /* - */ FIRST_QUOTE_SYMBOL,
+  /* SECOND_TERMINAL_CHARACTER ::= */         TERMINAL_CHARACTER, /* - */ SECOND_QUOTE_SYMBOL,
+  /* GAP_SEPARATOR ::= */                     SPACE_CHARACTER,
+  /* GAP_SEPARATOR ::= */                     HORIZONTAL_TABULATION_CHARACTER,
+  /* GAP_SEPARATOR ::= */                     NEW_LINE,
+  /* GAP_SEPARATOR ::= */                     VERTICAL_TABULATION_CHARACTER,
+  /* GAP_SEPARATOR ::= */                     FORM_FEED,
+  /* _GAP_SEPARATOR_ANY ::= */                GAP_SEPARATOR,
+  /* _GAP_SYMBOL_UNIT ::= */                  GAP_FREE_SYMBOL, _GAP_SEPARATOR_ANY,
+  /* _GAP_SYMBOL_UNIT_MANY ::= */             _GAP_SYMBOL_UNIT,
+  /* SYNTAX ::= */                            _GAP_SEPARATOR_ANY, _GAP_SYMBOL_UNIT_MANY,
+  /* _COMMENTLESS_SYMBOL_TERMINAL_CHARACTER ::= */ TERMINAL_CHARACTER, /* - */ LETTER, DECIMAL_DIGIT, FIRST_QUOTE_SYMBOL, SECOND_QUOTE_SYMBOL, START_COMMENT_SYMBOL, END_COMMENT_SYMBOL, SPECIAL_SEQUENCE_SYMBOL, OTHER_CHARACTER,
+  /* COMMENTLESS_SYMBOL ::= */                _COMMENTLESS_SYMBOL_TERMINAL_CHARACTER,
+  /* COMMENTLESS_SYMBOL ::= */                META_IDENTIFIER,
+  /* COMMENTLESS_SYMBOL ::= */                INTEGER,
+  /* COMMENTLESS_SYMBOL ::= */                TERMINAL_STRING,
+  /* COMMENTLESS_SYMBOL ::= */                SPECIAL_SEQUENCE,
+  /* INTEGER ::= */                           DECIMAL_DIGIT,
+  /* META_IDENTIFIER ::= */                   LETTER, _META_IDENTIFIER_CHARACTER_ANY,
+  /* _META_IDENTIFIER_CHARACTER_ANY ::= */    META_IDENTIFIER_CHARACTER,
+  /* META_IDENTIFIER_CHARACTER ::= */         LETTER,
+  /* META_IDENTIFIER_CHARACTER ::= */         DECIMAL_DIGIT,
+  /* _SPECIAL_SEQUENCE_CHARACTER_ANY ::= */   SPECIAL_SEQUENCE_CHARACTER,
+  /* SPECIAL_SEQUENCE ::= */                  SPECIAL_SEQUENCE_SYMBOL, _SPECIAL_SEQUENCE_CHARACTER_ANY, SPECIAL_SEQUENCE_SYMBOL,
+  /* SPECIAL_SEQUENCE_CHARACTER ::= */        TERMINAL_CHARACTER,
+  /* COMMENT_SYMBOL ::= */                    BRACKETED_TEXTUAL_COMMENT,
+  /* COMMENT_SYMBOL ::= */                    OTHER_CHARACTER,
+  /* COMMENT_SYMBOL ::= */                    COMMENTLESS_SYMBOL,
+  /* _COMMENT_SYMBOL_ANY ::= */               COMMENT_SYMBOL,
+  /* BRACKETED_TEXTUAL_COMMENT ::= */         START_COMMENT_SYMBOL, _COMMENT_SYMBOL_ANY, END_COMMENT_SYMBOL,
+  /* _BRACKETED_TEXTUAL_COMMENT_ANY ::= */    BRACKETED_TEXTUAL_COMMENT,
+  /* _COMMENTLESS_SYMBOL_UNIT ::= */          COMMENTLESS_SYMBOL, _BRACKETED_TEXTUAL_COMMENT_ANY,
+  /* _COMMENTLESS_SYMBOL_UNIT_MANY ::= */     _COMMENTLESS_SYMBOL_UNIT,
+  /* SYNTAX ::= */                            _BRACKETED_TEXTUAL_COMMENT_ANY, _COMMENTLESS_SYMBOL_UNIT_MANY,
+  /* SYNTAX ::= */                            SYNTAX_RULE, SYNTAX,
+  /* SYNTAX ::= */                            SYNTAX_RULE,
+  /* SYNTAX_RULE ::= */                       META_IDENTIFIER, DEFINING_SYMBOL, DEFINITIONS_LIST, TERMINATOR_SYMBOL,
+  /* _DEFINITIONS_SEQUENCE ::= */             SINGLE_DEFINITION,
+  /* DEFINITIONS_LIST ::= */                  _DEFINITIONS_SEQUENCE,
+  /* DEFINITIONS_LIST ::= */                  EMPTY_SEQUENCE,
+  /* SINGLE_DEFINITION ::= */                 SYNTACTIC_TERM,
+  /* SYNTACTIC_TERM ::= */                    SYNTACTIC_FACTOR,
+  /* SYNTACTIC_TERM ::= */                    SYNTACTIC_FACTOR, EXCEPT_SYMBOL, SYNTACTIC_EXCEPTION,
+  /* SYNTACTIC_FACTOR ::= */                  INTEGER, REPETITION_SYMBOL, SYNTACTIC_PRIMARY,
+  /* SYNTACTIC_FACTOR ::= */                  SYNTACTIC_PRIMARY,
+  /* SYNTACTIC_PRIMARY ::= */                 OPTIONAL_SEQUENCE,
+  /* SYNTACTIC_PRIMARY ::= */                 REPEATED_SEQUENCE,
+  /* SYNTACTIC_PRIMARY ::= */                 GROUPED_SEQUENCE,
+  /* SYNTACTIC_PRIMARY ::= */                 META_IDENTIFIER,
+  /* SYNTACTIC_PRIMARY ::= */                 TERMINAL_STRING,
+  /* SYNTACTIC_PRIMARY ::= */                 SPECIAL_SEQUENCE,
+  /* SYNTACTIC_PRIMARY ::= EMPTY_SEQUENCE: disabled, c.f. the rule */
+  /* OPTIONAL_SEQUENCE ::= */                 START_OPTION_SYMBOL, DEFINITIONS_LIST, END_OPTION_SYMBOL,
+  /* REPEATED_SEQUENCE ::= */                 START_REPEAT_SYMBOL, DEFINITIONS_LIST, END_REPEAT_SYMBOL,
+  /* GROUPED_SEQUENCE ::= */                  START_GROUP_SYMBOL, DEFINITIONS_LIST, END_GROUP_SYMBOL,
+  /* EMPTY_SEQUENCE ::= */
+};
+
+static size_t               marpaEBNFRuleOffsetArray[MARPAEBNF_LENGTH_ARRAY(marpaEBNFRuleArray) + 1];
+static marpaEBNFSymbolSet_t marpaEBNFRuleExceptSetArray[MARPAEBNF_LENGTH_ARRAY(marpaEBNFRuleArray)];
+static marpaEBNFRuleTable_t marpaEBNFRuleTable = {
+  marpaEBNFRuleArray, MARPAEBNF_LENGTH_ARRAY(marpaEBNFRuleArray),
+  marpaEBNFRuleSymbolArray, MARPAEBNF_LENGTH_ARRAY(marpaEBNFRuleSymbolArray),
+  marpaEBNFRuleOffsetArray, marpaEBNFRuleExceptSetArray,
+  { { 0 } }   /* Filled by _marpaEBNF_ruleTableInitb */
+};
+
+/* List of all symbols of the token-level EBNF grammar: lexemes are recognized as a whole */
+/* by the tokenizer, so that only the section 4 of ISO/IEC 14977:1996 remains.            */
+static marpaEBNFSymbol_t marpaEBNFTokenSymbolArray[] = {
+  /* -----------------------------------------------------------
+  {symboli,                                descriptions
+  -------------------------------------------------------------- */
+  {(int) _TOKEN_START                      , "[:start:]" },
+  {(int) TOKEN_META_IDENTIFIER             , "<meta identifier>" },
+  {(int) TOKEN_INTEGER                     , "<integer>" },
+  {(int) TOKEN_TERMINAL_STRING             , "<terminal string>" },
+  {(int) TOKEN_SPECIAL_SEQUENCE            , "<special sequence>" },
+  {(int) TOKEN_CONCATENATE_SYMBOL          , "<concatenate symbol>" },
+  {(int) TOKEN_DEFINING_SYMBOL             , "<defining symbol>" },
+  {(int) TOKEN_DEFINITION_SEPARATOR_SYMBOL , "<definition separator symbol>" },
+  {(int) TOKEN_END_GROUP_SYMBOL            , "<end group symbol>" },
+  {(int) TOKEN_END_OPTION_SYMBOL           , "<end option symbol>" },
+  {(int) TOKEN_END_REPEAT_SYMBOL           , "<end repeat symbol>" },
+  {(int) TOKEN_EXCEPT_SYMBOL               , "<except symbol>" },
+  {(int) TOKEN_REPETITION_SYMBOL           , "<repetition symbol>" },
+  {(int) TOKEN_START_GROUP_SYMBOL          , "<start group symbol>" },
+  {(int) TOKEN_START_OPTION_SYMBOL         , "<start option symbol>" },
+  {(int) TOKEN_START_REPEAT_SYMBOL         , "<start repeat symbol>" },
+  {(int) TOKEN_TERMINATOR_SYMBOL           , "<terminator symbol>" },
+  {(int) TOKEN_SYNTAX                      , "<syntax>" },
+  {(int) TOKEN_SYNTAX_RULE                 , "<syntax rule>" },
+  {(int) TOKEN_DEFINITIONS_LIST            , "<definitions list>" },
+  {(int) TOKEN_SINGLE_DEFINITION           , "<single definition>" },
+  {(int) TOKEN_SYNTACTIC_TERM              , "<syntactic term>" },
+  {(int) TOKEN_SYNTACTIC_EXCEPTION         , "<syntactic exception>" },
+  {(int) TOKEN_SYNTACTIC_FACTOR            , "<syntactic factor>" },
+  {(int) TOKEN_SYNTACTIC_PRIMARY           , "<syntactic primary>" },
+  {(int) TOKEN_OPTIONAL_SEQUENCE           , "<optional sequence>" },
+  {(int) TOKEN_REPEATED_SEQUENCE           , "<repeated sequence>" },
+  {(int) TOKEN_GROUPED_SEQUENCE            , "<grouped sequence>" },
+  {(int) TOKEN_EMPTY_SEQUENCE              , "<empty sequence>" }
+};
+
+/*
+  The repetitions of section 4 are written as left recursions instead of Marpa sequences:
+  <empty sequence> is a nullable that can appear in any <syntactic term>, and Marpa does
+  not like counted nullables.
+
+  syntax = syntax rule, {syntax rule}
+  definitions list = single definition, {definition separator symbol, single definition}
+  single definition = syntactic term, {concatenate symbol, syntactic term}
+  syntactic term = syntactic factor, [except symbol, syntactic exception]
+  syntactic factor = [integer, repetition symbol], syntactic primary
+
+  The exception "syntactic exception = ? a syntactic-factor that could be replaced by a
+  syntactic-factor containing no meta-identifiers ?" is not context-free and is revisited to:
+
+  syntactic exception = syntactic factor
+*/
+static marpaEBNFRule_t marpaEBNFTokenRuleArray[] = {
+  { { 0, 0, 0,            -1, 0, 0 }, _TOKEN_START,                     1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTAX,                     1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTAX,                     2, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTAX_RULE,                4, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_DEFINITIONS_LIST,           1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_DEFINITIONS_LIST,           3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SINGLE_DEFINITION,          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SINGLE_DEFINITION,          3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_TERM,             1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_TERM,             3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_EXCEPTION,        1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_FACTOR,           3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_FACTOR,           1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_PRIMARY,          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_PRIMARY,          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_PRIMARY,          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_PRIMARY,          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_PRIMARY,          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_PRIMARY,          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_SYNTACTIC_PRIMARY,          1, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_OPTIONAL_SEQUENCE,          3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_REPEATED_SEQUENCE,          3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_GROUPED_SEQUENCE,           3, 0 },
+  { { 0, 0, 0,            -1, 0, 0 }, TOKEN_EMPTY_SEQUENCE,             0, 0 }
+};
+
+/* Right-hand sides of the rules above, each followed by its exceptions, in rule order */
+static int marpaEBNFTokenRuleSymbolArray[] = {
+  /* _TOKEN_START ::= */                      TOKEN_SYNTAX,
+  /* TOKEN_SYNTAX ::= */                      TOKEN_SYNTAX_RULE,
+  /* TOKEN_SYNTAX ::= */                      TOKEN_SYNTAX, TOKEN_SYNTAX_RULE,
+  /* TOKEN_SYNTAX_RULE ::= */                 TOKEN_META_IDENTIFIER, TOKEN_DEFINING_SYMBOL, TOKEN_DEFINITIONS_LIST, TOKEN_TERMINATOR_SYMBOL,
+  /* TOKEN_DEFINITIONS_LIST ::= */            TOKEN_SINGLE_DEFINITION,
+  /* TOKEN_DEFINITIONS_LIST ::= */            TOKEN_DEFINITIONS_LIST, TOKEN_DEFINITION_SEPARATOR_SYMBOL, TOKEN_SINGLE_DEFINITION,
+  /* TOKEN_SINGLE_DEFINITION ::= */           TOKEN_SYNTACTIC_TERM,
+  /* TOKEN_SINGLE_DEFINITION ::= */           TOKEN_SINGLE_DEFINITION, TOKEN_CONCATENATE_SYMBOL, TOKEN_SYNTACTIC_TERM,
+  /* TOKEN_SYNTACTIC_TERM ::= */              TOKEN_SYNTACTIC_FACTOR,
+  /* TOKEN_SYNTACTIC_TERM ::= */              TOKEN_SYNTACTIC_FACTOR, TOKEN_EXCEPT_SYMBOL, TOKEN_SYNTACTIC_EXCEPTION,
+  /* TOKEN_SYNTACTIC_EXCEPTION ::= */         TOKEN_SYNTACTIC_FACTOR,
+  /* TOKEN_SYNTACTIC_FACTOR ::= */            TOKEN_INTEGER, TOKEN_REPETITION_SYMBOL, TOKEN_SYNTACTIC_PRIMARY,
+  /* TOKEN_SYNTACTIC_FACTOR ::= */            TOKEN_SYNTACTIC_PRIMARY,
+  /* TOKEN_SYNTACTIC_PRIMARY ::= */           TOKEN_OPTIONAL_SEQUENCE,
+  /* TOKEN_SYNTACTIC_PRIMARY ::= */           TOKEN_REPEATED_SEQUENCE,
+  /* TOKEN_SYNTACTIC_PRIMARY ::= */           TOKEN_GROUPED_SEQUENCE,
+  /* TOKEN_SYNTACTIC_PRIMARY ::= */           TOKEN_META_IDENTIFIER,
+  /* TOKEN_SYNTACTIC_PRIMARY ::= */           TOKEN_TERMINAL_STRING,
+  /* TOKEN_SYNTACTIC_PRIMARY ::= */           TOKEN_SPECIAL_SEQUENCE,
+  /* TOKEN_SYNTACTIC_PRIMARY ::= */           TOKEN_EMPTY_SEQUENCE,
+  /* TOKEN_OPTIONAL_SEQUENCE ::= */           TOKEN_START_OPTION_SYMBOL, TOKEN_DEFINITIONS_LIST, TOKEN_END_OPTION_SYMBOL,
+  /* TOKEN_REPEATED_SEQUENCE ::= */           TOKEN_START_REPEAT_SYMBOL, TOKEN_DEFINITIONS_LIST, TOKEN_END_REPEAT_SYMBOL,
+  /* TOKEN_GROUPED_SEQUENCE ::= */            TOKEN_START_GROUP_SYMBOL, TOKEN_DEFINITIONS_LIST, TOKEN_END_GROUP_SYMBOL,
+  /* TOKEN_EMPTY_SEQUENCE ::= */
+};
+
+static size_t               marpaEBNFTokenRuleOffsetArray[MARPAEBNF_LENGTH_ARRAY(marpaEBNFTokenRuleArray) + 1];
+static marpaEBNFSymbolSet_t marpaEBNFTokenRuleExceptSetArray[MARPAEBNF_LENGTH_ARRAY(marpaEBNFTokenRuleArray)];
+static marpaEBNFRuleTable_t marpaEBNFTokenRuleTable = {
+  marpaEBNFTokenRuleArray, MARPAEBNF_LENGTH_ARRAY(marpaEBNFTokenRuleArray),
+  marpaEBNFTokenRuleSymbolArray, MARPAEBNF_LENGTH_ARRAY(marpaEBNFTokenRuleSymbolArray),
+  marpaEBNFTokenRuleOffsetArray, marpaEBNFTokenRuleExceptSetArray,
+  { { 0 } }   /* Filled by _marpaEBNF_ruleTableInitb */
+};
+
+/* Expected terminals are memoized, keyed by a fingerprint of the array returned by */
+/* marpaWrapperRecognizer_expectedb: long runs of comment or terminal-string text   */
+/* keep the recognizer in the same state.                                           */
+#define MARPAEBNF_EXPECTEDCACHE_SIZE 16 /* Must be a power of 2 */
+
+typedef struct marpaEBNFExpectedCache {
+  unsigned long         fingerprintl;
+  size_t                nSymboll;                      /* 0 for an empty slot */
+  int                   symbolip[_MARPAEBNF_NSYMBOL];  /* Copy of the expected array, for exact match */
+  marpaEBNFSymbolSet_t  expectedSet;                   /* Acceptance mask */
+  short                 pairb;                         /* Is a two-characters lexeme expected */
+} marpaEBNFExpectedCache_t;
+
+/* A token value is a view into the grammar buffer: no copy of the text is ever made */
+typedef struct marpaEBNFSpan {
+  size_t offsetl;       /* Absolute offset in the source */
+  size_t lengthl;
+  size_t textOffsetl;   /* Offset of the text: in the grammar buffer, or in textBuffer when streaming */
+} marpaEBNFSpan_t;
+
+#define MARPAEBNF_SPAN_INITIAL_SIZE 1024
+
+/* Growable byte buffer, kept from one parse to another */
+typedef struct marpaEBNFBuffer {
+  char   *bytes;
+  size_t  bytel;      /* Number of used bytes */
+  size_t  allocl;     /* Number of allocated bytes */
+} marpaEBNFBuffer_t;
+
+#define MARPAEBNF_BUFFER_INITIAL_SIZE 4096
+
+/* Where a syntax rule of the AST is in the grammar being edited: an edit */
+/* starts counting lines and columns at the end of the rule before it.    */
+typedef struct marpaEBNFEditRule {
+  marpaEBNFPiece_t start;   /* Meta identifier, lengthl being that of the rule */
+  marpaEBNFPiece_t end;     /* After the terminator symbol */
+} marpaEBNFEditRule_t;
+
+/* The internal grammars and the byte classes depend on nothing but the static */
+/* arrays above: they are built once per process, when first needed, and are  */
+/* shared read-only by all the instances. They are kept until the process      */
+/* ends, so that instances created one after the other never precompute them   */
+/* again: marpaEBNF_shutdownv() releases them, and so does the destructor of   */
+/* the library where the compiler supports it. Reference counts of libmarpa    */
+/* are not atomic: creation and destruction of the recognizers, the only       */
+/* objects that reference a shared grammar, are serialized with the same       */
+/* mutex.                                                                      */
+typedef struct marpaEBNFShared {
+  marpaWrapperGrammar_t *marpaWrapperGrammarp;      /* Character-level grammar, NULL until needed */
+  marpaWrapperGrammar_t *marpaWrapperTokenGrammarp; /* Token-level grammar, NULL until needed */
+  size_t                 refcountl;                 /* Number of grammars, only to keep marpaEBNF_shutdownv() from releasing them too early */
+  short                  byteClassb;                /* Is byteClass initialized */
+  short                  ruleTableb;                /* Are the offsets and exceptions of the rule tables initialized */
+  marpaEBNFByteClass_t   byteClass;
+} marpaEBNFShared_t;
+
+static marpaEBNFMutex_t  marpaEBNFSharedMutex = MARPAEBNF_MUTEX_INITIALIZER;
+static marpaEBNFShared_t marpaEBNFShared;
+
+/* A grammar is never modified once created: it is what the parse contexts  */
+/* share. Everything a parse writes to is in the context.                   */
+struct marpaEBNFGrammar {
+  marpaEBNFOption_t      marpaEBNFOption;      /* Option, inherited by the contexts */
+  marpaEBNFAllocator_t   marpaEBNFAllocator;   /* Allocator hooks of the grammar itself */
+  marpaWrapperGrammar_t *marpaWrapperGrammarp; /* Internal grammar of the selected mode, shared process-wide */
+  marpaEBNFByteClass_t  *byteClassp;           /* Byte to terminals lookup tables, shared process-wide */
+  size_t                 refcountl;            /* The creator and the contexts, protected by marpaEBNFSharedMutex */
 };
 
 /* Internally, EBNF is nothing else but an instance of marpaWrapperGrammar_t along */
-/* with symbols and rules book-keeping.                                            */
+/* with symbols and rules book-keeping. An instance is a parse context: it must    */
+/* not be used by two threads at the same time.                                    */
 struct marpaEBNF {
-  marpaEBNFOption_t      marpaEBNFOption;      /* Option */
-  marpaWrapperGrammar_t *grammarp;             /* External grammar */
-  marpaWrapperGrammar_t *marpaWrapperGrammarp; /* Internal grammar */
-  marpaEBNFSymbol_t     *symbolArrayp;         /* Copy of marpaEBNFSymbolArray */
-  marpaEBNFRule_t       *ruleArrayp;           /* Copy of marpaEBNFRuleArray */
-  genericStack_t        *inputStackp;
-  genericStack_t        *outputStackp;
-  short                  stringContextb;
+  marpaEBNFOption_t      marpaEBNFOption;      /* Option, copy of the one of the grammar */
+  marpaEBNFAllocator_t   marpaEBNFAllocator;   /* Allocator hooks and accounting */
+  marpaEBNFGrammar_t    *marpaEBNFGrammarp;    /* Read-only grammar, of which the context holds a reference */
+  marpaEBNFCompiled_t   *grammarp;             /* External grammar, compiled from the AST of the last successful parse */
+  char                  *inputs;               /* Grammar buffer of the current parse, owned by the caller */
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp; /* Recognizer of the current parse */
+  short                  parsingb;             /* A parse is in progress */
+  short                  streamingb;           /* Input comes by chunks: token values are copied in textBuffer */
+  marpaEBNFBuffer_t      carryBuffer;          /* Bytes of the previous chunks not yet consumed */
+  marpaEBNFBuffer_t      textBuffer;           /* Streaming: text of the token values */
+  marpaEBNFLexer_t       lexer;                /* Token-level reader state */
+  size_t                 scannerOffsetl;       /* Character-level reader state: absolute offset */
+  size_t                 startOffsetl;         /* Absolute offset where the parse starts: that of its piece */
+  size_t                 scannerLinel;         /* Character-level reader state: current line */
+  size_t                 scannerColumnl;       /* Character-level reader state: current column */
+  marpaEBNFSpan_t       *spanArrayp;           /* Token values, indexed by the value given to the recognizer */
+  size_t                 spanl;                /* Number of used spans */
+  size_t                 spanAllocl;           /* Number of allocated spans, kept from one parse to another */
+  genericStack_t        *outputStackp;         /* AST nodes, indexed as the valuation stack */
+  marpaEBNFAstBuilder_t  astBuilder;
+  marpaEBNFAst_t        *astp;                 /* AST of the last successful parse */
+  marpaEBNFArena_t       arena;                /* Per-parse allocations */
+  char                   stringQuotec;         /* Character-level reader: quote of the terminal string being read, '\0' outside */
+  short                  specialContextb;      /* Character-level reader: inside a special sequence */
+  size_t                 commentLevell;        /* Character-level reader: depth of bracketed textual comments */
   short                  sequenceContextb;
+  marpaEBNFExpectedCache_t *expectedCachep;   /* MARPAEBNF_EXPECTEDCACHE_SIZE entries, allocated by the first character-level parse */
+  marpaEBNFStats_t       stats;                /* Statistics of the last parse */
+  marpaEBNFEventRing_t  *eventRingp;           /* Trace events of the last parse, allocated by the first character-level parse */
+  short                  pieceb;               /* Parses pieces of a parallel parse: the AST is not compiled */
+  marpaEBNFBuffer_t      editBuffer;           /* Grammar of the last parse of a whole buffer, that edits change */
+  short                  editb;                /* editBuffer holds it */
+  struct marpaEBNF      *editContextp;         /* Parses the syntax rules touched by edits, created by the first one */
+  marpaEBNFEditRule_t   *editRulep;            /* One per syntax rule of the AST, when editRuleb */
+  size_t                 editRuleAllocl;       /* Kept from one parse to another */
+  short                  editRuleb;            /* editRulep is that of the AST: built by the first edit, kept by the next ones */
+  marpaEBNFDiagnostic_t *diagnosticp;          /* Syntax errors of the last parse, with the recoverb option */
+  size_t                 diagnosticl;
+  size_t                 diagnosticAllocl;     /* Kept from one parse to another */
+  short                  recoveringb;          /* Lexemes are skipped up to the next terminator symbol */
+  size_t                 segmentTokenl;        /* Lexemes submitted before the current recognizer */
 };
 
-/* When pruning the ASF, we distinguish concatenated strings from structures */
-typedef enum marpaEBNFOutputStackType {
-  MARPAEBNFOUTPUTSTACKTYPE_STRING = 0,
-  MARPAEBNFOUTPUTSTACKTYPE_STRUCT
-} marpaEBNFOutputStackType_t;
-
-typedef struct marpaEBNFOutputStack {
-  marpaEBNFOutputStackType_t type;
-  void                      *p;
-} marpaEBNFOutputStack_t;
-
-static inline short  _marpaEBNF_internalGrammarb(marpaEBNF_t *marpaEBNFp);
+/* A batch worker: its context logs, at warning level and above, to the */
+/* diagnostics of the item in progress.                                 */
+typedef struct marpaEBNFBatchWorker {
+  marpaEBNF_t          *marpaEBNFp;
+  genericLogger_t      *genericLoggerp;
+  marpaEBNFBatchItem_t *itemp;               /* Item in progress */
+  size_t                diagnosticl;         /* Bytes used in its diagnostics */
+  size_t                okl;
+  size_t                bytel;
+} marpaEBNFBatchWorker_t;
+
+typedef struct marpaEBNFBatch {
+  marpaEBNFBatchWorker_t *workerp;
+  marpaEBNFBatchItem_t   *itemp;
+} marpaEBNFBatch_t;
+
+/* A parallel parse: pieces are dealt to the worker contexts, each piece */
+/* leaves its AST and the worker that owns it.                           */
+#define MARPAEBNF_PARALLEL_PIECES_PER_THREAD 4
+
+typedef struct marpaEBNFParallelResult {
+  marpaEBNFAst_t  *astp;
+  size_t           workeri;
+  marpaEBNFStats_t stats;
+} marpaEBNFParallelResult_t;
+
+typedef struct marpaEBNFParallel {
+  char                      *grammars;
+  marpaEBNF_t              **marpaEBNFpp;  /* Context of each worker */
+  marpaEBNFPiece_t          *piecep;
+  marpaEBNFParallelResult_t *resultp;
+} marpaEBNFParallel_t;
+
+/* Warnings of the compilation of an edit: they are given to the logger */
+/* only when the edit is kept, else the parse of the whole grammar that  */
+/* follows reports everything once.                                      */
+#define MARPAEBNF_EDIT_WARNINGS_SIZE 1024
+
+typedef struct marpaEBNFEditLog {
+  char   warnings[MARPAEBNF_EDIT_WARNINGS_SIZE]; /* One per line, truncated when full */
+  size_t warningl;
+} marpaEBNFEditLog_t;
+
+static inline short  _marpaEBNF_internalGrammarb(genericLogger_t *genericLoggerp, marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaEBNFSymbol_t *symbolArrayp, size_t nSymboll, marpaEBNFRuleTable_t *ruleTablep);
+static inline marpaWrapperGrammar_t *_marpaEBNF_sharedGrammarp(genericLogger_t *genericLoggerp, marpaEBNFSymbol_t *symbolArrayp, size_t nSymboll, marpaEBNFRuleTable_t *ruleTablep);
+static inline short  _marpaEBNF_sharedAcquireb(marpaEBNFGrammar_t *marpaEBNFGrammarp);
+static inline void   _marpaEBNF_sharedReleasev(marpaEBNFGrammar_t *marpaEBNFGrammarp);
+static inline marpaWrapperRecognizer_t *_marpaEBNF_sharedRecognizerNewp(marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizerOption_t *marpaWrapperRecognizerOptionp);
+static inline void   _marpaEBNF_sharedRecognizerFreev(marpaWrapperRecognizer_t *marpaWrapperRecognizerp);
+static inline void   _marpaEBNF_grammarReleasev(marpaEBNFGrammar_t *marpaEBNFGrammarp);
+static inline marpaEBNF_t *_marpaEBNF_contextNewp(marpaEBNFGrammar_t *marpaEBNFGrammarp, genericLogger_t *genericLoggerp);
+static short         _marpaEBNF_batchItemb(void *userDatavp, size_t workeri, size_t itemi);
+static void          _marpaEBNF_batchLoggerv(void *userDatavp, genericLoggerLevel_t logLeveli, const char *msgs);
+static void          _marpaEBNF_editLoggerv(void *userDatavp, genericLoggerLevel_t logLeveli, const char *msgs);
+static short         _marpaEBNF_parallelPieceb(void *userDatavp, size_t workeri, size_t itemi);
+static inline short  _marpaEBNF_pieceb(marpaEBNF_t *marpaEBNFp, char *grammars, marpaEBNFPiece_t *piecep);
 static inline char  *_marpaEBNF_symbolDescription(void *userDatavp, int symboli);
+static inline char  *_marpaEBNF_tokenSymbolDescription(void *userDatavp, int symboli);
+static inline char  *_marpaEBNF_grammarSymbolDescription(void *userDatavp, int symboli);
+static inline short  _marpaEBNF_grammarBufferb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl);
+static inline short  _marpaEBNF_cacheKeyb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl, unsigned char *keyp);
+static inline short  _marpaEBNF_cacheHitb(marpaEBNF_t *marpaEBNFp, unsigned char *keyp);
+static inline short  _marpaEBNF_grammarParallelb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl, size_t threadl);
+static inline void   _marpaEBNF_editKeepv(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl);
+static inline short  _marpaEBNF_editRulesb(marpaEBNF_t *marpaEBNFp, size_t offsetl, size_t removedl, size_t *firstRulelp, size_t *endRulelp, size_t *startlp, size_t *endlp);
+static inline short  _marpaEBNF_editPieceb(marpaEBNF_t *marpaEBNFp, size_t firstRulel, size_t endRulel, size_t startl, size_t endl, size_t deltal);
+static inline short  _marpaEBNF_editRuleAllocb(marpaEBNF_t *marpaEBNFp, size_t rulel);
+static inline short  _marpaEBNF_editRuleInitb(marpaEBNF_t *marpaEBNFp);
+static inline void   _marpaEBNF_editRuleSplicev(marpaEBNF_t *marpaEBNFp, size_t firstRulel, size_t rulel, size_t oldRulel, marpaEBNFAst_t *pieceAstp, size_t deltal);
+static inline short  _marpaEBNF_beginb(marpaEBNF_t *marpaEBNFp, short streamingb);
+static inline short  _marpaEBNF_recognizerNewb(marpaEBNF_t *marpaEBNFp);
+static inline short  _marpaEBNF_diagnosticb(marpaEBNF_t *marpaEBNFp, size_t offsetl, size_t lengthl, size_t linel, size_t columnl);
+static inline short  _marpaEBNF_tokenRecoverb(marpaEBNF_t *marpaEBNFp, marpaEBNFToken_t *marpaEBNFTokenp, size_t baseOffsetl);
+static inline short  _marpaEBNF_feedb(marpaEBNF_t *marpaEBNFp, char *inputs, size_t inputl, short eofb);
+static inline short  _marpaEBNF_endb(marpaEBNF_t *marpaEBNFp);
+static inline void   _marpaEBNF_parseFreev(marpaEBNF_t *marpaEBNFp, short rcb);
+static inline void   _marpaEBNF_statsResetv(marpaEBNF_t *marpaEBNFp);
+static inline void   _marpaEBNF_statsAddv(marpaEBNFStats_t *marpaEBNFStatsp, marpaEBNFStats_t *pieceStatsp);
+static inline short  _marpaEBNF_eventRingb(marpaEBNF_t *marpaEBNFp, short resetb);
+static inline void   _marpaEBNF_scannerContextv(marpaEBNF_t *marpaEBNFp, marpaEBNFSymbolSet_t *acceptedSymbolSetp, char c);
+static inline short  _marpaEBNF_scannerlessReadb(marpaEBNF_t *marpaEBNFp, char *inputs, size_t inputl, short eofb, size_t *consumedlp);
+static inline short  _marpaEBNF_tokenReadb(marpaEBNF_t *marpaEBNFp, char *inputs, size_t inputl, short eofb, size_t *consumedlp);
 static inline short  _marpaEBNF_okSymbolCallbackb(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi);
 static inline short  _marpaEBNF_okRuleCallbackb(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei);
+static inline short  _marpaEBNF_tokenOkSymbolCallbackb(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi);
+static inline short  _marpaEBNF_tokenOkRuleCallbackb(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei);
 static inline short  _marpaEBNF_valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
 static inline short  _marpaEBNF_valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
 static inline short  _marpaEBNF_valueNullingCallback(void *userDatavp, int symboli, int resulti);
 
 static marpaEBNFOption_t marpaEBNFOptionDefault = {
-  NULL /* genericLoggerp */
+  NULL, /* genericLoggerp */
+  0,    /* scannerlessb */
+  NULL, /* mallocp */
+  NULL, /* reallocp */
+  NULL, /* freep */
+  NULL, /* allocatorUserDatavp */
+  NULL, /* cachep */
+  0,    /* recoverb */
+  0     /* utf8b */
 };
 
-static inline void  _marpaEBNF_inputStackFree(marpaEBNF_t *marpaEBNFp);
+static inline int   _marpaEBNF_spanPushi(marpaEBNF_t *marpaEBNFp, char *texts, size_t offsetl, size_t lengthl);
+static inline short _marpaEBNF_bufferAppendb(marpaEBNF_t *marpaEBNFp, marpaEBNFBuffer_t *bufferp, char *bytes, size_t bytel);
+static inline char *_marpaEBNF_spanViews(marpaEBNF_t *marpaEBNFp, int valuei, size_t *lengthlp);
+static inline marpaEBNFExpectedCache_t *_marpaEBNF_expectedCachep(marpaEBNF_t *marpaEBNFp, size_t nSymboll, int *expectedSymbolArrayp);
+static inline short _marpaEBNF_outputStackSetb(marpaEBNF_t *marpaEBNFp, marpaEBNFAstNode_t *nodep, int resulti);
 static inline void  _marpaEBNF_outputStackFree(marpaEBNF_t *marpaEBNFp);
 
 /****************************************************************************/
 marpaEBNF_t *marpaEBNF_newp(marpaEBNFOption_t *marpaEBNFOptionp)
 /****************************************************************************/
+/* A private grammar with a single context: the context holds the only      */
+/* reference to the grammar once created.                                   */
+/****************************************************************************/
 {
-  marpaEBNF_t                *marpaEBNFp;
-  marpaWrapperGrammarOption_t marpaWrapperGrammarOption;
-  const static size_t         marpaEBNFSymbolArraySizel = MARPAEBNF_LENGTH_ARRAY(marpaEBNFSymbolArray) * sizeof(marpaEBNFSymbol_t);
-  const static size_t         marpaEBNFRuleArraySizel = MARPAEBNF_LENGTH_ARRAY(marpaEBNFRuleArray) * sizeof(marpaEBNFRule_t);
+  marpaEBNFGrammar_t *marpaEBNFGrammarp;
+  marpaEBNF_t        *marpaEBNFp;
+
+  marpaEBNFGrammarp = marpaEBNFGrammar_newp(marpaEBNFOptionp);
+  if (marpaEBNFGrammarp == NULL) {
+    return NULL;
+  }
+  marpaEBNFp = marpaEBNF_contextNewp(marpaEBNFGrammarp);
+  marpaEBNFGrammar_freev(marpaEBNFGrammarp);
+
+  return marpaEBNFp;
+}
+
+/****************************************************************************/
+marpaEBNFGrammar_t *marpaEBNFGrammar_newp(marpaEBNFOption_t *marpaEBNFOptionp)
+/****************************************************************************/
+{
+  marpaEBNFGrammar_t  *marpaEBNFGrammarp;
+  marpaEBNFAllocator_t marpaEBNFAllocator;
 
   if (marpaEBNFOptionp == NULL) {
     marpaEBNFOptionp = &marpaEBNFOptionDefault;
   }
 
-  marpaEBNFp = malloc(sizeof(marpaEBNF_t));
-  if (marpaEBNFp == NULL) {
-    goto err;
+  _marpaEBNF_memoryInitv(&marpaEBNFAllocator, marpaEBNFOptionp);
+  marpaEBNFGrammarp = (marpaEBNFGrammar_t *) _marpaEBNF_memoryMallocp(&marpaEBNFAllocator, sizeof(marpaEBNFGrammar_t));
+  if (marpaEBNFGrammarp == NULL) {
+    MARPAEBNF_ERRORF(marpaEBNFOptionp->genericLoggerp, "malloc error, %s", strerror(errno));
+    return NULL;
   }
 
-  /* Initialization */
-  marpaEBNFp->marpaEBNFOption      = *marpaEBNFOptionp;
-  marpaEBNFp->grammarp             = NULL;
-  marpaEBNFp->marpaWrapperGrammarp = NULL;
-  marpaEBNFp->symbolArrayp         = NULL;
-  marpaEBNFp->ruleArrayp           = NULL;
-  marpaEBNFp->inputStackp          = NULL;
-  marpaEBNFp->outputStackp         = NULL;
-  marpaEBNFp->stringContextb       = 0;
-  marpaEBNFp->sequenceContextb     = 0;
-  
-  marpaEBNFp->symbolArrayp         = (marpaEBNFSymbol_t *) malloc(marpaEBNFSymbolArraySizel);
-  if (marpaEBNFp->symbolArrayp == NULL) {
-    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "malloc error, %s", strerror(errno));
-    goto err;
-  }
-  marpaEBNFp->ruleArrayp           = (marpaEBNFRule_t *) malloc(marpaEBNFRuleArraySizel);
-  if (marpaEBNFp->ruleArrayp == NULL) {
-    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "malloc error, %s", strerror(errno));
-    goto err;
+  marpaEBNFGrammarp->marpaEBNFOption      = *marpaEBNFOptionp;
+  marpaEBNFGrammarp->marpaEBNFAllocator   = marpaEBNFAllocator;
+  marpaEBNFGrammarp->marpaWrapperGrammarp = NULL;
+  marpaEBNFGrammarp->byteClassp           = NULL;
+  marpaEBNFGrammarp->refcountl            = 1;
+
+  /* Internal grammar of the selected mode, built by the first grammar that needs it */
+  if (_marpaEBNF_sharedAcquireb(marpaEBNFGrammarp) == 0) {
+    marpaEBNFGrammar_freev(marpaEBNFGrammarp);
+    return NULL;
   }
 
-  marpaWrapperGrammarOption.genericLoggerp    = marpaEBNFp->marpaEBNFOption.genericLoggerp;
-  marpaWrapperGrammarOption.warningIsErrorb   = 0;
-  marpaWrapperGrammarOption.warningIsIgnoredb = 0;
-  marpaWrapperGrammarOption.autorankb         = 0;
+  return marpaEBNFGrammarp;
+}
 
-  marpaEBNFp->marpaWrapperGrammarp = marpaWrapperGrammar_newp(&marpaWrapperGrammarOption);
-  if (marpaEBNFp->marpaWrapperGrammarp == NULL) {
-    goto err;
+/****************************************************************************/
+void marpaEBNFGrammar_freev(marpaEBNFGrammar_t *marpaEBNFGrammarp)
+/****************************************************************************/
+/* Contexts created from the grammar remain valid                           */
+/****************************************************************************/
+{
+  if (marpaEBNFGrammarp != NULL) {
+    _marpaEBNF_grammarReleasev(marpaEBNFGrammarp);
   }
+}
 
-  /* Take care: marpaEBNFp->symbolArrayp and marpaEBNFp->ruleArrayp will contain pointers    */
-  /* to strings that are shared with the static marpaEBNFSymbolArray and marpaEBNFRuleArray, */
-  /* respectively.                                                                           */
-  memcpy(marpaEBNFp->symbolArrayp, marpaEBNFSymbolArray, marpaEBNFSymbolArraySizel);
-  memcpy(marpaEBNFp->ruleArrayp, marpaEBNFRuleArray, marpaEBNFRuleArraySizel);
-
-  /* Compute internal grammar */
-  if (_marpaEBNF_internalGrammarb(marpaEBNFp) == 0) {
-    goto err;
+/****************************************************************************/
+static inline void _marpaEBNF_grammarReleasev(marpaEBNFGrammar_t *marpaEBNFGrammarp)
+/****************************************************************************/
+{
+  marpaEBNFAllocator_t marpaEBNFAllocator;
+  size_t               refcountl;
+
+  MARPAEBNF_MUTEX_LOCK(&marpaEBNFSharedMutex);
+  refcountl = --(marpaEBNFGrammarp->refcountl);
+  MARPAEBNF_MUTEX_UNLOCK(&marpaEBNFSharedMutex);
+
+  if (refcountl <= 0) {
+    _marpaEBNF_sharedReleasev(marpaEBNFGrammarp);
+    /* The allocator must survive the grammar */
+    marpaEBNFAllocator = marpaEBNFGrammarp->marpaEBNFAllocator;
+    _marpaEBNF_memoryFreev(&marpaEBNFAllocator, marpaEBNFGrammarp);
   }
+}
 
-  return marpaEBNFp;
+/****************************************************************************/
+marpaEBNF_t *marpaEBNF_contextNewp(marpaEBNFGrammar_t *marpaEBNFGrammarp)
+/****************************************************************************/
+{
+  if (marpaEBNFGrammarp == NULL) {
+    errno = EINVAL;
+    return NULL;
+  }
 
- err:
-  marpaEBNF_freev(marpaEBNFp);
-  return NULL;
+  return _marpaEBNF_contextNewp(marpaEBNFGrammarp, marpaEBNFGrammarp->marpaEBNFOption.genericLoggerp);
 }
 
 /****************************************************************************/
-short marpaEBNF_grammarb(marpaEBNF_t *marpaEBNFp, char *grammars)
+static inline marpaEBNF_t *_marpaEBNF_contextNewp(marpaEBNFGrammar_t *marpaEBNFGrammarp, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* The context logs to genericLoggerp instead of the logger of the grammar  */
 /****************************************************************************/
 {
-  const static char             funcs[]                  = "marpaEBNF_grammarb";
-  int                            linel                   = 1;
-  int                            columnl                 = 1;
-  marpaWrapperRecognizer_t      *marpaWrapperRecognizerp = NULL;
-  genericStack_t                *alternativeStackp       = NULL;
-  int                            posi                    = 0;
-  const static size_t            marpaEBNFSymbolArraySizel = MARPAEBNF_LENGTH_ARRAY(marpaEBNFSymbolArray) * sizeof(marpaEBNFSymbol_t);
+  marpaEBNF_t          *marpaEBNFp;
+  marpaEBNFAllocator_t  marpaEBNFAllocator;
 
-  marpaWrapperAsf_t             *marpaWrapperAsfp = NULL;
-  marpaWrapperRecognizerOption_t marpaWrapperRecognizerOption;
-  marpaWrapperAsfOption_t        marpaWrapperAsfOption;
-  size_t                         i;
-  size_t                         nSymboll;
-  int                           *expectedSymbolArrayp;
-  marpaEBNFSymbolEnum_t          symboli;
-  marpaEBNFSymbol_t             *marpaEBNFSymbolp;
-  char                           c1;
-  char                           c2;
-  char                          *p;
-  char                          *q;
-  char                          *maxp;
-  size_t                         grammarLengthl;
-  short                          okb;
-  size_t                         lengthl;
-  short                          rci;
-  
-  /* Initialize sensible data used in the err section */
-  marpaEBNFp->inputStackp  = NULL;
-  marpaEBNFp->outputStackp = NULL;
+  /* The context itself is accounted for: the allocator moves into it once it exists */
+  _marpaEBNF_memoryInitv(&marpaEBNFAllocator, &(marpaEBNFGrammarp->marpaEBNFOption));
+  marpaEBNFp = (marpaEBNF_t *) _marpaEBNF_memoryMallocp(&marpaEBNFAllocator, sizeof(marpaEBNF_t));
+  if (marpaEBNFp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    return NULL;
+  }
 
-  if (grammars == NULL) {
+  MARPAEBNF_MUTEX_LOCK(&marpaEBNFSharedMutex);
+  marpaEBNFGrammarp->refcountl++;
+  MARPAEBNF_MUTEX_UNLOCK(&marpaEBNFSharedMutex);
+
+  /* Initialization */
+  marpaEBNFp->marpaEBNFOption      = marpaEBNFGrammarp->marpaEBNFOption;
+  marpaEBNFp->marpaEBNFOption.genericLoggerp = genericLoggerp;
+  marpaEBNFp->marpaEBNFAllocator   = marpaEBNFAllocator;
+  marpaEBNFp->marpaEBNFGrammarp    = marpaEBNFGrammarp;
+  marpaEBNFp->grammarp             = NULL;
+  marpaEBNFp->inputs               = NULL;
+  marpaEBNFp->marpaWrapperRecognizerp = NULL;
+  marpaEBNFp->parsingb             = 0;
+  marpaEBNFp->streamingb           = 0;
+  memset(&(marpaEBNFp->carryBuffer), 0, sizeof(marpaEBNFBuffer_t));
+  memset(&(marpaEBNFp->textBuffer), 0, sizeof(marpaEBNFBuffer_t));
+  _marpaEBNF_lexerInitv(&(marpaEBNFp->lexer), marpaEBNFp->marpaEBNFOption.genericLoggerp, NULL, 0);
+  marpaEBNFp->scannerOffsetl       = 0;
+  marpaEBNFp->startOffsetl         = 0;
+  marpaEBNFp->scannerLinel         = 1;
+  marpaEBNFp->scannerColumnl       = 1;
+  marpaEBNFp->spanArrayp           = NULL;
+  marpaEBNFp->spanl                = 0;
+  marpaEBNFp->spanAllocl           = 0;
+  marpaEBNFp->outputStackp         = NULL;
+  _marpaEBNF_arenaInitv(&(marpaEBNFp->arena), marpaEBNFp->marpaEBNFOption.genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator));
+  _marpaEBNF_astBuilderInitv(&(marpaEBNFp->astBuilder), &(marpaEBNFp->arena));
+  marpaEBNFp->astp                 = NULL;
+  marpaEBNFp->stringQuotec         = '\0';
+  marpaEBNFp->specialContextb      = 0;
+  marpaEBNFp->commentLevell        = 0;
+  marpaEBNFp->sequenceContextb     = 0;
+  marpaEBNFp->expectedCachep       = NULL;
+  memset(&(marpaEBNFp->stats), 0, sizeof(marpaEBNFStats_t));
+  marpaEBNFp->eventRingp           = NULL;
+  marpaEBNFp->pieceb               = 0;
+  memset(&(marpaEBNFp->editBuffer), 0, sizeof(marpaEBNFBuffer_t));
+  marpaEBNFp->editb                = 0;
+  marpaEBNFp->editContextp         = NULL;
+  marpaEBNFp->editRulep            = NULL;
+  marpaEBNFp->editRuleAllocl       = 0;
+  marpaEBNFp->editRuleb            = 0;
+  marpaEBNFp->diagnosticp          = NULL;
+  marpaEBNFp->diagnosticl          = 0;
+  marpaEBNFp->diagnosticAllocl     = 0;
+  marpaEBNFp->recoveringb          = 0;
+  marpaEBNFp->segmentTokenl        = 0;
+
+  return marpaEBNFp;
+}
+
+/****************************************************************************/
+short marpaEBNFGrammar_batchb(marpaEBNFGrammar_t *marpaEBNFGrammarp, marpaEBNFBatchItem_t *itemp, size_t iteml, size_t threadl, marpaEBNFBatchStats_t *marpaEBNFBatchStatsp)
+/****************************************************************************/
+/* The meta-grammar is shared by all the workers, that have nothing else in */
+/* common: no lock is taken per item, but the one of the pool itself.       */
+/****************************************************************************/
+{
+  genericLogger_t        *genericLoggerp;
+  marpaEBNFAllocator_t    marpaEBNFAllocator;
+  marpaEBNFBatch_t        marpaEBNFBatch;
+  marpaEBNFBatchWorker_t *marpaEBNFBatchWorkerp;
+  marpaEBNFBatchStats_t   marpaEBNFBatchStats;
+  size_t                  workeri;
+  size_t                  workerl = 0;
+  short                   rcb;
+
+  if ((marpaEBNFGrammarp == NULL) || ((itemp == NULL) && (iteml > 0))) {
     errno = EINVAL;
-    goto err;
+    return 0;
   }
 
-  /* An ISO EBNF grammar is always expressed in the 7-bit ASCII range; that is entirely */
-  /* covered by the basic C default character set. We just have to take care to always  */
-  /* compare with a char, not an integer value.                                         */
-  /* We assume a grammar always first in a single string within memory.                 */
-  grammarLengthl = strlen(grammars);
+  genericLoggerp = marpaEBNFGrammarp->marpaEBNFOption.genericLoggerp;
+  memset(&marpaEBNFBatchStats, 0, sizeof(marpaEBNFBatchStats_t));
+  marpaEBNFBatchStats.iteml = iteml;
+  marpaEBNFBatchStats.secondsd = _marpaEBNF_threadSecondsd();
 
-  /* Create input stack */
-  GENERICSTACK_NEW(marpaEBNFp->inputStackp);
-  if (GENERICSTACK_ERROR(marpaEBNFp->inputStackp)) {
-    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_NEW error, %s", strerror(errno));
-    goto err;
-  }
-  /* Marpa does not like the indice 0 with the input stack, it means an unvalued symbol */
-  GENERICSTACK_PUSH_NA(marpaEBNFp->inputStackp);
-  if (GENERICSTACK_ERROR(marpaEBNFp->inputStackp)) {
-    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_PUSH_NA error, %s", strerror(errno));
-    goto err;
+  /* Never more workers than items */
+  if (threadl <= 0) {
+    threadl = _marpaEBNF_threadCpul();
   }
-  /* Create output stack */
-  GENERICSTACK_NEW(marpaEBNFp->outputStackp);
-  if (GENERICSTACK_ERROR(marpaEBNFp->outputStackp)) {
-    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_NEW error, %s", strerror(errno));
-    goto err;
+  if (threadl > iteml) {
+    threadl = (iteml > 0) ? iteml : 1;
   }
 
-  /* Parse external grammar using internal grammar, supposed to fit entirely in memory */
-  marpaWrapperRecognizerOption.genericLoggerp    = marpaEBNFp->marpaEBNFOption.genericLoggerp;
-  marpaWrapperRecognizerOption.disableThresholdb = 0;
-
-  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaEBNFp->marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
-  if (marpaWrapperRecognizerp == NULL) {
+  _marpaEBNF_memoryInitv(&marpaEBNFAllocator, &(marpaEBNFGrammarp->marpaEBNFOption));
+  marpaEBNFBatch.itemp = itemp;
+  marpaEBNFBatch.workerp = (marpaEBNFBatchWorker_t *) _marpaEBNF_memoryMallocp(&marpaEBNFAllocator, threadl * sizeof(marpaEBNFBatchWorker_t));
+  if (marpaEBNFBatch.workerp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
     goto err;
   }
 
-  /* Loop until it is consumed or an error */
-  p = q = grammars;
-  c2 = p[0];         /* Ultimately, this will be '\0' */
-  maxp = p + grammarLengthl;
-  while (p <= maxp) {
-
-    /* Initialize alternatives stack */
-    GENERICSTACK_FREE(alternativeStackp);
-    GENERICSTACK_NEW_SIZED(alternativeStackp, marpaEBNFSymbolArraySizel);
-    if (GENERICSTACK_ERROR(alternativeStackp)) {
-      MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_NEW error, %s", strerror(errno));
+  for (workerl = 0; workerl < threadl; workerl++) {
+    marpaEBNFBatchWorkerp = &(marpaEBNFBatch.workerp[workerl]);
+    marpaEBNFBatchWorkerp->marpaEBNFp     = NULL;
+    marpaEBNFBatchWorkerp->itemp          = NULL;
+    marpaEBNFBatchWorkerp->diagnosticl    = 0;
+    marpaEBNFBatchWorkerp->okl            = 0;
+    marpaEBNFBatchWorkerp->bytel          = 0;
+    marpaEBNFBatchWorkerp->genericLoggerp = GENERICLOGGER_CUSTOM(_marpaEBNF_batchLoggerv, marpaEBNFBatchWorkerp, GENERICLOGGER_LOGLEVEL_WARNING);
+    if (marpaEBNFBatchWorkerp->genericLoggerp == NULL) {
+      MARPAEBNF_ERRORF(genericLoggerp, "Worker %ld: logger creation failure, %s", (long) workerl, strerror(errno));
       goto err;
     }
-
-    /* Lookup expected terminals */
-    if (marpaWrapperRecognizer_expectedb(marpaWrapperRecognizerp, &nSymboll, &expectedSymbolArrayp) == 0) {
+    marpaEBNFBatchWorkerp->marpaEBNFp = _marpaEBNF_contextNewp(marpaEBNFGrammarp, marpaEBNFBatchWorkerp->genericLoggerp);
+    if (marpaEBNFBatchWorkerp->marpaEBNFp == NULL) {
+      GENERICLOGGER_FREE(marpaEBNFBatchWorkerp->genericLoggerp);
       goto err;
     }
-
-    lengthl = 0;
-    if (nSymboll > 0) {
-
-      okb = 0;
-
-      if (p < maxp) {
-        c1 = c2;
-	c2 = *++q;
-
-	for (i = 0; i < nSymboll; i++) {
-	  symboli = expectedSymbolArrayp[i];
-	  marpaEBNFSymbolp = &(marpaEBNFp->symbolArrayp[symboli]);
-
-	  /* Lexing */
-	  switch (symboli) {
-	  case LETTER:
-	    okb = (((c1 >= 'a') && (c1 <= 'z')) || ((c1 >= 'A') && (c1 <= 'Z')));
-	    break;
-	  case DECIMAL_DIGIT:
-	    okb = ((c1 >= '0') && (c1 <= '9'));
-	    break;
-	  case CONCATENATE_SYMBOL:
-	    okb = (c1 == ',');
-	    break;
-	  case DEFINING_SYMBOL:
-	    okb = (c1 == '=');
-	    break;
-	  case DEFINITION_SEPARATOR_SYMBOL:
-	    okb = ((c1 == '|') || (c1 == '/') || (c1 == '!'));
-	    break;
-	  case END_COMMENT_SYMBOL:
-	    okb = ((c1 == '*') && (c2 == ')'));
-	    break;
-	  case END_GROUP_SYMBOL:
-	    okb = (c1 == ')');
-	    break;
-	  case _END_OPTION_SYMBOL_0:
-	    okb = (c1 == ']');
-	    break;
-	  case _END_OPTION_SYMBOL_1:
-	    okb = ((c1 == '/') && (c2 == ')'));
-	    break;
-	  case _END_REPEAT_SYMBOL_0:
-	    okb = (c1 == '}');
-	    break;
-	  case _END_REPEAT_SYMBOL_1:
-	    okb = ((c1 == ':') && (c2 == ')'));
-	    break;
-	  case EXCEPT_SYMBOL:
-	    okb = (c1 == '-');
-	    break;
-	  case FIRST_QUOTE_SYMBOL:
-	    okb = (c1 == '\'');
-	    break;
-	  case REPETITION_SYMBOL:
-	    okb = (c1 == '*');
-	    break;
-	  case SECOND_QUOTE_SYMBOL:
-	    okb = (c1 == '"');
-	    break;
-	  case SPECIAL_SEQUENCE_SYMBOL:
-	    okb = (c1 == '?');
-	    break;
-	  case START_COMMENT_SYMBOL:
-	    okb = ((c1 == '(') && (c2 == '*'));
-	    break;
-	  case START_GROUP_SYMBOL:
-	    okb = (c1 == '(');
-	    break;
-	  case _START_OPTION_SYMBOL_0:
-	    okb = (c1 == '[');
-	    break;
-	  case _START_OPTION_SYMBOL_1:
-	    okb = ((c1 == '(') && (c2 == '/'));
-	    break;
-	  case _START_REPEAT_SYMBOL_0:
-	    okb = (c1 == '{');
-	    break;
-	  case _START_REPEAT_SYMBOL_1:
-	    okb = ((c1 == '(') && (c2 == ':'));
-	    break;
-	  case TERMINATOR_SYMBOL:
-	    okb = (c1 == ';' || c1 == '.');
-	    break;
-	  case OTHER_CHARACTER:
-	    okb = ((c1 == ' ') || (c1 == ':') || (c1 == '+') || (c1 == '_') || (c1 == '%') || (c1 == '@')  ||
-		   (c1 == '&') || (c1 == '#') || (c1 == '$') || (c1 == '<') || (c1 == '>') || (c1 == '\\') ||
-		   (c1 == '^') || (c1 == '`') || (c1 == '~'));
-	    /*
-	      if (okb && (c1 == ' ') && (! marpaEBNFp->stringContextb)) {
-	        okb = 0;
-	      }
-	    */
-	    break;
-	  case SPACE_CHARACTER:
-	    okb = (c1 == ' ');
-	    break;
-	  case HORIZONTAL_TABULATION_CHARACTER:
-	    okb = (c1 == '\t');
-	    break;
-          case _CARRIAGE_RETURN:
-	    okb = (c1 == '\r');
-	    break;
-          case _LINE_FEED:
-	    if ((okb = (c1 == '\n'))) {
-	      ++linel;
-	      columnl = 1;
-	    }
-	    break;
-	    break;
-	  case VERTICAL_TABULATION_CHARACTER:
-	    okb = (c1 == '\v');
-	    break;
-	  case FORM_FEED:
-	    okb = (c1 == '\f');
-	    break;
-	  default:
-	    okb = 0;
-	    break;
-	  }
-
-	  if (okb) {
-	    /* Force lengthl for multiple-characters mapped to a single token */
-	    switch (symboli) {
-	    case START_COMMENT_SYMBOL:
-	    case END_COMMENT_SYMBOL:
-	    case _START_OPTION_SYMBOL_1:
-	    case _END_OPTION_SYMBOL_1:
-	    case _START_REPEAT_SYMBOL_1:
-	    case _END_REPEAT_SYMBOL_1:
-	      if (lengthl != 2) {
-		/* First time we hit a multiple-characters lexeme: re-initialize alternatives */
-		GENERICSTACK_FREE(alternativeStackp);
-		GENERICSTACK_NEW_SIZED(alternativeStackp, marpaEBNFSymbolArraySizel);
-		if (GENERICSTACK_ERROR(alternativeStackp)) {
-		  MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_NEW error, %s", strerror(errno));
-		  goto err;
-		}
-		lengthl = 2;
-	      } else if ((lengthl > 0) && (lengthl != 2)) {
-		/* Not the first time, and we are hitting a single-character lexeme: ignore it */
-		okb = 0;
-	      }
-	      break;
-	    default:
-	      if (lengthl > 0) {
-		/* This can happen only when lengthl is 2, and when current lexeme is a single character: ignored */
-		okb = 0;
-	      }
-	      break;
-	    }
-	  }
-
-	  if (okb) {
-	    MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%d/%d] %c%c %s", (int) (p - grammars), (int) (grammarLengthl - 1), (lengthl == 2) ? c1 : ' ', (lengthl == 2) ? c2 : c1, _marpaEBNF_symbolDescription(marpaEBNFp, symboli));
-            GENERICSTACK_PUSH_INT(alternativeStackp, symboli);
-            if (GENERICSTACK_ERROR(alternativeStackp)) {
-              MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_PUSH_INT error, %s", strerror(errno));
-              goto err;
-            }
-	    /* Force lengthl for multiple-characters mapped to a single token */
-	    switch (symboli) {
-	    case START_COMMENT_SYMBOL:
-	    case END_COMMENT_SYMBOL:
-	    case _START_OPTION_SYMBOL_1:
-	    case _END_OPTION_SYMBOL_1:
-	    case _START_REPEAT_SYMBOL_1:
-	    case _END_REPEAT_SYMBOL_1:
-	      lengthl = 2;
-	      break;
-	    default:
-	      break;
-	    }
-	  }
-	  
-	}
-      }
-
-      /* We micro-optimized by not coding lengthl = 1 */
-      if ((GENERICSTACK_USED(alternativeStackp) > 0) && (lengthl <= 0)) {
-	lengthl = 1;
-      }
-    }
-
-    if (lengthl > 0) {
-      int alternativei;
-#ifndef MARPAEBNF_NTRACE
-      int    nalternativei;
-#endif
-      int    valuei;
-      char  *tokens;
-
-      /* A token value is a copy of its corresponding string */
-      tokens = (char *) malloc(lengthl + 1);
-      if (tokens == NULL) {
-	MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "malloc error, %s", strerror(errno));
-	goto err;
-      }
-      strncpy(tokens, grammars + posi, lengthl);
-      tokens[lengthl] = '\0';
-      GENERICSTACK_PUSH_PTR(marpaEBNFp->inputStackp, tokens);
-      if (GENERICSTACK_ERROR(marpaEBNFp->inputStackp)) {
-        MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_PUSH_PTR error, %s", strerror(errno));
-        goto err;
-      }
-
-      /* Because we pushed a NULL as a first member of inputStack, valuei is always > 0 here: */
-      valuei = GENERICSTACK_USED(marpaEBNFp->inputStackp) - 1;
-#ifndef MARPAEBNF_NTRACE
-      nalternativei = 0;
-#endif
-      for (alternativei = 0; alternativei < GENERICSTACK_USED(alternativeStackp); alternativei++) {
-	symboli = GENERICSTACK_GET_INT(alternativeStackp, alternativei);
-        if (GENERICSTACK_ERROR(alternativeStackp)) {
-          MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_GET_INT error, %s", strerror(errno));
-          goto err;
-        }
-        /* If lengthl > 1, we know it can be only one specific lexeme */
-        if ((lengthl > 1)                       &&
-            (symboli != START_COMMENT_SYMBOL)   &&
-            (symboli != END_COMMENT_SYMBOL)     &&
-            (symboli != _START_OPTION_SYMBOL_1) &&
-            (symboli != _END_OPTION_SYMBOL_1)   &&
-            (symboli != _START_REPEAT_SYMBOL_1) &&
-            (symboli != _END_REPEAT_SYMBOL_1)) {
-          continue;
-        }
-	/* Manage string context */
-	switch (symboli) {
-	case FIRST_QUOTE_SYMBOL:
-	case SECOND_QUOTE_SYMBOL:
-	  marpaEBNFp->stringContextb = ~marpaEBNFp->stringContextb;
-          MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%d/%d] String context is %s",
-                           (int) (p - grammars),
-                           (int) (grammarLengthl - 1),
-                           marpaEBNFp->stringContextb ? "starting" : "ending");
-	  break;
-	default:
-	  break;
-	}
-
-	if (marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symboli, valuei, 1) == 0) {
-	  goto err;
-	}
-#ifndef MARPAEBNF_NTRACE
-	nalternativei++;
-#endif
-      }
-      if (marpaWrapperRecognizer_completeb(marpaWrapperRecognizerp) == 0) {
-	goto err;
-      }
-#ifndef MARPAEBNF_NTRACE
-      if (nalternativei > 1) {
-	MARPAEBNF_INFOF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "[%d/%d] %d alternatives",
-			(int) (p - grammars),
-			(int) (grammarLengthl - 1),
-			nalternativei);
-	for (alternativei = 0; alternativei < GENERICSTACK_USED(alternativeStackp); alternativei++) {
-	  symboli = GENERICSTACK_GET_INT(alternativeStackp, alternativei);
-	  if (GENERICSTACK_ERROR(alternativeStackp)) {
-	    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_GET_INT error, %s", strerror(errno));
-	    goto err;
-	  }
-	  /* If lengthl > 1, we know it can be only one specific lexeme */
-	  if ((lengthl > 1)                       &&
-	      (symboli != START_COMMENT_SYMBOL)   &&
-	      (symboli != END_COMMENT_SYMBOL)     &&
-	      (symboli != _START_OPTION_SYMBOL_1) &&
-	      (symboli != _END_OPTION_SYMBOL_1)   &&
-	      (symboli != _START_REPEAT_SYMBOL_1) &&
-	      (symboli != _END_REPEAT_SYMBOL_1)) {
-	    continue;
-	  }
-	  MARPAEBNF_INFOF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "  %s", _marpaEBNF_symbolDescription(marpaEBNFp, symboli));
-	}
-      }
-#endif
-    } else {
-      /* This is an error if we are not at the end of the grammar and this is not a "space" */
-      if (p < maxp) {
-        if (! isspace(c1)) {
-          MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "[%d/%d] Current character: 0x%02x '%c'%s is not recognized",
-                           (int) (p - grammars),
-                           (int) (grammarLengthl - 1),
-                           (int) c1,
-                           isprint((int) c1) ? c1 : ' ',
-                           isprint((int) c1) ? "" : " (non printable)");
-          goto err;
-        } else {
-          MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%d/%d] Discarded character: 0x%02x '%c'%s",
-                           (int) (p - grammars),
-                           (int) (grammarLengthl - 1),
-                           (int) c1, isprint((int) c1) ? c1 : ' ',
-                           isprint((int) c1) ? "" : " (non printable)");
-          lengthl = 1;
-        }
-      }
-    }
-
-    if (p < maxp) {
-      /* Resume */   
-      p += lengthl;
-      posi += lengthl;
-      q = p;
-      c2 = *p;
-    } else {
-      break;
-    }
   }
 
-  /* Traverse the ASF */
-  MARPAEBNF_TRACE(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "Building ASF");
-  marpaWrapperAsfOption.genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
-  marpaWrapperAsfOption.highRankOnlyb = 0;
-  marpaWrapperAsfOption.orderByRankb = 0;
-  marpaWrapperAsfOption.ambiguousb = 1;
-  marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
-  if (marpaWrapperAsfp == NULL) {
+  if (_marpaEBNF_poolRunb(genericLoggerp, &marpaEBNFAllocator, threadl, iteml, _marpaEBNF_batchItemb, &marpaEBNFBatch, &(marpaEBNFBatchStats.stolenl)) == 0) {
     goto err;
   }
 
-  /* Prune the ASF */
-  marpaEBNFp->stringContextb = 0;
-  marpaEBNFp->sequenceContextb = 0;
-  if (! marpaWrapperAsf_prunedValueb(marpaWrapperAsfp,
-				     marpaEBNFp,
-				     _marpaEBNF_okSymbolCallbackb,
-				     _marpaEBNF_okRuleCallbackb,
-				     _marpaEBNF_valueRuleCallback,
-				     _marpaEBNF_valueSymbolCallback,
-				     _marpaEBNF_valueNullingCallback)) {
-    goto err;
+  marpaEBNFBatchStats.threadl = threadl;
+  for (workeri = 0; workeri < threadl; workeri++) {
+    marpaEBNFBatchStats.okl   += marpaEBNFBatch.workerp[workeri].okl;
+    marpaEBNFBatchStats.bytel += marpaEBNFBatch.workerp[workeri].bytel;
+  }
+  marpaEBNFBatchStats.secondsd = _marpaEBNF_threadSecondsd() - marpaEBNFBatchStats.secondsd;
+  if (marpaEBNFBatchStatsp != NULL) {
+    *marpaEBNFBatchStatsp = marpaEBNFBatchStats;
   }
 
-  rci = 1;
+  rcb = 1;
   goto done;
 
  err:
-  rci = 0;
+  rcb = 0;
 
  done:
-  _marpaEBNF_inputStackFree(marpaEBNFp);
-  _marpaEBNF_outputStackFree(marpaEBNFp);
+  if (marpaEBNFBatch.workerp != NULL) {
+    for (workeri = 0; workeri < workerl; workeri++) {
+      marpaEBNF_freev(marpaEBNFBatch.workerp[workeri].marpaEBNFp);
+      GENERICLOGGER_FREE(marpaEBNFBatch.workerp[workeri].genericLoggerp);
+    }
+    _marpaEBNF_memoryFreev(&marpaEBNFAllocator, marpaEBNFBatch.workerp);
+  }
 
-  GENERICSTACK_FREE(alternativeStackp);
+  return rcb;
+}
 
-  if (marpaWrapperAsfp != NULL) {
-    /* Must be done before free on the recognizer */
-    marpaWrapperAsf_freev(marpaWrapperAsfp);
+/****************************************************************************/
+static short _marpaEBNF_batchItemb(void *userDatavp, size_t workeri, size_t itemi)
+/****************************************************************************/
+/* A grammar that does not parse is the result of its item, not a failure   */
+/* of the batch.                                                            */
+/****************************************************************************/
+{
+  marpaEBNFBatch_t       *marpaEBNFBatchp        = (marpaEBNFBatch_t *) userDatavp;
+  marpaEBNFBatchWorker_t *marpaEBNFBatchWorkerp = &(marpaEBNFBatchp->workerp[workeri]);
+  marpaEBNFBatchItem_t   *itemp                  = &(marpaEBNFBatchp->itemp[itemi]);
+
+  itemp->diagnostics[0] = '\0';
+  marpaEBNFBatchWorkerp->itemp       = itemp;
+  marpaEBNFBatchWorkerp->diagnosticl = 0;
+
+  if ((itemp->grammars == NULL) && (itemp->grammarl > 0)) {
+    MARPAEBNF_ERROR(marpaEBNFBatchWorkerp->genericLoggerp, "NULL grammar buffer with a non-zero length");
+    itemp->okb = 0;
+  } else {
+    itemp->okb = _marpaEBNF_grammarBufferb(marpaEBNFBatchWorkerp->marpaEBNFp, (itemp->grammars != NULL) ? itemp->grammars : "", itemp->grammarl);
   }
-  if (marpaWrapperRecognizerp != NULL) {
-    if (rci == 0) {
-      /* Log current state of the recognizer */
-      if (marpaEBNFp->marpaEBNFOption.genericLoggerp != NULL) {
-        marpaWrapperRecognizer_progressLogb(marpaWrapperRecognizerp, -1, -1, GENERICLOGGER_LOGLEVEL_ERROR, marpaEBNFp, _marpaEBNF_symbolDescription);
-      }
-    }
-    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+
+  if (itemp->okb) {
+    marpaEBNFBatchWorkerp->okl++;
   }
+  marpaEBNFBatchWorkerp->bytel += itemp->grammarl;
+  marpaEBNFBatchWorkerp->itemp  = NULL;
 
-  return rci;
+  return 1;
 }
 
 /****************************************************************************/
-void marpaEBNF_freev(marpaEBNF_t *marpaEBNFp)
+static void _marpaEBNF_batchLoggerv(void *userDatavp, genericLoggerLevel_t logLeveli, const char *msgs)
 /****************************************************************************/
 {
-  if (marpaEBNFp != NULL) {
-    if (marpaEBNFp->symbolArrayp != NULL) {
-      free(marpaEBNFp->symbolArrayp);
-    }
-    if (marpaEBNFp->ruleArrayp != NULL) {
-      free(marpaEBNFp->ruleArrayp);
-    }
-    if (marpaEBNFp->marpaWrapperGrammarp != NULL) {
-      marpaWrapperGrammar_freev(marpaEBNFp->marpaWrapperGrammarp);
-    }
-    if (marpaEBNFp->grammarp != NULL) {
-      marpaWrapperGrammar_freev(marpaEBNFp->grammarp);
-    }
-    free(marpaEBNFp);
+  marpaEBNFBatchWorker_t *marpaEBNFBatchWorkerp = (marpaEBNFBatchWorker_t *) userDatavp;
+  marpaEBNFBatchItem_t   *itemp                  = marpaEBNFBatchWorkerp->itemp;
+  size_t                  leftl;
+  size_t                  msgl;
+
+  /* Nothing is logged outside of an item but failures of the worker itself */
+  if ((itemp == NULL) || (msgs == NULL)) {
+    return;
   }
+
+  /* Room for the line, its newline and the NUL terminator */
+  leftl = MARPAEBNF_BATCH_DIAGNOSTICS_SIZE - marpaEBNFBatchWorkerp->diagnosticl;
+  if (leftl <= 2) {
+    return;
+  }
+  msgl = strlen(msgs);
+  if (msgl > leftl - 2) {
+    msgl = leftl - 2;
+  }
+  memcpy(itemp->diagnostics + marpaEBNFBatchWorkerp->diagnosticl, msgs, msgl);
+  marpaEBNFBatchWorkerp->diagnosticl += msgl;
+  itemp->diagnostics[marpaEBNFBatchWorkerp->diagnosticl++] = '\n';
+  itemp->diagnostics[marpaEBNFBatchWorkerp->diagnosticl]   = '\0';
 }
 
 /****************************************************************************/
-static inline short _marpaEBNF_internalGrammarb(marpaEBNF_t *marpaEBNFp)
+static void _marpaEBNF_editLoggerv(void *userDatavp, genericLoggerLevel_t logLeveli, const char *msgs)
 /****************************************************************************/
 {
-  int                   i;
-  marpaEBNFSymbolEnum_t symboli;
-  int                   rulei;
+  marpaEBNFEditLog_t *marpaEBNFEditLogp = (marpaEBNFEditLog_t *) userDatavp;
+  size_t              leftl;
+  size_t              msgl;
 
-  /* Declare all the symbols */
-  for (i = 0; i < MARPAEBNF_LENGTH_ARRAY(marpaEBNFSymbolArray); i++) {
-    symboli = marpaWrapperGrammar_newSymboli(marpaEBNFp->marpaWrapperGrammarp, NULL);
-    /* We take advantage of the fact that symbols always start at 0 with marpa */
-    if (symboli != i) {
-      MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "symboli is %d != %d", symboli, i);
-      goto err;
-    }
+  /* Errors make the edit fail: they are those of the whole grammar */
+  if ((logLeveli != GENERICLOGGER_LOGLEVEL_WARNING) || (msgs == NULL)) {
+    return;
   }
 
-  /* Declare all the rules */
-  for (i = 0; i < MARPAEBNF_LENGTH_ARRAY(marpaEBNFRuleArray); i++) {
-    rulei = marpaWrapperGrammar_newRulei(marpaEBNFp->marpaWrapperGrammarp,
-					 &(marpaEBNFRuleArray[i].option),
-					 marpaEBNFRuleArray[i].lhsSymboli,
-					 marpaEBNFRuleArray[i].rhsSymboll,
-					 marpaEBNFRuleArray[i].rhsSymbolip);
-    /* We take advantage of the fact that rules always start at 0 with marpa */
-    if (rulei != i) {
-      MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "rulei is %d != %d", rulei, i);
-      goto err;
-    }
+  /* Room for the line, its newline and the NUL terminator */
+  leftl = MARPAEBNF_EDIT_WARNINGS_SIZE - marpaEBNFEditLogp->warningl;
+  if (leftl <= 2) {
+    return;
   }
-
-  /* Precompute grammar */
-  if (marpaWrapperGrammar_precomputeb(marpaEBNFp->marpaWrapperGrammarp) == 0) {
-    goto err;
+  msgl = strlen(msgs);
+  if (msgl > leftl - 2) {
+    msgl = leftl - 2;
   }
-
-  return 1;
-
- err:
-  return 0;
+  memcpy(marpaEBNFEditLogp->warnings + marpaEBNFEditLogp->warningl, msgs, msgl);
+  marpaEBNFEditLogp->warningl += msgl;
+  marpaEBNFEditLogp->warnings[marpaEBNFEditLogp->warningl++] = '\n';
+  marpaEBNFEditLogp->warnings[marpaEBNFEditLogp->warningl]   = '\0';
 }
 
 /****************************************************************************/
-static inline char *_marpaEBNF_symbolDescription(void *userDatavp, int symboli)
+short marpaEBNF_grammarb(marpaEBNF_t *marpaEBNFp, char *grammars)
 /****************************************************************************/
 {
-  marpaEBNF_t *marpaEBNFp = (marpaEBNF_t *) userDatavp;
+  size_t grammarl;
+  short  rcb;
 
-  return marpaEBNFSymbolArray[symboli].descriptions;
+  if ((marpaEBNFp == NULL) || (grammars == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  grammarl = strlen(grammars);
+  rcb = _marpaEBNF_grammarBufferb(marpaEBNFp, grammars, grammarl);
+  _marpaEBNF_editKeepv(marpaEBNFp, grammars, grammarl);
+
+  return rcb;
 }
 
 /****************************************************************************/
-static inline void _marpaEBNF_inputStackFree(marpaEBNF_t *marpaEBNFp)
+short marpaEBNF_grammarBufferb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl)
+/****************************************************************************/
+/* No terminator is needed: a NUL byte is not a terminal character, and     */
+/* is reported as an error at its position like any other.                  */
 /****************************************************************************/
 {
-  int i;
-  
-  if (marpaEBNFp->inputStackp != NULL) {
-    for (i = 0; i < GENERICSTACK_USED(marpaEBNFp->inputStackp); i++) {
-      if (GENERICSTACK_IS_PTR(marpaEBNFp->inputStackp, i)) {
-	char *p = GENERICSTACK_GET_PTR(marpaEBNFp->inputStackp, i);
-	if (p != NULL) {
-	  free(p);
-	}
-      }
-    }
-    GENERICSTACK_FREE(marpaEBNFp->inputStackp);
+  short rcb;
+
+  if ((marpaEBNFp == NULL) || ((grammars == NULL) && (grammarl > 0))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (grammars == NULL) {
+    grammars = "";
   }
+  rcb = _marpaEBNF_grammarBufferb(marpaEBNFp, grammars, grammarl);
+  _marpaEBNF_editKeepv(marpaEBNFp, grammars, grammarl);
+
+  return rcb;
 }
 
 /****************************************************************************/
-static inline void _marpaEBNF_outputStackFree(marpaEBNF_t *marpaEBNFp)
+short marpaEBNF_grammarFileb(marpaEBNF_t *marpaEBNFp, char *filenames)
 /****************************************************************************/
 {
-  int i;
-  
-  if (marpaEBNFp->outputStackp != NULL) {
-    for (i = 0; i < GENERICSTACK_USED(marpaEBNFp->outputStackp); i++) {
-      if (GENERICSTACK_IS_PTR(marpaEBNFp->outputStackp, i)) {
-	marpaEBNFOutputStack_t *marpaEBNFOutputStackp = (marpaEBNFOutputStack_t *) GENERICSTACK_GET_PTR(marpaEBNFp->outputStackp, i);
-
-	if (marpaEBNFOutputStackp != NULL) {
-	  switch (marpaEBNFOutputStackp->type) {
-	  case MARPAEBNFOUTPUTSTACKTYPE_STRING:
-	    {
-	      char *p = (char *) marpaEBNFOutputStackp->p;
-	      if (p != NULL) {
-		free(p);
-	      }
-	    }
-	    break;
-	  default:
-	    MARPAEBNF_WARN(marpaEBNFp->marpaEBNFOption.genericLoggerp, "TO DO");
-	    break;
-	  }
-	  free(marpaEBNFOutputStackp);
-	}
-      }
+  marpaEBNFFile_t marpaEBNFFile;
+  short           rcb;
+
+  if ((marpaEBNFp == NULL) || (filenames == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (_marpaEBNF_fileOpenb(&marpaEBNFFile, marpaEBNFp->marpaEBNFOption.genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), filenames) == 0) {
+    return 0;
+  }
+  /* Parsed in place: the AST and the edit buffer keep their own copies, so the */
+  /* file is closed as soon as both are done.                                    */
+  rcb = _marpaEBNF_grammarBufferb(marpaEBNFp, marpaEBNFFile.inputs, marpaEBNFFile.inputl);
+  _marpaEBNF_editKeepv(marpaEBNFp, marpaEBNFFile.inputs, marpaEBNFFile.inputl);
+  _marpaEBNF_fileClosev(&marpaEBNFFile, &(marpaEBNFp->marpaEBNFAllocator));
+
+  return rcb;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_grammarBufferb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl)
+/****************************************************************************/
+{
+  unsigned char    keyp[MARPAEBNF_CACHE_KEY_SIZE];
+  short            cacheb;
+  marpaEBNFPiece_t marpaEBNFPiece;
+  short            rcb;
+
+  cacheb = _marpaEBNF_cacheKeyb(marpaEBNFp, grammars, grammarl, keyp);
+  if (cacheb && _marpaEBNF_cacheHitb(marpaEBNFp, keyp)) {
+    return 1;
+  }
+
+  marpaEBNFPiece.offsetl = 0;
+  marpaEBNFPiece.lengthl = grammarl;
+  marpaEBNFPiece.linel   = 1;
+  marpaEBNFPiece.columnl = 1;
+
+  rcb = _marpaEBNF_pieceb(marpaEBNFp, grammars, &marpaEBNFPiece);
+  if (rcb && cacheb) {
+    _marpaEBNF_cachePutv(marpaEBNFp->marpaEBNFOption.cachep, keyp, marpaEBNFp->astp);
+  }
+
+  return rcb;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_cacheKeyb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl, unsigned char *keyp)
+/****************************************************************************/
+/* False when the parse does not go through the cache: no cache, the       */
+/* character-level grammar that builds no AST, or a parse in progress that  */
+/* the parse itself reports.                                                */
+/****************************************************************************/
+{
+  if ((marpaEBNFp->marpaEBNFOption.cachep == NULL) || marpaEBNFp->marpaEBNFOption.scannerlessb || marpaEBNFp->parsingb || marpaEBNFp->pieceb) {
+    return 0;
+  }
+
+  _marpaEBNF_cacheKeyv(grammars, grammarl, marpaEBNFp->marpaEBNFOption.utf8b, keyp);
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_cacheHitb(marpaEBNF_t *marpaEBNFp, unsigned char *keyp)
+/****************************************************************************/
+/* On a hit the instance is as after a parse of the grammar: the AST is a   */
+/* copy of the cached one, and is compiled again. A failure to compile it   */
+/* is a miss: the grammar is then parsed.                                   */
+/****************************************************************************/
+{
+  const static char  funcs[] = "_marpaEBNF_cacheHitb";
+  genericLogger_t   *genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+  marpaEBNFAst_t    *marpaEBNFAstp;
+  double             startd;
+
+  marpaEBNFAstp = _marpaEBNF_cacheGetp(marpaEBNFp->marpaEBNFOption.cachep, keyp, genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator));
+  if (marpaEBNFAstp == NULL) {
+    return 0;
+  }
+
+  /* What a parse would reset */
+  _marpaEBNF_astFreev(marpaEBNFp->astp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->astp = marpaEBNFAstp;
+  _marpaEBNF_compiledFreev(marpaEBNFp->grammarp, &(marpaEBNFp->marpaEBNFAllocator));
+  _marpaEBNF_statsResetv(marpaEBNFp);
+  marpaEBNFp->diagnosticl = 0;
+
+  startd = _marpaEBNF_threadSecondsd();
+  marpaEBNFp->grammarp = _marpaEBNF_compileNewp(genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), &(marpaEBNFp->arena), marpaEBNFp->astp);
+  marpaEBNFp->stats.compileSecondsd = _marpaEBNF_threadSecondsd() - startd;
+  marpaEBNFp->stats.arenaSizel      = marpaEBNFp->arena.allocatedl;
+  _marpaEBNF_arenaResetv(&(marpaEBNFp->arena));
+  if (marpaEBNFp->grammarp == NULL) {
+    _marpaEBNF_astFreev(marpaEBNFp->astp, &(marpaEBNFp->marpaEBNFAllocator));
+    marpaEBNFp->astp = NULL;
+    return 0;
+  }
+
+  MARPAEBNF_TRACEF(genericLoggerp, funcs, "AST of %ld nodes from the cache", (long) marpaEBNFp->astp->nodel);
+  marpaEBNFp->stats.cacheHitl = 1;
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_pieceb(marpaEBNF_t *marpaEBNFp, char *grammars, marpaEBNFPiece_t *piecep)
+/****************************************************************************/
+/* Parses a piece of grammars, by default the whole of it: the readers      */
+/* start where the piece starts, and positions are those of grammars.       */
+/****************************************************************************/
+{
+  if (_marpaEBNF_beginb(marpaEBNFp, 0) == 0) {
+    return 0;
+  }
+
+  /* An ISO EBNF grammar is always expressed in the 7-bit ASCII range; that is entirely */
+  /* covered by the basic C default character set. We just have to take care to always  */
+  /* compare with a char, not an integer value.                                         */
+  /* The grammar is a single chunk that is also the last one: token values are views on */
+  /* it, nothing is copied.                                                             */
+  marpaEBNFp->inputs              = grammars;
+  marpaEBNFp->lexer.baseOffsetl   = piecep->offsetl;
+  marpaEBNFp->lexer.linel         = piecep->linel;
+  marpaEBNFp->lexer.columnl       = piecep->columnl;
+  marpaEBNFp->scannerOffsetl      = piecep->offsetl;
+  marpaEBNFp->startOffsetl        = piecep->offsetl;
+  marpaEBNFp->scannerLinel        = piecep->linel;
+  marpaEBNFp->scannerColumnl      = piecep->columnl;
+  if (_marpaEBNF_feedb(marpaEBNFp, grammars + piecep->offsetl, piecep->lengthl, 1) == 0) {
+    return 0;
+  }
+
+  return _marpaEBNF_endb(marpaEBNFp);
+}
+
+/****************************************************************************/
+short marpaEBNF_grammarParallelb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl, size_t threadl)
+/****************************************************************************/
+{
+  short rcb;
+
+  if ((marpaEBNFp == NULL) || ((grammars == NULL) && (grammarl > 0))) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (grammars == NULL) {
+    grammars = "";
+  }
+
+  rcb = _marpaEBNF_grammarParallelb(marpaEBNFp, grammars, grammarl, threadl);
+  _marpaEBNF_editKeepv(marpaEBNFp, grammars, grammarl);
+
+  return rcb;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_grammarParallelb(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl, size_t threadl)
+/****************************************************************************/
+/* The grammar is cut after syntax rules, and the pieces are parsed by as   */
+/* many contexts on the same grammar, on a work-stealing pool. Their ASTs   */
+/* are merged in source order, then compiled as one. With the character-    */
+/* level grammar, that builds no AST, the pieces are only validated.        */
+/****************************************************************************/
+{
+  const static char          funcs[] = "_marpaEBNF_grammarParallelb";
+  genericLogger_t           *genericLoggerp;
+  marpaEBNFParallel_t        marpaEBNFParallel;
+  marpaEBNFAst_t           **astpp;
+  marpaEBNF_t               *workerp;
+  size_t                     maxPiecel;
+  size_t                     piecel   = 0;
+  size_t                     workerl  = 0;
+  size_t                     i;
+  double                     startd;
+  unsigned char              keyp[MARPAEBNF_CACHE_KEY_SIZE];
+  short                      cacheb;
+  short                      rcb;
+
+  genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+  if (marpaEBNFp->parsingb) {
+    MARPAEBNF_ERROR(genericLoggerp, "A parse is already in progress");
+    errno = EINVAL;
+    return 0;
+  }
+
+  /* Small grammars are not worth it */
+  if (threadl <= 0) {
+    threadl = _marpaEBNF_threadCpul();
+  }
+  maxPiecel = threadl * MARPAEBNF_PARALLEL_PIECES_PER_THREAD;
+  if (maxPiecel > grammarl / MARPAEBNF_SPLIT_MIN_SIZE) {
+    maxPiecel = grammarl / MARPAEBNF_SPLIT_MIN_SIZE;
+  }
+  /* Diagnostics are those of a single pass */
+  if ((threadl <= 1) || (maxPiecel <= 1) || marpaEBNFp->marpaEBNFOption.recoverb) {
+    return _marpaEBNF_grammarBufferb(marpaEBNFp, grammars, grammarl);
+  }
+  cacheb = _marpaEBNF_cacheKeyb(marpaEBNFp, grammars, grammarl, keyp);
+  if (cacheb && _marpaEBNF_cacheHitb(marpaEBNFp, keyp)) {
+    return 1;
+  }
+
+  /* What a parse would reset */
+  _marpaEBNF_astFreev(marpaEBNFp->astp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->astp = NULL;
+  _marpaEBNF_compiledFreev(marpaEBNFp->grammarp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->grammarp = NULL;
+  _marpaEBNF_statsResetv(marpaEBNFp);
+
+  marpaEBNFParallel.grammars    = grammars;
+  marpaEBNFParallel.marpaEBNFpp = NULL;
+  marpaEBNFParallel.resultp     = NULL;
+  marpaEBNFParallel.piecep      = (marpaEBNFPiece_t *) _marpaEBNF_memoryMallocp(&(marpaEBNFp->marpaEBNFAllocator), maxPiecel * sizeof(marpaEBNFPiece_t));
+  if (marpaEBNFParallel.piecep == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    goto err;
+  }
+  piecel = _marpaEBNF_splitl(grammars, grammarl, marpaEBNFParallel.piecep, maxPiecel, marpaEBNFp->marpaEBNFOption.utf8b);
+  if (piecel <= 1) {
+    _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFParallel.piecep);
+    return _marpaEBNF_grammarBufferb(marpaEBNFp, grammars, grammarl);
+  }
+  if (_marpaEBNF_eventRingb(marpaEBNFp, 1) == 0) {
+    goto err;
+  }
+
+  marpaEBNFParallel.resultp = (marpaEBNFParallelResult_t *) _marpaEBNF_memoryMallocp(&(marpaEBNFp->marpaEBNFAllocator), piecel * sizeof(marpaEBNFParallelResult_t));
+  if (marpaEBNFParallel.resultp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    piecel = 0;
+    goto err;
+  }
+  for (i = 0; i < piecel; i++) {
+    marpaEBNFParallel.resultp[i].astp = NULL;
+  }
+
+  if (threadl > piecel) {
+    threadl = piecel;
+  }
+  marpaEBNFParallel.marpaEBNFpp = (marpaEBNF_t **) _marpaEBNF_memoryMallocp(&(marpaEBNFp->marpaEBNFAllocator), threadl * sizeof(marpaEBNF_t *));
+  if (marpaEBNFParallel.marpaEBNFpp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    goto err;
+  }
+  for (workerl = 0; workerl < threadl; workerl++) {
+    workerp = _marpaEBNF_contextNewp(marpaEBNFp->marpaEBNFGrammarp, genericLoggerp);
+    if (workerp == NULL) {
+      goto err;
+    }
+    workerp->pieceb = 1;
+    marpaEBNFParallel.marpaEBNFpp[workerl] = workerp;
+  }
+
+  MARPAEBNF_TRACEF(genericLoggerp, funcs, "%ld bytes in %ld pieces on %ld workers", (long) grammarl, (long) piecel, (long) threadl);
+  if (_marpaEBNF_poolRunb(genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), threadl, piecel, _marpaEBNF_parallelPieceb, &marpaEBNFParallel, NULL) == 0) {
+    goto err;
+  }
+
+  for (i = 0; i < piecel; i++) {
+    _marpaEBNF_statsAddv(&(marpaEBNFp->stats), &(marpaEBNFParallel.resultp[i].stats));
+  }
+
+  if (! marpaEBNFp->marpaEBNFOption.scannerlessb) {
+    /* The pointers to the ASTs, in order, are laid over the results */
+    astpp = (marpaEBNFAst_t **) _marpaEBNF_arenaAllocp(&(marpaEBNFp->arena), piecel * sizeof(marpaEBNFAst_t *));
+    if (astpp == NULL) {
+      goto err;
+    }
+    for (i = 0; i < piecel; i++) {
+      astpp[i] = marpaEBNFParallel.resultp[i].astp;
+    }
+    marpaEBNFp->astp = _marpaEBNF_astMergep(genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), astpp, piecel);
+    if (marpaEBNFp->astp == NULL) {
+      goto err;
+    }
+    startd = _marpaEBNF_threadSecondsd();
+    marpaEBNFp->grammarp = _marpaEBNF_compileNewp(genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), &(marpaEBNFp->arena), marpaEBNFp->astp);
+    marpaEBNFp->stats.compileSecondsd += _marpaEBNF_threadSecondsd() - startd;
+    if (marpaEBNFp->grammarp == NULL) {
+      goto err;
+    }
+    if (cacheb) {
+      _marpaEBNF_cachePutv(marpaEBNFp->marpaEBNFOption.cachep, keyp, marpaEBNFp->astp);
+    }
+  }
+
+  rcb = 1;
+  goto done;
+
+ err:
+  rcb = 0;
+  _marpaEBNF_astFreev(marpaEBNFp->astp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->astp = NULL;
+
+ done:
+  marpaEBNFp->stats.arenaSizel = marpaEBNFp->arena.allocatedl;
+  _marpaEBNF_arenaResetv(&(marpaEBNFp->arena));
+  /* The AST of a piece belongs to the allocator of its worker */
+  if (marpaEBNFParallel.resultp != NULL) {
+    for (i = 0; i < piecel; i++) {
+      if (marpaEBNFParallel.resultp[i].astp != NULL) {
+        _marpaEBNF_astFreev(marpaEBNFParallel.resultp[i].astp, &(marpaEBNFParallel.marpaEBNFpp[marpaEBNFParallel.resultp[i].workeri]->marpaEBNFAllocator));
+      }
+    }
+    _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFParallel.resultp);
+  }
+  if (marpaEBNFParallel.marpaEBNFpp != NULL) {
+    for (i = 0; i < workerl; i++) {
+      /* Events of the pieces are kept worker by worker */
+      if ((marpaEBNFp->eventRingp != NULL) && (marpaEBNFParallel.marpaEBNFpp[i]->eventRingp != NULL)) {
+        _marpaEBNF_eventAppendv(marpaEBNFp->eventRingp, marpaEBNFParallel.marpaEBNFpp[i]->eventRingp);
+      }
+      marpaEBNF_freev(marpaEBNFParallel.marpaEBNFpp[i]);
+    }
+    _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFParallel.marpaEBNFpp);
+  }
+  if (marpaEBNFParallel.piecep != NULL) {
+    _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFParallel.piecep);
+  }
+
+  return rcb;
+}
+
+/****************************************************************************/
+static short _marpaEBNF_parallelPieceb(void *userDatavp, size_t workeri, size_t itemi)
+/****************************************************************************/
+/* A piece that does not parse stops the others                             */
+/****************************************************************************/
+{
+  marpaEBNFParallel_t       *marpaEBNFParallelp = (marpaEBNFParallel_t *) userDatavp;
+  marpaEBNF_t               *marpaEBNFp         = marpaEBNFParallelp->marpaEBNFpp[workeri];
+  marpaEBNFParallelResult_t *resultp            = &(marpaEBNFParallelp->resultp[itemi]);
+
+  /* Valuation counters are per context: only this piece counts */
+  marpaEBNFp->stats.singleTreel = 0;
+  marpaEBNFp->stats.asfl        = 0;
+  if (_marpaEBNF_pieceb(marpaEBNFp, marpaEBNFParallelp->grammars, &(marpaEBNFParallelp->piecep[itemi])) == 0) {
+    return 0;
+  }
+
+  /* The AST moves to the result: the next piece of the worker would free it */
+  resultp->astp    = marpaEBNFp->astp;
+  resultp->workeri = workeri;
+  resultp->stats   = marpaEBNFp->stats;
+  marpaEBNFp->astp = NULL;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_editKeepv(marpaEBNF_t *marpaEBNFp, char *grammars, size_t grammarl)
+/****************************************************************************/
+/* Keeps the grammar of a parse of a whole buffer, whatever its outcome:    */
+/* edits start from it. A failure to copy it only forbids them.             */
+/****************************************************************************/
+{
+  char *bytes;
+
+  if ((marpaEBNFp == NULL) || marpaEBNFp->parsingb) {
+    return;
+  }
+  marpaEBNFp->editb     = 0;
+  marpaEBNFp->editRuleb = 0;
+  if (grammarl + 1 > marpaEBNFp->editBuffer.allocl) {
+    bytes = (char *) _marpaEBNF_memoryReallocp(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->editBuffer.bytes, grammarl + 1);
+    if (bytes == NULL) {
+      MARPAEBNF_WARNF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "realloc error, %s: the grammar cannot be edited", strerror(errno));
+      return;
+    }
+    marpaEBNFp->editBuffer.bytes  = bytes;
+    marpaEBNFp->editBuffer.allocl = grammarl + 1;
+  }
+  if (grammarl > 0) {
+    memcpy(marpaEBNFp->editBuffer.bytes, grammars, grammarl);
+  }
+  marpaEBNFp->editBuffer.bytes[grammarl] = '\0';
+  marpaEBNFp->editBuffer.bytel = grammarl;
+  marpaEBNFp->editb = 1;
+}
+
+/****************************************************************************/
+short marpaEBNF_editb(marpaEBNF_t *marpaEBNFp, size_t offsetl, size_t removedl, char *inserteds, size_t insertedl)
+/****************************************************************************/
+/* The syntax rules around the edit are parsed again, as a piece of the     */
+/* new grammar, and replace the old ones in the AST, in place: the rules    */
+/* after them only move, with their offsets moved by the change of length. */
+/* Anything else, a failure included, is a parse of the whole new grammar,  */
+/* that reports errors as usual.                                            */
+/****************************************************************************/
+{
+  const static char  funcs[] = "marpaEBNF_editb";
+  genericLogger_t   *genericLoggerp;
+  char              *bytes;
+  size_t             bytel;
+  size_t             firstRulel;
+  size_t             endRulel;
+  size_t             startl;
+  size_t             endl;
+  short              incrementalb;
+
+  if ((marpaEBNFp == NULL) || ((inserteds == NULL) && (insertedl > 0))) {
+    errno = EINVAL;
+    return 0;
+  }
+  genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+
+  if (marpaEBNFp->parsingb) {
+    MARPAEBNF_ERROR(genericLoggerp, "A parse is already in progress");
+    errno = EINVAL;
+    return 0;
+  }
+  if (! marpaEBNFp->editb) {
+    MARPAEBNF_ERROR(genericLoggerp, "No grammar to edit");
+    errno = EINVAL;
+    return 0;
+  }
+  if ((offsetl > marpaEBNFp->editBuffer.bytel) || (removedl > marpaEBNFp->editBuffer.bytel - offsetl)) {
+    MARPAEBNF_ERRORF(genericLoggerp, "Edit of %ld bytes at offset %ld is out of the %ld bytes of the grammar", (long) removedl, (long) offsetl, (long) marpaEBNFp->editBuffer.bytel);
+    errno = EINVAL;
+    return 0;
+  }
+
+  /* The region is in the coordinates of the old grammar */
+  incrementalb = _marpaEBNF_editRulesb(marpaEBNFp, offsetl, removedl, &firstRulel, &endRulel, &startl, &endl);
+
+  /* The edit itself, in place */
+  bytel = marpaEBNFp->editBuffer.bytel - removedl + insertedl;
+  if (bytel + 1 > marpaEBNFp->editBuffer.allocl) {
+    bytes = (char *) _marpaEBNF_memoryReallocp(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->editBuffer.bytes, bytel + 1);
+    if (bytes == NULL) {
+      MARPAEBNF_ERRORF(genericLoggerp, "realloc error, %s", strerror(errno));
+      return 0;
+    }
+    marpaEBNFp->editBuffer.bytes  = bytes;
+    marpaEBNFp->editBuffer.allocl = bytel + 1;
+  }
+  memmove(marpaEBNFp->editBuffer.bytes + offsetl + insertedl, marpaEBNFp->editBuffer.bytes + offsetl + removedl, marpaEBNFp->editBuffer.bytel - offsetl - removedl);
+  if (insertedl > 0) {
+    memcpy(marpaEBNFp->editBuffer.bytes + offsetl, inserteds, insertedl);
+  }
+  marpaEBNFp->editBuffer.bytes[bytel] = '\0';
+  marpaEBNFp->editBuffer.bytel = bytel;
+
+  if (incrementalb && _marpaEBNF_editPieceb(marpaEBNFp, firstRulel, endRulel, startl, endl + insertedl - removedl, insertedl - removedl)) {
+    MARPAEBNF_TRACEF(genericLoggerp, funcs, "Syntax rules %ld to %ld parsed again", (long) firstRulel, (long) endRulel - 1);
+    return 1;
+  }
+
+  MARPAEBNF_TRACE(genericLoggerp, funcs, "Whole grammar parsed again");
+  marpaEBNFp->editRuleb = 0;
+  return _marpaEBNF_grammarBufferb(marpaEBNFp, marpaEBNFp->editBuffer.bytes, marpaEBNFp->editBuffer.bytel);
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_editRulesb(marpaEBNF_t *marpaEBNFp, size_t offsetl, size_t removedl, size_t *firstRulelp, size_t *endRulelp, size_t *startlp, size_t *endlp)
+/****************************************************************************/
+/* Syntax rules firstRulel .. endRulel - 1 are those that the edit touches, */
+/* or the one next to it when it only touches a gap. The region goes from   */
+/* the end of the rule before them to the start of the rule after them: it  */
+/* starts after a terminator and ends before a meta identifier, where a     */
+/* grammar can be cut. False when there is no AST to edit, or no room for   */
+/* the positions of its rules.                                              */
+/****************************************************************************/
+{
+  marpaEBNFAst_t *marpaEBNFAstp = marpaEBNFp->astp;
+  size_t          firstChildl;
+  size_t          rulel;
+  size_t          lowl;
+  size_t          highl;
+  size_t          middlel;
+  size_t          firstRulel;
+  size_t          endRulel;
+
+  if (marpaEBNFp->marpaEBNFOption.scannerlessb || (marpaEBNFAstp == NULL) || (marpaEBNFAstp->nodel <= 0) || (marpaEBNFAstp->childlp[0] <= 0)) {
+    return 0;
+  }
+  if ((! marpaEBNFp->editRuleb) && (_marpaEBNF_editRuleInitb(marpaEBNFp) == 0)) {
+    return 0;
+  }
+  firstChildl = marpaEBNFAstp->firstChildlp[0];
+  rulel       = marpaEBNFAstp->childlp[0];
+
+  /* First rule that ends at or after the edit */
+  lowl  = 0;
+  highl = rulel;
+  while (lowl < highl) {
+    middlel = lowl + (highl - lowl) / 2;
+    if (marpaEBNFAstp->offsetlp[firstChildl + middlel] + marpaEBNFAstp->lengthlp[firstChildl + middlel] < offsetl) {
+      lowl = middlel + 1;
+    } else {
+      highl = middlel;
+    }
+  }
+  firstRulel = lowl;
+
+  /* First rule that starts after the edit */
+  highl = rulel;
+  while (lowl < highl) {
+    middlel = lowl + (highl - lowl) / 2;
+    if (marpaEBNFAstp->offsetlp[firstChildl + middlel] <= offsetl + removedl) {
+      lowl = middlel + 1;
+    } else {
+      highl = middlel;
+    }
+  }
+  endRulel = lowl;
+
+  if (firstRulel >= endRulel) {
+    if (firstRulel >= rulel) {
+      firstRulel = rulel - 1;
+    }
+    endRulel = firstRulel + 1;
+  }
+
+  *firstRulelp = firstRulel;
+  *endRulelp   = endRulel;
+  *startlp     = (firstRulel > 0) ? marpaEBNFAstp->offsetlp[firstChildl + firstRulel - 1] + marpaEBNFAstp->lengthlp[firstChildl + firstRulel - 1] : 0;
+  *endlp       = (endRulel < rulel) ? marpaEBNFAstp->offsetlp[firstChildl + endRulel] : marpaEBNFp->editBuffer.bytel;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_editPieceb(marpaEBNF_t *marpaEBNFp, size_t firstRulel, size_t endRulel, size_t startl, size_t endl, size_t deltal)
+/****************************************************************************/
+/* Parses startl .. endl - 1 of the new grammar with the context of edits,  */
+/* from the position of the end of the rule before, then replaces the old  */
+/* rules by its ones in the AST. The external grammar is compiled again    */
+/* from the whole AST, and precomputed as a whole: libmarpa has no other   */
+/* way. On failure the AST is left as it was, or freed once changed: the   */
+/* caller parses the whole grammar anyway.                                  */
+/****************************************************************************/
+{
+  genericLogger_t     *genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+  marpaEBNF_t         *editContextp;
+  marpaEBNFPiece_t     marpaEBNFPiece;
+  size_t               rulel = marpaEBNFp->astp->childlp[0];
+  marpaEBNFCompiled_t *grammarp;
+  genericLogger_t     *editLoggerp = NULL;
+  marpaEBNFEditLog_t   marpaEBNFEditLog;
+  char                *warnings;
+  char                *endWarnings;
+  char                *eols;
+  double               startd;
+  short                rcb;
+
+  if (marpaEBNFp->editContextp == NULL) {
+    /* Errors of a piece are those of the whole grammar, that reports them */
+    marpaEBNFp->editContextp = _marpaEBNF_contextNewp(marpaEBNFp->marpaEBNFGrammarp, NULL);
+    if (marpaEBNFp->editContextp == NULL) {
+      return 0;
+    }
+    marpaEBNFp->editContextp->pieceb = 1;
+    marpaEBNFp->editContextp->marpaEBNFOption.recoverb = 0;
+  }
+  editContextp = marpaEBNFp->editContextp;
+
+  /* The grammar before startl did not change */
+  if (firstRulel > 0) {
+    marpaEBNFPiece = marpaEBNFp->editRulep[firstRulel - 1].end;
+  } else {
+    marpaEBNFPiece.offsetl = 0;
+    marpaEBNFPiece.linel   = 1;
+    marpaEBNFPiece.columnl = 1;
+  }
+  marpaEBNFPiece.lengthl = endl - startl;
+
+  /* Valuation counters are per context: only this piece counts */
+  editContextp->stats.singleTreel = 0;
+  editContextp->stats.asfl        = 0;
+  if (_marpaEBNF_pieceb(editContextp, marpaEBNFp->editBuffer.bytes, &marpaEBNFPiece) == 0) {
+    return 0;
+  }
+
+  /* A failure is reported by the parse of the whole grammar that follows */
+  if (genericLoggerp != NULL) {
+    editLoggerp = GENERICLOGGER_CUSTOM(_marpaEBNF_editLoggerv, &marpaEBNFEditLog, GENERICLOGGER_LOGLEVEL_WARNING);
+    if (editLoggerp == NULL) {
+      MARPAEBNF_ERRORF(genericLoggerp, "Logger of an edit failure, %s", strerror(errno));
+      goto err;
+    }
+  }
+
+  if (_marpaEBNF_astSpliceb(genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), &(marpaEBNFp->astp), firstRulel, endRulel - firstRulel, editContextp->astp, deltal) == 0) {
+    goto err;
+  }
+
+  marpaEBNFEditLog.warningl = 0;
+  startd = _marpaEBNF_threadSecondsd();
+  grammarp = _marpaEBNF_compileNewp(editLoggerp, &(marpaEBNFp->marpaEBNFAllocator), &(marpaEBNFp->arena), marpaEBNFp->astp);
+  if (grammarp == NULL) {
+    _marpaEBNF_arenaResetv(&(marpaEBNFp->arena));
+    _marpaEBNF_astFreev(marpaEBNFp->astp, &(marpaEBNFp->marpaEBNFAllocator));
+    marpaEBNFp->astp      = NULL;
+    marpaEBNFp->editRuleb = 0;
+    goto err;
+  }
+  for (warnings = marpaEBNFEditLog.warnings, endWarnings = marpaEBNFEditLog.warnings + marpaEBNFEditLog.warningl; warnings < endWarnings; warnings = eols + 1) {
+    eols = strchr(warnings, '\n');
+    *eols = '\0';
+    MARPAEBNF_WARNF(genericLoggerp, "%s", warnings);
+  }
+  _marpaEBNF_editRuleSplicev(marpaEBNFp, firstRulel, endRulel - firstRulel, rulel, editContextp->astp, deltal);
+
+  /* What a parse would reset */
+  _marpaEBNF_compiledFreev(marpaEBNFp->grammarp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->grammarp = grammarp;
+  _marpaEBNF_statsResetv(marpaEBNFp);
+  _marpaEBNF_statsAddv(&(marpaEBNFp->stats), &(editContextp->stats));
+  marpaEBNFp->stats.compileSecondsd = _marpaEBNF_threadSecondsd() - startd;
+  marpaEBNFp->stats.arenaSizel      = marpaEBNFp->arena.allocatedl;
+  _marpaEBNF_arenaResetv(&(marpaEBNFp->arena));
+
+  rcb = 1;
+  goto done;
+
+ err:
+  rcb = 0;
+
+ done:
+  /* The AST of the piece belongs to the allocator of the context of edits */
+  _marpaEBNF_astFreev(editContextp->astp, &(editContextp->marpaEBNFAllocator));
+  editContextp->astp = NULL;
+  if (editLoggerp != NULL) {
+    GENERICLOGGER_FREE(editLoggerp);
+  }
+
+  return rcb;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_editRuleAllocb(marpaEBNF_t *marpaEBNFp, size_t rulel)
+/****************************************************************************/
+{
+  marpaEBNFEditRule_t *editRulep;
+  size_t               allocl;
+
+  if (rulel <= marpaEBNFp->editRuleAllocl) {
+    return 1;
+  }
+  allocl = rulel + rulel / 2;
+  editRulep = (marpaEBNFEditRule_t *) _marpaEBNF_memoryReallocp(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->editRulep, allocl * sizeof(marpaEBNFEditRule_t));
+  if (editRulep == NULL) {
+    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "realloc error, %s", strerror(errno));
+    return 0;
+  }
+  marpaEBNFp->editRulep      = editRulep;
+  marpaEBNFp->editRuleAllocl = allocl;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_editRuleInitb(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+/* Positions of all the syntax rules of the AST, counted once from the     */
+/* start of the grammar: the first edit after a parse pays for it.         */
+/****************************************************************************/
+{
+  marpaEBNFAst_t      *marpaEBNFAstp = marpaEBNFp->astp;
+  size_t               firstChildl   = marpaEBNFAstp->firstChildlp[0];
+  size_t               rulel         = marpaEBNFAstp->childlp[0];
+  marpaEBNFEditRule_t *editRulep;
+  marpaEBNFPiece_t     marpaEBNFPiece;
+  size_t               i;
+
+  if (_marpaEBNF_editRuleAllocb(marpaEBNFp, rulel) == 0) {
+    return 0;
+  }
+
+  marpaEBNFPiece.offsetl = 0;
+  marpaEBNFPiece.lengthl = 0;
+  marpaEBNFPiece.linel   = 1;
+  marpaEBNFPiece.columnl = 1;
+  for (i = 0; i < rulel; i++) {
+    editRulep = &(marpaEBNFp->editRulep[i]);
+    _marpaEBNF_splitPiecev(marpaEBNFp->editBuffer.bytes, &marpaEBNFPiece, &(editRulep->start), marpaEBNFAstp->offsetlp[firstChildl + i], marpaEBNFp->marpaEBNFOption.utf8b);
+    _marpaEBNF_splitPiecev(marpaEBNFp->editBuffer.bytes, &(editRulep->start), &(editRulep->end), marpaEBNFAstp->offsetlp[firstChildl + i] + marpaEBNFAstp->lengthlp[firstChildl + i], marpaEBNFp->marpaEBNFOption.utf8b);
+    editRulep->start.lengthl = marpaEBNFAstp->lengthlp[firstChildl + i];
+    editRulep->end.lengthl   = 0;
+    marpaEBNFPiece = editRulep->end;
+  }
+  marpaEBNFp->editRuleb = 1;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_editRuleSplicev(marpaEBNF_t *marpaEBNFp, size_t firstRulel, size_t rulel, size_t oldRulel, marpaEBNFAst_t *pieceAstp, size_t deltal)
+/****************************************************************************/
+/* Follows _marpaEBNF_astSpliceb(): the positions of the new rules are      */
+/* counted in their piece, those of the rules after them move by as many   */
+/* lines as the edit added, and by as many columns on the line where they  */
+/* start. A failure only means that the next edit counts them all again.   */
+/****************************************************************************/
+{
+  size_t               firstChildl = pieceAstp->firstChildlp[0];
+  size_t               pieceRulel  = pieceAstp->childlp[0];
+  size_t               afterRulel  = oldRulel - firstRulel - rulel;
+  marpaEBNFEditRule_t *editRulep;
+  marpaEBNFPiece_t     marpaEBNFPiece;
+  marpaEBNFPiece_t     oldAfter;
+  marpaEBNFPiece_t     newAfter;
+  marpaEBNFPiece_t    *piecep;
+  size_t               i;
+  int                  j;
+
+  if ((! marpaEBNFp->editRuleb) || (_marpaEBNF_editRuleAllocb(marpaEBNFp, firstRulel + pieceRulel + afterRulel) == 0)) {
+    marpaEBNFp->editRuleb = 0;
+    return;
+  }
+  if (afterRulel > 0) {
+    oldAfter = marpaEBNFp->editRulep[firstRulel + rulel].start;
+    memmove(marpaEBNFp->editRulep + firstRulel + pieceRulel, marpaEBNFp->editRulep + firstRulel + rulel, afterRulel * sizeof(marpaEBNFEditRule_t));
+  }
+
+  if (firstRulel > 0) {
+    marpaEBNFPiece = marpaEBNFp->editRulep[firstRulel - 1].end;
+  } else {
+    marpaEBNFPiece.offsetl = 0;
+    marpaEBNFPiece.lengthl = 0;
+    marpaEBNFPiece.linel   = 1;
+    marpaEBNFPiece.columnl = 1;
+  }
+  for (i = 0; i < pieceRulel; i++) {
+    editRulep = &(marpaEBNFp->editRulep[firstRulel + i]);
+    _marpaEBNF_splitPiecev(marpaEBNFp->editBuffer.bytes, &marpaEBNFPiece, &(editRulep->start), pieceAstp->offsetlp[firstChildl + i], marpaEBNFp->marpaEBNFOption.utf8b);
+    _marpaEBNF_splitPiecev(marpaEBNFp->editBuffer.bytes, &(editRulep->start), &(editRulep->end), pieceAstp->offsetlp[firstChildl + i] + pieceAstp->lengthlp[firstChildl + i], marpaEBNFp->marpaEBNFOption.utf8b);
+    editRulep->start.lengthl = pieceAstp->lengthlp[firstChildl + i];
+    editRulep->end.lengthl   = 0;
+    marpaEBNFPiece = editRulep->end;
+  }
+
+  if (afterRulel > 0) {
+    _marpaEBNF_splitPiecev(marpaEBNFp->editBuffer.bytes, &marpaEBNFPiece, &newAfter, oldAfter.offsetl + deltal, marpaEBNFp->marpaEBNFOption.utf8b);
+    for (i = firstRulel + pieceRulel; i < firstRulel + pieceRulel + afterRulel; i++) {
+      for (j = 0; j < 2; j++) {
+        piecep = (j == 0) ? &(marpaEBNFp->editRulep[i].start) : &(marpaEBNFp->editRulep[i].end);
+        if (piecep->linel == oldAfter.linel) {
+          piecep->columnl = piecep->columnl - oldAfter.columnl + newAfter.columnl;
+        }
+        piecep->linel    = piecep->linel - oldAfter.linel + newAfter.linel;
+        piecep->offsetl += deltal;
+      }
+    }
+  }
+}
+
+/****************************************************************************/
+short marpaEBNF_beginb(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+{
+  if (marpaEBNFp == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  return _marpaEBNF_beginb(marpaEBNFp, 1);
+}
+
+/****************************************************************************/
+short marpaEBNF_feedb(marpaEBNF_t *marpaEBNFp, char *chunks, size_t chunkl)
+/****************************************************************************/
+/* The chunk can be released as soon as this call returns: bytes that could */
+/* not be consumed, e.g. the beginning of a lexeme, are kept internally.    */
+/****************************************************************************/
+{
+  if ((marpaEBNFp == NULL) || ((chunks == NULL) && (chunkl > 0))) {
+    errno = EINVAL;
+    return 0;
+  }
+  if ((! marpaEBNFp->parsingb) || (! marpaEBNFp->streamingb)) {
+    MARPAEBNF_ERROR(marpaEBNFp->marpaEBNFOption.genericLoggerp, "No parse in progress, marpaEBNF_beginb() must be called first");
+    errno = EINVAL;
+    return 0;
+  }
+
+  return _marpaEBNF_feedb(marpaEBNFp, chunks, chunkl, 0);
+}
+
+/****************************************************************************/
+short marpaEBNF_endb(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+{
+  if (marpaEBNFp == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if ((! marpaEBNFp->parsingb) || (! marpaEBNFp->streamingb)) {
+    MARPAEBNF_ERROR(marpaEBNFp->marpaEBNFOption.genericLoggerp, "No parse in progress, marpaEBNF_beginb() must be called first");
+    errno = EINVAL;
+    return 0;
+  }
+
+  return _marpaEBNF_endb(marpaEBNFp);
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_beginb(marpaEBNF_t *marpaEBNFp, short streamingb)
+/****************************************************************************/
+{
+  if (marpaEBNFp->parsingb) {
+    MARPAEBNF_ERROR(marpaEBNFp->marpaEBNFOption.genericLoggerp, "A parse is already in progress");
+    errno = EINVAL;
+    return 0;
+  }
+
+  /* Initialize sensible data used by _marpaEBNF_parseFreev() */
+  marpaEBNFp->parsingb         = 1;
+  marpaEBNFp->streamingb       = streamingb;
+  if (streamingb) {
+    /* Its grammar is not kept: there is nothing to edit */
+    marpaEBNFp->editb          = 0;
+  }
+  marpaEBNFp->inputs           = NULL;
+  marpaEBNFp->spanl            = 0;
+  marpaEBNFp->outputStackp     = NULL;
+  marpaEBNFp->carryBuffer.bytel = 0;
+  marpaEBNFp->textBuffer.bytel  = 0;
+  marpaEBNFp->stringQuotec     = '\0';
+  marpaEBNFp->specialContextb  = 0;
+  marpaEBNFp->commentLevell    = 0;
+  marpaEBNFp->sequenceContextb = 0;
+  marpaEBNFp->scannerOffsetl   = 0;
+  marpaEBNFp->startOffsetl     = 0;
+  marpaEBNFp->scannerLinel     = 1;
+  marpaEBNFp->scannerColumnl   = 1;
+  marpaEBNFp->diagnosticl      = 0;
+  _marpaEBNF_lexerInitv(&(marpaEBNFp->lexer), marpaEBNFp->marpaEBNFOption.genericLoggerp, NULL, 0);
+  marpaEBNFp->lexer.utf8b      = marpaEBNFp->marpaEBNFOption.utf8b;
+  _marpaEBNF_astBuilderInitv(&(marpaEBNFp->astBuilder), &(marpaEBNFp->arena));
+  _marpaEBNF_astFreev(marpaEBNFp->astp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->astp             = NULL;
+  _marpaEBNF_compiledFreev(marpaEBNFp->grammarp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->grammarp         = NULL;
+  _marpaEBNF_statsResetv(marpaEBNFp);
+  /* The pieces of a parallel parse add up their events */
+  if (_marpaEBNF_eventRingb(marpaEBNFp, ! marpaEBNFp->pieceb) == 0) {
+    goto err;
+  }
+
+  /* Marpa does not like the indice 0 for a token value, it means an unvalued symbol */
+  if (_marpaEBNF_spanPushi(marpaEBNFp, NULL, 0, 0) < 0) {
+    goto err;
+  }
+  /* Create output stack */
+  GENERICSTACK_NEW(marpaEBNFp->outputStackp);
+  if (GENERICSTACK_ERROR(marpaEBNFp->outputStackp)) {
+    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_NEW error, %s", strerror(errno));
+    goto err;
+  }
+
+  /* The expected terminals cache is needed by the character-level reader only */
+  if (marpaEBNFp->marpaEBNFOption.scannerlessb && (marpaEBNFp->expectedCachep == NULL)) {
+    marpaEBNFp->expectedCachep = (marpaEBNFExpectedCache_t *) _marpaEBNF_memoryMallocp(&(marpaEBNFp->marpaEBNFAllocator), MARPAEBNF_EXPECTEDCACHE_SIZE * sizeof(marpaEBNFExpectedCache_t));
+    if (marpaEBNFp->expectedCachep == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "malloc error, %s", strerror(errno));
+      goto err;
+    }
+    memset(marpaEBNFp->expectedCachep, 0, MARPAEBNF_EXPECTEDCACHE_SIZE * sizeof(marpaEBNFExpectedCache_t));
+  }
+
+  /* The recognizer lives until _marpaEBNF_endb() */
+  if (_marpaEBNF_recognizerNewb(marpaEBNFp) == 0) {
+    goto err;
+  }
+
+  return 1;
+
+ err:
+  _marpaEBNF_parseFreev(marpaEBNFp, 0);
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_recognizerNewb(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+/* At the start of a parse, and after a syntax error with the recoverb      */
+/* option: the new recognizer goes on with the next syntax rule.            */
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t marpaWrapperRecognizerOption;
+
+  marpaWrapperRecognizerOption.genericLoggerp    = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+  marpaWrapperRecognizerOption.disableThresholdb = 0;
+
+  if (marpaEBNFp->marpaWrapperRecognizerp != NULL) {
+    _marpaEBNF_sharedRecognizerFreev(marpaEBNFp->marpaWrapperRecognizerp);
+  }
+  marpaEBNFp->marpaWrapperRecognizerp = _marpaEBNF_sharedRecognizerNewp(marpaEBNFp->marpaEBNFGrammarp->marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaEBNFp->marpaWrapperRecognizerp == NULL) {
+    return 0;
+  }
+
+  marpaEBNFp->recoveringb          = 0;
+  marpaEBNFp->segmentTokenl        = marpaEBNFp->stats.tokenl;
+  marpaEBNFp->lexer.genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_diagnosticb(marpaEBNF_t *marpaEBNFp, size_t offsetl, size_t lengthl, size_t linel, size_t columnl)
+/****************************************************************************/
+/* Appends a diagnostic, with the terminals that the recognizer expects     */
+/****************************************************************************/
+{
+  marpaEBNFDiagnostic_t *diagnosticp;
+  size_t                 allocl;
+  size_t                 nSymboll;
+  int                   *expectedSymbolArrayp;
+  size_t                 i;
+
+  if (marpaEBNFp->diagnosticl >= marpaEBNFp->diagnosticAllocl) {
+    allocl = (marpaEBNFp->diagnosticAllocl > 0) ? marpaEBNFp->diagnosticAllocl * 2 : 16;
+    diagnosticp = (marpaEBNFDiagnostic_t *) _marpaEBNF_memoryReallocp(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->diagnosticp, allocl * sizeof(marpaEBNFDiagnostic_t));
+    if (diagnosticp == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "realloc error, %s", strerror(errno));
+      return 0;
+    }
+    marpaEBNFp->diagnosticp      = diagnosticp;
+    marpaEBNFp->diagnosticAllocl = allocl;
+  }
+
+  diagnosticp = &(marpaEBNFp->diagnosticp[marpaEBNFp->diagnosticl++]);
+  diagnosticp->offsetl   = offsetl;
+  diagnosticp->lengthl   = lengthl;
+  diagnosticp->linel     = linel;
+  diagnosticp->columnl   = columnl;
+  diagnosticp->expectedl = 0;
+  if (marpaWrapperRecognizer_expectedb(marpaEBNFp->marpaWrapperRecognizerp, &nSymboll, &expectedSymbolArrayp) != 0) {
+    for (i = 0; (i < nSymboll) && (i < MARPAEBNF_DIAGNOSTIC_EXPECTED_SIZE); i++) {
+      diagnosticp->expectedsp[i] = marpaEBNFp->marpaEBNFOption.scannerlessb ? _marpaEBNF_symbolDescription(marpaEBNFp, expectedSymbolArrayp[i]) : _marpaEBNF_tokenSymbolDescription(marpaEBNFp, expectedSymbolArrayp[i]);
+    }
+    diagnosticp->expectedl = i;
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_tokenRecoverb(marpaEBNF_t *marpaEBNFp, marpaEBNFToken_t *marpaEBNFTokenp, size_t baseOffsetl)
+/****************************************************************************/
+/* The first error of a syntax rule is a diagnostic. Lexemes are then      */
+/* skipped silently up to the next terminator symbol.                       */
+/****************************************************************************/
+{
+  if (marpaEBNFp->recoveringb) {
+    return 1;
+  }
+  if (_marpaEBNF_diagnosticb(marpaEBNFp, baseOffsetl + marpaEBNFTokenp->offsetl, marpaEBNFTokenp->lengthl, marpaEBNFTokenp->linel, marpaEBNFTokenp->columnl) == 0) {
+    return 0;
+  }
+  marpaEBNFp->recoveringb          = 1;
+  marpaEBNFp->lexer.genericLoggerp = NULL;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_feedb(marpaEBNF_t *marpaEBNFp, char *inputs, size_t inputl, short eofb)
+/****************************************************************************/
+/* Reads as much as possible of the carried bytes followed by inputs. What  */
+/* cannot be decided yet, because it depends on bytes that are not there,   */
+/* becomes the new carry. When eofb is true everything is consumed.         */
+/****************************************************************************/
+{
+  marpaEBNFBuffer_t *carryBufferp = &(marpaEBNFp->carryBuffer);
+  double             startd       = _marpaEBNF_threadSecondsd();
+  char              *bufs;
+  size_t             bufl;
+  size_t             consumedl = 0;
+  short              rcb;
+
+  if (carryBufferp->bytel > 0) {
+    if (_marpaEBNF_bufferAppendb(marpaEBNFp, carryBufferp, inputs, inputl) == 0) {
+      goto err;
+    }
+    bufs = carryBufferp->bytes;
+    bufl = carryBufferp->bytel;
+  } else {
+    bufs = inputs;
+    bufl = inputl;
+  }
+
+  if (marpaEBNFp->marpaEBNFOption.scannerlessb) {
+    rcb = _marpaEBNF_scannerlessReadb(marpaEBNFp, bufs, bufl, eofb, &consumedl);
+  } else {
+    rcb = _marpaEBNF_tokenReadb(marpaEBNFp, bufs, bufl, eofb, &consumedl);
+  }
+  if (rcb == 0) {
+    goto err;
+  }
+
+  /* Keep what is left for the next chunk */
+  if (bufs == carryBufferp->bytes) {
+    if (consumedl > 0) {
+      memmove(carryBufferp->bytes, carryBufferp->bytes + consumedl, bufl - consumedl);
+    }
+    carryBufferp->bytel = bufl - consumedl;
+  } else if (_marpaEBNF_bufferAppendb(marpaEBNFp, carryBufferp, bufs + consumedl, bufl - consumedl) == 0) {
+    goto err;
+  }
+
+  marpaEBNFp->stats.recognizeSecondsd += _marpaEBNF_threadSecondsd() - startd;
+  return 1;
+
+ err:
+  marpaEBNFp->stats.recognizeSecondsd += _marpaEBNF_threadSecondsd() - startd;
+  _marpaEBNF_parseFreev(marpaEBNFp, 0);
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_endb(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+{
+  const static char          funcs[]            = "_marpaEBNF_endb";
+  marpaWrapperValue_t       *marpaWrapperValuep = NULL;
+  marpaWrapperValueOption_t  marpaWrapperValueOption;
+  marpaWrapperAsf_t         *marpaWrapperAsfp   = NULL;
+  marpaWrapperAsfOption_t    marpaWrapperAsfOption;
+  double                     startd;
+  short                      rcb;
+
+  /* The carry is now known to be the end of the input */
+  if (_marpaEBNF_feedb(marpaEBNFp, NULL, 0, 1) == 0) {
+    return 0;
+  }
+
+  /* After syntax errors the parse fails anyway: only the existence of a parse */
+  /* of the syntax rules after the last one is checked, to report a missing    */
+  /* end, and nothing is valued.                                               */
+  if ((marpaEBNFp->diagnosticl > 0) && (marpaEBNFp->recoveringb || (marpaEBNFp->stats.tokenl <= marpaEBNFp->segmentTokenl))) {
+    goto err;
+  }
+
+  startd = _marpaEBNF_threadSecondsd();
+
+  /* An unambiguous parse is valued as the single tree it is. The token-level  */
+  /* grammar has nothing to check on the way: an ambiguous parse, refused      */
+  /* silently here, is left to the ASF. The character-level grammar has        */
+  /* exceptions, that only the pruning of the ASF enforces.                    */
+  if (! marpaEBNFp->marpaEBNFOption.scannerlessb) {
+    marpaWrapperValueOption.genericLoggerp = NULL;
+    marpaWrapperValueOption.highRankOnlyb  = 0;
+    marpaWrapperValueOption.orderByRankb   = 0;
+    marpaWrapperValueOption.ambiguousb     = 0;
+    marpaWrapperValueOption.nullb          = 0;
+    marpaWrapperValuep = marpaWrapperValue_newp(marpaEBNFp->marpaWrapperRecognizerp, &marpaWrapperValueOption);
+  }
+
+  if (marpaWrapperValuep != NULL) {
+    marpaEBNFp->stats.asfSecondsd += _marpaEBNF_threadSecondsd() - startd;
+    startd = _marpaEBNF_threadSecondsd();
+    if (marpaEBNFp->diagnosticl > 0) {
+      goto err;
+    }
+    MARPAEBNF_TRACE(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "Valuing the single tree");
+    if (! marpaWrapperValue_valueb(marpaWrapperValuep,
+                                   marpaEBNFp,
+                                   _marpaEBNF_valueRuleCallback,
+                                   _marpaEBNF_valueSymbolCallback,
+                                   _marpaEBNF_valueNullingCallback)) {
+      goto err;
+    }
+    marpaEBNFp->stats.singleTreel++;
+  } else {
+    /* Traverse the ASF */
+    MARPAEBNF_TRACE(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "Building ASF");
+    marpaWrapperAsfOption.genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+    marpaWrapperAsfOption.highRankOnlyb = 0;
+    marpaWrapperAsfOption.orderByRankb = 0;
+    marpaWrapperAsfOption.ambiguousb = 1;
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaEBNFp->marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    marpaEBNFp->stats.asfSecondsd += _marpaEBNF_threadSecondsd() - startd;
+    startd = _marpaEBNF_threadSecondsd();
+    if (marpaWrapperAsfp == NULL) {
+      /* No parse: the grammar ends too early */
+      if (marpaEBNFp->marpaEBNFOption.recoverb) {
+        if (marpaEBNFp->marpaEBNFOption.scannerlessb) {
+          _marpaEBNF_diagnosticb(marpaEBNFp, marpaEBNFp->scannerOffsetl, 0, marpaEBNFp->scannerLinel, marpaEBNFp->scannerColumnl);
+        } else {
+          _marpaEBNF_diagnosticb(marpaEBNFp, marpaEBNFp->lexer.baseOffsetl + marpaEBNFp->lexer.offsetl, 0, marpaEBNFp->lexer.linel, marpaEBNFp->lexer.columnl);
+        }
+      }
+      goto err;
+    }
+    if (marpaEBNFp->diagnosticl > 0) {
+      goto err;
+    }
+
+    /* Prune the ASF */
+    marpaEBNFp->sequenceContextb = 0;
+    if (! marpaWrapperAsf_prunedValueb(marpaWrapperAsfp,
+                                       marpaEBNFp,
+                                       marpaEBNFp->marpaEBNFOption.scannerlessb ? _marpaEBNF_okSymbolCallbackb : _marpaEBNF_tokenOkSymbolCallbackb,
+                                       marpaEBNFp->marpaEBNFOption.scannerlessb ? _marpaEBNF_okRuleCallbackb : _marpaEBNF_tokenOkRuleCallbackb,
+                                       _marpaEBNF_valueRuleCallback,
+                                       _marpaEBNF_valueSymbolCallback,
+                                       _marpaEBNF_valueNullingCallback)) {
+      goto err;
+    }
+    marpaEBNFp->stats.asfl++;
+  }
+
+  /* The valuation left the root at the bottom of the stack */
+  if (! marpaEBNFp->marpaEBNFOption.scannerlessb) {
+    if ((GENERICSTACK_USED(marpaEBNFp->outputStackp) <= 0) || (! GENERICSTACK_IS_PTR(marpaEBNFp->outputStackp, 0))) {
+      MARPAEBNF_ERROR(marpaEBNFp->marpaEBNFOption.genericLoggerp, "Valuation did not produce an AST");
+      goto err;
+    }
+    marpaEBNFp->astp = _marpaEBNF_astNewp(&(marpaEBNFp->astBuilder), marpaEBNFp->marpaEBNFOption.genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), (marpaEBNFAstNode_t *) GENERICSTACK_GET_PTR(marpaEBNFp->outputStackp, 0));
+    if (marpaEBNFp->astp == NULL) {
+      goto err;
+    }
+    marpaEBNFp->stats.valueSecondsd += _marpaEBNF_threadSecondsd() - startd;
+    startd = _marpaEBNF_threadSecondsd();
+    /* Compile it before the arena is reset: the compiler uses it for its temporary data */
+    marpaEBNFp->grammarp = marpaEBNFp->pieceb ? NULL : _marpaEBNF_compileNewp(marpaEBNFp->marpaEBNFOption.genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), &(marpaEBNFp->arena), marpaEBNFp->astp);
+    marpaEBNFp->stats.compileSecondsd += _marpaEBNF_threadSecondsd() - startd;
+    if ((marpaEBNFp->grammarp == NULL) && (! marpaEBNFp->pieceb)) {
+      goto err;
+    }
+  } else {
+    marpaEBNFp->stats.valueSecondsd += _marpaEBNF_threadSecondsd() - startd;
+  }
+
+  rcb = 1;
+  goto done;
+
+ err:
+  rcb = 0;
+
+ done:
+  if (marpaWrapperValuep != NULL) {
+    /* Must be done before free on the recognizer, that releases the grammar */
+    marpaWrapperValue_freev(marpaWrapperValuep);
+  }
+  if (marpaWrapperAsfp != NULL) {
+    /* Must be done before free on the recognizer, that releases the grammar */
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  _marpaEBNF_parseFreev(marpaEBNFp, rcb);
+
+  return rcb;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_parseFreev(marpaEBNF_t *marpaEBNFp, short rcb)
+/****************************************************************************/
+/* Ends the current parse: on failure the state of the recognizer is logged */
+/****************************************************************************/
+{
+  const static char funcs[] = "_marpaEBNF_parseFreev";
+
+  MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "Expected terminals cache: %ld hits, %ld misses", (long) marpaEBNFp->stats.expectedCacheHitl, (long) marpaEBNFp->stats.expectedCacheMissl);
+  MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "Earley sets: %ld", (long) marpaEBNFp->stats.earleySetl);
+  MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "Characters: %ld scanned, %ld discarded; tokens: %ld, %ld alternatives, %ld ambiguous; ASF nodes visited: %ld; symbols rejected: %ld",
+                   (long) marpaEBNFp->stats.characterScannedl,
+                   (long) marpaEBNFp->stats.characterDiscardedl,
+                   (long) marpaEBNFp->stats.tokenl,
+                   (long) marpaEBNFp->stats.alternativel,
+                   (long) marpaEBNFp->stats.ambiguousPositionl,
+                   (long) marpaEBNFp->stats.asfNodeVisitedl,
+                   (long) marpaEBNFp->stats.symbolRejectedl);
+  marpaEBNFp->inputs = NULL;
+  _marpaEBNF_outputStackFree(marpaEBNFp);
+  marpaEBNFp->stats.arenaSizel = marpaEBNFp->arena.allocatedl;
+  _marpaEBNF_arenaResetv(&(marpaEBNFp->arena));
+
+  if (marpaEBNFp->marpaWrapperRecognizerp != NULL) {
+    if (rcb == 0) {
+      /* Log current state of the recognizer, that diagnostics replace */
+      if ((marpaEBNFp->marpaEBNFOption.genericLoggerp != NULL) && (marpaEBNFp->diagnosticl <= 0)) {
+        marpaWrapperRecognizer_progressLogb(marpaEBNFp->marpaWrapperRecognizerp, -1, -1, GENERICLOGGER_LOGLEVEL_ERROR, marpaEBNFp, marpaEBNFp->marpaEBNFOption.scannerlessb ? _marpaEBNF_symbolDescription : _marpaEBNF_tokenSymbolDescription);
+      }
+    }
+    _marpaEBNF_sharedRecognizerFreev(marpaEBNFp->marpaWrapperRecognizerp);
+    marpaEBNFp->marpaWrapperRecognizerp = NULL;
+  }
+
+  marpaEBNFp->carryBuffer.bytel = 0;
+  marpaEBNFp->parsingb          = 0;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_scannerlessReadb(marpaEBNF_t *marpaEBNFp, char *inputs, size_t inputl, short eofb, size_t *consumedlp)
+/****************************************************************************/
+/* Character-level reader: every character is a token of the internal       */
+/* grammar. Unless this is the end of the input, the last byte is left to   */
+/* the next chunk: it is the lookahead of a two-characters lexeme.          */
+/****************************************************************************/
+{
+  const static char             funcs[]                  = "_marpaEBNF_scannerlessReadb";
+  marpaWrapperRecognizer_t      *marpaWrapperRecognizerp = marpaEBNFp->marpaWrapperRecognizerp;
+  size_t                         baseOffsetl             = marpaEBNFp->scannerOffsetl;
+  size_t                         nSymboll;
+  int                           *expectedSymbolArrayp;
+  marpaEBNFSymbolSet_t           acceptedSymbolSet;
+  size_t                         wordi;
+  marpaEBNFSymbolSetWord_t       w;
+  int                            symboli;
+  marpaEBNFExpectedCache_t      *expectedCachep;
+  char                           c1;
+  char                           c2;
+  char                          *p;
+  char                          *maxp;
+  size_t                         lengthl;
+
+  p = inputs;
+  maxp = p + inputl;
+  while ((p < maxp) && (eofb || (p + 1 < maxp))) {
+
+    /* Lookup expected terminals */
+    if (marpaWrapperRecognizer_expectedb(marpaWrapperRecognizerp, &nSymboll, &expectedSymbolArrayp) == 0) {
+      goto err;
+    }
+
+    c1 = p[0];
+    c2 = (p + 1 < maxp) ? p[1] : '\0';
+    lengthl = 0;
+    if (nSymboll > 0) {
+      /* Lexing: intersect the expected terminals with the ones that c1 (and c2) can start */
+      expectedCachep = _marpaEBNF_expectedCachep(marpaEBNFp, nSymboll, expectedSymbolArrayp);
+      lengthl = _marpaEBNF_byteClassLexl(marpaEBNFp->marpaEBNFGrammarp->byteClassp, &(expectedCachep->expectedSet), expectedCachep->pairb, (unsigned char) c1, (unsigned char) c2, &acceptedSymbolSet);
+      if (MARPAEBNF_SYMBOLSET_ISSET(&acceptedSymbolSet, _LINE_FEED)) {
+        marpaEBNFp->scannerLinel++;
+        marpaEBNFp->scannerColumnl = 0;
+      }
+      /* Only the alternative of the context is offered: a space is an other  */
+      /* character inside a terminal string, a special sequence or a comment, */
+      /* a gap separator elsewhere.                                            */
+      if (MARPAEBNF_SYMBOLSET_ISSET(&acceptedSymbolSet, OTHER_CHARACTER) && MARPAEBNF_SYMBOLSET_ISSET(&acceptedSymbolSet, SPACE_CHARACTER)) {
+        if ((marpaEBNFp->stringQuotec != '\0') || marpaEBNFp->specialContextb || (marpaEBNFp->commentLevell > 0)) {
+          MARPAEBNF_SYMBOLSET_CLR(&acceptedSymbolSet, SPACE_CHARACTER);
+          _marpaEBNF_eventPushv(marpaEBNFp->eventRingp, MARPAEBNF_EVENT_CONTEXT, SPACE_CHARACTER, -1, marpaEBNFp->scannerOffsetl);
+        } else {
+          MARPAEBNF_SYMBOLSET_CLR(&acceptedSymbolSet, OTHER_CHARACTER);
+          _marpaEBNF_eventPushv(marpaEBNFp->eventRingp, MARPAEBNF_EVENT_CONTEXT, OTHER_CHARACTER, -1, marpaEBNFp->scannerOffsetl);
+        }
+        marpaEBNFp->stats.symbolRejectedl++;
+      }
+    }
+
+    if (lengthl > 0) {
+      int    nalternativei;
+      int    valuei;
+
+      /* Because span 0 is reserved, valuei is always > 0 here: */
+      valuei = _marpaEBNF_spanPushi(marpaEBNFp, p, marpaEBNFp->scannerOffsetl, lengthl);
+      if (valuei < 0) {
+        goto err;
+      }
+      nalternativei = 0;
+      MARPAEBNF_SYMBOLSET_FOREACH(&acceptedSymbolSet, wordi, w, symboli) {
+	MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%ld/%ld] %c%c %s", (long) marpaEBNFp->scannerOffsetl, (long) (baseOffsetl + inputl), (lengthl == 2) ? c1 : ' ', (lengthl == 2) ? c2 : c1, _marpaEBNF_symbolDescription(marpaEBNFp, symboli));
+	if (marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symboli, valuei, 1) == 0) {
+	  goto err;
+	}
+	nalternativei++;
+      }
+      if (marpaWrapperRecognizer_completeb(marpaWrapperRecognizerp) == 0) {
+	goto err;
+      }
+      marpaEBNFp->stats.earleySetl++;
+      marpaEBNFp->stats.tokenl++;
+      marpaEBNFp->stats.alternativel += nalternativei;
+      if (nalternativei > 1) {
+        marpaEBNFp->stats.ambiguousPositionl++;
+	MARPAEBNF_SYMBOLSET_FOREACH(&acceptedSymbolSet, wordi, w, symboli) {
+          _marpaEBNF_eventPushv(marpaEBNFp->eventRingp, MARPAEBNF_EVENT_AMBIGUOUS, symboli, -1, marpaEBNFp->scannerOffsetl);
+	}
+      }
+      _marpaEBNF_scannerContextv(marpaEBNFp, &acceptedSymbolSet, c1);
+    } else {
+      /* This is an error if this is not a "space" */
+      if (! isspace((unsigned char) c1)) {
+        MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "[%ld/%ld] line %ld: Current character: 0x%02x '%c'%s is not recognized",
+                         (long) marpaEBNFp->scannerOffsetl,
+                         (long) (baseOffsetl + inputl),
+                         (long) marpaEBNFp->scannerLinel,
+                         (int) (unsigned char) c1,
+                         isprint((unsigned char) c1) ? c1 : ' ',
+                         isprint((unsigned char) c1) ? "" : " (non printable)");
+        /* Contexts are not known after an error: the parse stops there */
+        if (marpaEBNFp->marpaEBNFOption.recoverb) {
+          _marpaEBNF_diagnosticb(marpaEBNFp, marpaEBNFp->scannerOffsetl, 1, marpaEBNFp->scannerLinel, marpaEBNFp->scannerColumnl);
+        }
+        goto err;
+      } else {
+        MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%ld/%ld] Discarded character: 0x%02x '%c'%s",
+                         (long) marpaEBNFp->scannerOffsetl,
+                         (long) (baseOffsetl + inputl),
+                         (int) (unsigned char) c1, isprint((unsigned char) c1) ? c1 : ' ',
+                         isprint((unsigned char) c1) ? "" : " (non printable)");
+        marpaEBNFp->stats.characterDiscardedl++;
+        lengthl = 1;
+      }
+    }
+
+    /* Resume */
+    p += lengthl;
+    marpaEBNFp->scannerOffsetl += lengthl;
+    marpaEBNFp->scannerColumnl += lengthl;
+  }
+
+  marpaEBNFp->stats.characterScannedl += p - inputs;
+  *consumedlp = p - inputs;
+  return 1;
+
+ err:
+  return 0;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_scannerContextv(marpaEBNF_t *marpaEBNFp, marpaEBNFSymbolSet_t *acceptedSymbolSetp, char c)
+/****************************************************************************/
+/* Follows the lexeme just read. Inside a terminal string only the same     */
+/* quote matters, inside a special sequence only its end, elsewhere         */
+/* comments nest.                                                           */
+/****************************************************************************/
+{
+  const static char funcs[] = "_marpaEBNF_scannerContextv";
+
+  if (marpaEBNFp->stringQuotec != '\0') {
+    if (c == marpaEBNFp->stringQuotec) {
+      marpaEBNFp->stringQuotec = '\0';
+      MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%ld] String context is off", (long) marpaEBNFp->scannerOffsetl);
+    }
+  } else if (marpaEBNFp->specialContextb) {
+    if (MARPAEBNF_SYMBOLSET_ISSET(acceptedSymbolSetp, SPECIAL_SEQUENCE_SYMBOL)) {
+      marpaEBNFp->specialContextb = 0;
+      MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%ld] Special sequence context is off", (long) marpaEBNFp->scannerOffsetl);
+    }
+  } else if (MARPAEBNF_SYMBOLSET_ISSET(acceptedSymbolSetp, FIRST_QUOTE_SYMBOL) || MARPAEBNF_SYMBOLSET_ISSET(acceptedSymbolSetp, SECOND_QUOTE_SYMBOL)) {
+    marpaEBNFp->stringQuotec = c;
+    MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%ld] String context is on", (long) marpaEBNFp->scannerOffsetl);
+  } else if (MARPAEBNF_SYMBOLSET_ISSET(acceptedSymbolSetp, SPECIAL_SEQUENCE_SYMBOL)) {
+    marpaEBNFp->specialContextb = 1;
+    MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%ld] Special sequence context is on", (long) marpaEBNFp->scannerOffsetl);
+  } else if (MARPAEBNF_SYMBOLSET_ISSET(acceptedSymbolSetp, START_COMMENT_SYMBOL)) {
+    marpaEBNFp->commentLevell++;
+    MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%ld] Comment level is %ld", (long) marpaEBNFp->scannerOffsetl, (long) marpaEBNFp->commentLevell);
+  } else if (MARPAEBNF_SYMBOLSET_ISSET(acceptedSymbolSetp, END_COMMENT_SYMBOL) && (marpaEBNFp->commentLevell > 0)) {
+    marpaEBNFp->commentLevell--;
+    MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "[%ld] Comment level is %ld", (long) marpaEBNFp->scannerOffsetl, (long) marpaEBNFp->commentLevell);
+  }
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_tokenReadb(marpaEBNF_t *marpaEBNFp, char *inputs, size_t inputl, short eofb, size_t *consumedlp)
+/****************************************************************************/
+/* Token-level reader: lexemes are recognized by the tokenizer, gap         */
+/* separators and comments never reach the recognizer. A lexeme that may    */
+/* continue in the next chunk is left unconsumed.                           */
+/****************************************************************************/
+{
+  const static char         funcs[] = "_marpaEBNF_tokenReadb";
+  genericLogger_t          *genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp = marpaEBNFp->marpaWrapperRecognizerp;
+  marpaEBNFLexer_t         *marpaEBNFLexerp = &(marpaEBNFp->lexer);
+  marpaEBNFToken_t          marpaEBNFToken;
+  size_t                    baseOffsetl;
+  size_t                    nSymboll;
+  int                      *expectedSymbolArrayp;
+  size_t                    i;
+  int                       valuei;
+
+  _marpaEBNF_lexerChunkv(marpaEBNFLexerp, inputs, inputl, eofb);
+  baseOffsetl = marpaEBNFLexerp->baseOffsetl;
+
+  while (1) {
+    if (_marpaEBNF_lexerNextb(marpaEBNFLexerp, &marpaEBNFToken) == 0) {
+      if ((! marpaEBNFp->marpaEBNFOption.recoverb) || (_marpaEBNF_tokenRecoverb(marpaEBNFp, &marpaEBNFToken, baseOffsetl) == 0)) {
+        goto err;
+      }
+      _marpaEBNF_lexerSkipv(marpaEBNFLexerp, marpaEBNFToken.lengthl);
+      continue;
+    }
+    if ((marpaEBNFToken.symboli == MARPAEBNF_TOKEN_EOF) || (marpaEBNFToken.symboli == MARPAEBNF_TOKEN_MORE)) {
+      break;
+    }
+
+    /* Resynchronization: the next syntax rule starts after a terminator symbol */
+    if (marpaEBNFp->recoveringb) {
+      if (marpaEBNFToken.symboli == TOKEN_TERMINATOR_SYMBOL) {
+        if (_marpaEBNF_recognizerNewb(marpaEBNFp) == 0) {
+          goto err;
+        }
+        marpaWrapperRecognizerp = marpaEBNFp->marpaWrapperRecognizerp;
+      }
+      continue;
+    }
+
+    /* Lookup expected terminals: a lexeme that is not expected is a syntax error */
+    if (marpaWrapperRecognizer_expectedb(marpaWrapperRecognizerp, &nSymboll, &expectedSymbolArrayp) == 0) {
+      goto err;
+    }
+    for (i = 0; i < nSymboll; i++) {
+      if (expectedSymbolArrayp[i] == marpaEBNFToken.symboli) {
+        break;
+      }
+    }
+    if (i >= nSymboll) {
+      MARPAEBNF_ERRORF(genericLoggerp, "[%ld/%ld] line %ld column %ld: %s \"%.*s\" is not expected",
+                       (long) (baseOffsetl + marpaEBNFToken.offsetl),
+                       (long) (baseOffsetl + inputl),
+                       (long) marpaEBNFToken.linel,
+                       (long) marpaEBNFToken.columnl,
+                       _marpaEBNF_tokenSymbolDescription(marpaEBNFp, marpaEBNFToken.symboli),
+                       (int) marpaEBNFToken.lengthl,
+                       inputs + marpaEBNFToken.offsetl);
+      for (i = 0; i < nSymboll; i++) {
+        MARPAEBNF_ERRORF(genericLoggerp, "  Expected: %s", _marpaEBNF_tokenSymbolDescription(marpaEBNFp, expectedSymbolArrayp[i]));
+      }
+      if ((! marpaEBNFp->marpaEBNFOption.recoverb) || (_marpaEBNF_tokenRecoverb(marpaEBNFp, &marpaEBNFToken, baseOffsetl) == 0)) {
+        goto err;
+      }
+      /* An unexpected terminator symbol ends the syntax rule in error by itself */
+      if (marpaEBNFToken.symboli == TOKEN_TERMINATOR_SYMBOL) {
+        if (_marpaEBNF_recognizerNewb(marpaEBNFp) == 0) {
+          goto err;
+        }
+        marpaWrapperRecognizerp = marpaEBNFp->marpaWrapperRecognizerp;
+      }
+      continue;
+    }
+
+    /* Because span 0 is reserved, valuei is always > 0 here: */
+    valuei = _marpaEBNF_spanPushi(marpaEBNFp, inputs + marpaEBNFToken.offsetl, baseOffsetl + marpaEBNFToken.offsetl, marpaEBNFToken.lengthl);
+    if (valuei < 0) {
+      goto err;
+    }
+    MARPAEBNF_TRACEF(genericLoggerp, funcs, "[%ld/%ld] %s %.*s", (long) (baseOffsetl + marpaEBNFToken.offsetl), (long) (baseOffsetl + inputl), _marpaEBNF_tokenSymbolDescription(marpaEBNFp, marpaEBNFToken.symboli), (int) marpaEBNFToken.lengthl, inputs + marpaEBNFToken.offsetl);
+    if (marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, marpaEBNFToken.symboli, valuei, 1) == 0) {
+      goto err;
+    }
+    if (marpaWrapperRecognizer_completeb(marpaWrapperRecognizerp) == 0) {
+      goto err;
+    }
+    marpaEBNFp->stats.earleySetl++;
+    marpaEBNFp->stats.tokenl++;
+    marpaEBNFp->stats.alternativel++;
+  }
+
+  /* The lexer counts from the beginning of the grammar, not of the piece */
+  marpaEBNFp->stats.characterScannedl   = marpaEBNFLexerp->baseOffsetl + marpaEBNFLexerp->offsetl - marpaEBNFp->startOffsetl;
+  marpaEBNFp->stats.characterDiscardedl = marpaEBNFLexerp->discardedl;
+  *consumedlp = marpaEBNFLexerp->offsetl;
+  return 1;
+
+ err:
+  return 0;
+}
+
+/****************************************************************************/
+short marpaEBNF_parseb(marpaEBNF_t *marpaEBNFp, char *inputs, size_t inputl)
+/****************************************************************************/
+/* Recognizes inputs with the grammar compiled by the last successful parse */
+/* of a grammar. Every byte is a token; the compiled grammar is not         */
+/* modified, so that it serves any number of inputs.                        */
+/****************************************************************************/
+{
+  const static char              funcs[] = "marpaEBNF_parseb";
+  genericLogger_t               *genericLoggerp;
+  marpaEBNFCompiled_t           *grammarp;
+  marpaWrapperRecognizerOption_t marpaWrapperRecognizerOption;
+  marpaWrapperRecognizer_t      *marpaWrapperRecognizerp = NULL;
+  marpaWrapperValueOption_t      marpaWrapperValueOption;
+  marpaWrapperValue_t           *marpaWrapperValuep;
+  size_t                         nSymboll;
+  int                           *expectedSymbolArrayp;
+  size_t                         linel = 1;
+  size_t                         columnl = 1;
+  size_t                         i;
+  size_t                         j;
+  unsigned char                  c;
+  int                            symboli;
+  short                          rcb;
+
+  if ((marpaEBNFp == NULL) || ((inputs == NULL) && (inputl > 0))) {
+    errno = EINVAL;
+    return 0;
+  }
+  genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+  grammarp       = marpaEBNFp->grammarp;
+  if (grammarp == NULL) {
+    MARPAEBNF_ERROR(genericLoggerp, "No compiled grammar: the last grammar parse failed, was character-level, or never happened");
+    errno = EINVAL;
+    return 0;
+  }
+
+  marpaWrapperRecognizerOption.genericLoggerp    = genericLoggerp;
+  marpaWrapperRecognizerOption.disableThresholdb = 0;
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(grammarp->marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp == NULL) {
+    goto err;
+  }
+
+  for (i = 0; i < inputl; i++) {
+    c = (unsigned char) inputs[i];
+    symboli = grammarp->byteSymbolip[c];
+    /* Value 0 means an unvalued symbol: the value is the offset plus one */
+    if ((symboli < 0) || (marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symboli, (int) (i + 1), 1) == 0)) {
+      MARPAEBNF_ERRORF(genericLoggerp, "[%ld/%ld] line %ld column %ld: byte 0x%02x is not expected", (long) i, (long) inputl, (long) linel, (long) columnl, (unsigned int) c);
+      if (marpaWrapperRecognizer_expectedb(marpaWrapperRecognizerp, &nSymboll, &expectedSymbolArrayp) != 0) {
+        for (j = 0; j < nSymboll; j++) {
+          MARPAEBNF_ERRORF(genericLoggerp, "  Expected: %s", _marpaEBNF_compiledDescriptions(grammarp, expectedSymbolArrayp[j]));
+        }
+      }
+      goto err;
+    }
+    if (marpaWrapperRecognizer_completeb(marpaWrapperRecognizerp) == 0) {
+      goto err;
+    }
+    if (c == '\n') {
+      linel++;
+      columnl = 1;
+    } else {
+      columnl++;
+    }
+  }
+
+  /* There is a parse if and only if the start symbol spans the whole input */
+  marpaWrapperValueOption.genericLoggerp = genericLoggerp;
+  marpaWrapperValueOption.highRankOnlyb  = 0;
+  marpaWrapperValueOption.orderByRankb   = 0;
+  marpaWrapperValueOption.ambiguousb     = 1;
+  marpaWrapperValueOption.nullb          = 1;
+  marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &marpaWrapperValueOption);
+  if (marpaWrapperValuep == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "[%ld/%ld] line %ld column %ld: premature end of input", (long) inputl, (long) inputl, (long) linel, (long) columnl);
+    marpaWrapperRecognizer_progressLogb(marpaWrapperRecognizerp, -1, -1, GENERICLOGGER_LOGLEVEL_ERROR, marpaEBNFp, _marpaEBNF_grammarSymbolDescription);
+    goto err;
+  }
+  marpaWrapperValue_freev(marpaWrapperValuep);
+  MARPAEBNF_TRACEF(genericLoggerp, funcs, "%ld bytes recognized", (long) inputl);
+
+  rcb = 1;
+  goto done;
+
+ err:
+  rcb = 0;
+
+ done:
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+
+  return rcb;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_statsResetv(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+/* Statistics are those of the last parse, but the valuation counters      */
+/****************************************************************************/
+{
+  size_t singleTreel = marpaEBNFp->stats.singleTreel;
+  size_t asfl        = marpaEBNFp->stats.asfl;
+
+  memset(&(marpaEBNFp->stats), 0, sizeof(marpaEBNFStats_t));
+  marpaEBNFp->stats.singleTreel = singleTreel;
+  marpaEBNFp->stats.asfl        = asfl;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_statsAddv(marpaEBNFStats_t *marpaEBNFStatsp, marpaEBNFStats_t *pieceStatsp)
+/****************************************************************************/
+/* Parse counters of a piece, parsed by another context                     */
+/****************************************************************************/
+{
+  marpaEBNFStatsp->expectedCacheHitl   += pieceStatsp->expectedCacheHitl;
+  marpaEBNFStatsp->expectedCacheMissl  += pieceStatsp->expectedCacheMissl;
+  marpaEBNFStatsp->earleySetl          += pieceStatsp->earleySetl;
+  marpaEBNFStatsp->characterScannedl   += pieceStatsp->characterScannedl;
+  marpaEBNFStatsp->characterDiscardedl += pieceStatsp->characterDiscardedl;
+  marpaEBNFStatsp->tokenl              += pieceStatsp->tokenl;
+  marpaEBNFStatsp->alternativel        += pieceStatsp->alternativel;
+  marpaEBNFStatsp->ambiguousPositionl  += pieceStatsp->ambiguousPositionl;
+  marpaEBNFStatsp->asfNodeVisitedl     += pieceStatsp->asfNodeVisitedl;
+  marpaEBNFStatsp->symbolRejectedl     += pieceStatsp->symbolRejectedl;
+  marpaEBNFStatsp->singleTreel         += pieceStatsp->singleTreel;
+  marpaEBNFStatsp->asfl                += pieceStatsp->asfl;
+  marpaEBNFStatsp->recognizeSecondsd   += pieceStatsp->recognizeSecondsd;
+  marpaEBNFStatsp->asfSecondsd         += pieceStatsp->asfSecondsd;
+  marpaEBNFStatsp->valueSecondsd       += pieceStatsp->valueSecondsd;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_eventRingb(marpaEBNF_t *marpaEBNFp, short resetb)
+/****************************************************************************/
+/* Only the character-level grammar records events: its first parse         */
+/* allocates the ring, kept for the next parses like the expected cache.   */
+/****************************************************************************/
+{
+  if (! marpaEBNFp->marpaEBNFOption.scannerlessb) {
+    return 1;
+  }
+  if (marpaEBNFp->eventRingp == NULL) {
+    marpaEBNFp->eventRingp = (marpaEBNFEventRing_t *) _marpaEBNF_memoryMallocp(&(marpaEBNFp->marpaEBNFAllocator), sizeof(marpaEBNFEventRing_t));
+    if (marpaEBNFp->eventRingp == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "malloc error, %s", strerror(errno));
+      return 0;
+    }
+    resetb = 1;
+  }
+  if (resetb) {
+    _marpaEBNF_eventRingResetv(marpaEBNFp->eventRingp);
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+short marpaEBNF_generateb(marpaEBNF_t *marpaEBNFp, char *names, char *filenames)
+/****************************************************************************/
+{
+  if ((marpaEBNFp == NULL) || (names == NULL) || (filenames == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (marpaEBNFp->grammarp == NULL) {
+    MARPAEBNF_ERROR(marpaEBNFp->marpaEBNFOption.genericLoggerp, "No compiled grammar: the last grammar parse failed, was character-level, or never happened");
+    errno = EINVAL;
+    return 0;
+  }
+
+  return _marpaEBNF_generateb(marpaEBNFp->grammarp, marpaEBNFp->marpaEBNFOption.genericLoggerp, names, filenames);
+}
+
+/****************************************************************************/
+short marpaEBNF_generatedb(marpaEBNF_t *marpaEBNFp, const marpaEBNFGenerated_t *marpaEBNFGeneratedp)
+/****************************************************************************/
+/* The instance is as after a parse of the grammar, without an AST: there  */
+/* is nothing to edit nor to cache. Nothing changes on failure.             */
+/****************************************************************************/
+{
+  genericLogger_t     *genericLoggerp;
+  marpaEBNFCompiled_t *grammarp;
+  double               startd;
+
+  if ((marpaEBNFp == NULL) || (marpaEBNFGeneratedp == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+  genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
+  if (marpaEBNFp->parsingb) {
+    MARPAEBNF_ERROR(genericLoggerp, "A parse is already in progress");
+    errno = EINVAL;
+    return 0;
+  }
+
+  startd = _marpaEBNF_threadSecondsd();
+  grammarp = _marpaEBNF_compiledNewp(genericLoggerp, &(marpaEBNFp->marpaEBNFAllocator), marpaEBNFGeneratedp);
+  if (grammarp == NULL) {
+    return 0;
+  }
+
+  /* What a parse would reset */
+  _marpaEBNF_astFreev(marpaEBNFp->astp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->astp = NULL;
+  _marpaEBNF_compiledFreev(marpaEBNFp->grammarp, &(marpaEBNFp->marpaEBNFAllocator));
+  marpaEBNFp->grammarp    = grammarp;
+  marpaEBNFp->editb       = 0;
+  marpaEBNFp->diagnosticl = 0;
+  _marpaEBNF_statsResetv(marpaEBNFp);
+  marpaEBNFp->stats.compileSecondsd = _marpaEBNF_threadSecondsd() - startd;
+
+  return 1;
+}
+
+/****************************************************************************/
+short marpaEBNF_statsb(marpaEBNF_t *marpaEBNFp, marpaEBNFStats_t *marpaEBNFStatsp)
+/****************************************************************************/
+{
+  if ((marpaEBNFp == NULL) || (marpaEBNFStatsp == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  *marpaEBNFStatsp            = marpaEBNFp->stats;
+  marpaEBNFStatsp->eventLostl = (marpaEBNFp->eventRingp != NULL) ? marpaEBNFp->eventRingp->lostl : 0;
+  return 1;
+}
+
+/****************************************************************************/
+size_t marpaEBNF_diagnosticsl(marpaEBNF_t *marpaEBNFp, marpaEBNFDiagnostic_t **diagnosticpp)
+/****************************************************************************/
+{
+  if ((marpaEBNFp == NULL) || (diagnosticpp == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  *diagnosticpp = marpaEBNFp->diagnosticp;
+  return marpaEBNFp->diagnosticl;
+}
+
+/****************************************************************************/
+size_t marpaEBNF_eventsl(marpaEBNF_t *marpaEBNFp, marpaEBNFEvent_t *eventp, size_t eventl)
+/****************************************************************************/
+{
+  if ((marpaEBNFp == NULL) || ((eventp == NULL) && (eventl > 0))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (marpaEBNFp->eventRingp == NULL) {
+    return 0;
+  }
+
+  return _marpaEBNF_eventDrainl(marpaEBNFp->eventRingp, eventp, eventl);
+}
+
+/****************************************************************************/
+char *marpaEBNF_eventFormats(marpaEBNF_t *marpaEBNFp, marpaEBNFEvent_t *eventp, char *buffers, size_t bufferl)
+/****************************************************************************/
+/* Descriptions are looked up here only, never when the event is recorded   */
+/****************************************************************************/
+{
+  short            scannerlessb;
+  marpaEBNFRule_t *rulep;
+  size_t           rulel;
+  size_t           symboll;
+  char            *symbols;
+  char            *rules;
+  char             positions[32];
+  char             messages[320];
+  size_t           messagel;
+
+  if ((marpaEBNFp == NULL) || (eventp == NULL) || (buffers == NULL) || (bufferl <= 0)) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  scannerlessb = marpaEBNFp->marpaEBNFOption.scannerlessb;
+  rulep        = scannerlessb ? marpaEBNFRuleArray : marpaEBNFTokenRuleArray;
+  rulel        = scannerlessb ? MARPAEBNF_LENGTH_ARRAY(marpaEBNFRuleArray) : MARPAEBNF_LENGTH_ARRAY(marpaEBNFTokenRuleArray);
+  symboll      = scannerlessb ? MARPAEBNF_LENGTH_ARRAY(marpaEBNFSymbolArray) : MARPAEBNF_LENGTH_ARRAY(marpaEBNFTokenSymbolArray);
+
+  symbols = "?";
+  if ((eventp->symboli >= 0) && ((size_t) eventp->symboli < symboll)) {
+    symbols = scannerlessb ? _marpaEBNF_symbolDescription(marpaEBNFp, eventp->symboli) : _marpaEBNF_tokenSymbolDescription(marpaEBNFp, eventp->symboli);
+  }
+  rules = "?";
+  if ((eventp->rulei >= 0) && ((size_t) eventp->rulei < rulel)) {
+    rules = scannerlessb ? _marpaEBNF_symbolDescription(marpaEBNFp, rulep[eventp->rulei].lhsSymboli) : _marpaEBNF_tokenSymbolDescription(marpaEBNFp, rulep[eventp->rulei].lhsSymboli);
+  }
+  if (eventp->positionl == MARPAEBNF_EVENT_NO_POSITION) {
+    strcpy(positions, "?");
+  } else {
+    sprintf(positions, "%ld", (long) eventp->positionl);
+  }
+
+  /* Descriptions are short: their precision only bounds the local buffer */
+  switch (eventp->eventi) {
+  case MARPAEBNF_EVENT_EXCEPTION:
+    sprintf(messages, "[%s] Symbol %.100s: found as %.100s exception", positions, symbols, rules);
+    break;
+  case MARPAEBNF_EVENT_CONTEXT:
+    sprintf(messages, "[%s] Symbol %.100s: rejected by the scanner context", positions, symbols);
+    break;
+  case MARPAEBNF_EVENT_AMBIGUOUS:
+    sprintf(messages, "[%s] Symbol %.100s: one of several alternatives", positions, symbols);
+    break;
+  default:
+    sprintf(messages, "[%s] Unknown event %d", positions, eventp->eventi);
+    break;
+  }
+
+  messagel = strlen(messages);
+  if (messagel >= bufferl) {
+    messagel = bufferl - 1;
+  }
+  memcpy(buffers, messages, messagel);
+  buffers[messagel] = '\0';
+
+  return buffers;
+}
+
+/****************************************************************************/
+short marpaEBNF_memoryb(marpaEBNF_t *marpaEBNFp, marpaEBNFMemory_t *marpaEBNFMemoryp)
+/****************************************************************************/
+{
+  if ((marpaEBNFp == NULL) || (marpaEBNFMemoryp == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  *marpaEBNFMemoryp = marpaEBNFp->marpaEBNFAllocator.memory;
+  return 1;
+}
+
+/****************************************************************************/
+marpaEBNFAst_t *marpaEBNF_astp(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+{
+  if (marpaEBNFp == NULL) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  return marpaEBNFp->astp;
+}
+
+/****************************************************************************/
+void marpaEBNF_freev(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+{
+  marpaEBNFAllocator_t marpaEBNFAllocator;
+
+  if (marpaEBNFp != NULL) {
+    if (marpaEBNFp->parsingb) {
+      _marpaEBNF_parseFreev(marpaEBNFp, 1);
+    }
+    if (marpaEBNFp->spanArrayp != NULL) {
+      _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->spanArrayp);
+    }
+    if (marpaEBNFp->carryBuffer.bytes != NULL) {
+      _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->carryBuffer.bytes);
     }
+    if (marpaEBNFp->textBuffer.bytes != NULL) {
+      _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->textBuffer.bytes);
+    }
+    if (marpaEBNFp->editBuffer.bytes != NULL) {
+      _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->editBuffer.bytes);
+    }
+    if (marpaEBNFp->editContextp != NULL) {
+      marpaEBNF_freev(marpaEBNFp->editContextp);
+    }
+    if (marpaEBNFp->editRulep != NULL) {
+      _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->editRulep);
+    }
+    if (marpaEBNFp->diagnosticp != NULL) {
+      _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->diagnosticp);
+    }
+    _marpaEBNF_astFreev(marpaEBNFp->astp, &(marpaEBNFp->marpaEBNFAllocator));
+    _marpaEBNF_arenaFreev(&(marpaEBNFp->arena));
+    if (marpaEBNFp->expectedCachep != NULL) {
+      _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->expectedCachep);
+    }
+    if (marpaEBNFp->eventRingp != NULL) {
+      _marpaEBNF_memoryFreev(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->eventRingp);
+    }
+    _marpaEBNF_grammarReleasev(marpaEBNFp->marpaEBNFGrammarp);
+    _marpaEBNF_compiledFreev(marpaEBNFp->grammarp, &(marpaEBNFp->marpaEBNFAllocator));
+    /* The allocator must survive the instance */
+    marpaEBNFAllocator = marpaEBNFp->marpaEBNFAllocator;
+    _marpaEBNF_memoryFreev(&marpaEBNFAllocator, marpaEBNFp);
+  }
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_internalGrammarb(genericLogger_t *genericLoggerp, marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaEBNFSymbol_t *symbolArrayp, size_t nSymboll, marpaEBNFRuleTable_t *ruleTablep)
+/****************************************************************************/
+{
+  int i;
+  int symboli;
+  int rulei;
+
+  /* Declare all the symbols */
+  for (i = 0; i < (int) nSymboll; i++) {
+    symboli = marpaWrapperGrammar_newSymboli(marpaWrapperGrammarp, NULL);
+    /* We take advantage of the fact that symbols always start at 0 with marpa */
+    if (symboli != i) {
+      MARPAEBNF_ERRORF(genericLoggerp, "symboli is %d != %d", symboli, i);
+      goto err;
+    }
+  }
+
+  /* Declare all the rules */
+  for (i = 0; i < (int) ruleTablep->rulel; i++) {
+    rulei = marpaWrapperGrammar_newRulei(marpaWrapperGrammarp,
+					 &(ruleTablep->rulep[i].option),
+					 ruleTablep->rulep[i].lhsSymboli,
+					 ruleTablep->rulep[i].rhsSymboll,
+					 MARPAEBNF_RULE_RHSP(ruleTablep, i));
+    /* We take advantage of the fact that rules always start at 0 with marpa */
+    if (rulei != i) {
+      MARPAEBNF_ERRORF(genericLoggerp, "rulei is %d != %d", rulei, i);
+      goto err;
+    }
+  }
+
+  /* Precompute grammar */
+  if (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0) {
+    goto err;
+  }
+
+  return 1;
+
+ err:
+  return 0;
+}
+
+/****************************************************************************/
+static inline marpaWrapperGrammar_t *_marpaEBNF_sharedGrammarp(genericLogger_t *genericLoggerp, marpaEBNFSymbol_t *symbolArrayp, size_t nSymboll, marpaEBNFRuleTable_t *ruleTablep)
+/****************************************************************************/
+/* The grammar outlives the instance that builds it: it has no logger. The  */
+/* one of the instance only reports a failure.                              */
+/****************************************************************************/
+{
+  marpaWrapperGrammarOption_t marpaWrapperGrammarOption;
+  marpaWrapperGrammar_t      *marpaWrapperGrammarp;
+
+  marpaWrapperGrammarOption.genericLoggerp    = NULL;
+  marpaWrapperGrammarOption.warningIsErrorb   = 0;
+  marpaWrapperGrammarOption.warningIsIgnoredb = 0;
+  marpaWrapperGrammarOption.autorankb         = 0;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(&marpaWrapperGrammarOption);
+  if (marpaWrapperGrammarp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "marpaWrapperGrammar_newp failure, %s", strerror(errno));
+    return NULL;
+  }
+  if (_marpaEBNF_internalGrammarb(genericLoggerp, marpaWrapperGrammarp, symbolArrayp, nSymboll, ruleTablep) == 0) {
+    MARPAEBNF_ERROR(genericLoggerp, "Internal grammar failure");
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+    return NULL;
+  }
+
+  return marpaWrapperGrammarp;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_sharedAcquireb(marpaEBNFGrammar_t *marpaEBNFGrammarp)
+/****************************************************************************/
+{
+  genericLogger_t        *genericLoggerp = marpaEBNFGrammarp->marpaEBNFOption.genericLoggerp;
+  marpaWrapperGrammar_t **marpaWrapperGrammarpp;
+  short                   rcb            = 0;
+
+  MARPAEBNF_MUTEX_LOCK(&marpaEBNFSharedMutex);
+
+  if (! marpaEBNFShared.byteClassb) {
+    _marpaEBNF_byteClassInitv(&(marpaEBNFShared.byteClass));
+    marpaEBNFShared.byteClassb = 1;
+  }
+
+  if (! marpaEBNFShared.ruleTableb) {
+    if ((_marpaEBNF_ruleTableInitb(&marpaEBNFRuleTable) == 0) || (_marpaEBNF_ruleTableInitb(&marpaEBNFTokenRuleTable) == 0)) {
+      MARPAEBNF_ERROR(genericLoggerp, "Internal rule table is inconsistent");
+      goto done;
+    }
+    marpaEBNFShared.ruleTableb = 1;
+  }
+
+  /* Only the grammar of the selected mode is needed */
+  if (marpaEBNFGrammarp->marpaEBNFOption.scannerlessb) {
+    marpaWrapperGrammarpp = &(marpaEBNFShared.marpaWrapperGrammarp);
+    if (*marpaWrapperGrammarpp == NULL) {
+      *marpaWrapperGrammarpp = _marpaEBNF_sharedGrammarp(genericLoggerp,
+                                                         marpaEBNFSymbolArray,
+                                                         MARPAEBNF_LENGTH_ARRAY(marpaEBNFSymbolArray),
+                                                         &marpaEBNFRuleTable);
+    }
+  } else {
+    marpaWrapperGrammarpp = &(marpaEBNFShared.marpaWrapperTokenGrammarp);
+    if (*marpaWrapperGrammarpp == NULL) {
+      *marpaWrapperGrammarpp = _marpaEBNF_sharedGrammarp(genericLoggerp,
+                                                         marpaEBNFTokenSymbolArray,
+                                                         MARPAEBNF_LENGTH_ARRAY(marpaEBNFTokenSymbolArray),
+                                                         &marpaEBNFTokenRuleTable);
+    }
+  }
+  if (*marpaWrapperGrammarpp == NULL) {
+    goto done;
+  }
+
+  marpaEBNFGrammarp->marpaWrapperGrammarp = *marpaWrapperGrammarpp;
+  marpaEBNFGrammarp->byteClassp           = &(marpaEBNFShared.byteClass);
+  marpaEBNFShared.refcountl++;
+  rcb = 1;
+
+ done:
+  MARPAEBNF_MUTEX_UNLOCK(&marpaEBNFSharedMutex);
+  return rcb;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_sharedReleasev(marpaEBNFGrammar_t *marpaEBNFGrammarp)
+/****************************************************************************/
+{
+  if (marpaEBNFGrammarp->marpaWrapperGrammarp == NULL) {
+    return;
+  }
+
+  /* The internal grammars stay: the next instance reuses them */
+  MARPAEBNF_MUTEX_LOCK(&marpaEBNFSharedMutex);
+  marpaEBNFShared.refcountl--;
+  MARPAEBNF_MUTEX_UNLOCK(&marpaEBNFSharedMutex);
+
+  marpaEBNFGrammarp->marpaWrapperGrammarp = NULL;
+  marpaEBNFGrammarp->byteClassp           = NULL;
+}
+
+/****************************************************************************/
+static inline marpaWrapperRecognizer_t *_marpaEBNF_sharedRecognizerNewp(marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizerOption_t *marpaWrapperRecognizerOptionp)
+/****************************************************************************/
+/* The recognizer is the only object that references the shared grammar:   */
+/* the value and the ASF reference the recognizer of the context, that is   */
+/* freed after them. Only its creation and destruction hold the lock.       */
+/****************************************************************************/
+{
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp;
+
+  MARPAEBNF_MUTEX_LOCK(&marpaEBNFSharedMutex);
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, marpaWrapperRecognizerOptionp);
+  MARPAEBNF_MUTEX_UNLOCK(&marpaEBNFSharedMutex);
+
+  return marpaWrapperRecognizerp;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_sharedRecognizerFreev(marpaWrapperRecognizer_t *marpaWrapperRecognizerp)
+/****************************************************************************/
+{
+  MARPAEBNF_MUTEX_LOCK(&marpaEBNFSharedMutex);
+  marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  MARPAEBNF_MUTEX_UNLOCK(&marpaEBNFSharedMutex);
+}
+
+/****************************************************************************/
+void marpaEBNF_shutdownv(void)
+/****************************************************************************/
+/* Grammars still alive, e.g. in other threads, keep the internal ones      */
+/****************************************************************************/
+{
+  MARPAEBNF_MUTEX_LOCK(&marpaEBNFSharedMutex);
+  if (marpaEBNFShared.refcountl <= 0) {
+    if (marpaEBNFShared.marpaWrapperGrammarp != NULL) {
+      marpaWrapperGrammar_freev(marpaEBNFShared.marpaWrapperGrammarp);
+      marpaEBNFShared.marpaWrapperGrammarp = NULL;
+    }
+    if (marpaEBNFShared.marpaWrapperTokenGrammarp != NULL) {
+      marpaWrapperGrammar_freev(marpaEBNFShared.marpaWrapperTokenGrammarp);
+      marpaEBNFShared.marpaWrapperTokenGrammarp = NULL;
+    }
+  }
+  MARPAEBNF_MUTEX_UNLOCK(&marpaEBNFSharedMutex);
+}
+
+#if defined(__GNUC__)
+/****************************************************************************/
+__attribute__((destructor)) static void _marpaEBNF_sharedDestructorv(void)
+/****************************************************************************/
+/* Runs at exit and when the library is unloaded, unlike a handler given to */
+/* atexit() that would point into unmapped code.                            */
+/****************************************************************************/
+{
+  marpaEBNF_shutdownv();
+}
+#endif
+
+/****************************************************************************/
+static inline char *_marpaEBNF_symbolDescription(void *userDatavp, int symboli)
+/****************************************************************************/
+{
+  marpaEBNF_t *marpaEBNFp = (marpaEBNF_t *) userDatavp;
+
+  return marpaEBNFSymbolArray[symboli].descriptions;
+}
+
+/****************************************************************************/
+static inline char *_marpaEBNF_tokenSymbolDescription(void *userDatavp, int symboli)
+/****************************************************************************/
+{
+  return marpaEBNFTokenSymbolArray[symboli].descriptions;
+}
+
+/****************************************************************************/
+static inline char *_marpaEBNF_grammarSymbolDescription(void *userDatavp, int symboli)
+/****************************************************************************/
+{
+  marpaEBNF_t *marpaEBNFp = (marpaEBNF_t *) userDatavp;
+
+  return _marpaEBNF_compiledDescriptions(marpaEBNFp->grammarp, symboli);
+}
+
+/****************************************************************************/
+static inline marpaEBNFExpectedCache_t *_marpaEBNF_expectedCachep(marpaEBNF_t *marpaEBNFp, size_t nSymboll, int *expectedSymbolArrayp)
+/****************************************************************************/
+{
+  unsigned long             fingerprintl = 2166136261UL; /* FNV-1a */
+  marpaEBNFExpectedCache_t *expectedCachep;
+  size_t                    i;
+  size_t                    wordi;
+
+  for (i = 0; i < nSymboll; i++) {
+    fingerprintl = ((fingerprintl ^ (unsigned long) expectedSymbolArrayp[i]) * 16777619UL) & 0xFFFFFFFFUL;
+  }
+
+  expectedCachep = &(marpaEBNFp->expectedCachep[fingerprintl & (MARPAEBNF_EXPECTEDCACHE_SIZE - 1)]);
+  if ((expectedCachep->nSymboll == nSymboll)         &&
+      (expectedCachep->fingerprintl == fingerprintl) &&
+      (memcmp(expectedCachep->symbolip, expectedSymbolArrayp, nSymboll * sizeof(int)) == 0)) {
+    marpaEBNFp->stats.expectedCacheHitl++;
+    return expectedCachep;
+  }
+
+  marpaEBNFp->stats.expectedCacheMissl++;
+
+  MARPAEBNF_SYMBOLSET_ZERO(&(expectedCachep->expectedSet));
+  for (i = 0; i < nSymboll; i++) {
+    MARPAEBNF_SYMBOLSET_SET(&(expectedCachep->expectedSet), expectedSymbolArrayp[i]);
+  }
+  expectedCachep->pairb = 0;
+  for (wordi = 0; wordi < MARPAEBNF_SYMBOLSET_NWORD; wordi++) {
+    expectedCachep->expectedSet.wordp[wordi] &= marpaEBNFp->marpaEBNFGrammarp->byteClassp->lexemeSet.wordp[wordi];
+    if ((expectedCachep->expectedSet.wordp[wordi] & marpaEBNFp->marpaEBNFGrammarp->byteClassp->pairSet.wordp[wordi]) != 0) {
+      expectedCachep->pairb = 1;
+    }
+  }
+
+  /* Expected terminals are distinct terminals: nSymboll is always <= _MARPAEBNF_NSYMBOL */
+  if (nSymboll <= _MARPAEBNF_NSYMBOL) {
+    expectedCachep->fingerprintl = fingerprintl;
+    expectedCachep->nSymboll     = nSymboll;
+    memcpy(expectedCachep->symbolip, expectedSymbolArrayp, nSymboll * sizeof(int));
+  } else {
+    expectedCachep->nSymboll     = 0;
+  }
+
+  return expectedCachep;
+}
+
+/****************************************************************************/
+static inline int _marpaEBNF_spanPushi(marpaEBNF_t *marpaEBNFp, char *texts, size_t offsetl, size_t lengthl)
+/****************************************************************************/
+/* Appends a token value and returns its indice, -1 on failure. offsetl is  */
+/* the absolute offset of texts. When streaming, chunks do not outlive the  */
+/* call to marpaEBNF_feedb(): the text is copied.                           */
+/****************************************************************************/
+{
+  marpaEBNFSpan_t *spanArrayp;
+  size_t           spanAllocl;
+  size_t           textOffsetl;
+
+  if (marpaEBNFp->streamingb) {
+    textOffsetl = marpaEBNFp->textBuffer.bytel;
+    if (_marpaEBNF_bufferAppendb(marpaEBNFp, &(marpaEBNFp->textBuffer), texts, lengthl) == 0) {
+      return -1;
+    }
+  } else {
+    textOffsetl = offsetl;
+  }
+
+  if (marpaEBNFp->spanl >= marpaEBNFp->spanAllocl) {
+    spanAllocl = (marpaEBNFp->spanAllocl > 0) ? marpaEBNFp->spanAllocl * 2 : MARPAEBNF_SPAN_INITIAL_SIZE;
+    spanArrayp = (marpaEBNFSpan_t *) _marpaEBNF_memoryReallocp(&(marpaEBNFp->marpaEBNFAllocator), marpaEBNFp->spanArrayp, spanAllocl * sizeof(marpaEBNFSpan_t));
+    if (spanArrayp == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "realloc error, %s", strerror(errno));
+      return -1;
+    }
+    marpaEBNFp->spanArrayp = spanArrayp;
+    marpaEBNFp->spanAllocl = spanAllocl;
+  }
+
+  marpaEBNFp->spanArrayp[marpaEBNFp->spanl].offsetl = offsetl;
+  marpaEBNFp->spanArrayp[marpaEBNFp->spanl].lengthl = lengthl;
+  marpaEBNFp->spanArrayp[marpaEBNFp->spanl].textOffsetl = textOffsetl;
+
+  return (int) marpaEBNFp->spanl++;
+}
+
+/****************************************************************************/
+static inline char *_marpaEBNF_spanViews(marpaEBNF_t *marpaEBNFp, int valuei, size_t *lengthlp)
+/****************************************************************************/
+/* Returns a view, not NUL terminated, on the text of a token value         */
+/****************************************************************************/
+{
+  marpaEBNFSpan_t *spanp = &(marpaEBNFp->spanArrayp[valuei]);
+
+  *lengthlp = spanp->lengthl;
+  return (marpaEBNFp->streamingb ? marpaEBNFp->textBuffer.bytes : marpaEBNFp->inputs) + spanp->textOffsetl;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_bufferAppendb(marpaEBNF_t *marpaEBNFp, marpaEBNFBuffer_t *bufferp, char *bytes, size_t bytel)
+/****************************************************************************/
+{
+  char   *newbytes;
+  size_t  allocl;
+
+  if (bytel <= 0) {
+    return 1;
+  }
+
+  if (bufferp->bytel + bytel > bufferp->allocl) {
+    allocl = (bufferp->allocl > 0) ? bufferp->allocl : MARPAEBNF_BUFFER_INITIAL_SIZE;
+    while (allocl < bufferp->bytel + bytel) {
+      allocl *= 2;
+    }
+    newbytes = (char *) _marpaEBNF_memoryReallocp(&(marpaEBNFp->marpaEBNFAllocator), bufferp->bytes, allocl);
+    if (newbytes == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "realloc error, %s", strerror(errno));
+      return 0;
+    }
+    bufferp->bytes  = newbytes;
+    bufferp->allocl = allocl;
+  }
+
+  memcpy(bufferp->bytes + bufferp->bytel, bytes, bytel);
+  bufferp->bytel += bytel;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_outputStackSetb(marpaEBNF_t *marpaEBNFp, marpaEBNFAstNode_t *nodep, int resulti)
+/****************************************************************************/
+/* AST nodes live in the arena: they are released all at once at the end  */
+/* of the parse.                                                            */
+/****************************************************************************/
+{
+  if (nodep == NULL) {
+    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "AST node allocation error, %s", strerror(errno));
+    return 0;
+  }
+
+  GENERICSTACK_SET_PTR(marpaEBNFp->outputStackp, nodep, resulti);
+  if (GENERICSTACK_ERROR(marpaEBNFp->outputStackp)) {
+    MARPAEBNF_ERRORF(marpaEBNFp->marpaEBNFOption.genericLoggerp, "GENERICSTACK_SET_PTR error, %s", strerror(errno));
+    return 0;
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_outputStackFree(marpaEBNF_t *marpaEBNFp)
+/****************************************************************************/
+{
+  /* Items are in the arena */
+  if (marpaEBNFp->outputStackp != NULL) {
     GENERICSTACK_FREE(marpaEBNFp->outputStackp);
   }
 }
@@ -1192,10 +3490,11 @@ static inline short  _marpaEBNF_okRuleCallbackb(void *userDatavp, genericStack_t
   const static char  funcs[]          = "_marpaEBNF_okRuleCallbackb";
   marpaEBNF_t       *marpaEBNFp       = (marpaEBNF_t *) userDatavp;
   genericLogger_t   *genericLoggerp   = marpaEBNFp->marpaEBNFOption.genericLoggerp;
-  marpaEBNFRule_t   *rulep            = &(marpaEBNFp->ruleArrayp[rulei]);
+  marpaEBNFRule_t   *rulep            = &(marpaEBNFRuleArray[rulei]);
   char              *descriptions     = _marpaEBNF_symbolDescription(marpaEBNFp, rulep->lhsSymboli);
   short              rcb              = 1;
 
+  marpaEBNFp->stats.asfNodeVisitedl++;
   /* MARPAEBNF_TRACEF(genericLoggerp, funcs, "Rule %s: return %d", descriptions, (int) rcb); */
   return rcb;
 }
@@ -1211,12 +3510,12 @@ static inline short _marpaEBNF_okSymbolCallbackb(void *userDatavp, genericStack_
   genericLogger_t   *genericLoggerp;
   char              *descriptions;
   int                grandParentRulei;
-  marpaEBNFRule_t   *grandParentrulep;
-  char              *grandParentDescriptions;
-  int                i;
-  int                maxi;
+  size_t             positionl;
 
-  if (parentStackUsedl > 2) {
+  marpaEBNFp->stats.asfNodeVisitedl++;
+
+  /* Only a symbol that is an exception somewhere needs its grandparent rule */
+  if ((parentStackUsedl > 2) && MARPAEBNF_SYMBOLSET_ISSET(&(marpaEBNFRuleTable.exceptSet), symboli)) {
     grandParentRulei = GENERICSTACK_GET_INT(parentRuleiStackp, parentStackUsedl - 2);
     if (GENERICSTACK_ERROR(parentRuleiStackp)) {
       genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
@@ -1225,41 +3524,13 @@ static inline short _marpaEBNF_okSymbolCallbackb(void *userDatavp, genericStack_
       rcb = 0;
     } else {
       /* Is rulei an exception of grandParentRulei ? */
-      grandParentrulep = &(marpaEBNFp->ruleArrayp[grandParentRulei]);
-      maxi = (int) grandParentrulep->rhsExceptl;
-      for (i = 0; i < maxi; i++) {
-	if (grandParentrulep->rhsExceptp[i] == symboli) {
-	  genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
-	  descriptions = _marpaEBNF_symbolDescription(marpaEBNFp, symboli);
-	  grandParentDescriptions = _marpaEBNF_symbolDescription(marpaEBNFp, grandParentrulep->lhsSymboli);
-	  MARPAEBNF_INFOF(genericLoggerp, "Symbol %s: found as %s exception", _marpaEBNF_symbolDescription(marpaEBNFp, symboli), grandParentDescriptions);
-	  rcb = -1;
-	  break;
-	}
-      }
-    }
-  }
-
-  if (rcb == 1) {
-    /* Manage string context */
-    switch (symboli) {
-    case FIRST_QUOTE_SYMBOL:
-    case SECOND_QUOTE_SYMBOL:
-      marpaEBNFp->stringContextb = ~marpaEBNFp->stringContextb;
-      genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
-      descriptions = _marpaEBNF_symbolDescription(marpaEBNFp, symboli);
-      MARPAEBNF_INFOF(genericLoggerp, "Symbol %s: string context is %s", _marpaEBNF_symbolDescription(marpaEBNFp, symboli), marpaEBNFp->stringContextb ? "starting" : "ending");
-      break;
-    case OTHER_CHARACTER:
-      if (! marpaEBNFp->stringContextb) {
-	descriptions = _marpaEBNF_symbolDescription(marpaEBNFp, symboli);
-	genericLoggerp = marpaEBNFp->marpaEBNFOption.genericLoggerp;
-	MARPAEBNF_INFOF(genericLoggerp, "Symbol %s: rejected because not in string context", _marpaEBNF_symbolDescription(marpaEBNFp, symboli));
+      if (MARPAEBNF_SYMBOLSET_ISSET(&(marpaEBNFRuleTable.exceptSetp[grandParentRulei]), symboli)) {
+	/* A token symbol has its value as argument: its span gives the position */
+	positionl = ((argi > 0) && ((size_t) argi < marpaEBNFp->spanl)) ? marpaEBNFp->spanArrayp[argi].offsetl : MARPAEBNF_EVENT_NO_POSITION;
+	_marpaEBNF_eventPushv(marpaEBNFp->eventRingp, MARPAEBNF_EVENT_EXCEPTION, symboli, grandParentRulei, positionl);
+	marpaEBNFp->stats.symbolRejectedl++;
 	rcb = -1;
       }
-      break;
-    default:
-      break;
     }
   }
 
@@ -1271,22 +3542,173 @@ static inline short _marpaEBNF_okSymbolCallbackb(void *userDatavp, genericStack_
 }
 
 /****************************************************************************/
-static inline short  _marpaEBNF_valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+static inline short  _marpaEBNF_tokenOkRuleCallbackb(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei)
 /****************************************************************************/
 {
+  marpaEBNF_t *marpaEBNFp = (marpaEBNF_t *) userDatavp;
+
+  /* The token-level grammar has no exception to check at the lexeme level */
+  marpaEBNFp->stats.asfNodeVisitedl++;
   return 1;
 }
 
 /****************************************************************************/
-static inline short  _marpaEBNF_valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+static inline short _marpaEBNF_tokenOkSymbolCallbackb(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi)
 /****************************************************************************/
 {
+  marpaEBNF_t *marpaEBNFp = (marpaEBNF_t *) userDatavp;
+
+  /* String context and gap separators were already resolved by the tokenizer */
+  marpaEBNFp->stats.asfNodeVisitedl++;
   return 1;
 }
 
+/****************************************************************************/
+static inline short  _marpaEBNF_valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+/* Token-level grammar only: left recursions are flattened into one node,  */
+/* and terms, factors and primaries that add nothing are passed through.    */
+/****************************************************************************/
+{
+  marpaEBNF_t           *marpaEBNFp       = (marpaEBNF_t *) userDatavp;
+  marpaEBNFAstBuilder_t *astBuilderp      = &(marpaEBNFp->astBuilder);
+  genericStack_t        *outputStackp     = marpaEBNFp->outputStackp;
+  marpaEBNFRule_t       *rulep;
+  marpaEBNFAstNode_t    *nodep;
+  int                    kindi;
+  int                    argi;
+
+  if (marpaEBNFp->marpaEBNFOption.scannerlessb) {
+    return 1;
+  }
+
+  rulep = &(marpaEBNFTokenRuleArray[rulei]);
+  switch (rulep->lhsSymboli) {
+  case TOKEN_SYNTAX:
+    kindi = MARPAEBNF_AST_SYNTAX;
+    break;
+  case TOKEN_DEFINITIONS_LIST:
+    kindi = MARPAEBNF_AST_DEFINITIONS_LIST;
+    break;
+  case TOKEN_SINGLE_DEFINITION:
+    kindi = MARPAEBNF_AST_SINGLE_DEFINITION;
+    break;
+  case TOKEN_SYNTAX_RULE:
+    kindi = MARPAEBNF_AST_SYNTAX_RULE;
+    break;
+  case TOKEN_SYNTACTIC_TERM:
+    kindi = MARPAEBNF_AST_EXCEPTION;
+    break;
+  case TOKEN_SYNTACTIC_FACTOR:
+    kindi = MARPAEBNF_AST_REPETITION;
+    break;
+  case TOKEN_OPTIONAL_SEQUENCE:
+    kindi = MARPAEBNF_AST_OPTIONAL_SEQUENCE;
+    break;
+  case TOKEN_REPEATED_SEQUENCE:
+    kindi = MARPAEBNF_AST_REPEATED_SEQUENCE;
+    break;
+  case TOKEN_GROUPED_SEQUENCE:
+    kindi = MARPAEBNF_AST_GROUPED_SEQUENCE;
+    break;
+  case TOKEN_EMPTY_SEQUENCE:
+    kindi = MARPAEBNF_AST_EMPTY_SEQUENCE;
+    break;
+  default:
+    /* [:start:], syntactic exception and syntactic primary */
+    kindi = -1;
+    break;
+  }
+
+  /* Pass-through, also for the terms and factors that are just their primary */
+  if ((kindi < 0) || (((kindi == MARPAEBNF_AST_EXCEPTION) || (kindi == MARPAEBNF_AST_REPETITION)) && (rulep->rhsSymboll <= 1))) {
+    return _marpaEBNF_outputStackSetb(marpaEBNFp, (marpaEBNFAstNode_t *) GENERICSTACK_GET_PTR(outputStackp, arg0i), resulti);
+  }
+
+  if (((kindi == MARPAEBNF_AST_SYNTAX) || (kindi == MARPAEBNF_AST_DEFINITIONS_LIST) || (kindi == MARPAEBNF_AST_SINGLE_DEFINITION)) && (rulep->rhsSymboll > 1)) {
+    /* X = X, [separator], item: the list is the first argument */
+    nodep = (marpaEBNFAstNode_t *) GENERICSTACK_GET_PTR(outputStackp, arg0i);
+    arg0i++;
+  } else {
+    nodep = _marpaEBNF_astNodeNewp(astBuilderp, kindi);
+    if (nodep == NULL) {
+      return _marpaEBNF_outputStackSetb(marpaEBNFp, NULL, resulti);
+    }
+  }
+
+  /* Empty rule: argni is below arg0i */
+  for (argi = arg0i; argi <= argni; argi++) {
+    if (_marpaEBNF_astNodeAppendb(astBuilderp, nodep, (marpaEBNFAstNode_t *) GENERICSTACK_GET_PTR(outputStackp, argi)) == 0) {
+      return _marpaEBNF_outputStackSetb(marpaEBNFp, NULL, resulti);
+    }
+  }
+
+  return _marpaEBNF_outputStackSetb(marpaEBNFp, nodep, resulti);
+}
+
+/****************************************************************************/
+static inline short  _marpaEBNF_valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  const static char  funcs[]    = "_marpaEBNF_valueSymbolCallback";
+  marpaEBNF_t       *marpaEBNFp = (marpaEBNF_t *) userDatavp;
+  char              *views;
+  size_t             lengthl;
+  int                kindi;
+
+  views = _marpaEBNF_spanViews(marpaEBNFp, argi, &lengthl);
+  MARPAEBNF_TRACEF(marpaEBNFp->marpaEBNFOption.genericLoggerp, funcs, "Symbol %d: %.*s", symboli, (int) lengthl, views);
+
+  if (marpaEBNFp->marpaEBNFOption.scannerlessb) {
+    return 1;
+  }
+
+  switch (symboli) {
+  case TOKEN_META_IDENTIFIER:
+    kindi = MARPAEBNF_AST_META_IDENTIFIER;
+    break;
+  case TOKEN_INTEGER:
+    kindi = MARPAEBNF_AST_INTEGER;
+    break;
+  case TOKEN_TERMINAL_STRING:
+    kindi = MARPAEBNF_AST_TERMINAL_STRING;
+    break;
+  case TOKEN_SPECIAL_SEQUENCE:
+    kindi = MARPAEBNF_AST_SPECIAL_SEQUENCE;
+    break;
+  default:
+    kindi = MARPAEBNF_AST_PUNCTUATION;
+    break;
+  }
+
+  return _marpaEBNF_outputStackSetb(marpaEBNFp, _marpaEBNF_astLeafNewp(&(marpaEBNFp->astBuilder), kindi, marpaEBNFp->spanArrayp[argi].offsetl, views, lengthl), resulti);
+}
+
 /****************************************************************************/
 static inline short  _marpaEBNF_valueNullingCallback(void *userDatavp, int symboli, int resulti)
 /****************************************************************************/
+/* Nulled lists keep their shape: definitions list, single definition and  */
+/* empty sequence.                                                          */
+/****************************************************************************/
 {
-  return 1;
+  marpaEBNF_t           *marpaEBNFp  = (marpaEBNF_t *) userDatavp;
+  marpaEBNFAstBuilder_t *astBuilderp = &(marpaEBNFp->astBuilder);
+  marpaEBNFAstNode_t    *nodep;
+  marpaEBNFAstNode_t    *parentp;
+
+  if (marpaEBNFp->marpaEBNFOption.scannerlessb) {
+    return 1;
+  }
+
+  nodep = _marpaEBNF_astNodeNewp(astBuilderp, MARPAEBNF_AST_EMPTY_SEQUENCE);
+  if ((nodep != NULL) && ((symboli == TOKEN_SINGLE_DEFINITION) || (symboli == TOKEN_DEFINITIONS_LIST))) {
+    parentp = _marpaEBNF_astNodeNewp(astBuilderp, MARPAEBNF_AST_SINGLE_DEFINITION);
+    nodep = ((parentp != NULL) && _marpaEBNF_astNodeAppendb(astBuilderp, parentp, nodep)) ? parentp : NULL;
+  }
+  if ((nodep != NULL) && (symboli == TOKEN_DEFINITIONS_LIST)) {
+    parentp = _marpaEBNF_astNodeNewp(astBuilderp, MARPAEBNF_AST_DEFINITIONS_LIST);
+    nodep = ((parentp != NULL) && _marpaEBNF_astNodeAppendb(astBuilderp, parentp, nodep)) ? parentp : NULL;
+  }
+
+  return _marpaEBNF_outputStackSetb(marpaEBNFp, nodep, resulti);
 }
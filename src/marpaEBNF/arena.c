@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/arena.h"
+
+/* Every allocation is aligned on the strictest fundamental alignment */
+typedef union marpaEBNFArenaAlign {
+  long         l;
+  double       d;
+  long double  ld;
+  void        *p;
+  void       (*fp)(void);
+} marpaEBNFArenaAlign_t;
+
+#define MARPAEBNF_ARENA_ALIGN(x)   ((((x) + sizeof(marpaEBNFArenaAlign_t) - 1) / sizeof(marpaEBNFArenaAlign_t)) * sizeof(marpaEBNFArenaAlign_t))
+#define MARPAEBNF_ARENA_HEADER     MARPAEBNF_ARENA_ALIGN(sizeof(marpaEBNFArenaChunk_t))
+#define MARPAEBNF_ARENA_DATA(chunkp) (((char *) (chunkp)) + MARPAEBNF_ARENA_HEADER)
+
+/****************************************************************************/
+void _marpaEBNF_arenaInitv(marpaEBNFArena_t *marpaEBNFArenap, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp)
+/****************************************************************************/
+{
+  marpaEBNFArenap->genericLoggerp      = genericLoggerp;
+  marpaEBNFArenap->marpaEBNFAllocatorp = marpaEBNFAllocatorp;
+  marpaEBNFArenap->headp          = NULL;
+  marpaEBNFArenap->currentp       = NULL;
+  marpaEBNFArenap->usedl          = 0;
+  marpaEBNFArenap->allocatedl     = 0;
+}
+
+/****************************************************************************/
+void *_marpaEBNF_arenaAllocp(marpaEBNFArena_t *marpaEBNFArenap, size_t sizel)
+/****************************************************************************/
+{
+  marpaEBNFArenaChunk_t *chunkp;
+  size_t                 chunkSizel;
+  void                  *p;
+
+  sizel = MARPAEBNF_ARENA_ALIGN((sizel > 0) ? sizel : 1);
+
+  /* Fast path: room in the current chunk */
+  if ((marpaEBNFArenap->currentp != NULL) && (marpaEBNFArenap->usedl + sizel <= marpaEBNFArenap->currentp->sizel)) {
+    p = MARPAEBNF_ARENA_DATA(marpaEBNFArenap->currentp) + marpaEBNFArenap->usedl;
+    marpaEBNFArenap->usedl += sizel;
+    return p;
+  }
+
+  /* Next chunk kept from a previous parse */
+  chunkp = (marpaEBNFArenap->currentp != NULL) ? marpaEBNFArenap->currentp->nextp : marpaEBNFArenap->headp;
+  if ((chunkp == NULL) || (chunkp->sizel < sizel)) {
+    /* A new chunk is inserted after the current one: a too small kept chunk is not lost */
+    chunkSizel = (sizel > MARPAEBNF_ARENA_CHUNK_SIZE) ? sizel : MARPAEBNF_ARENA_CHUNK_SIZE;
+    chunkp = (marpaEBNFArenaChunk_t *) _marpaEBNF_memoryMallocp(marpaEBNFArenap->marpaEBNFAllocatorp, MARPAEBNF_ARENA_HEADER + chunkSizel);
+    if (chunkp == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFArenap->genericLoggerp, "malloc error, %s", strerror(errno));
+      return NULL;
+    }
+    chunkp->sizel = chunkSizel;
+    if (marpaEBNFArenap->currentp != NULL) {
+      chunkp->nextp = marpaEBNFArenap->currentp->nextp;
+      marpaEBNFArenap->currentp->nextp = chunkp;
+    } else {
+      chunkp->nextp = marpaEBNFArenap->headp;
+      marpaEBNFArenap->headp = chunkp;
+    }
+    marpaEBNFArenap->allocatedl += chunkSizel;
+  }
+
+  marpaEBNFArenap->currentp = chunkp;
+  marpaEBNFArenap->usedl    = sizel;
+
+  return MARPAEBNF_ARENA_DATA(chunkp);
+}
+
+/****************************************************************************/
+void _marpaEBNF_arenaResetv(marpaEBNFArena_t *marpaEBNFArenap)
+/****************************************************************************/
+{
+  marpaEBNFArenap->currentp = NULL;
+  marpaEBNFArenap->usedl    = 0;
+}
+
+/****************************************************************************/
+void _marpaEBNF_arenaFreev(marpaEBNFArena_t *marpaEBNFArenap)
+/****************************************************************************/
+{
+  marpaEBNFArenaChunk_t *chunkp;
+  marpaEBNFArenaChunk_t *nextp;
+
+  for (chunkp = marpaEBNFArenap->headp; chunkp != NULL; chunkp = nextp) {
+    nextp = chunkp->nextp;
+    _marpaEBNF_memoryFreev(marpaEBNFArenap->marpaEBNFAllocatorp, chunkp);
+  }
+
+  _marpaEBNF_arenaInitv(marpaEBNFArenap, marpaEBNFArenap->genericLoggerp, marpaEBNFArenap->marpaEBNFAllocatorp);
+}
@@ -0,0 +1,995 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/scan.h"
+#include "marpaEBNF/internal/ast.h"
+
+#define MARPAEBNF_AST_CHILD_INITIAL_SIZE 4
+
+/* Arrays of the block, by decreasing alignment */
+#define MARPAEBNF_AST_ALIGN(x) ((((x) + sizeof(size_t) - 1) / sizeof(size_t)) * sizeof(size_t))
+
+/* Serialized form: the header, then the arrays of the block with exactly */
+/* nodel entries, in the same order. It is meant to be read back on the    */
+/* same kind of machine: sizes and byte order are checked, not converted.  */
+#define MARPAEBNF_AST_FILE_MAGIC   "MEBNFAST"
+#define MARPAEBNF_AST_FILE_VERSION 1
+#define MARPAEBNF_AST_FILE_MARKER  ((size_t) 0x01020304)
+
+typedef struct marpaEBNFAstFileHeader {
+  char   magics[8];
+  size_t versionl;
+  size_t markerl;       /* Byte order */
+  size_t sizeofSizel;
+  size_t sizeofIntl;
+  size_t nodel;
+  size_t textl;
+} marpaEBNFAstFileHeader_t;
+
+/* A level of the tree while rules are replaced: indices are the old ones, */
+/* but for the first node of the level once done.                          */
+typedef struct marpaEBNFAstLevel {
+  size_t startl;          /* Nodes of the level */
+  size_t endl;
+  size_t removedStartl;   /* Of which those of the old rules */
+  size_t removedEndl;
+  size_t pieceStartl;     /* Nodes of the level in the tree of the new rules */
+  size_t pieceEndl;
+  size_t newStartl;
+} marpaEBNFAstLevel_t;
+
+/* Where the new rules and the nodes after them go in a level, and how far */
+/* the runs of the level move, modulo the size of a size_t                 */
+#define MARPAEBNF_AST_PIECE_STARTL(lp)  ((lp)->newStartl + ((lp)->removedStartl - (lp)->startl))
+#define MARPAEBNF_AST_AFTER_STARTL(lp)  (MARPAEBNF_AST_PIECE_STARTL(lp) + ((lp)->pieceEndl - (lp)->pieceStartl))
+#define MARPAEBNF_AST_BEFORE_SHIFTL(lp) ((lp)->newStartl - (lp)->startl)
+#define MARPAEBNF_AST_PIECE_SHIFTL(lp)  (MARPAEBNF_AST_PIECE_STARTL(lp) - (lp)->pieceStartl)
+#define MARPAEBNF_AST_AFTER_SHIFTL(lp)  (MARPAEBNF_AST_AFTER_STARTL(lp) - (lp)->removedEndl)
+
+static inline marpaEBNFAst_t *_marpaEBNF_astAllocp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, size_t nodel, size_t textl);
+static inline short           _marpaEBNF_astCheckb(marpaEBNFAst_t *marpaEBNFAstp);
+static inline short           _marpaEBNF_astChildKindb(int kindi, size_t childi, int childKindi);
+static inline short           _marpaEBNF_astTextb(int kindi);
+static inline void            _marpaEBNF_astMovev(marpaEBNFAst_t *marpaEBNFAstp, size_t froml, size_t tol, size_t nodel, size_t firstChildDeltal, size_t offsetDeltal);
+static inline void            _marpaEBNF_astCopyv(marpaEBNFAst_t *marpaEBNFAstp, marpaEBNFAst_t *pieceAstp, size_t froml, size_t tol, size_t nodel, size_t firstChildDeltal, size_t textOffsetDeltal);
+
+/****************************************************************************/
+void _marpaEBNF_astBuilderInitv(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, marpaEBNFArena_t *marpaEBNFArenap)
+/****************************************************************************/
+{
+  marpaEBNFAstBuilderp->marpaEBNFArenap = marpaEBNFArenap;
+  marpaEBNFAstBuilderp->nodel           = 0;
+  marpaEBNFAstBuilderp->textl           = 0;
+}
+
+/****************************************************************************/
+marpaEBNFAstNode_t *_marpaEBNF_astNodeNewp(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, int kindi)
+/****************************************************************************/
+/* Inner node: its span is the union of the spans of what is appended      */
+/****************************************************************************/
+{
+  marpaEBNFAstNode_t *nodep;
+
+  nodep = (marpaEBNFAstNode_t *) _marpaEBNF_arenaAllocp(marpaEBNFAstBuilderp->marpaEBNFArenap, sizeof(marpaEBNFAstNode_t));
+  if (nodep == NULL) {
+    return NULL;
+  }
+
+  nodep->kindi       = kindi;
+  nodep->positionb   = 0;
+  nodep->offsetl     = 0;
+  nodep->lengthl     = 0;
+  nodep->texts       = NULL;
+  nodep->textl       = 0;
+  nodep->childpp     = NULL;
+  nodep->childl      = 0;
+  nodep->childAllocl = 0;
+
+  if (kindi != MARPAEBNF_AST_PUNCTUATION) {
+    marpaEBNFAstBuilderp->nodel++;
+  }
+
+  return nodep;
+}
+
+/****************************************************************************/
+marpaEBNFAstNode_t *_marpaEBNF_astLeafNewp(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, int kindi, size_t offsetl, char *texts, size_t textl)
+/****************************************************************************/
+/* texts is the lexeme as it appears in the source. The text of the leaf is */
+/* its value: meta identifiers and integers lose their gap separators,      */
+/* terminal strings and special sequences their delimiters.                 */
+/****************************************************************************/
+{
+  marpaEBNFAstNode_t *nodep;
+  size_t              i;
+  size_t              valuel;
+
+  nodep = _marpaEBNF_astNodeNewp(marpaEBNFAstBuilderp, kindi);
+  if (nodep == NULL) {
+    return NULL;
+  }
+  nodep->positionb = 1;
+  nodep->offsetl   = offsetl;
+  nodep->lengthl   = textl;
+
+  switch (kindi) {
+  case MARPAEBNF_AST_META_IDENTIFIER:
+  case MARPAEBNF_AST_INTEGER:
+    nodep->texts = (char *) _marpaEBNF_arenaAllocp(marpaEBNFAstBuilderp->marpaEBNFArenap, textl + 1);
+    if (nodep->texts == NULL) {
+      return NULL;
+    }
+    for (i = 0, valuel = 0; i < textl; i++) {
+      if (! MARPAEBNF_SCAN_IS_GAP((unsigned char) texts[i])) {
+        nodep->texts[valuel++] = texts[i];
+      }
+    }
+    break;
+  case MARPAEBNF_AST_TERMINAL_STRING:
+  case MARPAEBNF_AST_SPECIAL_SEQUENCE:
+    valuel = (textl >= 2) ? textl - 2 : 0;
+    nodep->texts = (char *) _marpaEBNF_arenaAllocp(marpaEBNFAstBuilderp->marpaEBNFArenap, valuel + 1);
+    if (nodep->texts == NULL) {
+      return NULL;
+    }
+    memcpy(nodep->texts, texts + 1, valuel);
+    break;
+  default:
+    return nodep;
+  }
+
+  nodep->texts[valuel] = '\0';
+  nodep->textl = valuel;
+  marpaEBNFAstBuilderp->textl += valuel + 1;
+
+  return nodep;
+}
+
+/****************************************************************************/
+short _marpaEBNF_astNodeAppendb(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, marpaEBNFAstNode_t *parentp, marpaEBNFAstNode_t *childp)
+/****************************************************************************/
+/* Punctuation only extends the span of the parent                          */
+/****************************************************************************/
+{
+  marpaEBNFAstNode_t **childpp;
+  size_t               childAllocl;
+  size_t               endl;
+
+  if (childp->positionb) {
+    if (! parentp->positionb) {
+      parentp->positionb = 1;
+      parentp->offsetl   = childp->offsetl;
+      parentp->lengthl   = childp->lengthl;
+    } else {
+      endl = parentp->offsetl + parentp->lengthl;
+      if (childp->offsetl < parentp->offsetl) {
+        parentp->offsetl = childp->offsetl;
+      }
+      if (childp->offsetl + childp->lengthl > endl) {
+        endl = childp->offsetl + childp->lengthl;
+      }
+      parentp->lengthl = endl - parentp->offsetl;
+    }
+  }
+
+  if (childp->kindi == MARPAEBNF_AST_PUNCTUATION) {
+    return 1;
+  }
+
+  /* The arena does not reallocate: the old array is simply left behind */
+  if (parentp->childl >= parentp->childAllocl) {
+    childAllocl = (parentp->childAllocl > 0) ? parentp->childAllocl * 2 : MARPAEBNF_AST_CHILD_INITIAL_SIZE;
+    childpp = (marpaEBNFAstNode_t **) _marpaEBNF_arenaAllocp(marpaEBNFAstBuilderp->marpaEBNFArenap, childAllocl * sizeof(marpaEBNFAstNode_t *));
+    if (childpp == NULL) {
+      return 0;
+    }
+    if (parentp->childl > 0) {
+      memcpy(childpp, parentp->childpp, parentp->childl * sizeof(marpaEBNFAstNode_t *));
+    }
+    parentp->childpp     = childpp;
+    parentp->childAllocl = childAllocl;
+  }
+  parentp->childpp[parentp->childl++] = childp;
+
+  return 1;
+}
+
+/****************************************************************************/
+marpaEBNFAst_t *_marpaEBNF_astNewp(marpaEBNFAstBuilder_t *marpaEBNFAstBuilderp, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFAstNode_t *rootp)
+/****************************************************************************/
+/* Breadth-first layout: the queue of the traversal is the node order       */
+/****************************************************************************/
+{
+  size_t               maxNodel = marpaEBNFAstBuilderp->nodel;
+  marpaEBNFAst_t      *marpaEBNFAstp;
+  marpaEBNFAstNode_t **queuepp;
+  marpaEBNFAstNode_t  *nodep;
+  size_t               headl;
+  size_t               taill;
+  size_t               textl;
+  size_t               i;
+
+  queuepp = (marpaEBNFAstNode_t **) _marpaEBNF_arenaAllocp(marpaEBNFAstBuilderp->marpaEBNFArenap, (maxNodel + 1) * sizeof(marpaEBNFAstNode_t *));
+  if (queuepp == NULL) {
+    return NULL;
+  }
+
+  marpaEBNFAstp = _marpaEBNF_astAllocp(genericLoggerp, marpaEBNFAllocatorp, maxNodel, marpaEBNFAstBuilderp->textl);
+  if (marpaEBNFAstp == NULL) {
+    return NULL;
+  }
+
+  textl = 0;
+  headl = 0;
+  taill = 0;
+  queuepp[taill++] = rootp;
+  while (headl < taill) {
+    nodep = queuepp[headl];
+
+    marpaEBNFAstp->kindip[headl]       = nodep->kindi;
+    marpaEBNFAstp->firstChildlp[headl] = taill;
+    marpaEBNFAstp->childlp[headl]      = nodep->childl;
+    marpaEBNFAstp->offsetlp[headl]     = nodep->offsetl;
+    marpaEBNFAstp->lengthlp[headl]     = nodep->lengthl;
+    marpaEBNFAstp->textOffsetlp[headl] = textl;
+    marpaEBNFAstp->textLengthlp[headl] = nodep->textl;
+    if (nodep->texts != NULL) {
+      memcpy(marpaEBNFAstp->texts + textl, nodep->texts, nodep->textl + 1);
+      textl += nodep->textl + 1;
+    }
+
+    for (i = 0; i < nodep->childl; i++) {
+      if (taill >= maxNodel) {
+        /* Cannot happen: every node was counted when created */
+        MARPAEBNF_ERROR(genericLoggerp, "AST node count overflow");
+        _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFAstp);
+        return NULL;
+      }
+      /* Empty sequences are where the previous sibling ends, else where the parent starts */
+      if (! nodep->childpp[i]->positionb) {
+        nodep->childpp[i]->offsetl = (i > 0) ? nodep->childpp[i - 1]->offsetl + nodep->childpp[i - 1]->lengthl : nodep->offsetl;
+      }
+      queuepp[taill++] = nodep->childpp[i];
+    }
+    headl++;
+  }
+  marpaEBNFAstp->nodel = taill;
+  marpaEBNFAstp->textl = textl;
+
+  return marpaEBNFAstp;
+}
+
+/****************************************************************************/
+marpaEBNFAst_t *_marpaEBNF_astMergep(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFAst_t **astpp, size_t astl)
+/****************************************************************************/
+/* The syntax rules of the ASTs, in order, under a single syntax root. In   */
+/* breadth-first order a level of the merged tree is the same level of each */
+/* AST, one after the other: nodes are renumbered level by level.           */
+/****************************************************************************/
+{
+  marpaEBNFAst_t *marpaEBNFAstp;
+  marpaEBNFAst_t *pieceAstp;
+  size_t         *newNodelp = NULL;
+  size_t         *baseNodelp;
+  size_t         *levelStartlp;
+  size_t         *levelEndlp;
+  size_t          nodel    = 1;
+  size_t          oldNodel = 0;
+  size_t          textl    = 0;
+  size_t          childl   = 0;
+  size_t          startl;
+  size_t          endl;
+  size_t          lastl;
+  size_t          newl;
+  size_t          oldl;
+  size_t          textOffsetl;
+  size_t          nextChildl;
+  size_t          i;
+  short           moreb;
+
+  for (i = 0; i < astl; i++) {
+    if ((astpp[i]->nodel <= 0) || (astpp[i]->kindip[0] != MARPAEBNF_AST_SYNTAX)) {
+      MARPAEBNF_ERRORF(genericLoggerp, "AST %ld: root is not a syntax", (long) i);
+      return NULL;
+    }
+    nodel += astpp[i]->nodel - 1;
+    oldNodel += astpp[i]->nodel;
+    textl += astpp[i]->textl;
+    childl += astpp[i]->childlp[0];
+  }
+
+  /* New index of every node, then per AST: base in that array and current level */
+  newNodelp = (size_t *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, (oldNodel + 3 * astl) * sizeof(size_t));
+  if (newNodelp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    return NULL;
+  }
+  baseNodelp   = newNodelp + oldNodel;
+  levelStartlp = baseNodelp + astl;
+  levelEndlp   = levelStartlp + astl;
+
+  for (i = 0, oldl = 0; i < astl; i++) {
+    baseNodelp[i]   = oldl;
+    levelStartlp[i] = 0;
+    levelEndlp[i]   = 1;
+    oldl += astpp[i]->nodel;
+  }
+
+  newl = 1;
+  do {
+    moreb = 0;
+    for (i = 0; i < astl; i++) {
+      pieceAstp = astpp[i];
+      startl = levelStartlp[i];
+      endl   = levelEndlp[i];
+      if (startl >= endl) {
+        continue;
+      }
+      /* Next level: the children of the nodes of this one, that are consecutive */
+      lastl = endl - 1;
+      levelStartlp[i] = endl;
+      levelEndlp[i]   = pieceAstp->firstChildlp[lastl] + pieceAstp->childlp[lastl];
+      for (oldl = endl; oldl < levelEndlp[i]; oldl++) {
+        newNodelp[baseNodelp[i] + oldl] = newl++;
+      }
+      if (levelEndlp[i] > endl) {
+        moreb = 1;
+      }
+    }
+  } while (moreb);
+
+  marpaEBNFAstp = _marpaEBNF_astAllocp(genericLoggerp, marpaEBNFAllocatorp, nodel, textl);
+  if (marpaEBNFAstp == NULL) {
+    goto err;
+  }
+  marpaEBNFAstp->nodel = nodel;
+  marpaEBNFAstp->textl = textl;
+
+  marpaEBNFAstp->kindip[0]       = MARPAEBNF_AST_SYNTAX;
+  marpaEBNFAstp->childlp[0]      = childl;
+  marpaEBNFAstp->offsetlp[0]     = (astl > 0) ? astpp[0]->offsetlp[0] : 0;
+  marpaEBNFAstp->lengthlp[0]     = (astl > 0) ? astpp[astl - 1]->offsetlp[0] + astpp[astl - 1]->lengthlp[0] - marpaEBNFAstp->offsetlp[0] : 0;
+  marpaEBNFAstp->textOffsetlp[0] = 0;
+  marpaEBNFAstp->textLengthlp[0] = 0;
+
+  textOffsetl = 0;
+  for (i = 0; i < astl; i++) {
+    pieceAstp = astpp[i];
+    for (oldl = 1; oldl < pieceAstp->nodel; oldl++) {
+      newl = newNodelp[baseNodelp[i] + oldl];
+      marpaEBNFAstp->kindip[newl]       = pieceAstp->kindip[oldl];
+      marpaEBNFAstp->childlp[newl]      = pieceAstp->childlp[oldl];
+      marpaEBNFAstp->offsetlp[newl]     = pieceAstp->offsetlp[oldl];
+      marpaEBNFAstp->lengthlp[newl]     = pieceAstp->lengthlp[oldl];
+      marpaEBNFAstp->textOffsetlp[newl] = textOffsetl + pieceAstp->textOffsetlp[oldl];
+      marpaEBNFAstp->textLengthlp[newl] = pieceAstp->textLengthlp[oldl];
+    }
+    memcpy(marpaEBNFAstp->texts + textOffsetl, pieceAstp->texts, pieceAstp->textl);
+    textOffsetl += pieceAstp->textl;
+  }
+
+  /* As in _marpaEBNF_astNewp(), the children of a node, if any, start after  */
+  /* those of the nodes before it: leaves get where theirs would start.       */
+  for (newl = 0, nextChildl = 1; newl < nodel; newl++) {
+    marpaEBNFAstp->firstChildlp[newl] = nextChildl;
+    nextChildl += marpaEBNFAstp->childlp[newl];
+  }
+
+  _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, newNodelp);
+  return marpaEBNFAstp;
+
+ err:
+  _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, newNodelp);
+  return NULL;
+}
+
+/****************************************************************************/
+short _marpaEBNF_astSpliceb(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFAst_t **astpp, size_t firstRulel, size_t rulel, marpaEBNFAst_t *pieceAstp, size_t deltal)
+/****************************************************************************/
+/* The descendants of nodes that are consecutive in a level are consecutive */
+/* in the next level: per level, the nodes of the old rules are one range,  */
+/* that those of the new rules replace. The nodes before and after it keep  */
+/* their order, and each of these two runs moves as a whole: the runs that  */
+/* move backwards are moved from the root down, then those that move        */
+/* forwards from the leaves up, so that none is overwritten before it has   */
+/* moved.                                                                   */
+/* Texts of the new leaves are appended: those of the old ones are only     */
+/* dropped when the block has to grow.                                      */
+/****************************************************************************/
+{
+  marpaEBNFAst_t      *marpaEBNFAstp = *astpp;
+  marpaEBNFAst_t      *newAstp;
+  marpaEBNFAstLevel_t *levelp = NULL;
+  marpaEBNFAstLevel_t *lp;
+  size_t               levell = 0;
+  size_t               nodel;
+  size_t               textl;
+  size_t               startl;
+  size_t               endl;
+  size_t               nextEndl;
+  size_t               removedStartl;
+  size_t               removedEndl;
+  size_t               pieceStartl;
+  size_t               pieceEndl;
+  size_t               lastl;
+  size_t               rootOffsetl;
+  size_t               rootEndl;
+  size_t               i;
+  int                  passi;
+
+  if ((marpaEBNFAstp->nodel <= 0) || (firstRulel + rulel > marpaEBNFAstp->childlp[0]) || (pieceAstp->nodel <= 0) || (pieceAstp->kindip[0] != MARPAEBNF_AST_SYNTAX)) {
+    MARPAEBNF_ERROR(genericLoggerp, "Invalid AST splice");
+    return 0;
+  }
+
+  /* The first pass counts the levels, the second one describes them. The  */
+  /* last one is empty in both trees: it is where the leaves of the level  */
+  /* before it would have their children.                                  */
+  for (passi = 0; passi < 2; passi++) {
+    startl        = marpaEBNFAstp->firstChildlp[0];
+    endl          = startl + marpaEBNFAstp->childlp[0];
+    removedStartl = startl + firstRulel;
+    removedEndl   = removedStartl + rulel;
+    pieceStartl   = pieceAstp->firstChildlp[0];
+    pieceEndl     = pieceStartl + pieceAstp->childlp[0];
+    nodel         = 1;
+    for (i = 0; ; i++) {
+      if (passi > 0) {
+        lp = &(levelp[i]);
+        lp->startl        = startl;
+        lp->endl          = endl;
+        lp->removedStartl = removedStartl;
+        lp->removedEndl   = removedEndl;
+        lp->pieceStartl   = pieceStartl;
+        lp->pieceEndl     = pieceEndl;
+        lp->newStartl     = nodel;
+      }
+      if ((startl >= endl) && (pieceStartl >= pieceEndl)) {
+        break;
+      }
+      nodel += (endl - startl) - (removedEndl - removedStartl) + (pieceEndl - pieceStartl);
+
+      /* The first child of a leaf is where its children would start */
+      nextEndl      = (startl < endl) ? marpaEBNFAstp->firstChildlp[endl - 1] + marpaEBNFAstp->childlp[endl - 1] : endl;
+      removedStartl = (removedStartl < endl) ? marpaEBNFAstp->firstChildlp[removedStartl] : nextEndl;
+      removedEndl   = (removedEndl < endl) ? marpaEBNFAstp->firstChildlp[removedEndl] : nextEndl;
+      startl        = endl;
+      endl          = nextEndl;
+      nextEndl      = (pieceStartl < pieceEndl) ? pieceAstp->firstChildlp[pieceEndl - 1] + pieceAstp->childlp[pieceEndl - 1] : pieceEndl;
+      pieceStartl   = pieceEndl;
+      pieceEndl     = nextEndl;
+    }
+    if (passi <= 0) {
+      levell = i + 1;
+      levelp = (marpaEBNFAstLevel_t *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, levell * sizeof(marpaEBNFAstLevel_t));
+      if (levelp == NULL) {
+        MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+        return 0;
+      }
+    }
+  }
+
+  /* The root spans the rules, as in _marpaEBNF_astMergep() */
+  lastl       = marpaEBNFAstp->firstChildlp[0] + marpaEBNFAstp->childlp[0] - 1;
+  rootOffsetl = (firstRulel > 0) ? marpaEBNFAstp->offsetlp[marpaEBNFAstp->firstChildlp[0]] : pieceAstp->offsetlp[0];
+  rootEndl    = (firstRulel + rulel < marpaEBNFAstp->childlp[0]) ? marpaEBNFAstp->offsetlp[lastl] + marpaEBNFAstp->lengthlp[lastl] + deltal : pieceAstp->offsetlp[0] + pieceAstp->lengthlp[0];
+
+  nodel = levelp[levell - 1].newStartl;
+  if ((nodel > marpaEBNFAstp->nodeAllocl) || (marpaEBNFAstp->textl + pieceAstp->textl > marpaEBNFAstp->textAllocl)) {
+    /* Half as much room again, without the texts that no node refers to */
+    for (i = 0, textl = 0; i < marpaEBNFAstp->nodel; i++) {
+      if (_marpaEBNF_astTextb(marpaEBNFAstp->kindip[i])) {
+        textl += marpaEBNFAstp->textLengthlp[i] + 1;
+      }
+    }
+    textl += pieceAstp->textl;
+    newAstp = _marpaEBNF_astAllocp(genericLoggerp, marpaEBNFAllocatorp, nodel + nodel / 2, textl + textl / 2);
+    if (newAstp == NULL) {
+      _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, levelp);
+      return 0;
+    }
+    nodel = marpaEBNFAstp->nodel;
+    memcpy(newAstp->kindip,       marpaEBNFAstp->kindip,       nodel * sizeof(int));
+    memcpy(newAstp->firstChildlp, marpaEBNFAstp->firstChildlp, nodel * sizeof(size_t));
+    memcpy(newAstp->childlp,      marpaEBNFAstp->childlp,      nodel * sizeof(size_t));
+    memcpy(newAstp->offsetlp,     marpaEBNFAstp->offsetlp,     nodel * sizeof(size_t));
+    memcpy(newAstp->lengthlp,     marpaEBNFAstp->lengthlp,     nodel * sizeof(size_t));
+    memcpy(newAstp->textLengthlp, marpaEBNFAstp->textLengthlp, nodel * sizeof(size_t));
+    for (i = 0, textl = 0; i < nodel; i++) {
+      newAstp->textOffsetlp[i] = textl;
+      if (_marpaEBNF_astTextb(marpaEBNFAstp->kindip[i])) {
+        memcpy(newAstp->texts + textl, marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[i], marpaEBNFAstp->textLengthlp[i] + 1);
+        textl += marpaEBNFAstp->textLengthlp[i] + 1;
+      }
+    }
+    newAstp->nodel = nodel;
+    newAstp->textl = textl;
+    _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFAstp);
+    marpaEBNFAstp = newAstp;
+    *astpp        = newAstp;
+  }
+
+  /* Runs that move backwards or stay, from the root down */
+  for (i = 0; i + 1 < levell; i++) {
+    lp = &(levelp[i]);
+    if (lp->newStartl <= lp->startl) {
+      _marpaEBNF_astMovev(marpaEBNFAstp, lp->startl, lp->newStartl, lp->removedStartl - lp->startl, MARPAEBNF_AST_BEFORE_SHIFTL(lp + 1), 0);
+    }
+    if (MARPAEBNF_AST_AFTER_STARTL(lp) <= lp->removedEndl) {
+      _marpaEBNF_astMovev(marpaEBNFAstp, lp->removedEndl, MARPAEBNF_AST_AFTER_STARTL(lp), lp->endl - lp->removedEndl, MARPAEBNF_AST_AFTER_SHIFTL(lp + 1), deltal);
+    }
+  }
+  /* Runs that move forwards, from the leaves up */
+  for (i = levell - 1; i-- > 0; ) {
+    lp = &(levelp[i]);
+    if (MARPAEBNF_AST_AFTER_STARTL(lp) > lp->removedEndl) {
+      _marpaEBNF_astMovev(marpaEBNFAstp, lp->removedEndl, MARPAEBNF_AST_AFTER_STARTL(lp), lp->endl - lp->removedEndl, MARPAEBNF_AST_AFTER_SHIFTL(lp + 1), deltal);
+    }
+    if (lp->newStartl > lp->startl) {
+      _marpaEBNF_astMovev(marpaEBNFAstp, lp->startl, lp->newStartl, lp->removedStartl - lp->startl, MARPAEBNF_AST_BEFORE_SHIFTL(lp + 1), 0);
+    }
+  }
+  /* The new rules, in the room left */
+  for (i = 0; i + 1 < levell; i++) {
+    lp = &(levelp[i]);
+    _marpaEBNF_astCopyv(marpaEBNFAstp, pieceAstp, lp->pieceStartl, MARPAEBNF_AST_PIECE_STARTL(lp), lp->pieceEndl - lp->pieceStartl, MARPAEBNF_AST_PIECE_SHIFTL(lp + 1), marpaEBNFAstp->textl);
+  }
+  memcpy(marpaEBNFAstp->texts + marpaEBNFAstp->textl, pieceAstp->texts, pieceAstp->textl);
+
+  marpaEBNFAstp->nodel       = levelp[levell - 1].newStartl;
+  marpaEBNFAstp->textl      += pieceAstp->textl;
+  marpaEBNFAstp->childlp[0]  = marpaEBNFAstp->childlp[0] - rulel + pieceAstp->childlp[0];
+  marpaEBNFAstp->offsetlp[0] = rootOffsetl;
+  marpaEBNFAstp->lengthlp[0] = rootEndl - rootOffsetl;
+
+  _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, levelp);
+  return 1;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_astMovev(marpaEBNFAst_t *marpaEBNFAstp, size_t froml, size_t tol, size_t nodel, size_t firstChildDeltal, size_t offsetDeltal)
+/****************************************************************************/
+/* Deltas are modulo the size of a size_t, so that they can be negative     */
+/****************************************************************************/
+{
+  size_t i;
+
+  if (nodel <= 0) {
+    return;
+  }
+  if (froml != tol) {
+    memmove(marpaEBNFAstp->kindip       + tol, marpaEBNFAstp->kindip       + froml, nodel * sizeof(int));
+    memmove(marpaEBNFAstp->firstChildlp + tol, marpaEBNFAstp->firstChildlp + froml, nodel * sizeof(size_t));
+    memmove(marpaEBNFAstp->childlp      + tol, marpaEBNFAstp->childlp      + froml, nodel * sizeof(size_t));
+    memmove(marpaEBNFAstp->offsetlp     + tol, marpaEBNFAstp->offsetlp     + froml, nodel * sizeof(size_t));
+    memmove(marpaEBNFAstp->lengthlp     + tol, marpaEBNFAstp->lengthlp     + froml, nodel * sizeof(size_t));
+    memmove(marpaEBNFAstp->textOffsetlp + tol, marpaEBNFAstp->textOffsetlp + froml, nodel * sizeof(size_t));
+    memmove(marpaEBNFAstp->textLengthlp + tol, marpaEBNFAstp->textLengthlp + froml, nodel * sizeof(size_t));
+  }
+  if (firstChildDeltal != 0) {
+    for (i = tol; i < tol + nodel; i++) {
+      marpaEBNFAstp->firstChildlp[i] += firstChildDeltal;
+    }
+  }
+  if (offsetDeltal != 0) {
+    for (i = tol; i < tol + nodel; i++) {
+      marpaEBNFAstp->offsetlp[i] += offsetDeltal;
+    }
+  }
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_astCopyv(marpaEBNFAst_t *marpaEBNFAstp, marpaEBNFAst_t *pieceAstp, size_t froml, size_t tol, size_t nodel, size_t firstChildDeltal, size_t textOffsetDeltal)
+/****************************************************************************/
+{
+  size_t i;
+
+  for (i = 0; i < nodel; i++) {
+    marpaEBNFAstp->kindip[tol + i]       = pieceAstp->kindip[froml + i];
+    marpaEBNFAstp->firstChildlp[tol + i] = pieceAstp->firstChildlp[froml + i] + firstChildDeltal;
+    marpaEBNFAstp->childlp[tol + i]      = pieceAstp->childlp[froml + i];
+    marpaEBNFAstp->offsetlp[tol + i]     = pieceAstp->offsetlp[froml + i];
+    marpaEBNFAstp->lengthlp[tol + i]     = pieceAstp->lengthlp[froml + i];
+    marpaEBNFAstp->textOffsetlp[tol + i] = pieceAstp->textOffsetlp[froml + i] + textOffsetDeltal;
+    marpaEBNFAstp->textLengthlp[tol + i] = pieceAstp->textLengthlp[froml + i];
+  }
+}
+
+/****************************************************************************/
+marpaEBNFAst_t *_marpaEBNF_astClonep(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFAst_t *marpaEBNFAstp)
+/****************************************************************************/
+/* Arrays are copied one by one: the block of the original may have room   */
+/* for more nodes than it has.                                              */
+/****************************************************************************/
+{
+  marpaEBNFAst_t *cloneAstp;
+  size_t          nodel = marpaEBNFAstp->nodel;
+
+  cloneAstp = _marpaEBNF_astAllocp(genericLoggerp, marpaEBNFAllocatorp, nodel, marpaEBNFAstp->textl);
+  if (cloneAstp == NULL) {
+    return NULL;
+  }
+  memcpy(cloneAstp->kindip,       marpaEBNFAstp->kindip,       nodel * sizeof(int));
+  memcpy(cloneAstp->firstChildlp, marpaEBNFAstp->firstChildlp, nodel * sizeof(size_t));
+  memcpy(cloneAstp->childlp,      marpaEBNFAstp->childlp,      nodel * sizeof(size_t));
+  memcpy(cloneAstp->offsetlp,     marpaEBNFAstp->offsetlp,     nodel * sizeof(size_t));
+  memcpy(cloneAstp->lengthlp,     marpaEBNFAstp->lengthlp,     nodel * sizeof(size_t));
+  memcpy(cloneAstp->textOffsetlp, marpaEBNFAstp->textOffsetlp, nodel * sizeof(size_t));
+  memcpy(cloneAstp->textLengthlp, marpaEBNFAstp->textLengthlp, nodel * sizeof(size_t));
+  memcpy(cloneAstp->texts,        marpaEBNFAstp->texts,        marpaEBNFAstp->textl);
+  cloneAstp->nodel = nodel;
+  cloneAstp->textl = marpaEBNFAstp->textl;
+
+  return cloneAstp;
+}
+
+/****************************************************************************/
+size_t _marpaEBNF_astSizel(marpaEBNFAst_t *marpaEBNFAstp)
+/****************************************************************************/
+/* Bytes of a clone                                                         */
+/****************************************************************************/
+{
+  return MARPAEBNF_AST_ALIGN(sizeof(marpaEBNFAst_t))
+    + 6 * marpaEBNFAstp->nodel * sizeof(size_t)
+    + MARPAEBNF_AST_ALIGN(marpaEBNFAstp->nodel * sizeof(int))
+    + marpaEBNFAstp->textl;
+}
+
+/****************************************************************************/
+short _marpaEBNF_astWriteb(marpaEBNFAst_t *marpaEBNFAstp, FILE *fp)
+/****************************************************************************/
+{
+  marpaEBNFAstFileHeader_t header;
+  size_t                   nodel = marpaEBNFAstp->nodel;
+
+  memset(&header, 0, sizeof(marpaEBNFAstFileHeader_t));
+  memcpy(header.magics, MARPAEBNF_AST_FILE_MAGIC, sizeof(header.magics));
+  header.versionl    = MARPAEBNF_AST_FILE_VERSION;
+  header.markerl     = MARPAEBNF_AST_FILE_MARKER;
+  header.sizeofSizel = sizeof(size_t);
+  header.sizeofIntl  = sizeof(int);
+  header.nodel       = nodel;
+  header.textl       = marpaEBNFAstp->textl;
+
+  return (fwrite(&header, sizeof(marpaEBNFAstFileHeader_t), 1, fp) == 1)
+    && (fwrite(marpaEBNFAstp->firstChildlp, sizeof(size_t), nodel, fp) == nodel)
+    && (fwrite(marpaEBNFAstp->childlp,      sizeof(size_t), nodel, fp) == nodel)
+    && (fwrite(marpaEBNFAstp->offsetlp,     sizeof(size_t), nodel, fp) == nodel)
+    && (fwrite(marpaEBNFAstp->lengthlp,     sizeof(size_t), nodel, fp) == nodel)
+    && (fwrite(marpaEBNFAstp->textOffsetlp, sizeof(size_t), nodel, fp) == nodel)
+    && (fwrite(marpaEBNFAstp->textLengthlp, sizeof(size_t), nodel, fp) == nodel)
+    && (fwrite(marpaEBNFAstp->kindip,       sizeof(int),    nodel, fp) == nodel)
+    && (fwrite(marpaEBNFAstp->texts,        1,              marpaEBNFAstp->textl, fp) == marpaEBNFAstp->textl);
+}
+
+/****************************************************************************/
+marpaEBNFAst_t *_marpaEBNF_astReadp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, FILE *fp)
+/****************************************************************************/
+/* NULL, without an error message, when the content is not exactly an AST  */
+/* as written by _marpaEBNF_astWriteb(): sizes are checked against the file */
+/* before anything is allocated, and the tree is checked before it is used. */
+/****************************************************************************/
+{
+  marpaEBNFAstFileHeader_t  header;
+  marpaEBNFAst_t           *marpaEBNFAstp = NULL;
+  long                      filel;
+  size_t                    nodel;
+
+  if ((fseek(fp, 0, SEEK_END) != 0) || ((filel = ftell(fp)) < 0) || (fseek(fp, 0, SEEK_SET) != 0)) {
+    return NULL;
+  }
+  if (((size_t) filel < sizeof(marpaEBNFAstFileHeader_t)) || (fread(&header, sizeof(marpaEBNFAstFileHeader_t), 1, fp) != 1)) {
+    return NULL;
+  }
+  if ((memcmp(header.magics, MARPAEBNF_AST_FILE_MAGIC, sizeof(header.magics)) != 0)
+      || (header.versionl    != MARPAEBNF_AST_FILE_VERSION)
+      || (header.markerl     != MARPAEBNF_AST_FILE_MARKER)
+      || (header.sizeofSizel != sizeof(size_t))
+      || (header.sizeofIntl  != sizeof(int))) {
+    return NULL;
+  }
+  nodel = header.nodel;
+  filel -= (long) sizeof(marpaEBNFAstFileHeader_t);
+  if ((nodel > (size_t) filel / (6 * sizeof(size_t) + sizeof(int)))
+      || (header.textl != (size_t) filel - nodel * (6 * sizeof(size_t) + sizeof(int)))) {
+    return NULL;
+  }
+
+  marpaEBNFAstp = _marpaEBNF_astAllocp(genericLoggerp, marpaEBNFAllocatorp, nodel, header.textl);
+  if (marpaEBNFAstp == NULL) {
+    return NULL;
+  }
+  marpaEBNFAstp->nodel = nodel;
+  marpaEBNFAstp->textl = header.textl;
+  if ((fread(marpaEBNFAstp->firstChildlp, sizeof(size_t), nodel, fp) != nodel)
+      || (fread(marpaEBNFAstp->childlp,      sizeof(size_t), nodel, fp) != nodel)
+      || (fread(marpaEBNFAstp->offsetlp,     sizeof(size_t), nodel, fp) != nodel)
+      || (fread(marpaEBNFAstp->lengthlp,     sizeof(size_t), nodel, fp) != nodel)
+      || (fread(marpaEBNFAstp->textOffsetlp, sizeof(size_t), nodel, fp) != nodel)
+      || (fread(marpaEBNFAstp->textLengthlp, sizeof(size_t), nodel, fp) != nodel)
+      || (fread(marpaEBNFAstp->kindip,       sizeof(int),    nodel, fp) != nodel)
+      || (fread(marpaEBNFAstp->texts,        1,              header.textl, fp) != header.textl)
+      || (! _marpaEBNF_astCheckb(marpaEBNFAstp))) {
+    _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFAstp);
+    return NULL;
+  }
+
+  return marpaEBNFAstp;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_astCheckb(marpaEBNFAst_t *marpaEBNFAstp)
+/****************************************************************************/
+/* What the compiler relies on: a syntax root, children that come after    */
+/* their parent and within the tree, the number and the kinds of children  */
+/* of each kind, and NUL terminated leaf texts within the texts.            */
+/****************************************************************************/
+{
+  size_t nodel = marpaEBNFAstp->nodel;
+  size_t textl = marpaEBNFAstp->textl;
+  size_t firstChildl;
+  size_t childl;
+  size_t textOffsetl;
+  size_t textLengthl;
+  size_t i;
+  size_t j;
+
+  if ((nodel <= 0) || (marpaEBNFAstp->kindip[0] != MARPAEBNF_AST_SYNTAX)) {
+    return 0;
+  }
+
+  for (i = 0; i < nodel; i++) {
+    firstChildl = marpaEBNFAstp->firstChildlp[i];
+    childl      = marpaEBNFAstp->childlp[i];
+    textOffsetl = marpaEBNFAstp->textOffsetlp[i];
+    textLengthl = marpaEBNFAstp->textLengthlp[i];
+
+    if ((childl > 0) && ((firstChildl <= i) || (firstChildl > nodel) || (childl > nodel - firstChildl))) {
+      return 0;
+    }
+    if ((textOffsetl > textl) || (textLengthl > textl - textOffsetl)) {
+      return 0;
+    }
+
+    switch (marpaEBNFAstp->kindip[i]) {
+    case MARPAEBNF_AST_SYNTAX:
+      if (i > 0) {
+        return 0;
+      }
+      break;
+    case MARPAEBNF_AST_DEFINITIONS_LIST:
+    case MARPAEBNF_AST_SINGLE_DEFINITION:
+      if (childl <= 0) {
+        return 0;
+      }
+      break;
+    case MARPAEBNF_AST_SYNTAX_RULE:
+    case MARPAEBNF_AST_EXCEPTION:
+    case MARPAEBNF_AST_REPETITION:
+      if (childl != 2) {
+        return 0;
+      }
+      break;
+    case MARPAEBNF_AST_OPTIONAL_SEQUENCE:
+    case MARPAEBNF_AST_REPEATED_SEQUENCE:
+    case MARPAEBNF_AST_GROUPED_SEQUENCE:
+      if (childl != 1) {
+        return 0;
+      }
+      break;
+    case MARPAEBNF_AST_META_IDENTIFIER:
+    case MARPAEBNF_AST_INTEGER:
+    case MARPAEBNF_AST_TERMINAL_STRING:
+    case MARPAEBNF_AST_SPECIAL_SEQUENCE:
+      if ((childl > 0) || (textLengthl >= textl - textOffsetl) || (marpaEBNFAstp->texts[textOffsetl + textLengthl] != '\0')) {
+        return 0;
+      }
+      break;
+    case MARPAEBNF_AST_EMPTY_SEQUENCE:
+      if (childl > 0) {
+        return 0;
+      }
+      break;
+    default:
+      return 0;
+    }
+
+    for (j = 0; j < childl; j++) {
+      if (! _marpaEBNF_astChildKindb(marpaEBNFAstp->kindip[i], j, marpaEBNFAstp->kindip[firstChildl + j])) {
+        return 0;
+      }
+    }
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_astChildKindb(int kindi, size_t childi, int childKindi)
+/****************************************************************************/
+/* Is childKindi a possible kind of the child childi of a node of kind kindi */
+/****************************************************************************/
+{
+  switch (kindi) {
+  case MARPAEBNF_AST_SYNTAX:
+    return (childKindi == MARPAEBNF_AST_SYNTAX_RULE) ? 1 : 0;
+  case MARPAEBNF_AST_SYNTAX_RULE:
+    return (childKindi == ((childi == 0) ? MARPAEBNF_AST_META_IDENTIFIER : MARPAEBNF_AST_DEFINITIONS_LIST)) ? 1 : 0;
+  case MARPAEBNF_AST_DEFINITIONS_LIST:
+    return (childKindi == MARPAEBNF_AST_SINGLE_DEFINITION) ? 1 : 0;
+  case MARPAEBNF_AST_OPTIONAL_SEQUENCE:
+  case MARPAEBNF_AST_REPEATED_SEQUENCE:
+  case MARPAEBNF_AST_GROUPED_SEQUENCE:
+    return (childKindi == MARPAEBNF_AST_DEFINITIONS_LIST) ? 1 : 0;
+  case MARPAEBNF_AST_REPETITION:
+    if (childi == 0) {
+      return (childKindi == MARPAEBNF_AST_INTEGER) ? 1 : 0;
+    }
+    break;
+  case MARPAEBNF_AST_SINGLE_DEFINITION:
+  case MARPAEBNF_AST_EXCEPTION:
+    break;
+  default:
+    return 0;
+  }
+
+  /* A term */
+  switch (childKindi) {
+  case MARPAEBNF_AST_EXCEPTION:
+  case MARPAEBNF_AST_REPETITION:
+  case MARPAEBNF_AST_OPTIONAL_SEQUENCE:
+  case MARPAEBNF_AST_REPEATED_SEQUENCE:
+  case MARPAEBNF_AST_GROUPED_SEQUENCE:
+  case MARPAEBNF_AST_META_IDENTIFIER:
+  case MARPAEBNF_AST_TERMINAL_STRING:
+  case MARPAEBNF_AST_SPECIAL_SEQUENCE:
+  case MARPAEBNF_AST_EMPTY_SEQUENCE:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_astTextb(int kindi)
+/****************************************************************************/
+/* Kinds of the leaves that have a text                                     */
+/****************************************************************************/
+{
+  switch (kindi) {
+  case MARPAEBNF_AST_META_IDENTIFIER:
+  case MARPAEBNF_AST_INTEGER:
+  case MARPAEBNF_AST_TERMINAL_STRING:
+  case MARPAEBNF_AST_SPECIAL_SEQUENCE:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+/****************************************************************************/
+static inline marpaEBNFAst_t *_marpaEBNF_astAllocp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, size_t nodel, size_t textl)
+/****************************************************************************/
+/* A single block, arrays by decreasing alignment                           */
+/****************************************************************************/
+{
+  marpaEBNFAst_t *marpaEBNFAstp;
+  size_t          sizel;
+  char           *p;
+
+  sizel = MARPAEBNF_AST_ALIGN(sizeof(marpaEBNFAst_t))
+    + 6 * nodel * sizeof(size_t)
+    + MARPAEBNF_AST_ALIGN(nodel * sizeof(int))
+    + textl;
+  marpaEBNFAstp = (marpaEBNFAst_t *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, sizel);
+  if (marpaEBNFAstp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    return NULL;
+  }
+  p = ((char *) marpaEBNFAstp) + MARPAEBNF_AST_ALIGN(sizeof(marpaEBNFAst_t));
+  marpaEBNFAstp->firstChildlp = (size_t *) p; p += nodel * sizeof(size_t);
+  marpaEBNFAstp->childlp      = (size_t *) p; p += nodel * sizeof(size_t);
+  marpaEBNFAstp->offsetlp     = (size_t *) p; p += nodel * sizeof(size_t);
+  marpaEBNFAstp->lengthlp     = (size_t *) p; p += nodel * sizeof(size_t);
+  marpaEBNFAstp->textOffsetlp = (size_t *) p; p += nodel * sizeof(size_t);
+  marpaEBNFAstp->textLengthlp = (size_t *) p; p += nodel * sizeof(size_t);
+  marpaEBNFAstp->kindip       = (int *) p;    p += MARPAEBNF_AST_ALIGN(nodel * sizeof(int));
+  marpaEBNFAstp->texts        = p;
+  marpaEBNFAstp->nodel        = 0;
+  marpaEBNFAstp->textl        = 0;
+  marpaEBNFAstp->nodeAllocl   = nodel;
+  marpaEBNFAstp->textAllocl   = textl;
+
+  return marpaEBNFAstp;
+}
+
+/****************************************************************************/
+void _marpaEBNF_astFreev(marpaEBNFAst_t *marpaEBNFAstp, marpaEBNFAllocator_t *marpaEBNFAllocatorp)
+/****************************************************************************/
+{
+  if (marpaEBNFAstp != NULL) {
+    _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFAstp);
+  }
+}
+
+/****************************************************************************/
+size_t marpaEBNFAst_nodel(marpaEBNFAst_t *marpaEBNFAstp)
+/****************************************************************************/
+{
+  return (marpaEBNFAstp != NULL) ? marpaEBNFAstp->nodel : 0;
+}
+
+/****************************************************************************/
+int marpaEBNFAst_kindi(marpaEBNFAst_t *marpaEBNFAstp, size_t nodel)
+/****************************************************************************/
+{
+  if ((marpaEBNFAstp == NULL) || (nodel >= marpaEBNFAstp->nodel)) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  return marpaEBNFAstp->kindip[nodel];
+}
+
+/****************************************************************************/
+short marpaEBNFAst_childrenb(marpaEBNFAst_t *marpaEBNFAstp, size_t nodel, size_t *firstChildlp, size_t *childlp)
+/****************************************************************************/
+{
+  if ((marpaEBNFAstp == NULL) || (nodel >= marpaEBNFAstp->nodel)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (firstChildlp != NULL) {
+    *firstChildlp = marpaEBNFAstp->firstChildlp[nodel];
+  }
+  if (childlp != NULL) {
+    *childlp = marpaEBNFAstp->childlp[nodel];
+  }
+  return 1;
+}
+
+/****************************************************************************/
+short marpaEBNFAst_spanb(marpaEBNFAst_t *marpaEBNFAstp, size_t nodel, size_t *offsetlp, size_t *lengthlp)
+/****************************************************************************/
+{
+  if ((marpaEBNFAstp == NULL) || (nodel >= marpaEBNFAstp->nodel)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (offsetlp != NULL) {
+    *offsetlp = marpaEBNFAstp->offsetlp[nodel];
+  }
+  if (lengthlp != NULL) {
+    *lengthlp = marpaEBNFAstp->lengthlp[nodel];
+  }
+  return 1;
+}
+
+/****************************************************************************/
+char *marpaEBNFAst_texts(marpaEBNFAst_t *marpaEBNFAstp, size_t nodel, size_t *lengthlp)
+/****************************************************************************/
+{
+  if ((marpaEBNFAstp == NULL) || (nodel >= marpaEBNFAstp->nodel)) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  switch (marpaEBNFAstp->kindip[nodel]) {
+  case MARPAEBNF_AST_META_IDENTIFIER:
+  case MARPAEBNF_AST_INTEGER:
+  case MARPAEBNF_AST_TERMINAL_STRING:
+  case MARPAEBNF_AST_SPECIAL_SEQUENCE:
+    if (lengthlp != NULL) {
+      *lengthlp = marpaEBNFAstp->textLengthlp[nodel];
+    }
+    return marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[nodel];
+  default:
+    return NULL;
+  }
+}
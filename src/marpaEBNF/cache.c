@@ -0,0 +1,465 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <process.h>
+#define MARPAEBNF_CACHE_PID() ((unsigned long) _getpid())
+#else
+#include <unistd.h>
+#define MARPAEBNF_CACHE_PID() ((unsigned long) getpid())
+#endif
+
+#include "config.h"
+#include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/scan.h"
+#include "marpaEBNF/internal/ast.h"
+#include "marpaEBNF/internal/cache.h"
+
+#define MARPAEBNF_CACHE_MIN_BUCKETS 16
+#define MARPAEBNF_CACHE_SUFFIX      ".ast"
+
+static inline marpaEBNFCacheEntry_t *_marpaEBNF_cacheEntryp(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp);
+static inline short                  _marpaEBNF_cacheInsertb(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp, marpaEBNFAst_t *marpaEBNFAstp);
+static inline void                   _marpaEBNF_cacheUnlinkv(marpaEBNFCache_t *marpaEBNFCachep, marpaEBNFCacheEntry_t *entryp, short freeb);
+static inline void                   _marpaEBNF_cacheNewestv(marpaEBNFCache_t *marpaEBNFCachep, marpaEBNFCacheEntry_t *entryp);
+static inline char                  *_marpaEBNF_cachePathnames(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp, short temporaryb);
+static inline void                   _marpaEBNF_cachePathFreev(marpaEBNFCache_t *marpaEBNFCachep, char *pathnames);
+
+/****************************************************************************/
+marpaEBNFCache_t *marpaEBNFCache_newp(marpaEBNFCacheOption_t *marpaEBNFCacheOptionp)
+/****************************************************************************/
+/* The cache has its own system allocator: the hooks of an instance could   */
+/* not be called from another one.                                          */
+/****************************************************************************/
+{
+  genericLogger_t      *genericLoggerp = (marpaEBNFCacheOptionp != NULL) ? marpaEBNFCacheOptionp->genericLoggerp : NULL;
+  marpaEBNFCache_t     *marpaEBNFCachep;
+  marpaEBNFAllocator_t  marpaEBNFAllocator;
+  size_t                maxEntryl = ((marpaEBNFCacheOptionp != NULL) && (marpaEBNFCacheOptionp->maxEntryl > 0)) ? marpaEBNFCacheOptionp->maxEntryl : MARPAEBNF_CACHE_DEFAULT_ENTRIES;
+  size_t                bucketl;
+  size_t                i;
+
+  _marpaEBNF_memoryInitv(&marpaEBNFAllocator, NULL);
+  marpaEBNFCachep = (marpaEBNFCache_t *) _marpaEBNF_memoryMallocp(&marpaEBNFAllocator, sizeof(marpaEBNFCache_t));
+  if (marpaEBNFCachep == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    return NULL;
+  }
+  marpaEBNFCachep->genericLoggerp     = genericLoggerp;
+  marpaEBNFCachep->marpaEBNFAllocator = marpaEBNFAllocator;
+  marpaEBNFCachep->maxEntryl          = maxEntryl;
+  marpaEBNFCachep->maxBytel           = (marpaEBNFCacheOptionp != NULL) ? marpaEBNFCacheOptionp->maxBytel : 0;
+  marpaEBNFCachep->directorys         = NULL;
+  marpaEBNFCachep->bucketpp           = NULL;
+  marpaEBNFCachep->newestp            = NULL;
+  marpaEBNFCachep->oldestp            = NULL;
+  marpaEBNFCachep->temporaryl         = 0;
+  memset(&(marpaEBNFCachep->stats), 0, sizeof(marpaEBNFCacheStats_t));
+  MARPAEBNF_MUTEX_INIT(&(marpaEBNFCachep->mutex));
+
+  /* At most one entry per bucket on average */
+  for (bucketl = MARPAEBNF_CACHE_MIN_BUCKETS; (bucketl < maxEntryl) && (bucketl <= ((size_t) -1) / (2 * sizeof(marpaEBNFCacheEntry_t *))); bucketl *= 2) {
+  }
+  marpaEBNFCachep->bucketl  = bucketl;
+  marpaEBNFCachep->bucketpp = (marpaEBNFCacheEntry_t **) _marpaEBNF_memoryMallocp(&(marpaEBNFCachep->marpaEBNFAllocator), bucketl * sizeof(marpaEBNFCacheEntry_t *));
+  if (marpaEBNFCachep->bucketpp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    goto err;
+  }
+  for (i = 0; i < bucketl; i++) {
+    marpaEBNFCachep->bucketpp[i] = NULL;
+  }
+
+  if ((marpaEBNFCacheOptionp != NULL) && (marpaEBNFCacheOptionp->directorys != NULL)) {
+    marpaEBNFCachep->directorys = (char *) _marpaEBNF_memoryMallocp(&(marpaEBNFCachep->marpaEBNFAllocator), strlen(marpaEBNFCacheOptionp->directorys) + 1);
+    if (marpaEBNFCachep->directorys == NULL) {
+      MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+      goto err;
+    }
+    strcpy(marpaEBNFCachep->directorys, marpaEBNFCacheOptionp->directorys);
+  }
+
+  return marpaEBNFCachep;
+
+ err:
+  marpaEBNFCache_freev(marpaEBNFCachep);
+  return NULL;
+}
+
+/****************************************************************************/
+short marpaEBNFCache_statsb(marpaEBNFCache_t *marpaEBNFCachep, marpaEBNFCacheStats_t *marpaEBNFCacheStatsp)
+/****************************************************************************/
+{
+  if ((marpaEBNFCachep == NULL) || (marpaEBNFCacheStatsp == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+  *marpaEBNFCacheStatsp = marpaEBNFCachep->stats;
+  MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+
+  return 1;
+}
+
+/****************************************************************************/
+short marpaEBNFCache_removeb(marpaEBNFCache_t *marpaEBNFCachep, char *grammars, size_t grammarl)
+/****************************************************************************/
+/* A grammar that is not in the cache is not an error. It goes with and    */
+/* without the utf8b option.                                                */
+/****************************************************************************/
+{
+  unsigned char          keyp[MARPAEBNF_CACHE_KEY_SIZE];
+  marpaEBNFCacheEntry_t *entryp;
+  char                  *pathnames;
+  short                  utf8b;
+  short                  rcb = 1;
+
+  if ((marpaEBNFCachep == NULL) || ((grammars == NULL) && (grammarl > 0))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (utf8b = 0; utf8b <= 1; utf8b++) {
+    _marpaEBNF_cacheKeyv((grammars != NULL) ? grammars : "", grammarl, utf8b, keyp);
+
+    MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+    entryp = _marpaEBNF_cacheEntryp(marpaEBNFCachep, keyp);
+    if (entryp != NULL) {
+      _marpaEBNF_cacheUnlinkv(marpaEBNFCachep, entryp, 1);
+    }
+    MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+
+    if (marpaEBNFCachep->directorys != NULL) {
+      pathnames = _marpaEBNF_cachePathnames(marpaEBNFCachep, keyp, 0);
+      if (pathnames == NULL) {
+        return 0;
+      }
+      if ((remove(pathnames) != 0) && (errno != ENOENT)) {
+        MARPAEBNF_ERRORF(marpaEBNFCachep->genericLoggerp, "%s: %s", pathnames, strerror(errno));
+        rcb = 0;
+      }
+      _marpaEBNF_cachePathFreev(marpaEBNFCachep, pathnames);
+    }
+  }
+
+  return rcb;
+}
+
+/****************************************************************************/
+void marpaEBNFCache_freev(marpaEBNFCache_t *marpaEBNFCachep)
+/****************************************************************************/
+/* Files in the directory are kept                                          */
+/****************************************************************************/
+{
+  marpaEBNFAllocator_t marpaEBNFAllocator;
+
+  if (marpaEBNFCachep == NULL) {
+    return;
+  }
+
+  while (marpaEBNFCachep->oldestp != NULL) {
+    _marpaEBNF_cacheUnlinkv(marpaEBNFCachep, marpaEBNFCachep->oldestp, 1);
+  }
+  if (marpaEBNFCachep->bucketpp != NULL) {
+    _marpaEBNF_memoryFreev(&(marpaEBNFCachep->marpaEBNFAllocator), marpaEBNFCachep->bucketpp);
+  }
+  if (marpaEBNFCachep->directorys != NULL) {
+    _marpaEBNF_memoryFreev(&(marpaEBNFCachep->marpaEBNFAllocator), marpaEBNFCachep->directorys);
+  }
+  MARPAEBNF_MUTEX_DESTROY(&(marpaEBNFCachep->mutex));
+
+  /* The allocator must survive the cache */
+  marpaEBNFAllocator = marpaEBNFCachep->marpaEBNFAllocator;
+  _marpaEBNF_memoryFreev(&marpaEBNFAllocator, marpaEBNFCachep);
+}
+
+/****************************************************************************/
+void _marpaEBNF_cacheKeyv(char *grammars, size_t grammarl, short utf8b, unsigned char *keyp)
+/****************************************************************************/
+{
+  marpaEBNFSha256_t marpaEBNFSha256;
+
+  while ((grammarl > 0) && MARPAEBNF_SCAN_IS_GAP(grammars[grammarl - 1])) {
+    grammarl--;
+  }
+
+  _marpaEBNF_sha256Initv(&marpaEBNFSha256);
+  _marpaEBNF_sha256Updatev(&marpaEBNFSha256, MARPAEBNF_CACHE_KEY_VERSION, strlen(MARPAEBNF_CACHE_KEY_VERSION));
+  if (utf8b) {
+    _marpaEBNF_sha256Updatev(&marpaEBNFSha256, MARPAEBNF_CACHE_KEY_UTF8, strlen(MARPAEBNF_CACHE_KEY_UTF8));
+  }
+  _marpaEBNF_sha256Updatev(&marpaEBNFSha256, grammars, grammarl);
+  _marpaEBNF_sha256Finalv(&marpaEBNFSha256, keyp);
+}
+
+/****************************************************************************/
+marpaEBNFAst_t *_marpaEBNF_cacheGetp(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp)
+/****************************************************************************/
+/* Memory first, then the directory: an AST read from a file is kept in    */
+/* memory for the next lookups.                                             */
+/****************************************************************************/
+{
+  marpaEBNFCacheEntry_t *entryp;
+  marpaEBNFAst_t        *marpaEBNFAstp = NULL;
+  char                  *pathnames;
+  FILE                  *fp;
+  short                  openb;
+
+  MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+  entryp = _marpaEBNF_cacheEntryp(marpaEBNFCachep, keyp);
+  if (entryp != NULL) {
+    _marpaEBNF_cacheUnlinkv(marpaEBNFCachep, entryp, 0);
+    _marpaEBNF_cacheNewestv(marpaEBNFCachep, entryp);
+    marpaEBNFAstp = _marpaEBNF_astClonep(genericLoggerp, marpaEBNFAllocatorp, entryp->astp);
+    if (marpaEBNFAstp != NULL) {
+      marpaEBNFCachep->stats.hitl++;
+    }
+  }
+  MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+  if (entryp != NULL) {
+    return marpaEBNFAstp;
+  }
+
+  if (marpaEBNFCachep->directorys != NULL) {
+    pathnames = _marpaEBNF_cachePathnames(marpaEBNFCachep, keyp, 0);
+    if (pathnames != NULL) {
+      fp = fopen(pathnames, "rb");
+      openb = (fp != NULL);
+      if (openb) {
+        marpaEBNFAstp = _marpaEBNF_astReadp(genericLoggerp, marpaEBNFAllocatorp, fp);
+        fclose(fp);
+        if (marpaEBNFAstp == NULL) {
+          MARPAEBNF_WARNF(marpaEBNFCachep->genericLoggerp, "%s: not an AST, ignored", pathnames);
+        }
+      }
+      _marpaEBNF_cachePathFreev(marpaEBNFCachep, pathnames);
+
+      MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+      if (marpaEBNFAstp != NULL) {
+        marpaEBNFCachep->stats.diskHitl++;
+        if (_marpaEBNF_cacheEntryp(marpaEBNFCachep, keyp) == NULL) {
+          _marpaEBNF_cacheInsertb(marpaEBNFCachep, keyp, marpaEBNFAstp);
+        }
+      } else if (openb) {
+        marpaEBNFCachep->stats.diskErrorl++;
+      }
+      MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+      if (marpaEBNFAstp != NULL) {
+        return marpaEBNFAstp;
+      }
+    }
+  }
+
+  MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+  marpaEBNFCachep->stats.missl++;
+  MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+
+  return NULL;
+}
+
+/****************************************************************************/
+void _marpaEBNF_cachePutv(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp, marpaEBNFAst_t *marpaEBNFAstp)
+/****************************************************************************/
+/* Only the thread that inserts the entry writes the file                   */
+/****************************************************************************/
+{
+  char  *pathnames;
+  char  *temporaryPathnames;
+  FILE  *fp;
+  short  writeb;
+  short  okb = 0;
+
+  MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+  writeb = (_marpaEBNF_cacheEntryp(marpaEBNFCachep, keyp) == NULL) && _marpaEBNF_cacheInsertb(marpaEBNFCachep, keyp, marpaEBNFAstp);
+  MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+
+  if ((! writeb) || (marpaEBNFCachep->directorys == NULL)) {
+    return;
+  }
+
+  pathnames          = _marpaEBNF_cachePathnames(marpaEBNFCachep, keyp, 0);
+  temporaryPathnames = _marpaEBNF_cachePathnames(marpaEBNFCachep, keyp, 1);
+  if ((pathnames != NULL) && (temporaryPathnames != NULL)) {
+    fp = fopen(temporaryPathnames, "wb");
+    if (fp == NULL) {
+      MARPAEBNF_WARNF(marpaEBNFCachep->genericLoggerp, "%s: %s", temporaryPathnames, strerror(errno));
+    } else {
+      okb = _marpaEBNF_astWriteb(marpaEBNFAstp, fp);
+      if ((fclose(fp) != 0) || (! okb)) {
+        MARPAEBNF_WARNF(marpaEBNFCachep->genericLoggerp, "%s: write error", temporaryPathnames);
+        okb = 0;
+      } else if (rename(temporaryPathnames, pathnames) != 0) {
+        /* E.g. written in the meantime by another process, on a system that does not replace */
+        okb = 0;
+      }
+      if (! okb) {
+        remove(temporaryPathnames);
+      }
+    }
+  }
+  if (pathnames != NULL) {
+    _marpaEBNF_cachePathFreev(marpaEBNFCachep, pathnames);
+  }
+  if (temporaryPathnames != NULL) {
+    _marpaEBNF_cachePathFreev(marpaEBNFCachep, temporaryPathnames);
+  }
+
+  MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+  if (okb) {
+    marpaEBNFCachep->stats.diskWritel++;
+  } else {
+    marpaEBNFCachep->stats.diskErrorl++;
+  }
+  MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+}
+
+/****************************************************************************/
+static inline marpaEBNFCacheEntry_t *_marpaEBNF_cacheEntryp(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp)
+/****************************************************************************/
+/* The key is a digest: any of its bytes is a hash already                  */
+/****************************************************************************/
+{
+  marpaEBNFCacheEntry_t *entryp;
+  size_t                 hashl;
+
+  memcpy(&hashl, keyp, sizeof(size_t));
+  for (entryp = marpaEBNFCachep->bucketpp[hashl & (marpaEBNFCachep->bucketl - 1)]; entryp != NULL; entryp = entryp->hashNextp) {
+    if (memcmp(entryp->keyp, keyp, MARPAEBNF_CACHE_KEY_SIZE) == 0) {
+      return entryp;
+    }
+  }
+
+  return NULL;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_cacheInsertb(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp, marpaEBNFAst_t *marpaEBNFAstp)
+/****************************************************************************/
+/* The key must not be in the cache. The least recently used entries make  */
+/* room for the new one, that may itself go if it is above the byte limit.  */
+/****************************************************************************/
+{
+  marpaEBNFCacheEntry_t  *entryp;
+  marpaEBNFCacheEntry_t **bucketpp;
+  size_t                  hashl;
+
+  entryp = (marpaEBNFCacheEntry_t *) _marpaEBNF_memoryMallocp(&(marpaEBNFCachep->marpaEBNFAllocator), sizeof(marpaEBNFCacheEntry_t));
+  if (entryp == NULL) {
+    MARPAEBNF_ERRORF(marpaEBNFCachep->genericLoggerp, "malloc error, %s", strerror(errno));
+    return 0;
+  }
+  entryp->astp = _marpaEBNF_astClonep(marpaEBNFCachep->genericLoggerp, &(marpaEBNFCachep->marpaEBNFAllocator), marpaEBNFAstp);
+  if (entryp->astp == NULL) {
+    _marpaEBNF_memoryFreev(&(marpaEBNFCachep->marpaEBNFAllocator), entryp);
+    return 0;
+  }
+  memcpy(entryp->keyp, keyp, MARPAEBNF_CACHE_KEY_SIZE);
+  entryp->bytel = _marpaEBNF_astSizel(entryp->astp);
+
+  memcpy(&hashl, keyp, sizeof(size_t));
+  bucketpp = &(marpaEBNFCachep->bucketpp[hashl & (marpaEBNFCachep->bucketl - 1)]);
+  entryp->hashNextp = *bucketpp;
+  *bucketpp = entryp;
+  _marpaEBNF_cacheNewestv(marpaEBNFCachep, entryp);
+  marpaEBNFCachep->stats.entryl++;
+  marpaEBNFCachep->stats.bytel += entryp->bytel;
+
+  while ((marpaEBNFCachep->oldestp != NULL)
+         && ((marpaEBNFCachep->stats.entryl > marpaEBNFCachep->maxEntryl)
+             || ((marpaEBNFCachep->maxBytel > 0) && (marpaEBNFCachep->stats.bytel > marpaEBNFCachep->maxBytel)))) {
+    _marpaEBNF_cacheUnlinkv(marpaEBNFCachep, marpaEBNFCachep->oldestp, 1);
+    marpaEBNFCachep->stats.evictionl++;
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_cacheUnlinkv(marpaEBNFCache_t *marpaEBNFCachep, marpaEBNFCacheEntry_t *entryp, short freeb)
+/****************************************************************************/
+/* Out of the recency list, and when freeb is set out of the cache         */
+/****************************************************************************/
+{
+  marpaEBNFCacheEntry_t **entrypp;
+  size_t                  hashl;
+
+  if (entryp->newerp != NULL) {
+    entryp->newerp->olderp = entryp->olderp;
+  } else {
+    marpaEBNFCachep->newestp = entryp->olderp;
+  }
+  if (entryp->olderp != NULL) {
+    entryp->olderp->newerp = entryp->newerp;
+  } else {
+    marpaEBNFCachep->oldestp = entryp->newerp;
+  }
+
+  if (! freeb) {
+    return;
+  }
+
+  memcpy(&hashl, entryp->keyp, sizeof(size_t));
+  for (entrypp = &(marpaEBNFCachep->bucketpp[hashl & (marpaEBNFCachep->bucketl - 1)]); *entrypp != entryp; entrypp = &((*entrypp)->hashNextp)) {
+  }
+  *entrypp = entryp->hashNextp;
+
+  marpaEBNFCachep->stats.entryl--;
+  marpaEBNFCachep->stats.bytel -= entryp->bytel;
+  _marpaEBNF_astFreev(entryp->astp, &(marpaEBNFCachep->marpaEBNFAllocator));
+  _marpaEBNF_memoryFreev(&(marpaEBNFCachep->marpaEBNFAllocator), entryp);
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_cacheNewestv(marpaEBNFCache_t *marpaEBNFCachep, marpaEBNFCacheEntry_t *entryp)
+/****************************************************************************/
+{
+  entryp->newerp = NULL;
+  entryp->olderp = marpaEBNFCachep->newestp;
+  if (marpaEBNFCachep->newestp != NULL) {
+    marpaEBNFCachep->newestp->newerp = entryp;
+  } else {
+    marpaEBNFCachep->oldestp = entryp;
+  }
+  marpaEBNFCachep->newestp = entryp;
+}
+
+/****************************************************************************/
+static inline char *_marpaEBNF_cachePathnames(marpaEBNFCache_t *marpaEBNFCachep, unsigned char *keyp, short temporaryb)
+/****************************************************************************/
+/* <directory>/<key in hex>.ast, and for a temporary file the process and a */
+/* counter are appended: no two writers share one.                          */
+/****************************************************************************/
+{
+  char   *pathnames;
+  char   *p;
+  size_t  i;
+
+  MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+  pathnames = (char *) _marpaEBNF_memoryMallocp(&(marpaEBNFCachep->marpaEBNFAllocator), strlen(marpaEBNFCachep->directorys) + 1 + 2 * MARPAEBNF_CACHE_KEY_SIZE + strlen(MARPAEBNF_CACHE_SUFFIX) + 64);
+  if (pathnames == NULL) {
+    MARPAEBNF_ERRORF(marpaEBNFCachep->genericLoggerp, "malloc error, %s", strerror(errno));
+  } else {
+    p = pathnames + sprintf(pathnames, "%s/", marpaEBNFCachep->directorys);
+    for (i = 0; i < MARPAEBNF_CACHE_KEY_SIZE; i++) {
+      p += sprintf(p, "%02x", (unsigned int) keyp[i]);
+    }
+    p += sprintf(p, "%s", MARPAEBNF_CACHE_SUFFIX);
+    if (temporaryb) {
+      sprintf(p, ".%lu.%lu.tmp", MARPAEBNF_CACHE_PID(), ++(marpaEBNFCachep->temporaryl));
+    }
+  }
+  MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+
+  return pathnames;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_cachePathFreev(marpaEBNFCache_t *marpaEBNFCachep, char *pathnames)
+/****************************************************************************/
+{
+  MARPAEBNF_MUTEX_LOCK(&(marpaEBNFCachep->mutex));
+  _marpaEBNF_memoryFreev(&(marpaEBNFCachep->marpaEBNFAllocator), pathnames);
+  MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFCachep->mutex));
+}
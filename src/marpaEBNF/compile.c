@@ -0,0 +1,1322 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/compile.h"
+
+#define MARPAEBNF_COMPILE_SET_MAX            4096   /* Strings of a finite language */
+#define MARPAEBNF_COMPILE_SET_BYTE_MAX       1048576 /* Bytes of its strings */
+#define MARPAEBNF_COMPILE_REPETITION_MAX     65535  /* Largest integer of a syntactic factor */
+#define MARPAEBNF_COMPILE_RHS_INITIAL_SIZE   64
+#define MARPAEBNF_COMPILE_TEXT_INITIAL_SIZE  4096
+#define MARPAEBNF_COMPILE_SYMBOL_INITIAL_SIZE 256
+#define MARPAEBNF_COMPILE_RULE_INITIAL_SIZE   256
+#define MARPAEBNF_COMPILE_NONE               ((size_t) -1)
+
+/* A finite language is a sorted set of distinct byte strings, in the arena */
+typedef struct marpaEBNFString {
+  char   *s;
+  size_t  l;
+} marpaEBNFString_t;
+
+typedef struct marpaEBNFStringSet {
+  marpaEBNFString_t *stringp;
+  size_t             stringl;
+} marpaEBNFStringSet_t;
+
+/* Language of a meta identifier, computed on demand */
+#define MARPAEBNF_COMPILE_SET_UNKNOWN  0
+#define MARPAEBNF_COMPILE_SET_PENDING  1 /* Being computed: meeting it again means recursion */
+#define MARPAEBNF_COMPILE_SET_FINITE   2
+#define MARPAEBNF_COMPILE_SET_INFINITE 3
+
+typedef struct marpaEBNFIdentifier {
+  char                 *names;        /* Text of the AST leaf */
+  size_t                namel;
+  int                   symboli;
+  size_t                firstRulel;   /* First syntax rule defining it, rules are chained with nextRulelp */
+  size_t                lastRulel;
+  int                   seti;
+  marpaEBNFStringSet_t *setp;
+} marpaEBNFIdentifier_t;
+
+typedef struct marpaEBNFCompiler {
+  genericLogger_t       *genericLoggerp;
+  marpaEBNFAllocator_t  *marpaEBNFAllocatorp;
+  marpaEBNFArena_t      *marpaEBNFArenap;       /* Everything below is in the arena, except rhsip */
+  marpaEBNFAst_t        *marpaEBNFAstp;
+  marpaEBNFCompiled_t   *marpaEBNFCompiledp;
+  marpaEBNFIdentifier_t *identifierp;
+  size_t                 identifierl;
+  size_t                *identifierHashlp;      /* Indice + 1 in identifierp, 0 for a free slot */
+  size_t                 identifierHashMaskl;
+  size_t                *nextRulelp;            /* Per AST node */
+  int                  **ruleHashpp;            /* Declared rules as { lhs, number of rhs, rhs... }, NULL for a free slot */
+  size_t                 ruleHashMaskl;
+  int                   *rhsip;                 /* Stack of the right-hand sides being built */
+  size_t                 rhsl;
+  size_t                 rhsAllocl;
+  size_t                 descriptionAllocl;
+  size_t                 symbolAllocl;
+  size_t                 ruleAllocl;
+  size_t                 rhsSymbolAllocl;
+} marpaEBNFCompiler_t;
+
+/* Control functions of ISO/IEC 6429 that a special sequence may name */
+typedef struct marpaEBNFControl {
+  char          *names;
+  unsigned char  c;
+} marpaEBNFControl_t;
+
+static marpaEBNFControl_t marpaEBNFControlArray[] = {
+  { "Null",                    0x00 },
+  { "Bell",                    0x07 },
+  { "Backspace",               0x08 },
+  { "Horizontal Tabulation",   0x09 },
+  { "Line Feed",               0x0A },
+  { "Vertical Tabulation",     0x0B },
+  { "Line Tabulation",         0x0B },
+  { "Form Feed",               0x0C },
+  { "Carriage Return",         0x0D },
+  { "Escape",                  0x1B },
+  { "Delete",                  0x7F }
+};
+
+#define MARPAEBNF_COMPILE_CONTROL_PREFIX "ISO 6429 character "
+
+static inline unsigned long         _marpaEBNF_compileHashl(char *s, size_t l);
+static inline marpaEBNFIdentifier_t *_marpaEBNF_compileIdentifierp(marpaEBNFCompiler_t *marpaEBNFCompilerp, char *names, size_t namel, short createb);
+static inline marpaEBNFCompiled_t  *_marpaEBNF_compiledAllocp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp);
+static inline short                 _marpaEBNF_compiledGrammarb(marpaEBNFCompiled_t *marpaEBNFCompiledp, genericLogger_t *genericLoggerp);
+static inline int                   _marpaEBNF_compileSymboli(marpaEBNFCompiler_t *marpaEBNFCompilerp, short terminalb, char *descriptions);
+static inline int                   _marpaEBNF_compileGeneratedSymboli(marpaEBNFCompiler_t *marpaEBNFCompilerp, char *whats, size_t nodel);
+static inline int                   _marpaEBNF_compileByteSymboli(marpaEBNFCompiler_t *marpaEBNFCompilerp, unsigned char c);
+static inline short                 _marpaEBNF_compileRhsPushb(marpaEBNFCompiler_t *marpaEBNFCompilerp, int symboli);
+static inline short                 _marpaEBNF_compileRuleb(marpaEBNFCompiler_t *marpaEBNFCompilerp, int lhsSymboli, size_t rhs0l, short sequenceb);
+static inline short                 _marpaEBNF_compileDefinitionsListb(marpaEBNFCompiler_t *marpaEBNFCompilerp, int lhsSymboli, size_t nodel);
+static inline short                 _marpaEBNF_compileTermb(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t nodel);
+static inline short                 _marpaEBNF_compileSpecialb(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t nodel, unsigned char *cp);
+static inline short                 _marpaEBNF_compileIntegerb(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t nodel, size_t *nlp);
+static inline short                 _marpaEBNF_compileSetb(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t nodel, marpaEBNFStringSet_t **setpp);
+static inline marpaEBNFStringSet_t *_marpaEBNF_compileSetNewp(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t stringl);
+static inline void                  _marpaEBNF_compileSetNormalizev(marpaEBNFStringSet_t *setp);
+static inline short                 _marpaEBNF_compileSetUnionb(marpaEBNFCompiler_t *marpaEBNFCompilerp, marpaEBNFStringSet_t *set1p, marpaEBNFStringSet_t *set2p, marpaEBNFStringSet_t **setpp);
+static inline short                 _marpaEBNF_compileSetConcatb(marpaEBNFCompiler_t *marpaEBNFCompilerp, marpaEBNFStringSet_t *set1p, marpaEBNFStringSet_t *set2p, marpaEBNFStringSet_t **setpp);
+static inline marpaEBNFStringSet_t *_marpaEBNF_compileSetDifferencep(marpaEBNFCompiler_t *marpaEBNFCompilerp, marpaEBNFStringSet_t *set1p, marpaEBNFStringSet_t *set2p);
+static int                          _marpaEBNF_compileStringCmpi(const void *p1, const void *p2);
+
+/****************************************************************************/
+marpaEBNFCompiled_t *_marpaEBNF_compileNewp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFArena_t *marpaEBNFArenap, marpaEBNFAst_t *marpaEBNFAstp)
+/****************************************************************************/
+/* Temporary data is in the per-parse arena, the result in the allocator   */
+/****************************************************************************/
+{
+  marpaEBNFCompiler_t    marpaEBNFCompiler;
+  marpaEBNFCompiled_t   *marpaEBNFCompiledp;
+  marpaEBNFIdentifier_t *identifierp;
+  size_t                 firstRulel;
+  size_t                 rulel;
+  size_t                 nodel;
+  size_t                 metal;
+  size_t                 hashl;
+  size_t                 identifierl;
+  size_t                 i;
+
+  marpaEBNFCompiledp = _marpaEBNF_compiledAllocp(genericLoggerp, marpaEBNFAllocatorp);
+  if (marpaEBNFCompiledp == NULL) {
+    return NULL;
+  }
+
+  marpaEBNFCompiler.genericLoggerp          = genericLoggerp;
+  marpaEBNFCompiler.marpaEBNFAllocatorp     = marpaEBNFAllocatorp;
+  marpaEBNFCompiler.marpaEBNFArenap         = marpaEBNFArenap;
+  marpaEBNFCompiler.marpaEBNFAstp           = marpaEBNFAstp;
+  marpaEBNFCompiler.marpaEBNFCompiledp      = marpaEBNFCompiledp;
+  marpaEBNFCompiler.identifierp             = NULL;
+  marpaEBNFCompiler.identifierl             = 0;
+  marpaEBNFCompiler.identifierHashlp        = NULL;
+  marpaEBNFCompiler.identifierHashMaskl     = 0;
+  marpaEBNFCompiler.nextRulelp              = NULL;
+  marpaEBNFCompiler.ruleHashpp              = NULL;
+  marpaEBNFCompiler.ruleHashMaskl           = 0;
+  marpaEBNFCompiler.rhsip                   = NULL;
+  marpaEBNFCompiler.rhsl                    = 0;
+  marpaEBNFCompiler.rhsAllocl               = 0;
+  marpaEBNFCompiler.descriptionAllocl       = 0;
+  marpaEBNFCompiler.symbolAllocl            = 0;
+  marpaEBNFCompiler.ruleAllocl              = 0;
+  marpaEBNFCompiler.rhsSymbolAllocl         = 0;
+
+  if ((marpaEBNFAstp->nodel <= 0) || (marpaEBNFAstp->kindip[0] != MARPAEBNF_AST_SYNTAX)) {
+    MARPAEBNF_ERROR(genericLoggerp, "AST root is not a syntax");
+    goto err;
+  }
+  firstRulel = marpaEBNFAstp->firstChildlp[0];
+  rulel      = marpaEBNFAstp->childlp[0];
+
+  /* Meta identifiers: hash table at most half full */
+  identifierl = 0;
+  for (nodel = 0; nodel < marpaEBNFAstp->nodel; nodel++) {
+    if (marpaEBNFAstp->kindip[nodel] == MARPAEBNF_AST_META_IDENTIFIER) {
+      identifierl++;
+    }
+  }
+  for (hashl = 16; hashl < 2 * identifierl; hashl *= 2) {
+  }
+  marpaEBNFCompiler.identifierp      = (marpaEBNFIdentifier_t *) _marpaEBNF_arenaAllocp(marpaEBNFArenap, identifierl * sizeof(marpaEBNFIdentifier_t));
+  marpaEBNFCompiler.identifierHashlp = (size_t *) _marpaEBNF_arenaAllocp(marpaEBNFArenap, hashl * sizeof(size_t));
+  marpaEBNFCompiler.nextRulelp       = (size_t *) _marpaEBNF_arenaAllocp(marpaEBNFArenap, marpaEBNFAstp->nodel * sizeof(size_t));
+  marpaEBNFCompiler.ruleHashpp       = (int **) _marpaEBNF_arenaAllocp(marpaEBNFArenap, hashl * sizeof(int *));
+  if ((marpaEBNFCompiler.identifierp == NULL) || (marpaEBNFCompiler.identifierHashlp == NULL) || (marpaEBNFCompiler.nextRulelp == NULL) || (marpaEBNFCompiler.ruleHashpp == NULL)) {
+    goto err;
+  }
+  memset(marpaEBNFCompiler.identifierHashlp, 0, hashl * sizeof(size_t));
+  memset(marpaEBNFCompiler.ruleHashpp, 0, hashl * sizeof(int *));
+  marpaEBNFCompiler.identifierHashMaskl = hashl - 1;
+  marpaEBNFCompiler.ruleHashMaskl       = hashl - 1;
+
+  /* Every syntax rule is: meta identifier, definitions list */
+  for (nodel = firstRulel; nodel < firstRulel + rulel; nodel++) {
+    metal = marpaEBNFAstp->firstChildlp[nodel];
+    identifierp = _marpaEBNF_compileIdentifierp(&marpaEBNFCompiler, marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[metal], marpaEBNFAstp->textLengthlp[metal], 1);
+    marpaEBNFCompiler.nextRulelp[nodel] = MARPAEBNF_COMPILE_NONE;
+    if (identifierp->firstRulel == MARPAEBNF_COMPILE_NONE) {
+      identifierp->firstRulel = nodel;
+    } else {
+      marpaEBNFCompiler.nextRulelp[identifierp->lastRulel] = nodel;
+    }
+    identifierp->lastRulel = nodel;
+  }
+
+  /* Meta identifiers that are used without being defined come after */
+  for (nodel = 0; nodel < marpaEBNFAstp->nodel; nodel++) {
+    if (marpaEBNFAstp->kindip[nodel] == MARPAEBNF_AST_META_IDENTIFIER) {
+      _marpaEBNF_compileIdentifierp(&marpaEBNFCompiler, marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[nodel], marpaEBNFAstp->textLengthlp[nodel], 1);
+    }
+  }
+
+  /* One nonterminal per meta identifier, the first one defined is the start symbol. */
+  /* An undefined one is a terminal that no input byte is, i.e. it never matches.   */
+  for (i = 0; i < marpaEBNFCompiler.identifierl; i++) {
+    identifierp = &(marpaEBNFCompiler.identifierp[i]);
+    if (identifierp->firstRulel == MARPAEBNF_COMPILE_NONE) {
+      MARPAEBNF_WARNF(genericLoggerp, "Meta identifier \"%s\" is not defined", identifierp->names);
+    }
+    identifierp->symboli = _marpaEBNF_compileSymboli(&marpaEBNFCompiler, (identifierp->firstRulel == MARPAEBNF_COMPILE_NONE) ? 1 : 0, identifierp->names);
+    if (identifierp->symboli < 0) {
+      goto err;
+    }
+  }
+  marpaEBNFCompiledp->startSymboli = marpaEBNFCompiler.identifierp[0].symboli;
+
+  /* Rules, in source order */
+  for (nodel = firstRulel; nodel < firstRulel + rulel; nodel++) {
+    metal = marpaEBNFAstp->firstChildlp[nodel];
+    identifierp = _marpaEBNF_compileIdentifierp(&marpaEBNFCompiler, marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[metal], marpaEBNFAstp->textLengthlp[metal], 0);
+    if (_marpaEBNF_compileDefinitionsListb(&marpaEBNFCompiler, identifierp->symboli, metal + 1) == 0) {
+      goto err;
+    }
+  }
+
+  if (_marpaEBNF_compiledGrammarb(marpaEBNFCompiledp, genericLoggerp) == 0) {
+    goto err;
+  }
+
+  if (marpaEBNFCompiler.rhsip != NULL) {
+    _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFCompiler.rhsip);
+  }
+  return marpaEBNFCompiledp;
+
+ err:
+  if (marpaEBNFCompiler.rhsip != NULL) {
+    _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFCompiler.rhsip);
+  }
+  _marpaEBNF_compiledFreev(marpaEBNFCompiledp, marpaEBNFAllocatorp);
+  return NULL;
+}
+
+/****************************************************************************/
+marpaEBNFCompiled_t *_marpaEBNF_compiledNewp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, const marpaEBNFGenerated_t *marpaEBNFGeneratedp)
+/****************************************************************************/
+/* Tables are copied: they only have to outlive the call. They are checked  */
+/* as far as indices go, so that a table of another version or a corrupted  */
+/* one is an error and not a crash.                                         */
+/****************************************************************************/
+{
+  marpaEBNFCompiled_t *marpaEBNFCompiledp;
+  size_t               symboll;
+  size_t               rulel;
+  size_t               rhsSymboll = 0;
+  size_t               descriptionl = 0;
+  size_t               i;
+
+  if (marpaEBNFGeneratedp->versioni != MARPAEBNF_GENERATED_VERSION) {
+    MARPAEBNF_ERRORF(genericLoggerp, "Generated grammar is of version %d instead of %d: generate it again", marpaEBNFGeneratedp->versioni, MARPAEBNF_GENERATED_VERSION);
+    return NULL;
+  }
+  symboll = marpaEBNFGeneratedp->symboll;
+  rulel   = marpaEBNFGeneratedp->rulel;
+  if ((symboll <= 0) || (rulel <= 0) || (marpaEBNFGeneratedp->symbolp == NULL) || (marpaEBNFGeneratedp->rulep == NULL) || (marpaEBNFGeneratedp->byteSymbolip == NULL)
+      || ((marpaEBNFGeneratedp->rhsSymbolip == NULL) && (marpaEBNFGeneratedp->rhsSymboll > 0))
+      || (marpaEBNFGeneratedp->startSymboli < 0) || ((size_t) marpaEBNFGeneratedp->startSymboli >= symboll)) {
+    MARPAEBNF_ERROR(genericLoggerp, "Generated grammar is inconsistent");
+    return NULL;
+  }
+  for (i = 0; i < symboll; i++) {
+    if (marpaEBNFGeneratedp->symbolp[i].descriptions == NULL) {
+      MARPAEBNF_ERRORF(genericLoggerp, "Generated grammar: symbol %ld has no description", (long) i);
+      return NULL;
+    }
+    descriptionl += strlen(marpaEBNFGeneratedp->symbolp[i].descriptions) + 1;
+  }
+  for (i = 0; i < rulel; i++) {
+    if ((marpaEBNFGeneratedp->rulep[i].lhsSymboli < 0) || ((size_t) marpaEBNFGeneratedp->rulep[i].lhsSymboli >= symboll) || (marpaEBNFGeneratedp->rulep[i].rhsSymboll > marpaEBNFGeneratedp->rhsSymboll - rhsSymboll)) {
+      MARPAEBNF_ERRORF(genericLoggerp, "Generated grammar: rule %ld is inconsistent", (long) i);
+      return NULL;
+    }
+    rhsSymboll += marpaEBNFGeneratedp->rulep[i].rhsSymboll;
+  }
+  if (rhsSymboll != marpaEBNFGeneratedp->rhsSymboll) {
+    MARPAEBNF_ERRORF(genericLoggerp, "Generated grammar: rules have %ld right-hand side symbols instead of %ld", (long) rhsSymboll, (long) marpaEBNFGeneratedp->rhsSymboll);
+    return NULL;
+  }
+  for (i = 0; i < rhsSymboll; i++) {
+    if ((marpaEBNFGeneratedp->rhsSymbolip[i] < 0) || ((size_t) marpaEBNFGeneratedp->rhsSymbolip[i] >= symboll)) {
+      MARPAEBNF_ERRORF(genericLoggerp, "Generated grammar: right-hand side symbol %ld is out of range", (long) i);
+      return NULL;
+    }
+  }
+  for (i = 0; i < MARPAEBNF_COMPILE_NBYTE; i++) {
+    if ((marpaEBNFGeneratedp->byteSymbolip[i] < -1) || (marpaEBNFGeneratedp->byteSymbolip[i] >= (int) symboll)) {
+      MARPAEBNF_ERRORF(genericLoggerp, "Generated grammar: symbol of byte 0x%02x is out of range", (unsigned int) i);
+      return NULL;
+    }
+  }
+
+  marpaEBNFCompiledp = _marpaEBNF_compiledAllocp(genericLoggerp, marpaEBNFAllocatorp);
+  if (marpaEBNFCompiledp == NULL) {
+    return NULL;
+  }
+  marpaEBNFCompiledp->descriptionOffsetlp = (size_t *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, symboll * sizeof(size_t));
+  marpaEBNFCompiledp->terminalbp          = (short *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, symboll * sizeof(short));
+  marpaEBNFCompiledp->descriptions        = (char *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, descriptionl);
+  marpaEBNFCompiledp->rulep               = (marpaEBNFGeneratedRule_t *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, rulel * sizeof(marpaEBNFGeneratedRule_t));
+  if (rhsSymboll > 0) {
+    marpaEBNFCompiledp->rhsSymbolip       = (int *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, rhsSymboll * sizeof(int));
+  }
+  if ((marpaEBNFCompiledp->descriptionOffsetlp == NULL) || (marpaEBNFCompiledp->terminalbp == NULL) || (marpaEBNFCompiledp->descriptions == NULL) || (marpaEBNFCompiledp->rulep == NULL) || ((rhsSymboll > 0) && (marpaEBNFCompiledp->rhsSymbolip == NULL))) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    goto err;
+  }
+
+  for (i = 0; i < symboll; i++) {
+    descriptionl = strlen(marpaEBNFGeneratedp->symbolp[i].descriptions) + 1;
+    memcpy(marpaEBNFCompiledp->descriptions + marpaEBNFCompiledp->descriptionl, marpaEBNFGeneratedp->symbolp[i].descriptions, descriptionl);
+    marpaEBNFCompiledp->descriptionOffsetlp[i] = marpaEBNFCompiledp->descriptionl;
+    marpaEBNFCompiledp->descriptionl += descriptionl;
+    marpaEBNFCompiledp->terminalbp[i] = marpaEBNFGeneratedp->symbolp[i].terminalb;
+  }
+  memcpy(marpaEBNFCompiledp->rulep, marpaEBNFGeneratedp->rulep, rulel * sizeof(marpaEBNFGeneratedRule_t));
+  if (rhsSymboll > 0) {
+    memcpy(marpaEBNFCompiledp->rhsSymbolip, marpaEBNFGeneratedp->rhsSymbolip, rhsSymboll * sizeof(int));
+  }
+  memcpy(marpaEBNFCompiledp->byteSymbolip, marpaEBNFGeneratedp->byteSymbolip, MARPAEBNF_COMPILE_NBYTE * sizeof(int));
+  marpaEBNFCompiledp->nSymboll     = symboll;
+  marpaEBNFCompiledp->nRulel       = rulel;
+  marpaEBNFCompiledp->rhsSymboll   = rhsSymboll;
+  marpaEBNFCompiledp->startSymboli = marpaEBNFGeneratedp->startSymboli;
+
+  if (_marpaEBNF_compiledGrammarb(marpaEBNFCompiledp, genericLoggerp) == 0) {
+    goto err;
+  }
+
+  return marpaEBNFCompiledp;
+
+ err:
+  _marpaEBNF_compiledFreev(marpaEBNFCompiledp, marpaEBNFAllocatorp);
+  return NULL;
+}
+
+/****************************************************************************/
+char *_marpaEBNF_compiledDescriptions(marpaEBNFCompiled_t *marpaEBNFCompiledp, int symboli)
+/****************************************************************************/
+{
+  if ((symboli < 0) || ((size_t) symboli >= marpaEBNFCompiledp->nSymboll)) {
+    return "?";
+  }
+
+  return marpaEBNFCompiledp->descriptions + marpaEBNFCompiledp->descriptionOffsetlp[symboli];
+}
+
+/****************************************************************************/
+void _marpaEBNF_compiledFreev(marpaEBNFCompiled_t *marpaEBNFCompiledp, marpaEBNFAllocator_t *marpaEBNFAllocatorp)
+/****************************************************************************/
+{
+  if (marpaEBNFCompiledp != NULL) {
+    if (marpaEBNFCompiledp->marpaWrapperGrammarp != NULL) {
+      marpaWrapperGrammar_freev(marpaEBNFCompiledp->marpaWrapperGrammarp);
+    }
+    if (marpaEBNFCompiledp->descriptionOffsetlp != NULL) {
+      _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFCompiledp->descriptionOffsetlp);
+    }
+    if (marpaEBNFCompiledp->descriptions != NULL) {
+      _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFCompiledp->descriptions);
+    }
+    if (marpaEBNFCompiledp->terminalbp != NULL) {
+      _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFCompiledp->terminalbp);
+    }
+    if (marpaEBNFCompiledp->rulep != NULL) {
+      _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFCompiledp->rulep);
+    }
+    if (marpaEBNFCompiledp->rhsSymbolip != NULL) {
+      _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFCompiledp->rhsSymbolip);
+    }
+    _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFCompiledp);
+  }
+}
+
+/****************************************************************************/
+static inline marpaEBNFCompiled_t *_marpaEBNF_compiledAllocp(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp)
+/****************************************************************************/
+{
+  marpaEBNFCompiled_t *marpaEBNFCompiledp;
+  size_t               i;
+
+  marpaEBNFCompiledp = (marpaEBNFCompiled_t *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, sizeof(marpaEBNFCompiled_t));
+  if (marpaEBNFCompiledp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    return NULL;
+  }
+  marpaEBNFCompiledp->marpaWrapperGrammarp = NULL;
+  marpaEBNFCompiledp->startSymboli         = -1;
+  for (i = 0; i < MARPAEBNF_COMPILE_NBYTE; i++) {
+    marpaEBNFCompiledp->byteSymbolip[i] = -1;
+  }
+  marpaEBNFCompiledp->nSymboll             = 0;
+  marpaEBNFCompiledp->nRulel               = 0;
+  marpaEBNFCompiledp->descriptionOffsetlp  = NULL;
+  marpaEBNFCompiledp->descriptions         = NULL;
+  marpaEBNFCompiledp->descriptionl         = 0;
+  marpaEBNFCompiledp->terminalbp           = NULL;
+  marpaEBNFCompiledp->rulep                = NULL;
+  marpaEBNFCompiledp->rhsSymbolip          = NULL;
+  marpaEBNFCompiledp->rhsSymboll           = 0;
+
+  return marpaEBNFCompiledp;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compiledGrammarb(marpaEBNFCompiled_t *marpaEBNFCompiledp, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Declares the symbols and the rules of the tables, then precomputes, as   */
+/* the internal grammars are built from theirs                              */
+/****************************************************************************/
+{
+  marpaWrapperGrammarOption_t       marpaWrapperGrammarOption;
+  marpaWrapperGrammarSymbolOption_t marpaWrapperGrammarSymbolOption;
+  marpaEBNFGeneratedRule_t         *rulep;
+  size_t                            offsetl = 0;
+  size_t                            i;
+  int                               symboli;
+  int                               rulei;
+
+  marpaWrapperGrammarOption.genericLoggerp    = genericLoggerp;
+  marpaWrapperGrammarOption.warningIsErrorb   = 0;
+  marpaWrapperGrammarOption.warningIsIgnoredb = 0;
+  marpaWrapperGrammarOption.autorankb         = 0;
+  marpaEBNFCompiledp->marpaWrapperGrammarp = marpaWrapperGrammar_newp(&marpaWrapperGrammarOption);
+  if (marpaEBNFCompiledp->marpaWrapperGrammarp == NULL) {
+    return 0;
+  }
+
+  for (i = 0; i < marpaEBNFCompiledp->nSymboll; i++) {
+    marpaWrapperGrammarSymbolOption.terminalb = marpaEBNFCompiledp->terminalbp[i];
+    marpaWrapperGrammarSymbolOption.startb    = ((int) i == marpaEBNFCompiledp->startSymboli) ? 1 : 0;
+    marpaWrapperGrammarSymbolOption.eventSeti = 0; /* No event */
+    symboli = marpaWrapperGrammar_newSymboli(marpaEBNFCompiledp->marpaWrapperGrammarp, &marpaWrapperGrammarSymbolOption);
+    /* Symbols are numbered from 0, as for the internal grammars */
+    if (symboli != (int) i) {
+      MARPAEBNF_ERRORF(genericLoggerp, "symboli is %d != %d", symboli, (int) i);
+      return 0;
+    }
+  }
+
+  for (i = 0; i < marpaEBNFCompiledp->nRulel; i++) {
+    rulep = &(marpaEBNFCompiledp->rulep[i]);
+    rulei = marpaWrapperGrammar_newRulei(marpaEBNFCompiledp->marpaWrapperGrammarp, &(rulep->option), rulep->lhsSymboli, rulep->rhsSymboll, (rulep->rhsSymboll > 0) ? marpaEBNFCompiledp->rhsSymbolip + offsetl : NULL);
+    if (rulei != (int) i) {
+      MARPAEBNF_ERRORF(genericLoggerp, "rulei is %d != %d", rulei, (int) i);
+      return 0;
+    }
+    offsetl += rulep->rhsSymboll;
+  }
+
+  return marpaWrapperGrammar_precomputeb(marpaEBNFCompiledp->marpaWrapperGrammarp);
+}
+
+/****************************************************************************/
+static inline unsigned long _marpaEBNF_compileHashl(char *s, size_t l)
+/****************************************************************************/
+{
+  unsigned long hashl = 2166136261UL; /* FNV-1a */
+  size_t        i;
+
+  for (i = 0; i < l; i++) {
+    hashl = ((hashl ^ (unsigned long) (unsigned char) s[i]) * 16777619UL) & 0xFFFFFFFFUL;
+  }
+
+  return hashl;
+}
+
+/****************************************************************************/
+static inline marpaEBNFIdentifier_t *_marpaEBNF_compileIdentifierp(marpaEBNFCompiler_t *marpaEBNFCompilerp, char *names, size_t namel, short createb)
+/****************************************************************************/
+/* Lookup, with creation when createb is true. The table is sized for all  */
+/* the meta identifiers of the AST: creation cannot fail.                   */
+/****************************************************************************/
+{
+  size_t                 hashl = (size_t) _marpaEBNF_compileHashl(names, namel) & marpaEBNFCompilerp->identifierHashMaskl;
+  marpaEBNFIdentifier_t *identifierp;
+  size_t                 indicel;
+
+  while ((indicel = marpaEBNFCompilerp->identifierHashlp[hashl]) > 0) {
+    identifierp = &(marpaEBNFCompilerp->identifierp[indicel - 1]);
+    if ((identifierp->namel == namel) && (memcmp(identifierp->names, names, namel) == 0)) {
+      return identifierp;
+    }
+    hashl = (hashl + 1) & marpaEBNFCompilerp->identifierHashMaskl;
+  }
+
+  if (! createb) {
+    return NULL;
+  }
+
+  identifierp = &(marpaEBNFCompilerp->identifierp[marpaEBNFCompilerp->identifierl++]);
+  identifierp->names      = names;
+  identifierp->namel      = namel;
+  identifierp->symboli    = -1;
+  identifierp->firstRulel = MARPAEBNF_COMPILE_NONE;
+  identifierp->lastRulel  = MARPAEBNF_COMPILE_NONE;
+  identifierp->seti       = MARPAEBNF_COMPILE_SET_UNKNOWN;
+  identifierp->setp       = NULL;
+  marpaEBNFCompilerp->identifierHashlp[hashl] = marpaEBNFCompilerp->identifierl;
+
+  return identifierp;
+}
+
+/****************************************************************************/
+static inline int _marpaEBNF_compileSymboli(marpaEBNFCompiler_t *marpaEBNFCompilerp, short terminalb, char *descriptions)
+/****************************************************************************/
+{
+  marpaEBNFCompiled_t *marpaEBNFCompiledp = marpaEBNFCompilerp->marpaEBNFCompiledp;
+  size_t               descriptionl = strlen(descriptions) + 1;
+  size_t               allocl;
+  size_t              *descriptionOffsetlp;
+  short               *terminalbp;
+  char                *newdescriptions;
+
+  if (marpaEBNFCompiledp->nSymboll >= marpaEBNFCompilerp->symbolAllocl) {
+    allocl = (marpaEBNFCompilerp->symbolAllocl > 0) ? marpaEBNFCompilerp->symbolAllocl * 2 : MARPAEBNF_COMPILE_SYMBOL_INITIAL_SIZE;
+    descriptionOffsetlp = (size_t *) _marpaEBNF_memoryReallocp(marpaEBNFCompilerp->marpaEBNFAllocatorp, marpaEBNFCompiledp->descriptionOffsetlp, allocl * sizeof(size_t));
+    if (descriptionOffsetlp == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "realloc error, %s", strerror(errno));
+      return -1;
+    }
+    marpaEBNFCompiledp->descriptionOffsetlp = descriptionOffsetlp;
+    terminalbp = (short *) _marpaEBNF_memoryReallocp(marpaEBNFCompilerp->marpaEBNFAllocatorp, marpaEBNFCompiledp->terminalbp, allocl * sizeof(short));
+    if (terminalbp == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "realloc error, %s", strerror(errno));
+      return -1;
+    }
+    marpaEBNFCompiledp->terminalbp   = terminalbp;
+    marpaEBNFCompilerp->symbolAllocl = allocl;
+  }
+  if (marpaEBNFCompiledp->descriptionl + descriptionl > marpaEBNFCompilerp->descriptionAllocl) {
+    allocl = (marpaEBNFCompilerp->descriptionAllocl > 0) ? marpaEBNFCompilerp->descriptionAllocl : MARPAEBNF_COMPILE_TEXT_INITIAL_SIZE;
+    while (marpaEBNFCompiledp->descriptionl + descriptionl > allocl) {
+      allocl *= 2;
+    }
+    newdescriptions = (char *) _marpaEBNF_memoryReallocp(marpaEBNFCompilerp->marpaEBNFAllocatorp, marpaEBNFCompiledp->descriptions, allocl);
+    if (newdescriptions == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "realloc error, %s", strerror(errno));
+      return -1;
+    }
+    marpaEBNFCompiledp->descriptions      = newdescriptions;
+    marpaEBNFCompilerp->descriptionAllocl = allocl;
+  }
+
+  /* Declared in marpa by _marpaEBNF_compiledGrammarb(), with the same number */
+  memcpy(marpaEBNFCompiledp->descriptions + marpaEBNFCompiledp->descriptionl, descriptions, descriptionl);
+  marpaEBNFCompiledp->descriptionOffsetlp[marpaEBNFCompiledp->nSymboll] = marpaEBNFCompiledp->descriptionl;
+  marpaEBNFCompiledp->descriptionl += descriptionl;
+  marpaEBNFCompiledp->terminalbp[marpaEBNFCompiledp->nSymboll] = terminalb;
+
+  return (int) marpaEBNFCompiledp->nSymboll++;
+}
+
+/****************************************************************************/
+static inline int _marpaEBNF_compileGeneratedSymboli(marpaEBNFCompiler_t *marpaEBNFCompilerp, char *whats, size_t nodel)
+/****************************************************************************/
+/* Symbol of a construct of the grammar, described by its source offset    */
+/****************************************************************************/
+{
+  char descriptions[128];
+
+  sprintf(descriptions, "<%s at offset %ld>", whats, (long) marpaEBNFCompilerp->marpaEBNFAstp->offsetlp[nodel]);
+  return _marpaEBNF_compileSymboli(marpaEBNFCompilerp, 0, descriptions);
+}
+
+/****************************************************************************/
+static inline int _marpaEBNF_compileByteSymboli(marpaEBNFCompiler_t *marpaEBNFCompilerp, unsigned char c)
+/****************************************************************************/
+{
+  marpaEBNFCompiled_t *marpaEBNFCompiledp = marpaEBNFCompilerp->marpaEBNFCompiledp;
+  char                 descriptions[16];
+
+  if (marpaEBNFCompiledp->byteSymbolip[c] < 0) {
+    if ((c >= 0x20) && (c < 0x7F) && (c != '\'')) {
+      sprintf(descriptions, "'%c'", (char) c);
+    } else {
+      sprintf(descriptions, "0x%02x", (unsigned int) c);
+    }
+    marpaEBNFCompiledp->byteSymbolip[c] = _marpaEBNF_compileSymboli(marpaEBNFCompilerp, 1, descriptions);
+  }
+
+  return marpaEBNFCompiledp->byteSymbolip[c];
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileRhsPushb(marpaEBNFCompiler_t *marpaEBNFCompilerp, int symboli)
+/****************************************************************************/
+{
+  int    *rhsip;
+  size_t  allocl;
+
+  if (symboli < 0) {
+    return 0;
+  }
+
+  if (marpaEBNFCompilerp->rhsl >= marpaEBNFCompilerp->rhsAllocl) {
+    allocl = (marpaEBNFCompilerp->rhsAllocl > 0) ? marpaEBNFCompilerp->rhsAllocl * 2 : MARPAEBNF_COMPILE_RHS_INITIAL_SIZE;
+    rhsip = (int *) _marpaEBNF_memoryReallocp(marpaEBNFCompilerp->marpaEBNFAllocatorp, marpaEBNFCompilerp->rhsip, allocl * sizeof(int));
+    if (rhsip == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "realloc error, %s", strerror(errno));
+      return 0;
+    }
+    marpaEBNFCompilerp->rhsip     = rhsip;
+    marpaEBNFCompilerp->rhsAllocl = allocl;
+  }
+  marpaEBNFCompilerp->rhsip[marpaEBNFCompilerp->rhsl++] = symboli;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileRuleb(marpaEBNFCompiler_t *marpaEBNFCompilerp, int lhsSymboli, size_t rhs0l, short sequenceb)
+/****************************************************************************/
+/* Declares lhsSymboli ::= the right-hand side stacked from rhs0l, then    */
+/* pops it. Marpa refuses duplicate rules, e.g. from a = 'x' | 'x': they    */
+/* are the same language and are declared once.                             */
+/****************************************************************************/
+{
+  marpaEBNFCompiled_t       *marpaEBNFCompiledp = marpaEBNFCompilerp->marpaEBNFCompiledp;
+  size_t                     rhsl = marpaEBNFCompilerp->rhsl - rhs0l;
+  int                       *rhsip = marpaEBNFCompilerp->rhsip + rhs0l;
+  int                      **ruleHashpp;
+  int                       *rulep;
+  marpaEBNFGeneratedRule_t  *newrulep;
+  int                       *rhsSymbolip;
+  unsigned long              hashl;
+  size_t                     newMaskl;
+  size_t                     slotl;
+  size_t                     allocl;
+  size_t                     i;
+  size_t                     j;
+
+  if (! sequenceb) {
+    /* A rule is the int array { lhs, rhsl, rhs... } */
+    hashl = _marpaEBNF_compileHashl((char *) &lhsSymboli, sizeof(int));
+    hashl = (hashl << 5) ^ _marpaEBNF_compileHashl((char *) rhsip, rhsl * sizeof(int));
+    for (slotl = (size_t) hashl & marpaEBNFCompilerp->ruleHashMaskl; (rulep = marpaEBNFCompilerp->ruleHashpp[slotl]) != NULL; slotl = (slotl + 1) & marpaEBNFCompilerp->ruleHashMaskl) {
+      if ((rulep[0] == lhsSymboli) && ((size_t) rulep[1] == rhsl) && ((rhsl <= 0) || (memcmp(rulep + 2, rhsip, rhsl * sizeof(int)) == 0))) {
+        marpaEBNFCompilerp->rhsl = rhs0l;
+        return 1;
+      }
+    }
+    rulep = (int *) _marpaEBNF_arenaAllocp(marpaEBNFCompilerp->marpaEBNFArenap, (rhsl + 2) * sizeof(int));
+    if (rulep == NULL) {
+      return 0;
+    }
+    rulep[0] = lhsSymboli;
+    rulep[1] = (int) rhsl;
+    if (rhsl > 0) {
+      memcpy(rulep + 2, rhsip, rhsl * sizeof(int));
+    }
+    marpaEBNFCompilerp->ruleHashpp[slotl] = rulep;
+
+    /* Keep the table at most half full */
+    if (2 * (marpaEBNFCompiledp->nRulel + 1) > marpaEBNFCompilerp->ruleHashMaskl) {
+      newMaskl = marpaEBNFCompilerp->ruleHashMaskl * 2 + 1;
+      ruleHashpp = (int **) _marpaEBNF_arenaAllocp(marpaEBNFCompilerp->marpaEBNFArenap, (newMaskl + 1) * sizeof(int *));
+      if (ruleHashpp == NULL) {
+        return 0;
+      }
+      memset(ruleHashpp, 0, (newMaskl + 1) * sizeof(int *));
+      for (i = 0; i <= marpaEBNFCompilerp->ruleHashMaskl; i++) {
+        if ((rulep = marpaEBNFCompilerp->ruleHashpp[i]) != NULL) {
+          hashl = _marpaEBNF_compileHashl((char *) rulep, sizeof(int));
+          hashl = (hashl << 5) ^ _marpaEBNF_compileHashl((char *) (rulep + 2), (size_t) rulep[1] * sizeof(int));
+          for (j = (size_t) hashl & newMaskl; ruleHashpp[j] != NULL; j = (j + 1) & newMaskl) {
+          }
+          ruleHashpp[j] = rulep;
+        }
+      }
+      marpaEBNFCompilerp->ruleHashpp    = ruleHashpp;
+      marpaEBNFCompilerp->ruleHashMaskl = newMaskl;
+    }
+  }
+
+  if (marpaEBNFCompiledp->nRulel >= marpaEBNFCompilerp->ruleAllocl) {
+    allocl = (marpaEBNFCompilerp->ruleAllocl > 0) ? marpaEBNFCompilerp->ruleAllocl * 2 : MARPAEBNF_COMPILE_RULE_INITIAL_SIZE;
+    newrulep = (marpaEBNFGeneratedRule_t *) _marpaEBNF_memoryReallocp(marpaEBNFCompilerp->marpaEBNFAllocatorp, marpaEBNFCompiledp->rulep, allocl * sizeof(marpaEBNFGeneratedRule_t));
+    if (newrulep == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "realloc error, %s", strerror(errno));
+      return 0;
+    }
+    marpaEBNFCompiledp->rulep      = newrulep;
+    marpaEBNFCompilerp->ruleAllocl = allocl;
+  }
+  if (marpaEBNFCompiledp->rhsSymboll + rhsl > marpaEBNFCompilerp->rhsSymbolAllocl) {
+    allocl = (marpaEBNFCompilerp->rhsSymbolAllocl > 0) ? marpaEBNFCompilerp->rhsSymbolAllocl : MARPAEBNF_COMPILE_RULE_INITIAL_SIZE;
+    while (marpaEBNFCompiledp->rhsSymboll + rhsl > allocl) {
+      allocl *= 2;
+    }
+    rhsSymbolip = (int *) _marpaEBNF_memoryReallocp(marpaEBNFCompilerp->marpaEBNFAllocatorp, marpaEBNFCompiledp->rhsSymbolip, allocl * sizeof(int));
+    if (rhsSymbolip == NULL) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "realloc error, %s", strerror(errno));
+      return 0;
+    }
+    marpaEBNFCompiledp->rhsSymbolip     = rhsSymbolip;
+    marpaEBNFCompilerp->rhsSymbolAllocl = allocl;
+  }
+
+  /* Declared in marpa by _marpaEBNF_compiledGrammarb() */
+  newrulep = &(marpaEBNFCompiledp->rulep[marpaEBNFCompiledp->nRulel++]);
+  newrulep->option.ranki            = 0;
+  newrulep->option.nullRanksHighb   = 0;
+  newrulep->option.sequenceb        = sequenceb;
+  newrulep->option.separatorSymboli = -1;
+  newrulep->option.properb          = 0;
+  newrulep->option.minimumi         = 0;
+  newrulep->lhsSymboli              = lhsSymboli;
+  newrulep->rhsSymboll              = rhsl;
+  if (rhsl > 0) {
+    memcpy(marpaEBNFCompiledp->rhsSymbolip + marpaEBNFCompiledp->rhsSymboll, rhsip, rhsl * sizeof(int));
+    marpaEBNFCompiledp->rhsSymboll += rhsl;
+  }
+  marpaEBNFCompilerp->rhsl = rhs0l;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileDefinitionsListb(marpaEBNFCompiler_t *marpaEBNFCompilerp, int lhsSymboli, size_t nodel)
+/****************************************************************************/
+/* One rule per single definition                                           */
+/****************************************************************************/
+{
+  marpaEBNFAst_t *marpaEBNFAstp = marpaEBNFCompilerp->marpaEBNFAstp;
+  size_t          rhs0l         = marpaEBNFCompilerp->rhsl;
+  size_t          definitionl;
+  size_t          terml;
+
+  for (definitionl = marpaEBNFAstp->firstChildlp[nodel]; definitionl < marpaEBNFAstp->firstChildlp[nodel] + marpaEBNFAstp->childlp[nodel]; definitionl++) {
+    for (terml = marpaEBNFAstp->firstChildlp[definitionl]; terml < marpaEBNFAstp->firstChildlp[definitionl] + marpaEBNFAstp->childlp[definitionl]; terml++) {
+      if (_marpaEBNF_compileTermb(marpaEBNFCompilerp, terml) == 0) {
+        return 0;
+      }
+    }
+    if (_marpaEBNF_compileRuleb(marpaEBNFCompilerp, lhsSymboli, rhs0l, 0) == 0) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileTermb(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t nodel)
+/****************************************************************************/
+/* Pushes the symbols of a term on the right-hand side being built          */
+/****************************************************************************/
+{
+  marpaEBNFAst_t        *marpaEBNFAstp = marpaEBNFCompilerp->marpaEBNFAstp;
+  size_t                 firstChildl   = marpaEBNFAstp->firstChildlp[nodel];
+  char                  *texts         = marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[nodel];
+  size_t                 textl         = marpaEBNFAstp->textLengthlp[nodel];
+  marpaEBNFIdentifier_t *identifierp;
+  marpaEBNFStringSet_t  *setp;
+  marpaEBNFStringSet_t  *exceptSetp;
+  unsigned char          c;
+  char                   descriptions[64];
+  size_t                 rhs0l;
+  size_t                 rhs1l;
+  size_t                 nl;
+  size_t                 i;
+  size_t                 j;
+  int                    symboli;
+  int                    itemSymboli;
+  short                  rcb;
+
+  switch (marpaEBNFAstp->kindip[nodel]) {
+  case MARPAEBNF_AST_META_IDENTIFIER:
+    identifierp = _marpaEBNF_compileIdentifierp(marpaEBNFCompilerp, texts, textl, 0);
+    return _marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, identifierp->symboli);
+
+  case MARPAEBNF_AST_TERMINAL_STRING:
+    for (i = 0; i < textl; i++) {
+      if (_marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, _marpaEBNF_compileByteSymboli(marpaEBNFCompilerp, (unsigned char) texts[i])) == 0) {
+        return 0;
+      }
+    }
+    return 1;
+
+  case MARPAEBNF_AST_SPECIAL_SEQUENCE:
+    if (_marpaEBNF_compileSpecialb(marpaEBNFCompilerp, nodel, &c) == 0) {
+      /* A terminal that no input byte is: the sequence never matches */
+      sprintf(descriptions, "<special sequence at offset %ld>", (long) marpaEBNFAstp->offsetlp[nodel]);
+      return _marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, _marpaEBNF_compileSymboli(marpaEBNFCompilerp, 1, descriptions));
+    }
+    return _marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, _marpaEBNF_compileByteSymboli(marpaEBNFCompilerp, c));
+
+  case MARPAEBNF_AST_EMPTY_SEQUENCE:
+    return 1;
+
+  case MARPAEBNF_AST_OPTIONAL_SEQUENCE:
+    /* [ x ] is x or nothing */
+    symboli = _marpaEBNF_compileGeneratedSymboli(marpaEBNFCompilerp, "optional sequence", nodel);
+    if ((symboli < 0) || (_marpaEBNF_compileDefinitionsListb(marpaEBNFCompilerp, symboli, firstChildl) == 0)) {
+      return 0;
+    }
+    if (_marpaEBNF_compileRuleb(marpaEBNFCompilerp, symboli, marpaEBNFCompilerp->rhsl, 0) == 0) {
+      return 0;
+    }
+    return _marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, symboli);
+
+  case MARPAEBNF_AST_REPEATED_SEQUENCE:
+    /* { x } is a sequence rule of x, itself a symbol unless it is a lone meta identifier */
+    symboli = _marpaEBNF_compileGeneratedSymboli(marpaEBNFCompilerp, "repeated sequence", nodel);
+    if (symboli < 0) {
+      return 0;
+    }
+    j = marpaEBNFAstp->firstChildlp[firstChildl];
+    if ((marpaEBNFAstp->childlp[firstChildl] == 1) && (marpaEBNFAstp->childlp[j] == 1) && (marpaEBNFAstp->kindip[marpaEBNFAstp->firstChildlp[j]] == MARPAEBNF_AST_META_IDENTIFIER)) {
+      rhs0l = marpaEBNFCompilerp->rhsl;
+      if (_marpaEBNF_compileTermb(marpaEBNFCompilerp, marpaEBNFAstp->firstChildlp[j]) == 0) {
+        return 0;
+      }
+    } else {
+      itemSymboli = _marpaEBNF_compileGeneratedSymboli(marpaEBNFCompilerp, "repeated item", nodel);
+      if ((itemSymboli < 0) || (_marpaEBNF_compileDefinitionsListb(marpaEBNFCompilerp, itemSymboli, firstChildl) == 0)) {
+        return 0;
+      }
+      rhs0l = marpaEBNFCompilerp->rhsl;
+      if (_marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, itemSymboli) == 0) {
+        return 0;
+      }
+    }
+    if (_marpaEBNF_compileRuleb(marpaEBNFCompilerp, symboli, rhs0l, 1) == 0) {
+      return 0;
+    }
+    return _marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, symboli);
+
+  case MARPAEBNF_AST_GROUPED_SEQUENCE:
+    symboli = _marpaEBNF_compileGeneratedSymboli(marpaEBNFCompilerp, "grouped sequence", nodel);
+    if ((symboli < 0) || (_marpaEBNF_compileDefinitionsListb(marpaEBNFCompilerp, symboli, firstChildl) == 0)) {
+      return 0;
+    }
+    return _marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, symboli);
+
+  case MARPAEBNF_AST_REPETITION:
+    /* n * x is x written n times */
+    if (_marpaEBNF_compileIntegerb(marpaEBNFCompilerp, firstChildl, &nl) == 0) {
+      return 0;
+    }
+    rhs0l = marpaEBNFCompilerp->rhsl;
+    if (_marpaEBNF_compileTermb(marpaEBNFCompilerp, firstChildl + 1) == 0) {
+      return 0;
+    }
+    rhs1l = marpaEBNFCompilerp->rhsl;
+    if (nl <= 0) {
+      marpaEBNFCompilerp->rhsl = rhs0l;
+      return 1;
+    }
+    for (i = 1; i < nl; i++) {
+      for (j = rhs0l; j < rhs1l; j++) {
+        if (_marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, marpaEBNFCompilerp->rhsip[j]) == 0) {
+          return 0;
+        }
+      }
+    }
+    return 1;
+
+  case MARPAEBNF_AST_EXCEPTION:
+    /* x - y is the finite language of x minus the one of y, one rule per    */
+    /* string. ISO/IEC 14977 4.7 only requires y to be finite: an infinite x */
+    /* is a deviation from the standard, that is not supported.              */
+    rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, firstChildl + 1, &exceptSetp);
+    if (rcb < 0) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "Offset %ld: a syntactic exception must be a finite language of at most %d strings and %d bytes", (long) marpaEBNFAstp->offsetlp[firstChildl + 1], MARPAEBNF_COMPILE_SET_MAX, MARPAEBNF_COMPILE_SET_BYTE_MAX);
+      return 0;
+    }
+    if (rcb == 0) {
+      return 0;
+    }
+    rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, firstChildl, &setp);
+    if (rcb < 0) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "Offset %ld: the factor of an exception must be a finite language of at most %d strings and %d bytes: an infinite one is not supported", (long) marpaEBNFAstp->offsetlp[firstChildl], MARPAEBNF_COMPILE_SET_MAX, MARPAEBNF_COMPILE_SET_BYTE_MAX);
+      return 0;
+    }
+    if (rcb == 0) {
+      return 0;
+    }
+    setp = _marpaEBNF_compileSetDifferencep(marpaEBNFCompilerp, setp, exceptSetp);
+    if (setp == NULL) {
+      return 0;
+    }
+    symboli = _marpaEBNF_compileGeneratedSymboli(marpaEBNFCompilerp, "exception", nodel);
+    if (symboli < 0) {
+      return 0;
+    }
+    for (i = 0; i < setp->stringl; i++) {
+      rhs0l = marpaEBNFCompilerp->rhsl;
+      for (j = 0; j < setp->stringp[i].l; j++) {
+        if (_marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, _marpaEBNF_compileByteSymboli(marpaEBNFCompilerp, (unsigned char) setp->stringp[i].s[j])) == 0) {
+          return 0;
+        }
+      }
+      if (_marpaEBNF_compileRuleb(marpaEBNFCompilerp, symboli, rhs0l, 0) == 0) {
+        return 0;
+      }
+    }
+    return _marpaEBNF_compileRhsPushb(marpaEBNFCompilerp, symboli);
+
+  default:
+    MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "Offset %ld: unexpected AST node kind %d", (long) marpaEBNFAstp->offsetlp[nodel], marpaEBNFAstp->kindip[nodel]);
+    return 0;
+  }
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileSpecialb(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t nodel, unsigned char *cp)
+/****************************************************************************/
+/* The meaning of a special sequence is implementation defined. The only    */
+/* ones known are ISO 6429 control functions, as used by the standard       */
+/* itself: ? ISO 6429 character Horizontal Tabulation ?. Gap separators     */
+/* inside the sequence are not significant. Returns 0 for any other one.    */
+/****************************************************************************/
+{
+  const static char  funcs[]       = "_marpaEBNF_compileSpecialb";
+  marpaEBNFAst_t    *marpaEBNFAstp = marpaEBNFCompilerp->marpaEBNFAstp;
+  char              *texts         = marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[nodel];
+  size_t             textl         = marpaEBNFAstp->textLengthlp[nodel];
+  char               names[128];
+  size_t             namel         = 0;
+  size_t             i;
+  short              gapb          = 0;
+
+  /* Trimmed, with single spaces */
+  for (i = 0; i < textl; i++) {
+    if ((texts[i] == ' ') || ((texts[i] >= 0x09) && (texts[i] <= 0x0D))) {
+      gapb = (namel > 0) ? 1 : 0;
+      continue;
+    }
+    if (namel + 2 >= sizeof(names)) {
+      break;
+    }
+    if (gapb) {
+      names[namel++] = ' ';
+      gapb = 0;
+    }
+    names[namel++] = texts[i];
+  }
+  names[namel] = '\0';
+
+  if ((i >= textl) && (strncmp(names, MARPAEBNF_COMPILE_CONTROL_PREFIX, strlen(MARPAEBNF_COMPILE_CONTROL_PREFIX)) == 0)) {
+    for (i = 0; i < sizeof(marpaEBNFControlArray) / sizeof(marpaEBNFControlArray[0]); i++) {
+      if (strcmp(names + strlen(MARPAEBNF_COMPILE_CONTROL_PREFIX), marpaEBNFControlArray[i].names) == 0) {
+        *cp = marpaEBNFControlArray[i].c;
+        return 1;
+      }
+    }
+  }
+
+  MARPAEBNF_TRACEF(marpaEBNFCompilerp->genericLoggerp, funcs, "Offset %ld: special sequence ?%s? has no known meaning", (long) marpaEBNFAstp->offsetlp[nodel], texts);
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileIntegerb(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t nodel, size_t *nlp)
+/****************************************************************************/
+{
+  marpaEBNFAst_t *marpaEBNFAstp = marpaEBNFCompilerp->marpaEBNFAstp;
+  char           *texts         = marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[nodel];
+  size_t          textl         = marpaEBNFAstp->textLengthlp[nodel];
+  size_t          nl            = 0;
+  size_t          i;
+
+  for (i = 0; i < textl; i++) {
+    nl = nl * 10 + (size_t) (texts[i] - '0');
+    if (nl > MARPAEBNF_COMPILE_REPETITION_MAX) {
+      MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "Offset %ld: repetition %s is above %d", (long) marpaEBNFAstp->offsetlp[nodel], texts, MARPAEBNF_COMPILE_REPETITION_MAX);
+      return 0;
+    }
+  }
+
+  *nlp = nl;
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileSetb(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t nodel, marpaEBNFStringSet_t **setpp)
+/****************************************************************************/
+/* Finite language of a node. Returns 1 and the set, -1 if the language is  */
+/* infinite, too large or unknown, 0 on error.                              */
+/****************************************************************************/
+{
+  marpaEBNFAst_t        *marpaEBNFAstp = marpaEBNFCompilerp->marpaEBNFAstp;
+  size_t                 firstChildl   = marpaEBNFAstp->firstChildlp[nodel];
+  size_t                 childl        = marpaEBNFAstp->childlp[nodel];
+  char                  *texts         = marpaEBNFAstp->texts + marpaEBNFAstp->textOffsetlp[nodel];
+  size_t                 textl         = marpaEBNFAstp->textLengthlp[nodel];
+  marpaEBNFIdentifier_t *identifierp;
+  marpaEBNFStringSet_t  *setp;
+  marpaEBNFStringSet_t  *childSetp;
+  marpaEBNFStringSet_t  *emptySetp;
+  unsigned char          c;
+  size_t                 rulel;
+  size_t                 nl;
+  size_t                 i;
+  short                  rcb;
+
+  /* { "" } is the neutral element of the concatenation */
+  emptySetp = _marpaEBNF_compileSetNewp(marpaEBNFCompilerp, 1);
+  if (emptySetp == NULL) {
+    return 0;
+  }
+  emptySetp->stringp[0].s = texts;
+  emptySetp->stringp[0].l = 0;
+
+  switch (marpaEBNFAstp->kindip[nodel]) {
+  case MARPAEBNF_AST_TERMINAL_STRING:
+    emptySetp->stringp[0].l = textl;
+    *setpp = emptySetp;
+    return 1;
+
+  case MARPAEBNF_AST_SPECIAL_SEQUENCE:
+    if (_marpaEBNF_compileSpecialb(marpaEBNFCompilerp, nodel, &c) == 0) {
+      return -1;
+    }
+    emptySetp->stringp[0].s = (char *) _marpaEBNF_arenaAllocp(marpaEBNFCompilerp->marpaEBNFArenap, 1);
+    if (emptySetp->stringp[0].s == NULL) {
+      return 0;
+    }
+    emptySetp->stringp[0].s[0] = (char) c;
+    emptySetp->stringp[0].l    = 1;
+    *setpp = emptySetp;
+    return 1;
+
+  case MARPAEBNF_AST_EMPTY_SEQUENCE:
+    *setpp = emptySetp;
+    return 1;
+
+  case MARPAEBNF_AST_META_IDENTIFIER:
+    identifierp = _marpaEBNF_compileIdentifierp(marpaEBNFCompilerp, texts, textl, 0);
+    if (identifierp->firstRulel == MARPAEBNF_COMPILE_NONE) {
+      return -1;
+    }
+    switch (identifierp->seti) {
+    case MARPAEBNF_COMPILE_SET_FINITE:
+      *setpp = identifierp->setp;
+      return 1;
+    case MARPAEBNF_COMPILE_SET_PENDING:
+    case MARPAEBNF_COMPILE_SET_INFINITE:
+      return -1;
+    default:
+      break;
+    }
+    /* Union of all its definitions lists */
+    identifierp->seti = MARPAEBNF_COMPILE_SET_PENDING;
+    setp = NULL;
+    for (rulel = identifierp->firstRulel; rulel != MARPAEBNF_COMPILE_NONE; rulel = marpaEBNFCompilerp->nextRulelp[rulel]) {
+      rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, marpaEBNFAstp->firstChildlp[rulel] + 1, &childSetp);
+      if ((rcb > 0) && (setp != NULL)) {
+        rcb = _marpaEBNF_compileSetUnionb(marpaEBNFCompilerp, setp, childSetp, &childSetp);
+      }
+      if (rcb <= 0) {
+        identifierp->seti = MARPAEBNF_COMPILE_SET_INFINITE;
+        return rcb;
+      }
+      setp = childSetp;
+    }
+    identifierp->seti = MARPAEBNF_COMPILE_SET_FINITE;
+    identifierp->setp = setp;
+    *setpp = setp;
+    return 1;
+
+  case MARPAEBNF_AST_DEFINITIONS_LIST:
+    setp = NULL;
+    for (i = firstChildl; i < firstChildl + childl; i++) {
+      rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, i, &childSetp);
+      if ((rcb > 0) && (setp != NULL)) {
+        rcb = _marpaEBNF_compileSetUnionb(marpaEBNFCompilerp, setp, childSetp, &childSetp);
+      }
+      if (rcb <= 0) {
+        return rcb;
+      }
+      setp = childSetp;
+    }
+    *setpp = setp;
+    return 1;
+
+  case MARPAEBNF_AST_SINGLE_DEFINITION:
+    setp = emptySetp;
+    for (i = firstChildl; i < firstChildl + childl; i++) {
+      rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, i, &childSetp);
+      if (rcb > 0) {
+        rcb = _marpaEBNF_compileSetConcatb(marpaEBNFCompilerp, setp, childSetp, &setp);
+      }
+      if (rcb <= 0) {
+        return rcb;
+      }
+    }
+    *setpp = setp;
+    return 1;
+
+  case MARPAEBNF_AST_GROUPED_SEQUENCE:
+    return _marpaEBNF_compileSetb(marpaEBNFCompilerp, firstChildl, setpp);
+
+  case MARPAEBNF_AST_OPTIONAL_SEQUENCE:
+    rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, firstChildl, &childSetp);
+    if (rcb <= 0) {
+      return rcb;
+    }
+    return _marpaEBNF_compileSetUnionb(marpaEBNFCompilerp, childSetp, emptySetp, setpp);
+
+  case MARPAEBNF_AST_REPEATED_SEQUENCE:
+    /* Finite only when there is nothing to repeat */
+    rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, firstChildl, &childSetp);
+    if (rcb <= 0) {
+      return rcb;
+    }
+    if ((childSetp->stringl > 1) || ((childSetp->stringl == 1) && (childSetp->stringp[0].l > 0))) {
+      return -1;
+    }
+    *setpp = emptySetp;
+    return 1;
+
+  case MARPAEBNF_AST_REPETITION:
+    if (_marpaEBNF_compileIntegerb(marpaEBNFCompilerp, firstChildl, &nl) == 0) {
+      return 0;
+    }
+    rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, firstChildl + 1, &childSetp);
+    if (rcb <= 0) {
+      return rcb;
+    }
+    /* By squaring: the powers of the child set are factors of the result, */
+    /* that is never smaller than any of them.                              */
+    setp = emptySetp;
+    while (nl > 0) {
+      if ((nl & 1) != 0) {
+        rcb = _marpaEBNF_compileSetConcatb(marpaEBNFCompilerp, setp, childSetp, &setp);
+        if (rcb <= 0) {
+          return rcb;
+        }
+      }
+      nl >>= 1;
+      if (nl > 0) {
+        rcb = _marpaEBNF_compileSetConcatb(marpaEBNFCompilerp, childSetp, childSetp, &childSetp);
+        if (rcb <= 0) {
+          return rcb;
+        }
+      }
+    }
+    *setpp = setp;
+    return 1;
+
+  case MARPAEBNF_AST_EXCEPTION:
+    rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, firstChildl, &setp);
+    if (rcb <= 0) {
+      return rcb;
+    }
+    rcb = _marpaEBNF_compileSetb(marpaEBNFCompilerp, firstChildl + 1, &childSetp);
+    if (rcb <= 0) {
+      return rcb;
+    }
+    *setpp = _marpaEBNF_compileSetDifferencep(marpaEBNFCompilerp, setp, childSetp);
+    return (*setpp != NULL) ? 1 : 0;
+
+  default:
+    MARPAEBNF_ERRORF(marpaEBNFCompilerp->genericLoggerp, "Offset %ld: unexpected AST node kind %d", (long) marpaEBNFAstp->offsetlp[nodel], marpaEBNFAstp->kindip[nodel]);
+    return 0;
+  }
+}
+
+/****************************************************************************/
+static inline marpaEBNFStringSet_t *_marpaEBNF_compileSetNewp(marpaEBNFCompiler_t *marpaEBNFCompilerp, size_t stringl)
+/****************************************************************************/
+{
+  marpaEBNFStringSet_t *setp;
+
+  setp = (marpaEBNFStringSet_t *) _marpaEBNF_arenaAllocp(marpaEBNFCompilerp->marpaEBNFArenap, sizeof(marpaEBNFStringSet_t) + stringl * sizeof(marpaEBNFString_t));
+  if (setp == NULL) {
+    return NULL;
+  }
+  setp->stringp = (marpaEBNFString_t *) (setp + 1);
+  setp->stringl = stringl;
+
+  return setp;
+}
+
+/****************************************************************************/
+static int _marpaEBNF_compileStringCmpi(const void *p1, const void *p2)
+/****************************************************************************/
+{
+  const marpaEBNFString_t *string1p = (const marpaEBNFString_t *) p1;
+  const marpaEBNFString_t *string2p = (const marpaEBNFString_t *) p2;
+  int                      cmpi;
+
+  cmpi = memcmp(string1p->s, string2p->s, (string1p->l < string2p->l) ? string1p->l : string2p->l);
+  if (cmpi != 0) {
+    return cmpi;
+  }
+  return (string1p->l < string2p->l) ? -1 : ((string1p->l > string2p->l) ? 1 : 0);
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_compileSetNormalizev(marpaEBNFStringSet_t *setp)
+/****************************************************************************/
+/* Sorted, without duplicates */
+/****************************************************************************/
+{
+  size_t i;
+  size_t j;
+
+  if (setp->stringl <= 1) {
+    return;
+  }
+  qsort(setp->stringp, setp->stringl, sizeof(marpaEBNFString_t), _marpaEBNF_compileStringCmpi);
+  for (i = 1, j = 1; i < setp->stringl; i++) {
+    if (_marpaEBNF_compileStringCmpi(&(setp->stringp[i]), &(setp->stringp[j - 1])) != 0) {
+      setp->stringp[j++] = setp->stringp[i];
+    }
+  }
+  setp->stringl = j;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileSetUnionb(marpaEBNFCompiler_t *marpaEBNFCompilerp, marpaEBNFStringSet_t *set1p, marpaEBNFStringSet_t *set2p, marpaEBNFStringSet_t **setpp)
+/****************************************************************************/
+{
+  marpaEBNFStringSet_t *setp;
+
+  if (set1p->stringl + set2p->stringl > MARPAEBNF_COMPILE_SET_MAX) {
+    return -1;
+  }
+  setp = _marpaEBNF_compileSetNewp(marpaEBNFCompilerp, set1p->stringl + set2p->stringl);
+  if (setp == NULL) {
+    return 0;
+  }
+  memcpy(setp->stringp, set1p->stringp, set1p->stringl * sizeof(marpaEBNFString_t));
+  memcpy(setp->stringp + set1p->stringl, set2p->stringp, set2p->stringl * sizeof(marpaEBNFString_t));
+  _marpaEBNF_compileSetNormalizev(setp);
+
+  *setpp = setp;
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_compileSetConcatb(marpaEBNFCompiler_t *marpaEBNFCompilerp, marpaEBNFStringSet_t *set1p, marpaEBNFStringSet_t *set2p, marpaEBNFStringSet_t **setpp)
+/****************************************************************************/
+{
+  marpaEBNFStringSet_t *setp;
+  marpaEBNFString_t    *stringp;
+  size_t                byte1l = 0;
+  size_t                byte2l = 0;
+  size_t                i;
+  size_t                j;
+
+  if ((set1p->stringl > 0) && (set2p->stringl > MARPAEBNF_COMPILE_SET_MAX / set1p->stringl)) {
+    return -1;
+  }
+  /* Every string of one set is followed by, or follows, every string of the other */
+  for (i = 0; i < set1p->stringl; i++) {
+    byte1l += set1p->stringp[i].l;
+  }
+  for (j = 0; j < set2p->stringl; j++) {
+    byte2l += set2p->stringp[j].l;
+  }
+  if ((byte1l > MARPAEBNF_COMPILE_SET_BYTE_MAX) || (byte2l > MARPAEBNF_COMPILE_SET_BYTE_MAX)
+      || (byte1l * set2p->stringl + byte2l * set1p->stringl > MARPAEBNF_COMPILE_SET_BYTE_MAX)) {
+    return -1;
+  }
+  setp = _marpaEBNF_compileSetNewp(marpaEBNFCompilerp, set1p->stringl * set2p->stringl);
+  if (setp == NULL) {
+    return 0;
+  }
+  stringp = setp->stringp;
+  for (i = 0; i < set1p->stringl; i++) {
+    for (j = 0; j < set2p->stringl; j++, stringp++) {
+      stringp->l = set1p->stringp[i].l + set2p->stringp[j].l;
+      if (set1p->stringp[i].l <= 0) {
+        /* No copy when one side is the empty string */
+        stringp->s = set2p->stringp[j].s;
+      } else if (set2p->stringp[j].l <= 0) {
+        stringp->s = set1p->stringp[i].s;
+      } else {
+        stringp->s = (char *) _marpaEBNF_arenaAllocp(marpaEBNFCompilerp->marpaEBNFArenap, stringp->l);
+        if (stringp->s == NULL) {
+          return 0;
+        }
+        memcpy(stringp->s, set1p->stringp[i].s, set1p->stringp[i].l);
+        memcpy(stringp->s + set1p->stringp[i].l, set2p->stringp[j].s, set2p->stringp[j].l);
+      }
+    }
+  }
+  _marpaEBNF_compileSetNormalizev(setp);
+
+  *setpp = setp;
+  return 1;
+}
+
+/****************************************************************************/
+static inline marpaEBNFStringSet_t *_marpaEBNF_compileSetDifferencep(marpaEBNFCompiler_t *marpaEBNFCompilerp, marpaEBNFStringSet_t *set1p, marpaEBNFStringSet_t *set2p)
+/****************************************************************************/
+/* Both sets are sorted: one merge pass                                     */
+/****************************************************************************/
+{
+  marpaEBNFStringSet_t *setp;
+  size_t                i;
+  size_t                j;
+  int                   cmpi;
+
+  setp = _marpaEBNF_compileSetNewp(marpaEBNFCompilerp, set1p->stringl);
+  if (setp == NULL) {
+    return NULL;
+  }
+  setp->stringl = 0;
+  for (i = 0, j = 0; i < set1p->stringl; i++) {
+    cmpi = 1;
+    while ((j < set2p->stringl) && ((cmpi = _marpaEBNF_compileStringCmpi(&(set2p->stringp[j]), &(set1p->stringp[i]))) < 0)) {
+      j++;
+    }
+    if ((j >= set2p->stringl) || (cmpi != 0)) {
+      setp->stringp[setp->stringl++] = set1p->stringp[i];
+    }
+  }
+
+  return setp;
+}
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "config.h"
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/file.h"
+
+/* An empty file cannot be mapped: its view is this empty string */
+static char marpaEBNFFileEmptys[] = "";
+
+#ifdef HAVE_SYS_MMAN_H
+/****************************************************************************/
+short _marpaEBNF_fileOpenb(marpaEBNFFile_t *marpaEBNFFilep, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, char *filenames)
+/****************************************************************************/
+{
+  int          fd;
+  struct stat  st;
+  void        *p;
+
+  marpaEBNFFilep->inputs  = marpaEBNFFileEmptys;
+  marpaEBNFFilep->inputl  = 0;
+  marpaEBNFFilep->mappedb = 0;
+
+  fd = open(filenames, O_RDONLY);
+  if (fd < 0) {
+    MARPAEBNF_ERRORF(genericLoggerp, "%s: open error, %s", filenames, strerror(errno));
+    return 0;
+  }
+  if (fstat(fd, &st) != 0) {
+    MARPAEBNF_ERRORF(genericLoggerp, "%s: fstat error, %s", filenames, strerror(errno));
+    goto err;
+  }
+  if (! S_ISREG(st.st_mode)) {
+    MARPAEBNF_ERRORF(genericLoggerp, "%s: not a regular file", filenames);
+    errno = EINVAL;
+    goto err;
+  }
+
+  if (st.st_size > 0) {
+    p = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      MARPAEBNF_ERRORF(genericLoggerp, "%s: mmap error, %s", filenames, strerror(errno));
+      goto err;
+    }
+#ifdef MADV_SEQUENTIAL
+    /* The grammar is read once from start to end: this is only an advice */
+    madvise(p, (size_t) st.st_size, MADV_SEQUENTIAL);
+#endif
+    marpaEBNFFilep->inputs  = (char *) p;
+    marpaEBNFFilep->inputl  = (size_t) st.st_size;
+    marpaEBNFFilep->mappedb = 1;
+  }
+
+  /* The mapping does not need the descriptor */
+  close(fd);
+  return 1;
+
+ err:
+  close(fd);
+  return 0;
+}
+
+/****************************************************************************/
+void _marpaEBNF_fileClosev(marpaEBNFFile_t *marpaEBNFFilep, marpaEBNFAllocator_t *marpaEBNFAllocatorp)
+/****************************************************************************/
+{
+  if (marpaEBNFFilep->mappedb) {
+    munmap(marpaEBNFFilep->inputs, marpaEBNFFilep->inputl);
+  }
+  marpaEBNFFilep->inputs  = marpaEBNFFileEmptys;
+  marpaEBNFFilep->inputl  = 0;
+  marpaEBNFFilep->mappedb = 0;
+}
+
+#else /* HAVE_SYS_MMAN_H */
+
+/****************************************************************************/
+short _marpaEBNF_fileOpenb(marpaEBNFFile_t *marpaEBNFFilep, genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, char *filenames)
+/****************************************************************************/
+/* No memory mapping: one buffer that grows with the reads                  */
+/****************************************************************************/
+{
+  FILE   *fp;
+  char   *inputs = NULL;
+  char   *newinputs;
+  size_t  inputl = 0;
+  size_t  allocl = 0;
+  size_t  readl;
+
+  marpaEBNFFilep->inputs  = marpaEBNFFileEmptys;
+  marpaEBNFFilep->inputl  = 0;
+  marpaEBNFFilep->mappedb = 0;
+
+  fp = fopen(filenames, "rb");
+  if (fp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "%s: fopen error, %s", filenames, strerror(errno));
+    return 0;
+  }
+
+  while (1) {
+    if (inputl >= allocl) {
+      allocl = (allocl > 0) ? allocl * 2 : 65536;
+      newinputs = (char *) _marpaEBNF_memoryReallocp(marpaEBNFAllocatorp, inputs, allocl);
+      if (newinputs == NULL) {
+        MARPAEBNF_ERRORF(genericLoggerp, "realloc error, %s", strerror(errno));
+        goto err;
+      }
+      inputs = newinputs;
+    }
+    readl = fread(inputs + inputl, 1, allocl - inputl, fp);
+    inputl += readl;
+    if (readl <= 0) {
+      break;
+    }
+  }
+  if (ferror(fp)) {
+    MARPAEBNF_ERRORF(genericLoggerp, "%s: read error, %s", filenames, strerror(errno));
+    goto err;
+  }
+  fclose(fp);
+
+  marpaEBNFFilep->inputs = inputs;
+  marpaEBNFFilep->inputl = inputl;
+  return 1;
+
+ err:
+  if (inputs != NULL) {
+    _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, inputs);
+  }
+  fclose(fp);
+  return 0;
+}
+
+/****************************************************************************/
+void _marpaEBNF_fileClosev(marpaEBNFFile_t *marpaEBNFFilep, marpaEBNFAllocator_t *marpaEBNFAllocatorp)
+/****************************************************************************/
+{
+  if (marpaEBNFFilep->inputs != marpaEBNFFileEmptys) {
+    _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFFilep->inputs);
+  }
+  marpaEBNFFilep->inputs  = marpaEBNFFileEmptys;
+  marpaEBNFFilep->inputl  = 0;
+  marpaEBNFFilep->mappedb = 0;
+}
+
+#endif /* HAVE_SYS_MMAN_H */
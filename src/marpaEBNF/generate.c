@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/generate.h"
+
+#define MARPAEBNF_GENERATE_PER_LINE 16   /* Integers per line of an array */
+
+static inline short _marpaEBNF_generateNameb(char *names);
+static inline void  _marpaEBNF_generateStringv(FILE *fp, char *s);
+static inline void  _marpaEBNF_generateIntegersv(FILE *fp, const int *ip, size_t il);
+
+/****************************************************************************/
+short _marpaEBNF_generateb(marpaEBNFCompiled_t *marpaEBNFCompiledp, genericLogger_t *genericLoggerp, char *names, char *filenames)
+/****************************************************************************/
+{
+  const static char         funcs[] = "_marpaEBNF_generateb";
+  FILE                     *fp;
+  marpaEBNFGeneratedRule_t *rulep;
+  size_t                    i;
+  int                       closei;
+
+  if (! _marpaEBNF_generateNameb(names)) {
+    MARPAEBNF_ERRORF(genericLoggerp, "\"%s\" is not a C identifier", names);
+    errno = EINVAL;
+    return 0;
+  }
+
+  fp = fopen(filenames, "w");
+  if (fp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "%s: %s", filenames, strerror(errno));
+    return 0;
+  }
+
+  fprintf(fp, "/* Generated by marpaEBNF_generateb(): do not edit */\n");
+  fprintf(fp, "#include <stddef.h>\n");
+  fprintf(fp, "#include <marpaEBNF.h>\n");
+  fprintf(fp, "\n");
+  fprintf(fp, "/* An instance that parses inputs with marpaEBNF_parseb() as if it had parsed the grammar */\n");
+  fprintf(fp, "marpaEBNF_t *%s_newp(marpaEBNFOption_t *marpaEBNFOptionp);\n", names);
+  fprintf(fp, "\n");
+
+  fprintf(fp, "static const marpaEBNFGeneratedSymbol_t %sSymbolArray[] = {\n", names);
+  for (i = 0; i < marpaEBNFCompiledp->nSymboll; i++) {
+    fprintf(fp, "  /* %5ld */ { %d, ", (long) i, (int) marpaEBNFCompiledp->terminalbp[i]);
+    _marpaEBNF_generateStringv(fp, _marpaEBNF_compiledDescriptions(marpaEBNFCompiledp, (int) i));
+    fprintf(fp, " },\n");
+  }
+  fprintf(fp, "};\n\n");
+
+  fprintf(fp, "static const marpaEBNFGeneratedRule_t %sRuleArray[] = {\n", names);
+  for (i = 0; i < marpaEBNFCompiledp->nRulel; i++) {
+    rulep = &(marpaEBNFCompiledp->rulep[i]);
+    fprintf(fp, "  /* %5ld */ { { %d, %d, %d, %d, %d, %d }, %d, %ld },\n",
+            (long) i,
+            rulep->option.ranki,
+            (int) rulep->option.nullRanksHighb,
+            (int) rulep->option.sequenceb,
+            rulep->option.separatorSymboli,
+            (int) rulep->option.properb,
+            rulep->option.minimumi,
+            rulep->lhsSymboli,
+            (long) rulep->rhsSymboll);
+  }
+  fprintf(fp, "};\n\n");
+
+  /* C has no empty array: a grammar of empty rules only gets an unused entry */
+  fprintf(fp, "static const int %sRhsSymbolArray[] = {\n", names);
+  if (marpaEBNFCompiledp->rhsSymboll > 0) {
+    _marpaEBNF_generateIntegersv(fp, marpaEBNFCompiledp->rhsSymbolip, marpaEBNFCompiledp->rhsSymboll);
+  } else {
+    fprintf(fp, "  -1\n");
+  }
+  fprintf(fp, "};\n\n");
+
+  fprintf(fp, "static const int %sByteSymbolArray[%d] = {\n", names, MARPAEBNF_COMPILE_NBYTE);
+  _marpaEBNF_generateIntegersv(fp, marpaEBNFCompiledp->byteSymbolip, MARPAEBNF_COMPILE_NBYTE);
+  fprintf(fp, "};\n\n");
+
+  fprintf(fp, "static const marpaEBNFGenerated_t %sGenerated = {\n", names);
+  fprintf(fp, "  %d,\n", MARPAEBNF_GENERATED_VERSION);
+  fprintf(fp, "  %sSymbolArray, %ld,\n", names, (long) marpaEBNFCompiledp->nSymboll);
+  fprintf(fp, "  %sRuleArray, %ld,\n", names, (long) marpaEBNFCompiledp->nRulel);
+  fprintf(fp, "  %sRhsSymbolArray, %ld,\n", names, (long) marpaEBNFCompiledp->rhsSymboll);
+  fprintf(fp, "  %d,\n", marpaEBNFCompiledp->startSymboli);
+  fprintf(fp, "  %sByteSymbolArray\n", names);
+  fprintf(fp, "};\n\n");
+
+  fprintf(fp, "/****************************************************************************/\n");
+  fprintf(fp, "marpaEBNF_t *%s_newp(marpaEBNFOption_t *marpaEBNFOptionp)\n", names);
+  fprintf(fp, "/****************************************************************************/\n");
+  fprintf(fp, "{\n");
+  fprintf(fp, "  marpaEBNF_t *marpaEBNFp = marpaEBNF_newp(marpaEBNFOptionp);\n");
+  fprintf(fp, "\n");
+  fprintf(fp, "  if ((marpaEBNFp != NULL) && (marpaEBNF_generatedb(marpaEBNFp, &%sGenerated) == 0)) {\n", names);
+  fprintf(fp, "    marpaEBNF_freev(marpaEBNFp);\n");
+  fprintf(fp, "    marpaEBNFp = NULL;\n");
+  fprintf(fp, "  }\n");
+  fprintf(fp, "\n");
+  fprintf(fp, "  return marpaEBNFp;\n");
+  fprintf(fp, "}\n");
+
+  /* A write error, e.g. a full disk, may only show when the file is closed */
+  closei = ferror(fp);
+  if ((fclose(fp) != 0) || (closei != 0)) {
+    MARPAEBNF_ERRORF(genericLoggerp, "%s: write error, %s", filenames, strerror(errno));
+    remove(filenames);
+    return 0;
+  }
+
+  MARPAEBNF_TRACEF(genericLoggerp, funcs, "%s: %ld symbols and %ld rules", filenames, (long) marpaEBNFCompiledp->nSymboll, (long) marpaEBNFCompiledp->nRulel);
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_generateNameb(char *names)
+/****************************************************************************/
+/* In the basic C character set, so that the test does not depend on the    */
+/* locale: [A-Za-z_][A-Za-z0-9_]*                                           */
+/****************************************************************************/
+{
+  char *p;
+
+  if ((names == NULL) || (*names == '\0') || ((*names >= '0') && (*names <= '9'))) {
+    return 0;
+  }
+  for (p = names; *p != '\0'; p++) {
+    if (! (((*p >= 'a') && (*p <= 'z')) || ((*p >= 'A') && (*p <= 'Z')) || ((*p >= '0') && (*p <= '9')) || (*p == '_'))) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_generateStringv(FILE *fp, char *s)
+/****************************************************************************/
+/* A C string literal. Octal escapes always have three digits, so that the  */
+/* next character cannot extend them; ? is escaped against trigraphs.       */
+/****************************************************************************/
+{
+  unsigned char c;
+
+  fputc('"', fp);
+  for (; *s != '\0'; s++) {
+    c = (unsigned char) *s;
+    if ((c == '"') || (c == '\\') || (c == '?')) {
+      fputc('\\', fp);
+      fputc((int) c, fp);
+    } else if ((c >= 0x20) && (c < 0x7F)) {
+      fputc((int) c, fp);
+    } else {
+      fprintf(fp, "\\%03o", (unsigned int) c);
+    }
+  }
+  fputc('"', fp);
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_generateIntegersv(FILE *fp, const int *ip, size_t il)
+/****************************************************************************/
+{
+  size_t i;
+
+  for (i = 0; i < il; i++) {
+    if ((i % MARPAEBNF_GENERATE_PER_LINE) == 0) {
+      fprintf(fp, "  ");
+    }
+    fprintf(fp, "%d%s", ip[i], (i + 1 < il) ? "," : "");
+    if (((i + 1) % MARPAEBNF_GENERATE_PER_LINE == 0) || (i + 1 >= il)) {
+      fprintf(fp, "\n");
+    } else {
+      fprintf(fp, " ");
+    }
+  }
+}
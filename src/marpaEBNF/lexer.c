@@ -0,0 +1,426 @@
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/symbol.h"
+#include "marpaEBNF/internal/lexer.h"
+#include "marpaEBNF/internal/scan.h"
+
+/* Gap separators as per ISO/IEC 14977:1996 section 6.4 */
+#define MARPAEBNF_LEXER_IS_GAP(c) MARPAEBNF_SCAN_IS_GAP(c)
+/* Terminal characters as per ISO/IEC 14977:1996 section 6.2 cover the whole 7-bit printable range */
+#define MARPAEBNF_LEXER_IS_TERMINAL(c) MARPAEBNF_SCAN_IS_TERMINAL(c)
+#define MARPAEBNF_LEXER_IS_LETTER(c) ((((c) >= 'a') && ((c) <= 'z')) || (((c) >= 'A') && ((c) <= 'Z')))
+#define MARPAEBNF_LEXER_IS_DIGIT(c) (((c) >= '0') && ((c) <= '9'))
+
+static inline void   _marpaEBNF_lexerAdvancev(marpaEBNFLexer_t *marpaEBNFLexerp, size_t lengthl);
+static inline size_t _marpaEBNF_lexerGapEndl(marpaEBNFLexer_t *marpaEBNFLexerp, size_t offsetl);
+static inline void   _marpaEBNF_lexerInvalidv(marpaEBNFLexer_t *marpaEBNFLexerp, size_t offsetl, char *contexts);
+static inline short  _marpaEBNF_lexerMoreb(marpaEBNFLexer_t *marpaEBNFLexerp, marpaEBNFToken_t *marpaEBNFTokenp);
+static inline size_t _marpaEBNF_lexerStopl(marpaEBNFLexer_t *marpaEBNFLexerp, size_t offsetl, char delimiter1, char delimiter2, short gapb);
+static inline short  _marpaEBNF_lexerCutb(marpaEBNFLexer_t *marpaEBNFLexerp, size_t offsetl);
+
+/* Offsets in messages are absolute, i.e. counted since the first chunk */
+#define MARPAEBNF_LEXER_ABSOLUTE(lexerp, offsetl) ((long) ((lexerp)->baseOffsetl + (offsetl)))
+
+/****************************************************************************/
+void _marpaEBNF_lexerInitv(marpaEBNFLexer_t *marpaEBNFLexerp, genericLogger_t *genericLoggerp, char *inputs, size_t inputl)
+/****************************************************************************/
+{
+  marpaEBNFLexerp->genericLoggerp = genericLoggerp;
+  marpaEBNFLexerp->inputs         = inputs;
+  marpaEBNFLexerp->inputl         = inputl;
+  marpaEBNFLexerp->eofb           = 1;
+  marpaEBNFLexerp->baseOffsetl    = 0;
+  marpaEBNFLexerp->offsetl        = 0;
+  marpaEBNFLexerp->linel          = 1;
+  marpaEBNFLexerp->columnl        = 1;
+  marpaEBNFLexerp->discardedl     = 0;
+  marpaEBNFLexerp->utf8b          = 0;
+  marpaEBNFLexerp->utf8Crossedb   = 0;
+}
+
+/****************************************************************************/
+void _marpaEBNF_lexerChunkv(marpaEBNFLexer_t *marpaEBNFLexerp, char *inputs, size_t inputl, short eofb)
+/****************************************************************************/
+/* Continues with a new buffer, that must start with the bytes that were    */
+/* not consumed in the previous one. Line and column are kept.              */
+/****************************************************************************/
+{
+  marpaEBNFLexerp->baseOffsetl += marpaEBNFLexerp->offsetl;
+  marpaEBNFLexerp->inputs       = inputs;
+  marpaEBNFLexerp->inputl       = inputl;
+  marpaEBNFLexerp->eofb         = eofb;
+  marpaEBNFLexerp->offsetl      = 0;
+}
+
+/****************************************************************************/
+short _marpaEBNF_lexerNextb(marpaEBNFLexer_t *marpaEBNFLexerp, marpaEBNFToken_t *marpaEBNFTokenp)
+/****************************************************************************/
+{
+  const static char  funcs[] = "_marpaEBNF_lexerNextb";
+  char              *inputs  = marpaEBNFLexerp->inputs;
+  size_t             inputl  = marpaEBNFLexerp->inputl;
+  short              eofb    = marpaEBNFLexerp->eofb;
+  size_t             offsetl;
+  size_t             endl;
+  size_t             nextl;
+  unsigned char      c;
+  unsigned char      c2;
+  unsigned char      quote;
+  int                depthi;
+
+  while (1) {
+    offsetl = marpaEBNFLexerp->offsetl;
+
+    marpaEBNFTokenp->offsetl = offsetl;
+    marpaEBNFTokenp->linel   = marpaEBNFLexerp->linel;
+    marpaEBNFTokenp->columnl = marpaEBNFLexerp->columnl;
+
+    if (offsetl >= inputl) {
+      if (! eofb) {
+        return _marpaEBNF_lexerMoreb(marpaEBNFLexerp, marpaEBNFTokenp);
+      }
+      marpaEBNFTokenp->symboli = MARPAEBNF_TOKEN_EOF;
+      marpaEBNFTokenp->lengthl = 0;
+      return 1;
+    }
+
+    c    = (unsigned char) inputs[offsetl];
+    c2   = (offsetl + 1 < inputl) ? (unsigned char) inputs[offsetl + 1] : '\0';
+    endl = offsetl + 1;
+
+    /* Characters that can start a two-characters symbol need their lookahead */
+    if ((! eofb) && (offsetl + 1 >= inputl) && ((c == '(') || (c == '/') || (c == ':') || (c == '*'))) {
+      return _marpaEBNF_lexerMoreb(marpaEBNFLexerp, marpaEBNFTokenp);
+    }
+
+    /* Gap separators */
+    if (MARPAEBNF_LEXER_IS_GAP(c)) {
+      nextl = _marpaEBNF_lexerGapEndl(marpaEBNFLexerp, endl);
+      marpaEBNFLexerp->discardedl += nextl - offsetl;
+      _marpaEBNF_lexerAdvancev(marpaEBNFLexerp, nextl - offsetl);
+      continue;
+    }
+
+    /* Bracketed textual comment: they nest */
+    if ((c == '(') && (c2 == '*')) {
+      depthi = 1;
+      endl = offsetl + 2;
+      while (1) {
+        /* Only '(' and '*' can change the nesting */
+        endl = _marpaEBNF_lexerStopl(marpaEBNFLexerp, endl, '(', '*', 1);
+        if (endl >= inputl) {
+          break;
+        }
+        c = (unsigned char) inputs[endl];
+        c2 = (endl + 1 < inputl) ? (unsigned char) inputs[endl + 1] : '\0';
+        if ((c == '(') && (c2 == '*')) {
+          depthi++;
+          endl += 2;
+        } else if ((c == '*') && (c2 == ')')) {
+          endl += 2;
+          if (--depthi <= 0) {
+            break;
+          }
+        } else if (((! eofb) && (endl + 1 >= inputl)) || _marpaEBNF_lexerCutb(marpaEBNFLexerp, endl)) {
+          break;
+        } else if ((c == '(') || (c == '*')) {
+          endl++;
+        } else {
+          _marpaEBNF_lexerInvalidv(marpaEBNFLexerp, endl, "in a bracketed textual comment");
+          marpaEBNFTokenp->lengthl = endl + 1 - offsetl;
+          return 0;
+        }
+      }
+      if (depthi > 0) {
+        if (! eofb) {
+          return _marpaEBNF_lexerMoreb(marpaEBNFLexerp, marpaEBNFTokenp);
+        }
+        MARPAEBNF_ERRORF(marpaEBNFLexerp->genericLoggerp, "[%ld/%ld] line %ld column %ld: unterminated bracketed textual comment",
+                         MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, offsetl), MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, inputl), (long) marpaEBNFLexerp->linel, (long) marpaEBNFLexerp->columnl);
+        marpaEBNFTokenp->lengthl = inputl - offsetl;
+        return 0;
+      }
+      MARPAEBNF_TRACEF(marpaEBNFLexerp->genericLoggerp, funcs, "[%ld/%ld] Discarded comment of %ld bytes", MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, offsetl), MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, inputl), (long) (endl - offsetl));
+      marpaEBNFLexerp->discardedl += endl - offsetl;
+      _marpaEBNF_lexerAdvancev(marpaEBNFLexerp, endl - offsetl);
+      continue;
+    }
+
+    break;
+  }
+
+  switch (c) {
+  case ',':
+    marpaEBNFTokenp->symboli = TOKEN_CONCATENATE_SYMBOL;
+    break;
+  case '=':
+    marpaEBNFTokenp->symboli = TOKEN_DEFINING_SYMBOL;
+    break;
+  case '|':
+  case '!':
+    marpaEBNFTokenp->symboli = TOKEN_DEFINITION_SEPARATOR_SYMBOL;
+    break;
+  case '/':
+    if (c2 == ')') {
+      marpaEBNFTokenp->symboli = TOKEN_END_OPTION_SYMBOL;
+      endl++;
+    } else {
+      marpaEBNFTokenp->symboli = TOKEN_DEFINITION_SEPARATOR_SYMBOL;
+    }
+    break;
+  case ')':
+    marpaEBNFTokenp->symboli = TOKEN_END_GROUP_SYMBOL;
+    break;
+  case ']':
+    marpaEBNFTokenp->symboli = TOKEN_END_OPTION_SYMBOL;
+    break;
+  case '}':
+    marpaEBNFTokenp->symboli = TOKEN_END_REPEAT_SYMBOL;
+    break;
+  case ':':
+    if (c2 == ')') {
+      marpaEBNFTokenp->symboli = TOKEN_END_REPEAT_SYMBOL;
+      endl++;
+    } else {
+      _marpaEBNF_lexerInvalidv(marpaEBNFLexerp, offsetl, "outside of a terminal string");
+      marpaEBNFTokenp->lengthl = 1;
+      return 0;
+    }
+    break;
+  case '-':
+    marpaEBNFTokenp->symboli = TOKEN_EXCEPT_SYMBOL;
+    break;
+  case '*':
+    if (c2 == ')') {
+      MARPAEBNF_ERRORF(marpaEBNFLexerp->genericLoggerp, "[%ld/%ld] line %ld column %ld: end comment symbol outside of a comment",
+                       MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, offsetl), MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, inputl), (long) marpaEBNFLexerp->linel, (long) marpaEBNFLexerp->columnl);
+      marpaEBNFTokenp->lengthl = 2;
+      return 0;
+    }
+    marpaEBNFTokenp->symboli = TOKEN_REPETITION_SYMBOL;
+    break;
+  case '(':
+    if (c2 == '/') {
+      marpaEBNFTokenp->symboli = TOKEN_START_OPTION_SYMBOL;
+      endl++;
+    } else if (c2 == ':') {
+      marpaEBNFTokenp->symboli = TOKEN_START_REPEAT_SYMBOL;
+      endl++;
+    } else {
+      marpaEBNFTokenp->symboli = TOKEN_START_GROUP_SYMBOL;
+    }
+    break;
+  case '[':
+    marpaEBNFTokenp->symboli = TOKEN_START_OPTION_SYMBOL;
+    break;
+  case '{':
+    marpaEBNFTokenp->symboli = TOKEN_START_REPEAT_SYMBOL;
+    break;
+  case ';':
+  case '.':
+    marpaEBNFTokenp->symboli = TOKEN_TERMINATOR_SYMBOL;
+    break;
+  case '\'':
+  case '"':
+    /* Terminal string: at least one terminal character, that cannot be the quote */
+    quote = c;
+    endl = _marpaEBNF_lexerStopl(marpaEBNFLexerp, endl, (char) quote, (char) quote, 0);
+    if (_marpaEBNF_lexerCutb(marpaEBNFLexerp, endl)) {
+      return _marpaEBNF_lexerMoreb(marpaEBNFLexerp, marpaEBNFTokenp);
+    }
+    if ((endl < inputl) && ((unsigned char) inputs[endl] != quote)) {
+      _marpaEBNF_lexerInvalidv(marpaEBNFLexerp, endl, "in a terminal string");
+      marpaEBNFTokenp->lengthl = endl + 1 - offsetl;
+      return 0;
+    }
+    if (endl >= inputl) {
+      if (! eofb) {
+        return _marpaEBNF_lexerMoreb(marpaEBNFLexerp, marpaEBNFTokenp);
+      }
+      MARPAEBNF_ERRORF(marpaEBNFLexerp->genericLoggerp, "[%ld/%ld] line %ld column %ld: unterminated terminal string",
+                       MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, offsetl), MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, inputl), (long) marpaEBNFLexerp->linel, (long) marpaEBNFLexerp->columnl);
+      marpaEBNFTokenp->lengthl = inputl - offsetl;
+      return 0;
+    }
+    if (endl == offsetl + 1) {
+      MARPAEBNF_ERRORF(marpaEBNFLexerp->genericLoggerp, "[%ld/%ld] line %ld column %ld: empty terminal string",
+                       MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, offsetl), MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, inputl), (long) marpaEBNFLexerp->linel, (long) marpaEBNFLexerp->columnl);
+      marpaEBNFTokenp->lengthl = 2;
+      return 0;
+    }
+    endl++;
+    marpaEBNFTokenp->symboli = TOKEN_TERMINAL_STRING;
+    break;
+  case '?':
+    /* Special sequence: gap separators between special sequence characters have no effect */
+    endl = _marpaEBNF_lexerStopl(marpaEBNFLexerp, endl, '?', '?', 1);
+    if (_marpaEBNF_lexerCutb(marpaEBNFLexerp, endl)) {
+      return _marpaEBNF_lexerMoreb(marpaEBNFLexerp, marpaEBNFTokenp);
+    }
+    if ((endl < inputl) && (inputs[endl] != '?')) {
+      _marpaEBNF_lexerInvalidv(marpaEBNFLexerp, endl, "in a special sequence");
+      marpaEBNFTokenp->lengthl = endl + 1 - offsetl;
+      return 0;
+    }
+    if (endl >= inputl) {
+      if (! eofb) {
+        return _marpaEBNF_lexerMoreb(marpaEBNFLexerp, marpaEBNFTokenp);
+      }
+      MARPAEBNF_ERRORF(marpaEBNFLexerp->genericLoggerp, "[%ld/%ld] line %ld column %ld: unterminated special sequence",
+                       MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, offsetl), MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, inputl), (long) marpaEBNFLexerp->linel, (long) marpaEBNFLexerp->columnl);
+      marpaEBNFTokenp->lengthl = inputl - offsetl;
+      return 0;
+    }
+    endl++;
+    marpaEBNFTokenp->symboli = TOKEN_SPECIAL_SEQUENCE;
+    break;
+  default:
+    if (MARPAEBNF_LEXER_IS_LETTER(c) || MARPAEBNF_LEXER_IS_DIGIT(c)) {
+      /* Meta identifier or integer. Gap separators have no effect on a syntax: */
+      /* "decimal digit" is the meta identifier "decimaldigit", "1 2" is 12.    */
+#define MARPAEBNF_LEXER_CONTINUES(x) (MARPAEBNF_LEXER_IS_DIGIT(x) || (MARPAEBNF_LEXER_IS_LETTER(c) && MARPAEBNF_LEXER_IS_LETTER(x)))
+      while (1) {
+        while ((endl < inputl) && MARPAEBNF_LEXER_CONTINUES((unsigned char) inputs[endl])) {
+          endl++;
+        }
+        nextl = _marpaEBNF_lexerGapEndl(marpaEBNFLexerp, endl);
+        if ((nextl > endl) && (nextl < inputl) && MARPAEBNF_LEXER_CONTINUES((unsigned char) inputs[nextl])) {
+          endl = nextl;
+          continue;
+        }
+        break;
+      }
+#undef MARPAEBNF_LEXER_CONTINUES
+      /* The lexeme may continue in the next chunk, even after gap separators */
+      if ((! eofb) && (nextl >= inputl)) {
+        return _marpaEBNF_lexerMoreb(marpaEBNFLexerp, marpaEBNFTokenp);
+      }
+      marpaEBNFTokenp->symboli = MARPAEBNF_LEXER_IS_LETTER(c) ? TOKEN_META_IDENTIFIER : TOKEN_INTEGER;
+    } else {
+      _marpaEBNF_lexerInvalidv(marpaEBNFLexerp, offsetl, NULL);
+      marpaEBNFTokenp->lengthl = 1;
+      return 0;
+    }
+    break;
+  }
+
+  marpaEBNFTokenp->lengthl = endl - offsetl;
+  _marpaEBNF_lexerAdvancev(marpaEBNFLexerp, marpaEBNFTokenp->lengthl);
+
+  MARPAEBNF_TRACEF(marpaEBNFLexerp->genericLoggerp, funcs, "[%ld/%ld] Token %d of %ld bytes", MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, offsetl), MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, inputl), marpaEBNFTokenp->symboli, (long) marpaEBNFTokenp->lengthl);
+
+  return 1;
+}
+
+/****************************************************************************/
+void _marpaEBNF_lexerSkipv(marpaEBNFLexer_t *marpaEBNFLexerp, size_t lengthl)
+/****************************************************************************/
+{
+  /* Skipped text is whatever the parse did not want, UTF-8 included */
+  marpaEBNFLexerp->discardedl   += lengthl;
+  marpaEBNFLexerp->utf8Crossedb  = marpaEBNFLexerp->utf8b;
+  _marpaEBNF_lexerAdvancev(marpaEBNFLexerp, lengthl);
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_lexerAdvancev(marpaEBNFLexer_t *marpaEBNFLexerp, size_t lengthl)
+/****************************************************************************/
+{
+  char *p    = marpaEBNFLexerp->inputs + marpaEBNFLexerp->offsetl;
+  char *maxp = p + lengthl;
+  char *newlinep;
+
+  /* Long comments are mostly made of lines: let memchr() jump over them */
+  while ((newlinep = (char *) memchr(p, '\n', maxp - p)) != NULL) {
+    marpaEBNFLexerp->linel++;
+    marpaEBNFLexerp->columnl = 1;
+    p = newlinep + 1;
+  }
+  /* Bytes are characters unless a run went over UTF-8 ones */
+  marpaEBNFLexerp->columnl += _marpaEBNF_scanColumnl(p, 0, maxp - p, marpaEBNFLexerp->utf8Crossedb);
+
+  marpaEBNFLexerp->offsetl      += lengthl;
+  marpaEBNFLexerp->utf8Crossedb  = 0;
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_lexerGapEndl(marpaEBNFLexer_t *marpaEBNFLexerp, size_t offsetl)
+/****************************************************************************/
+{
+  return _marpaEBNF_scanGapEndl(marpaEBNFLexerp->inputs, offsetl, marpaEBNFLexerp->inputl);
+}
+
+/****************************************************************************/
+static inline size_t _marpaEBNF_lexerStopl(marpaEBNFLexer_t *marpaEBNFLexerp, size_t offsetl, char delimiter1, char delimiter2, short gapb)
+/****************************************************************************/
+/* _marpaEBNF_scanStopl(), that goes over UTF-8 characters with utf8b      */
+/****************************************************************************/
+{
+  char   *inputs = marpaEBNFLexerp->inputs;
+  size_t  inputl = marpaEBNFLexerp->inputl;
+  size_t  nextl;
+
+  while (1) {
+    offsetl = _marpaEBNF_scanStopl(inputs, offsetl, inputl, delimiter1, delimiter2, gapb);
+    if ((! marpaEBNFLexerp->utf8b) || (offsetl >= inputl) || ((unsigned char) inputs[offsetl] < 0x80)) {
+      break;
+    }
+    nextl = _marpaEBNF_scanUtf8Endl(inputs, offsetl, inputl);
+    if (nextl <= offsetl) {
+      break;
+    }
+    marpaEBNFLexerp->utf8Crossedb = 1;
+    offsetl = nextl;
+  }
+
+  return offsetl;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_lexerCutb(marpaEBNFLexer_t *marpaEBNFLexerp, size_t offsetl)
+/****************************************************************************/
+/* A scan stopped on a UTF-8 sequence that may be completed by the next    */
+/* chunk: it is only in error if the chunk is the last one.                 */
+/****************************************************************************/
+{
+  return marpaEBNFLexerp->utf8b
+    && (! marpaEBNFLexerp->eofb)
+    && (offsetl < marpaEBNFLexerp->inputl)
+    && ((unsigned char) marpaEBNFLexerp->inputs[offsetl] >= 0xC2)
+    && (offsetl + MARPAEBNF_SCAN_UTF8_LENGTH((unsigned char) marpaEBNFLexerp->inputs[offsetl]) > marpaEBNFLexerp->inputl);
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_lexerInvalidv(marpaEBNFLexer_t *marpaEBNFLexerp, size_t offsetl, char *contexts)
+/****************************************************************************/
+{
+  unsigned char c = (unsigned char) marpaEBNFLexerp->inputs[offsetl];
+
+  MARPAEBNF_ERRORF(marpaEBNFLexerp->genericLoggerp, "[%ld/%ld] line %ld column %ld: Current character: 0x%02x '%c'%s is not recognized%s%s",
+                   MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, offsetl),
+                   MARPAEBNF_LEXER_ABSOLUTE(marpaEBNFLexerp, marpaEBNFLexerp->inputl),
+                   (long) marpaEBNFLexerp->linel,
+                   (long) marpaEBNFLexerp->columnl,
+                   (int) c,
+                   isprint((int) c) ? c : ' ',
+                   isprint((int) c) ? "" : " (non printable)",
+                   (contexts != NULL) ? " " : "",
+                   (contexts != NULL) ? contexts : "");
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_lexerMoreb(marpaEBNFLexer_t *marpaEBNFLexerp, marpaEBNFToken_t *marpaEBNFTokenp)
+/****************************************************************************/
+/* The current lexeme reaches the end of a chunk that is not the last one:  */
+/* nothing is consumed, the caller has to come back with more input.        */
+/****************************************************************************/
+{
+  marpaEBNFTokenp->symboli = MARPAEBNF_TOKEN_MORE;
+  marpaEBNFTokenp->lengthl = 0;
+
+  return 1;
+}
@@ -0,0 +1,138 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/memory.h"
+
+/* The size prefix keeps the strictest fundamental alignment */
+typedef union marpaEBNFMemoryHeader {
+  size_t       sizel;
+  long         l;
+  double       d;
+  long double  ld;
+  void        *p;
+  void       (*fp)(void);
+} marpaEBNFMemoryHeader_t;
+
+static void *_marpaEBNF_systemMallocp(void *userDatavp, size_t sizel);
+static void *_marpaEBNF_systemReallocp(void *userDatavp, void *p, size_t sizel);
+static void  _marpaEBNF_systemFreev(void *userDatavp, void *p);
+
+/****************************************************************************/
+void _marpaEBNF_memoryInitv(marpaEBNFAllocator_t *marpaEBNFAllocatorp, marpaEBNFOption_t *marpaEBNFOptionp)
+/****************************************************************************/
+{
+  /* Hooks are all or nothing: a realloc or a free that would not match the malloc is not an option */
+  if ((marpaEBNFOptionp != NULL) && (marpaEBNFOptionp->mallocp != NULL) && (marpaEBNFOptionp->reallocp != NULL) && (marpaEBNFOptionp->freep != NULL)) {
+    marpaEBNFAllocatorp->mallocp    = marpaEBNFOptionp->mallocp;
+    marpaEBNFAllocatorp->reallocp   = marpaEBNFOptionp->reallocp;
+    marpaEBNFAllocatorp->freep      = marpaEBNFOptionp->freep;
+    marpaEBNFAllocatorp->userDatavp = marpaEBNFOptionp->allocatorUserDatavp;
+  } else {
+    marpaEBNFAllocatorp->mallocp    = _marpaEBNF_systemMallocp;
+    marpaEBNFAllocatorp->reallocp   = _marpaEBNF_systemReallocp;
+    marpaEBNFAllocatorp->freep      = _marpaEBNF_systemFreev;
+    marpaEBNFAllocatorp->userDatavp = NULL;
+  }
+
+  memset(&(marpaEBNFAllocatorp->memory), 0, sizeof(marpaEBNFMemory_t));
+}
+
+/****************************************************************************/
+void *_marpaEBNF_memoryMallocp(marpaEBNFAllocator_t *marpaEBNFAllocatorp, size_t sizel)
+/****************************************************************************/
+{
+  marpaEBNFMemoryHeader_t *headerp;
+
+  if (sizel > ((size_t) -1) - sizeof(marpaEBNFMemoryHeader_t)) {
+    errno = ENOMEM;
+    return NULL;
+  }
+
+  headerp = (marpaEBNFMemoryHeader_t *) marpaEBNFAllocatorp->mallocp(marpaEBNFAllocatorp->userDatavp, sizeof(marpaEBNFMemoryHeader_t) + sizel);
+  if (headerp == NULL) {
+    return NULL;
+  }
+  headerp->sizel = sizel;
+
+  marpaEBNFAllocatorp->memory.allocationl++;
+  marpaEBNFAllocatorp->memory.totalBytel += sizel;
+  marpaEBNFAllocatorp->memory.liveBytel  += sizel;
+  if (marpaEBNFAllocatorp->memory.liveBytel > marpaEBNFAllocatorp->memory.peakBytel) {
+    marpaEBNFAllocatorp->memory.peakBytel = marpaEBNFAllocatorp->memory.liveBytel;
+  }
+
+  return (void *) (headerp + 1);
+}
+
+/****************************************************************************/
+void *_marpaEBNF_memoryReallocp(marpaEBNFAllocator_t *marpaEBNFAllocatorp, void *p, size_t sizel)
+/****************************************************************************/
+{
+  marpaEBNFMemoryHeader_t *headerp;
+  size_t                   oldSizel;
+
+  if (p == NULL) {
+    return _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, sizel);
+  }
+  if (sizel > ((size_t) -1) - sizeof(marpaEBNFMemoryHeader_t)) {
+    errno = ENOMEM;
+    return NULL;
+  }
+
+  headerp  = ((marpaEBNFMemoryHeader_t *) p) - 1;
+  oldSizel = headerp->sizel;
+  headerp  = (marpaEBNFMemoryHeader_t *) marpaEBNFAllocatorp->reallocp(marpaEBNFAllocatorp->userDatavp, headerp, sizeof(marpaEBNFMemoryHeader_t) + sizel);
+  if (headerp == NULL) {
+    return NULL;
+  }
+  headerp->sizel = sizel;
+
+  marpaEBNFAllocatorp->memory.allocationl++;
+  if (sizel > oldSizel) {
+    marpaEBNFAllocatorp->memory.totalBytel += sizel - oldSizel;
+  }
+  marpaEBNFAllocatorp->memory.liveBytel = marpaEBNFAllocatorp->memory.liveBytel - oldSizel + sizel;
+  if (marpaEBNFAllocatorp->memory.liveBytel > marpaEBNFAllocatorp->memory.peakBytel) {
+    marpaEBNFAllocatorp->memory.peakBytel = marpaEBNFAllocatorp->memory.liveBytel;
+  }
+
+  return (void *) (headerp + 1);
+}
+
+/****************************************************************************/
+void _marpaEBNF_memoryFreev(marpaEBNFAllocator_t *marpaEBNFAllocatorp, void *p)
+/****************************************************************************/
+{
+  marpaEBNFMemoryHeader_t *headerp;
+
+  if (p == NULL) {
+    return;
+  }
+
+  headerp = ((marpaEBNFMemoryHeader_t *) p) - 1;
+  marpaEBNFAllocatorp->memory.liveBytel -= headerp->sizel;
+  marpaEBNFAllocatorp->freep(marpaEBNFAllocatorp->userDatavp, headerp);
+}
+
+/****************************************************************************/
+static void *_marpaEBNF_systemMallocp(void *userDatavp, size_t sizel)
+/****************************************************************************/
+{
+  return malloc(sizel);
+}
+
+/****************************************************************************/
+static void *_marpaEBNF_systemReallocp(void *userDatavp, void *p, size_t sizel)
+/****************************************************************************/
+{
+  return realloc(p, sizel);
+}
+
+/****************************************************************************/
+static void _marpaEBNF_systemFreev(void *userDatavp, void *p)
+/****************************************************************************/
+{
+  free(p);
+}
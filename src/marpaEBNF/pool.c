@@ -0,0 +1,219 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/logging.h"
+#include "marpaEBNF/internal/thread.h"
+#include "marpaEBNF/internal/pool.h"
+
+struct marpaEBNFPool;
+
+typedef struct marpaEBNFPoolWorker {
+  struct marpaEBNFPool *poolp;
+  size_t                workeri;
+  marpaEBNFMutex_t      mutex;      /* Protects the range */
+  size_t                firstl;     /* Items left are firstl .. lastl - 1 */
+  size_t                lastl;
+  marpaEBNFThread_t     thread;
+  short                 threadb;    /* Is thread running */
+} marpaEBNFPoolWorker_t;
+
+typedef struct marpaEBNFPool {
+  marpaEBNFPoolWorker_t  *workerp;
+  size_t                  workerl;
+  marpaEBNFPoolCallback_t callbackp;
+  void                   *userDatavp;
+  marpaEBNFMutex_t        mutex;    /* Protects what follows */
+  short                   failedb;
+  size_t                  stolenl;
+} marpaEBNFPool_t;
+
+static inline short        _marpaEBNF_poolNextb(marpaEBNFPoolWorker_t *marpaEBNFPoolWorkerp, size_t *itemlp);
+static inline short        _marpaEBNF_poolStealb(marpaEBNFPoolWorker_t *marpaEBNFPoolWorkerp);
+static inline void         _marpaEBNF_poolWorkv(marpaEBNFPoolWorker_t *marpaEBNFPoolWorkerp);
+static MARPAEBNF_THREAD_RETURN _marpaEBNF_poolThreadRun(void *marpaEBNFPoolWorkervp);
+
+/****************************************************************************/
+short _marpaEBNF_poolRunb(genericLogger_t *genericLoggerp, marpaEBNFAllocator_t *marpaEBNFAllocatorp, size_t workerl, size_t iteml, marpaEBNFPoolCallback_t callbackp, void *userDatavp, size_t *stolenlp)
+/****************************************************************************/
+{
+  marpaEBNFPool_t        marpaEBNFPool;
+  marpaEBNFPoolWorker_t *marpaEBNFPoolWorkerp;
+  size_t                 workeri;
+  int                    createi;
+
+  if (workerl <= 0) {
+    workerl = 1;
+  }
+
+  marpaEBNFPool.workerp = (marpaEBNFPoolWorker_t *) _marpaEBNF_memoryMallocp(marpaEBNFAllocatorp, workerl * sizeof(marpaEBNFPoolWorker_t));
+  if (marpaEBNFPool.workerp == NULL) {
+    MARPAEBNF_ERRORF(genericLoggerp, "malloc error, %s", strerror(errno));
+    return 0;
+  }
+  marpaEBNFPool.workerl    = workerl;
+  marpaEBNFPool.callbackp  = callbackp;
+  marpaEBNFPool.userDatavp = userDatavp;
+  marpaEBNFPool.failedb    = 0;
+  marpaEBNFPool.stolenl    = 0;
+  MARPAEBNF_MUTEX_INIT(&(marpaEBNFPool.mutex));
+
+  /* Items are dealt in contiguous ranges of nearly equal sizes */
+  for (workeri = 0; workeri < workerl; workeri++) {
+    marpaEBNFPoolWorkerp = &(marpaEBNFPool.workerp[workeri]);
+    marpaEBNFPoolWorkerp->poolp   = &marpaEBNFPool;
+    marpaEBNFPoolWorkerp->workeri = workeri;
+    marpaEBNFPoolWorkerp->firstl  = (iteml * workeri) / workerl;
+    marpaEBNFPoolWorkerp->lastl   = (iteml * (workeri + 1)) / workerl;
+    marpaEBNFPoolWorkerp->threadb = 0;
+    MARPAEBNF_MUTEX_INIT(&(marpaEBNFPoolWorkerp->mutex));
+  }
+
+  /* Worker 0 is the calling thread. A worker whose thread cannot be created */
+  /* only has its range stolen by the others.                                */
+  for (workeri = 1; workeri < workerl; workeri++) {
+    marpaEBNFPoolWorkerp = &(marpaEBNFPool.workerp[workeri]);
+    createi = MARPAEBNF_THREAD_CREATEI(&(marpaEBNFPoolWorkerp->thread), _marpaEBNF_poolThreadRun, marpaEBNFPoolWorkerp);
+    marpaEBNFPoolWorkerp->threadb = (createi == 0) ? 1 : 0;
+    if (! marpaEBNFPoolWorkerp->threadb) {
+      MARPAEBNF_WARNF(genericLoggerp, "Worker %ld: thread creation failure, %s", (long) workeri, strerror(createi));
+    }
+  }
+  _marpaEBNF_poolWorkv(&(marpaEBNFPool.workerp[0]));
+
+  for (workeri = 1; workeri < workerl; workeri++) {
+    marpaEBNFPoolWorkerp = &(marpaEBNFPool.workerp[workeri]);
+    if (marpaEBNFPoolWorkerp->threadb) {
+      MARPAEBNF_THREAD_JOIN(marpaEBNFPoolWorkerp->thread);
+    }
+  }
+
+  for (workeri = 0; workeri < workerl; workeri++) {
+    MARPAEBNF_MUTEX_DESTROY(&(marpaEBNFPool.workerp[workeri].mutex));
+  }
+  MARPAEBNF_MUTEX_DESTROY(&(marpaEBNFPool.mutex));
+  _marpaEBNF_memoryFreev(marpaEBNFAllocatorp, marpaEBNFPool.workerp);
+
+  if (stolenlp != NULL) {
+    *stolenlp = marpaEBNFPool.stolenl;
+  }
+
+  return marpaEBNFPool.failedb ? 0 : 1;
+}
+
+/****************************************************************************/
+static MARPAEBNF_THREAD_RETURN _marpaEBNF_poolThreadRun(void *marpaEBNFPoolWorkervp)
+/****************************************************************************/
+{
+  _marpaEBNF_poolWorkv((marpaEBNFPoolWorker_t *) marpaEBNFPoolWorkervp);
+
+  return MARPAEBNF_THREAD_RETURN_VALUE;
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_poolWorkv(marpaEBNFPoolWorker_t *marpaEBNFPoolWorkerp)
+/****************************************************************************/
+{
+  marpaEBNFPool_t *marpaEBNFPoolp = marpaEBNFPoolWorkerp->poolp;
+  size_t           iteml;
+  short            failedb;
+
+  while (_marpaEBNF_poolNextb(marpaEBNFPoolWorkerp, &iteml)) {
+    MARPAEBNF_MUTEX_LOCK(&(marpaEBNFPoolp->mutex));
+    failedb = marpaEBNFPoolp->failedb;
+    MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFPoolp->mutex));
+    if (failedb) {
+      break;
+    }
+    if (marpaEBNFPoolp->callbackp(marpaEBNFPoolp->userDatavp, marpaEBNFPoolWorkerp->workeri, iteml) == 0) {
+      MARPAEBNF_MUTEX_LOCK(&(marpaEBNFPoolp->mutex));
+      marpaEBNFPoolp->failedb = 1;
+      MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFPoolp->mutex));
+      break;
+    }
+  }
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_poolNextb(marpaEBNFPoolWorker_t *marpaEBNFPoolWorkerp, size_t *itemlp)
+/****************************************************************************/
+/* Front of the own range, else of a stolen one. 0 when nothing is left.    */
+/****************************************************************************/
+{
+  short rcb;
+
+  do {
+    MARPAEBNF_MUTEX_LOCK(&(marpaEBNFPoolWorkerp->mutex));
+    rcb = (marpaEBNFPoolWorkerp->firstl < marpaEBNFPoolWorkerp->lastl) ? 1 : 0;
+    if (rcb) {
+      *itemlp = marpaEBNFPoolWorkerp->firstl++;
+    }
+    MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFPoolWorkerp->mutex));
+    if (rcb) {
+      return 1;
+    }
+  } while (_marpaEBNF_poolStealb(marpaEBNFPoolWorkerp));
+
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaEBNF_poolStealb(marpaEBNFPoolWorker_t *marpaEBNFPoolWorkerp)
+/****************************************************************************/
+/* Only one mutex is held at a time: a range seen as the largest may be     */
+/* smaller, or empty, once locked. The scan is then done again.             */
+/****************************************************************************/
+{
+  marpaEBNFPool_t       *marpaEBNFPoolp = marpaEBNFPoolWorkerp->poolp;
+  marpaEBNFPoolWorker_t *victimp;
+  marpaEBNFPoolWorker_t *largestp;
+  size_t                 largestl;
+  size_t                 leftl;
+  size_t                 stolenl;
+  size_t                 lastl;
+  size_t                 workeri;
+
+  for (;;) {
+    largestp = NULL;
+    largestl = 0;
+    for (workeri = 0; workeri < marpaEBNFPoolp->workerl; workeri++) {
+      victimp = &(marpaEBNFPoolp->workerp[workeri]);
+      if (victimp == marpaEBNFPoolWorkerp) {
+        continue;
+      }
+      MARPAEBNF_MUTEX_LOCK(&(victimp->mutex));
+      leftl = victimp->lastl - victimp->firstl;
+      MARPAEBNF_MUTEX_UNLOCK(&(victimp->mutex));
+      if (leftl > largestl) {
+        largestp = victimp;
+        largestl = leftl;
+      }
+    }
+    if (largestp == NULL) {
+      return 0;
+    }
+
+    /* Back half, rounded up: a range of one item is taken entirely */
+    MARPAEBNF_MUTEX_LOCK(&(largestp->mutex));
+    leftl   = largestp->lastl - largestp->firstl;
+    stolenl = (leftl + 1) / 2;
+    lastl   = largestp->lastl;
+    largestp->lastl -= stolenl;
+    MARPAEBNF_MUTEX_UNLOCK(&(largestp->mutex));
+    if (stolenl <= 0) {
+      continue;
+    }
+
+    MARPAEBNF_MUTEX_LOCK(&(marpaEBNFPoolWorkerp->mutex));
+    marpaEBNFPoolWorkerp->firstl = lastl - stolenl;
+    marpaEBNFPoolWorkerp->lastl  = lastl;
+    MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFPoolWorkerp->mutex));
+
+    MARPAEBNF_MUTEX_LOCK(&(marpaEBNFPoolp->mutex));
+    marpaEBNFPoolp->stolenl += stolenl;
+    MARPAEBNF_MUTEX_UNLOCK(&(marpaEBNFPoolp->mutex));
+
+    return 1;
+  }
+}
@@ -0,0 +1,164 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/sha256.h"
+
+#define MARPAEBNF_SHA256_MASK          0xFFFFFFFFUL
+#define MARPAEBNF_SHA256_ROTR(x, n)    ((((x) >> (n)) | ((x) << (32 - (n)))) & MARPAEBNF_SHA256_MASK)
+
+static const unsigned long marpaEBNFSha256Kp[64] = {
+  0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+  0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+  0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+  0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+  0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+  0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+  0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+  0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
+};
+
+static inline void _marpaEBNF_sha256Blockv(marpaEBNFSha256_t *marpaEBNFSha256p, const unsigned char *blockp);
+
+/****************************************************************************/
+void _marpaEBNF_sha256Initv(marpaEBNFSha256_t *marpaEBNFSha256p)
+/****************************************************************************/
+{
+  marpaEBNFSha256p->statep[0] = 0x6a09e667UL;
+  marpaEBNFSha256p->statep[1] = 0xbb67ae85UL;
+  marpaEBNFSha256p->statep[2] = 0x3c6ef372UL;
+  marpaEBNFSha256p->statep[3] = 0xa54ff53aUL;
+  marpaEBNFSha256p->statep[4] = 0x510e527fUL;
+  marpaEBNFSha256p->statep[5] = 0x9b05688cUL;
+  marpaEBNFSha256p->statep[6] = 0x1f83d9abUL;
+  marpaEBNFSha256p->statep[7] = 0x5be0cd19UL;
+  marpaEBNFSha256p->blockl    = 0;
+  marpaEBNFSha256p->lengthl   = 0;
+}
+
+/****************************************************************************/
+void _marpaEBNF_sha256Updatev(marpaEBNFSha256_t *marpaEBNFSha256p, const void *p, size_t l)
+/****************************************************************************/
+{
+  const unsigned char *bytep = (const unsigned char *) p;
+  size_t               copyl;
+
+  marpaEBNFSha256p->lengthl += l;
+
+  if (marpaEBNFSha256p->blockl > 0) {
+    copyl = 64 - marpaEBNFSha256p->blockl;
+    if (copyl > l) {
+      copyl = l;
+    }
+    memcpy(marpaEBNFSha256p->blockp + marpaEBNFSha256p->blockl, bytep, copyl);
+    marpaEBNFSha256p->blockl += copyl;
+    bytep += copyl;
+    l -= copyl;
+    if (marpaEBNFSha256p->blockl < 64) {
+      return;
+    }
+    _marpaEBNF_sha256Blockv(marpaEBNFSha256p, marpaEBNFSha256p->blockp);
+    marpaEBNFSha256p->blockl = 0;
+  }
+
+  /* Whole blocks straight from the input */
+  while (l >= 64) {
+    _marpaEBNF_sha256Blockv(marpaEBNFSha256p, bytep);
+    bytep += 64;
+    l -= 64;
+  }
+
+  if (l > 0) {
+    memcpy(marpaEBNFSha256p->blockp, bytep, l);
+    marpaEBNFSha256p->blockl = l;
+  }
+}
+
+/****************************************************************************/
+void _marpaEBNF_sha256Finalv(marpaEBNFSha256_t *marpaEBNFSha256p, unsigned char *digestp)
+/****************************************************************************/
+/* Pads with 0x80, zeroes and the big-endian length in bits                 */
+/****************************************************************************/
+{
+  size_t        lengthl = marpaEBNFSha256p->lengthl;
+  size_t        blockl  = marpaEBNFSha256p->blockl;
+  unsigned long hil;
+  unsigned long lol;
+  int           i;
+
+  marpaEBNFSha256p->blockp[blockl++] = 0x80;
+  if (blockl > 56) {
+    memset(marpaEBNFSha256p->blockp + blockl, 0, 64 - blockl);
+    _marpaEBNF_sha256Blockv(marpaEBNFSha256p, marpaEBNFSha256p->blockp);
+    blockl = 0;
+  }
+  memset(marpaEBNFSha256p->blockp + blockl, 0, 56 - blockl);
+
+  /* Bits are lengthl * 8, on 64 bits whatever the size of size_t */
+  lol = (unsigned long) ((lengthl << 3) & MARPAEBNF_SHA256_MASK);
+  hil = (unsigned long) (((lengthl >> 16) >> 13) & MARPAEBNF_SHA256_MASK);
+  for (i = 0; i < 4; i++) {
+    marpaEBNFSha256p->blockp[56 + i] = (unsigned char) ((hil >> (24 - 8 * i)) & 0xFF);
+    marpaEBNFSha256p->blockp[60 + i] = (unsigned char) ((lol >> (24 - 8 * i)) & 0xFF);
+  }
+  _marpaEBNF_sha256Blockv(marpaEBNFSha256p, marpaEBNFSha256p->blockp);
+
+  for (i = 0; i < 32; i++) {
+    digestp[i] = (unsigned char) ((marpaEBNFSha256p->statep[i / 4] >> (24 - 8 * (i % 4))) & 0xFF);
+  }
+}
+
+/****************************************************************************/
+static inline void _marpaEBNF_sha256Blockv(marpaEBNFSha256_t *marpaEBNFSha256p, const unsigned char *blockp)
+/****************************************************************************/
+{
+  unsigned long wp[64];
+  unsigned long a, b, c, d, e, f, g, h;
+  unsigned long s0, s1, t1, t2;
+  int           i;
+
+  for (i = 0; i < 16; i++) {
+    wp[i] = ((unsigned long) blockp[4 * i] << 24)
+      | ((unsigned long) blockp[4 * i + 1] << 16)
+      | ((unsigned long) blockp[4 * i + 2] << 8)
+      | (unsigned long) blockp[4 * i + 3];
+  }
+  for (i = 16; i < 64; i++) {
+    s0 = MARPAEBNF_SHA256_ROTR(wp[i - 15], 7) ^ MARPAEBNF_SHA256_ROTR(wp[i - 15], 18) ^ (wp[i - 15] >> 3);
+    s1 = MARPAEBNF_SHA256_ROTR(wp[i - 2], 17) ^ MARPAEBNF_SHA256_ROTR(wp[i - 2], 19) ^ (wp[i - 2] >> 10);
+    wp[i] = (wp[i - 16] + s0 + wp[i - 7] + s1) & MARPAEBNF_SHA256_MASK;
+  }
+
+  a = marpaEBNFSha256p->statep[0];
+  b = marpaEBNFSha256p->statep[1];
+  c = marpaEBNFSha256p->statep[2];
+  d = marpaEBNFSha256p->statep[3];
+  e = marpaEBNFSha256p->statep[4];
+  f = marpaEBNFSha256p->statep[5];
+  g = marpaEBNFSha256p->statep[6];
+  h = marpaEBNFSha256p->statep[7];
+
+  for (i = 0; i < 64; i++) {
+    s1 = MARPAEBNF_SHA256_ROTR(e, 6) ^ MARPAEBNF_SHA256_ROTR(e, 11) ^ MARPAEBNF_SHA256_ROTR(e, 25);
+    t1 = (h + s1 + ((e & f) ^ ((~e) & g)) + marpaEBNFSha256Kp[i] + wp[i]) & MARPAEBNF_SHA256_MASK;
+    s0 = MARPAEBNF_SHA256_ROTR(a, 2) ^ MARPAEBNF_SHA256_ROTR(a, 13) ^ MARPAEBNF_SHA256_ROTR(a, 22);
+    t2 = (s0 + ((a & b) ^ (a & c) ^ (b & c))) & MARPAEBNF_SHA256_MASK;
+    h = g;
+    g = f;
+    f = e;
+    e = (d + t1) & MARPAEBNF_SHA256_MASK;
+    d = c;
+    c = b;
+    b = a;
+    a = (t1 + t2) & MARPAEBNF_SHA256_MASK;
+  }
+
+  marpaEBNFSha256p->statep[0] = (marpaEBNFSha256p->statep[0] + a) & MARPAEBNF_SHA256_MASK;
+  marpaEBNFSha256p->statep[1] = (marpaEBNFSha256p->statep[1] + b) & MARPAEBNF_SHA256_MASK;
+  marpaEBNFSha256p->statep[2] = (marpaEBNFSha256p->statep[2] + c) & MARPAEBNF_SHA256_MASK;
+  marpaEBNFSha256p->statep[3] = (marpaEBNFSha256p->statep[3] + d) & MARPAEBNF_SHA256_MASK;
+  marpaEBNFSha256p->statep[4] = (marpaEBNFSha256p->statep[4] + e) & MARPAEBNF_SHA256_MASK;
+  marpaEBNFSha256p->statep[5] = (marpaEBNFSha256p->statep[5] + f) & MARPAEBNF_SHA256_MASK;
+  marpaEBNFSha256p->statep[6] = (marpaEBNFSha256p->statep[6] + g) & MARPAEBNF_SHA256_MASK;
+  marpaEBNFSha256p->statep[7] = (marpaEBNFSha256p->statep[7] + h) & MARPAEBNF_SHA256_MASK;
+}
@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/split.h"
+#include "marpaEBNF/internal/scan.h"
+
+/****************************************************************************/
+size_t _marpaEBNF_splitl(char *inputs, size_t inputl, marpaEBNFPiece_t *piecep, size_t maxPiecel, short utf8b)
+/****************************************************************************/
+/* A cut is only confirmed by a terminator that follows it: the last piece  */
+/* is never made of gap separators and comments alone. The scan stops at    */
+/* the first thing it cannot skip, e.g. an unterminated terminal string:    */
+/* the piece that contains it reports the error.                            */
+/****************************************************************************/
+{
+  size_t  piecel   = 0;
+  size_t  targetl;
+  size_t  startl   = 0;
+  size_t  cutl     = 0;    /* Pending cut, 0 if none */
+  size_t  offsetl  = 0;
+  int     depthi;
+  char    c;
+  char   *endp;
+
+  if (maxPiecel <= 0) {
+    return 0;
+  }
+  targetl = inputl / maxPiecel;
+
+  piecep[0].offsetl = 0;
+  piecep[0].linel   = 1;
+  piecep[0].columnl = 1;
+
+  while ((offsetl < inputl) && (piecel + 1 < maxPiecel)) {
+    c = inputs[offsetl];
+    switch (c) {
+    case '\'':
+    case '"':
+    case '?':
+      /* Terminal strings and special sequences do not nest */
+      endp = (char *) memchr(inputs + offsetl + 1, c, inputl - offsetl - 1);
+      if (endp == NULL) {
+        goto done;
+      }
+      offsetl = (endp - inputs) + 1;
+      break;
+    case '(':
+      if ((offsetl + 1 >= inputl) || (inputs[offsetl + 1] != '*')) {
+        offsetl++;
+        break;
+      }
+      /* Bracketed textual comments nest */
+      depthi = 1;
+      offsetl += 2;
+      while ((depthi > 0) && (offsetl + 1 < inputl)) {
+        if ((inputs[offsetl] == '(') && (inputs[offsetl + 1] == '*')) {
+          depthi++;
+          offsetl += 2;
+        } else if ((inputs[offsetl] == '*') && (inputs[offsetl + 1] == ')')) {
+          depthi--;
+          offsetl += 2;
+        } else {
+          offsetl++;
+        }
+      }
+      if (depthi > 0) {
+        goto done;
+      }
+      break;
+    case ';':
+    case '.':
+      offsetl++;
+      if (cutl > 0) {
+        piecep[piecel].lengthl = cutl - startl;
+        _marpaEBNF_splitPiecev(inputs, &(piecep[piecel]), &(piecep[piecel + 1]), cutl, utf8b);
+        piecel++;
+        startl = cutl;
+        cutl = 0;
+      }
+      if ((offsetl - startl >= targetl) && (piecel + 1 < maxPiecel)) {
+        cutl = offsetl;
+      }
+      break;
+    default:
+      offsetl++;
+      break;
+    }
+  }
+
+ done:
+  piecep[piecel].lengthl = inputl - startl;
+
+  return piecel + 1;
+}
+
+/****************************************************************************/
+void _marpaEBNF_splitPiecev(char *inputs, marpaEBNFPiece_t *previousp, marpaEBNFPiece_t *piecep, size_t offsetl, short utf8b)
+/****************************************************************************/
+/* Line and column as counted by the tokenizer                              */
+/****************************************************************************/
+{
+  char *p    = inputs + previousp->offsetl;
+  char *maxp = inputs + offsetl;
+  char *newlinep;
+
+  piecep->offsetl = offsetl;
+  piecep->linel   = previousp->linel;
+  piecep->columnl = previousp->columnl;
+  while ((newlinep = (char *) memchr(p, '\n', maxp - p)) != NULL) {
+    piecep->linel++;
+    piecep->columnl = 1;
+    p = newlinep + 1;
+  }
+  piecep->columnl += _marpaEBNF_scanColumnl(p, 0, maxp - p, utf8b);
+}
@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "marpaEBNF.h"
+
+/* Parses a fixed corpus through the public API and writes one JSON object   */
+/* per line and per input and mode: throughput, allocations, peak RSS and    */
+/* the wall time of each phase. Each measure is the best of its iterations.  */
+/* The corpus is made of the files below, then of synthetic grammars of      */
+/* 1K to maxRules rules with heavy comments.                                 */
+/* Usage: marpaEBNFBench [corpusDirectory [maxRules [maxIterations]]]        */
+
+#define MARPAEBNFBENCH_MAX_RULES              1000000
+#define MARPAEBNFBENCH_SCANNERLESS_MAX_RULES  10000    /* The character-level grammar builds an ASF */
+#define MARPAEBNFBENCH_MIN_BYTES              (8 * 1024 * 1024) /* Small inputs are parsed until this is reached */
+#define MARPAEBNFBENCH_MAX_ITERATIONS         1000
+
+static char *corpusFilesp[] = {
+  "iso14977.ebnf",     /* ISO/IEC 14977 describing itself */
+  "pascal.ebnf"        /* A programming language specification */
+};
+
+typedef struct marpaEBNFBenchResult {
+  short              okb;
+  size_t             iterationl;
+  double             secondsd;         /* Best iteration */
+  marpaEBNFStats_t   marpaEBNFStats;   /* Of the best iteration */
+  marpaEBNFMemory_t  marpaEBNFMemory;  /* Ditto */
+  size_t             rulel;            /* Syntax rules, token-level mode only */
+} marpaEBNFBenchResult_t;
+
+/****************************************************************************/
+static double _marpaEBNFBench_secondsd(void)
+/****************************************************************************/
+{
+#ifdef _WIN32
+  return (double) clock() / (double) CLOCKS_PER_SEC;
+#else
+  struct timespec timespec;
+
+  clock_gettime(CLOCK_MONOTONIC, &timespec);
+  return (double) timespec.tv_sec + (double) timespec.tv_nsec / 1e9;
+#endif
+}
+
+/****************************************************************************/
+static long _marpaEBNFBench_peakRssKbl(void)
+/****************************************************************************/
+/* Of the whole process so far, -1 when unknown                             */
+/****************************************************************************/
+{
+#ifdef _WIN32
+  return -1;
+#else
+  struct rusage rusage;
+
+  if (getrusage(RUSAGE_SELF, &rusage) != 0) {
+    return -1;
+  }
+#ifdef __APPLE__
+  return (long) (rusage.ru_maxrss / 1024);
+#else
+  return (long) rusage.ru_maxrss;
+#endif
+#endif
+}
+
+/****************************************************************************/
+static char *_marpaEBNFBench_reads(char *directorys, char *filenames, size_t *lengthlp)
+/****************************************************************************/
+{
+  char   *pathnames;
+  FILE   *fp;
+  char   *inputs = NULL;
+  long    sizel;
+
+  pathnames = (char *) malloc(strlen(directorys) + 1 + strlen(filenames) + 1);
+  if (pathnames == NULL) {
+    perror("malloc");
+    return NULL;
+  }
+  sprintf(pathnames, "%s/%s", directorys, filenames);
+
+  fp = fopen(pathnames, "rb");
+  if (fp == NULL) {
+    perror(pathnames);
+    free(pathnames);
+    return NULL;
+  }
+  if ((fseek(fp, 0, SEEK_END) != 0) || ((sizel = ftell(fp)) < 0) || (fseek(fp, 0, SEEK_SET) != 0)) {
+    perror(pathnames);
+  } else if ((inputs = (char *) malloc((size_t) sizel + 1)) == NULL) {
+    perror("malloc");
+  } else if (fread(inputs, 1, (size_t) sizel, fp) != (size_t) sizel) {
+    perror(pathnames);
+    free(inputs);
+    inputs = NULL;
+  } else {
+    inputs[sizel] = '\0';
+    *lengthlp = (size_t) sizel;
+  }
+  fclose(fp);
+  free(pathnames);
+
+  return inputs;
+}
+
+/****************************************************************************/
+static char *_marpaEBNFBench_generates(size_t rulel, size_t *lengthlp)
+/****************************************************************************/
+/* Rules are commented as in an annotated specification: comments are more */
+/* than half of the input. Every rule refers to the next ones, and always   */
+/* starts with a terminal, so that there is neither a cycle nor an          */
+/* undefined meta identifier.                                               */
+/****************************************************************************/
+{
+  size_t  allocl = rulel * 256 + 256;
+  char   *inputs = (char *) malloc(allocl);
+  char   *p      = inputs;
+  size_t  i;
+
+  if (inputs == NULL) {
+    perror("malloc");
+    return NULL;
+  }
+  for (i = 0; i < rulel; i++) {
+    p += sprintf(p,
+                 "(* Rule %ld: a synthetic rule. (* Comments nest. *) It refers to the next ones *)\n"
+                 "rule %ld = 'kw%ld', [rule %ld], {',', rule %ld} | \"text %ld\" | 3 * 'x', rule %ld;\n",
+                 (long) i,
+                 (long) i, (long) i, (long) ((i + 1) % rulel), (long) ((i + 2) % rulel), (long) i, (long) ((i + 3) % rulel));
+  }
+  *lengthlp = (size_t) (p - inputs);
+
+  return inputs;
+}
+
+/****************************************************************************/
+static short _marpaEBNFBench_runb(char *inputs, size_t inputl, short scannerlessb, size_t maxIterationl, marpaEBNFBenchResult_t *resultp)
+/****************************************************************************/
+{
+  marpaEBNFOption_t  marpaEBNFOption;
+  marpaEBNF_t       *marpaEBNFp;
+  marpaEBNFAst_t    *marpaEBNFAstp;
+  size_t             iterationl;
+  size_t             firstChildl;
+  size_t             childl;
+  size_t             i;
+  double             startd;
+  double             secondsd;
+
+  iterationl = (inputl > 0) ? (MARPAEBNFBENCH_MIN_BYTES + inputl - 1) / inputl : 1;
+  if (iterationl > maxIterationl) {
+    iterationl = maxIterationl;
+  }
+
+  memset(resultp, 0, sizeof(marpaEBNFBenchResult_t));
+  memset(&marpaEBNFOption, 0, sizeof(marpaEBNFOption_t));
+  marpaEBNFOption.genericLoggerp = NULL;
+  marpaEBNFOption.scannerlessb   = scannerlessb;
+
+  /* A new instance per iteration: memory accounting is then per parse */
+  for (i = 0; i < iterationl; i++) {
+    marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+    if (marpaEBNFp == NULL) {
+      perror("marpaEBNF_newp");
+      return 0;
+    }
+    startd = _marpaEBNFBench_secondsd();
+    if (marpaEBNF_grammarBufferb(marpaEBNFp, inputs, inputl) == 0) {
+      marpaEBNF_freev(marpaEBNFp);
+      return 1;
+    }
+    secondsd = _marpaEBNFBench_secondsd() - startd;
+    if ((i == 0) || (secondsd < resultp->secondsd)) {
+      resultp->secondsd = secondsd;
+      marpaEBNF_statsb(marpaEBNFp, &(resultp->marpaEBNFStats));
+      marpaEBNF_memoryb(marpaEBNFp, &(resultp->marpaEBNFMemory));
+    }
+    if ((i == 0) && (! scannerlessb)) {
+      marpaEBNFAstp = marpaEBNF_astp(marpaEBNFp);
+      if ((marpaEBNFAstp != NULL) && marpaEBNFAst_childrenb(marpaEBNFAstp, 0, &firstChildl, &childl)) {
+        resultp->rulel = childl;
+      }
+    }
+    marpaEBNF_freev(marpaEBNFp);
+  }
+
+  resultp->okb        = 1;
+  resultp->iterationl = iterationl;
+  return 1;
+}
+
+/****************************************************************************/
+static void _marpaEBNFBench_printv(char *names, short scannerlessb, size_t inputl, size_t rulel, marpaEBNFBenchResult_t *resultp)
+/****************************************************************************/
+{
+  double secondsd = resultp->secondsd;
+
+  fprintf(stdout,
+          "{\"corpus\":\"%s\",\"mode\":\"%s\",\"ok\":%s,\"bytes\":%ld,\"rules\":%ld,\"iterations\":%ld,"
+          "\"seconds\":%.6f,\"mbPerSecond\":%.3f,\"tokens\":%ld,\"tokensPerSecond\":%.0f,"
+          "\"allocations\":%ld,\"peakBytes\":%ld,\"peakRssKb\":%ld,"
+          "\"recognizeSeconds\":%.6f,\"asfSeconds\":%.6f,\"valueSeconds\":%.6f,\"compileSeconds\":%.6f}\n",
+          names,
+          scannerlessb ? "scannerless" : "token",
+          resultp->okb ? "true" : "false",
+          (long) inputl,
+          (long) rulel,
+          (long) resultp->iterationl,
+          secondsd,
+          (secondsd > 0.) ? ((double) inputl / (1024. * 1024.)) / secondsd : 0.,
+          (long) resultp->marpaEBNFStats.earleySetl,
+          (secondsd > 0.) ? (double) resultp->marpaEBNFStats.earleySetl / secondsd : 0.,
+          (long) resultp->marpaEBNFMemory.allocationl,
+          (long) resultp->marpaEBNFMemory.peakBytel,
+          _marpaEBNFBench_peakRssKbl(),
+          resultp->marpaEBNFStats.recognizeSecondsd,
+          resultp->marpaEBNFStats.asfSecondsd,
+          resultp->marpaEBNFStats.valueSecondsd,
+          resultp->marpaEBNFStats.compileSecondsd);
+  fflush(stdout);
+}
+
+/****************************************************************************/
+static short _marpaEBNFBench_inputb(char *names, char *inputs, size_t inputl, short scannerlessOkb, size_t maxIterationl)
+/****************************************************************************/
+/* Token-level mode first: the number of rules comes from its AST           */
+/****************************************************************************/
+{
+  marpaEBNFBenchResult_t result;
+  size_t                 rulel;
+  short                  rcb = 1;
+
+  if (_marpaEBNFBench_runb(inputs, inputl, 0, maxIterationl, &result) == 0) {
+    return 0;
+  }
+  rulel = result.rulel;
+  _marpaEBNFBench_printv(names, 0, inputl, rulel, &result);
+  rcb = result.okb;
+
+  if (scannerlessOkb) {
+    if (_marpaEBNFBench_runb(inputs, inputl, 1, maxIterationl, &result) == 0) {
+      return 0;
+    }
+    _marpaEBNFBench_printv(names, 1, inputl, rulel, &result);
+    rcb = rcb && result.okb;
+  }
+
+  return rcb;
+}
+
+/****************************************************************************/
+int main(int argc, char **argv) {
+/****************************************************************************/
+  char   *directorys    = "corpus";
+  size_t  maxRulel      = MARPAEBNFBENCH_MAX_RULES;
+  size_t  maxIterationl = MARPAEBNFBENCH_MAX_ITERATIONS;
+  char   *inputs;
+  size_t  inputl;
+  size_t  rulel;
+  size_t  i;
+  char    names[64];
+  int     rci = 0;
+
+  if (argc > 1) {
+    directorys = argv[1];
+  }
+  if (argc > 2) {
+    maxRulel = (size_t) atol(argv[2]);
+  }
+  if ((argc > 3) && (atol(argv[3]) > 0)) {
+    maxIterationl = (size_t) atol(argv[3]);
+  }
+
+  for (i = 0; i < sizeof(corpusFilesp) / sizeof(corpusFilesp[0]); i++) {
+    inputs = _marpaEBNFBench_reads(directorys, corpusFilesp[i], &inputl);
+    if (inputs == NULL) {
+      rci = 1;
+      continue;
+    }
+    if (! _marpaEBNFBench_inputb(corpusFilesp[i], inputs, inputl, 1, maxIterationl)) {
+      rci = 1;
+    }
+    free(inputs);
+  }
+
+  for (rulel = 1000; rulel <= maxRulel; rulel *= 10) {
+    inputs = _marpaEBNFBench_generates(rulel, &inputl);
+    if (inputs == NULL) {
+      rci = 1;
+      break;
+    }
+    sprintf(names, "synthetic-%ld", (long) rulel);
+    if (! _marpaEBNFBench_inputb(names, inputs, inputl, (short) (rulel <= MARPAEBNFBENCH_SCANNERLESS_MAX_RULES), maxIterationl)) {
+      rci = 1;
+    }
+    free(inputs);
+  }
+
+  return rci;
+}
@@ -0,0 +1,459 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "config.h"
+#include "marpaEBNF/internal/symbol.h"
+#include "marpaEBNF/internal/byteClass.h"
+#include "marpaEBNF/internal/scan.h"
+
+/* Compares the table-driven lexer of the internal grammar with the per-expected-symbol switch */
+/* it replaced, and the bulk scan of the tokenizer with its scalar version, without and with   */
+/* UTF-8: the input again with the utf8b option, then a text with long UTF-8 runs.             */
+/* Usage: marpaEBNFLexerBench [file.ebnf [iterations]]                                         */
+
+static char *samples =
+"(* see 4.2 *) syntax" "\n"
+"= syntax rule, {syntax rule};" "\n"
+"(* see 4.3 *) syntax rule" "\n"
+"= meta identifier, defining symbol," "\n"
+"definitions list, terminator symbol;" "\n"
+"definition separator symbol = '|' | '/' | '!';" "\n"
+"end option symbol = ']' | '/)';" "\n"
+"end repeat symbol = '}' | ':)';" "\n"
+"start option symbol = '[' | '(/';" "\n"
+"start repeat symbol = '{' | '(:';" "\n"
+"other character" "\n"
+"= ' ' | ':' | '+' | '_' | '%' | '@'" "\n"
+"| '&' | '#' | '$' | '<' | '>' | '\\'" "\n"
+"| '^' | '`' | '~';" "\n"
+"horizontal tabulation character" "\n"
+"= ? ISO 6429 character Horizontal Tabulation ? ;" "\n"
+"(* see 4.8 *) syntactic factor" "\n"
+"= [integer, repetition symbol]," "\n"
+"syntactic primary;" "\n"
+  ;
+
+/* Greek words, a Japanese sentence, and terminal strings of 2, 3 and 4 bytes */
+static char *utf8Samples =
+"(* \xce\x93\xcf\x81\xce\xb1\xce\xbc\xce\xbc\xce\xb1\xcf\x84\xce\xb9\xce\xba\xce\xae \xce\xb3\xce\xb9\xce\xb1 \xcf\x84\xce\xbf EBNF, "
+"\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe6\x96\x87\xe6\xb3\x95\xe3\x81\xae\xe4\xbe\x8b\xe3\x81\xa7\xe3\x81\x99\xe3\x80\x82\xe6\x8b\xa1"
+"\xe5\xbc\xb5\xe3\x83\x90\xe3\x83\x83\xe3\x82\xab\xe3\x82\xb9\xe3\x83\xbb\xe3\x83\x8a\xe3\x82\xa6\xe3\x82\xa2\xe8\xa8\x98\xe6\xb3\x95\xe3\x81\xa7"
+"\xe6\x9b\xb8\xe3\x81\x8b\xe3\x82\x8c\xe3\x81\x9f\xe6\x96\x87\xe6\xb3\x95\xe3\x82\x92\xe8\xa7\xa3\xe6\x9e\x90\xe3\x81\x97\xe3\x81\xbe\xe3\x81\x99"
+"\xe3\x80\x82" " *)" "\n"
+"letter = '\xc3\xa9' | '\xc3\x9f' | '\xe4\xb8\xad' | '\xf0\x9f\x98\x80';" "\n"
+  ;
+
+/* Expected sets the lexer is typically asked about: everything, a gap context and an identifier context */
+static int gapSymbolip[] = { SPACE_CHARACTER, HORIZONTAL_TABULATION_CHARACTER, _CARRIAGE_RETURN, _LINE_FEED, VERTICAL_TABULATION_CHARACTER, FORM_FEED, START_COMMENT_SYMBOL, LETTER };
+static int identifierSymbolip[] = { LETTER, DECIMAL_DIGIT, SPACE_CHARACTER, _LINE_FEED, DEFINING_SYMBOL, CONCATENATE_SYMBOL, DEFINITION_SEPARATOR_SYMBOL, TERMINATOR_SYMBOL, _END_OPTION_SYMBOL_1, _END_REPEAT_SYMBOL_1, END_GROUP_SYMBOL };
+
+/****************************************************************************/
+static size_t _marpaEBNFLexerBench_switchl(int *expectedSymbolArrayp, size_t nSymboll, char c1, char c2, marpaEBNFSymbolSet_t *acceptedSetp)
+/****************************************************************************/
+/* The legacy lexer, as it was in marpaEBNF_grammarb                        */
+/****************************************************************************/
+{
+  size_t i;
+  int    symboli;
+  short  okb;
+  size_t lengthl = 0;
+
+  MARPAEBNF_SYMBOLSET_ZERO(acceptedSetp);
+  for (i = 0; i < nSymboll; i++) {
+    symboli = expectedSymbolArrayp[i];
+    switch (symboli) {
+    case LETTER:
+      okb = (((c1 >= 'a') && (c1 <= 'z')) || ((c1 >= 'A') && (c1 <= 'Z')));
+      break;
+    case DECIMAL_DIGIT:
+      okb = ((c1 >= '0') && (c1 <= '9'));
+      break;
+    case CONCATENATE_SYMBOL:
+      okb = (c1 == ',');
+      break;
+    case DEFINING_SYMBOL:
+      okb = (c1 == '=');
+      break;
+    case DEFINITION_SEPARATOR_SYMBOL:
+      okb = ((c1 == '|') || (c1 == '/') || (c1 == '!'));
+      break;
+    case END_COMMENT_SYMBOL:
+      okb = ((c1 == '*') && (c2 == ')'));
+      break;
+    case END_GROUP_SYMBOL:
+      okb = (c1 == ')');
+      break;
+    case _END_OPTION_SYMBOL_0:
+      okb = (c1 == ']');
+      break;
+    case _END_OPTION_SYMBOL_1:
+      okb = ((c1 == '/') && (c2 == ')'));
+      break;
+    case _END_REPEAT_SYMBOL_0:
+      okb = (c1 == '}');
+      break;
+    case _END_REPEAT_SYMBOL_1:
+      okb = ((c1 == ':') && (c2 == ')'));
+      break;
+    case EXCEPT_SYMBOL:
+      okb = (c1 == '-');
+      break;
+    case FIRST_QUOTE_SYMBOL:
+      okb = (c1 == '\'');
+      break;
+    case REPETITION_SYMBOL:
+      okb = (c1 == '*');
+      break;
+    case SECOND_QUOTE_SYMBOL:
+      okb = (c1 == '"');
+      break;
+    case SPECIAL_SEQUENCE_SYMBOL:
+      okb = (c1 == '?');
+      break;
+    case START_COMMENT_SYMBOL:
+      okb = ((c1 == '(') && (c2 == '*'));
+      break;
+    case START_GROUP_SYMBOL:
+      okb = (c1 == '(');
+      break;
+    case _START_OPTION_SYMBOL_0:
+      okb = (c1 == '[');
+      break;
+    case _START_OPTION_SYMBOL_1:
+      okb = ((c1 == '(') && (c2 == '/'));
+      break;
+    case _START_REPEAT_SYMBOL_0:
+      okb = (c1 == '{');
+      break;
+    case _START_REPEAT_SYMBOL_1:
+      okb = ((c1 == '(') && (c2 == ':'));
+      break;
+    case TERMINATOR_SYMBOL:
+      okb = (c1 == ';' || c1 == '.');
+      break;
+    case OTHER_CHARACTER:
+      okb = ((c1 == ' ') || (c1 == ':') || (c1 == '+') || (c1 == '_') || (c1 == '%') || (c1 == '@')  ||
+             (c1 == '&') || (c1 == '#') || (c1 == '$') || (c1 == '<') || (c1 == '>') || (c1 == '\\') ||
+             (c1 == '^') || (c1 == '`') || (c1 == '~'));
+      break;
+    case SPACE_CHARACTER:
+      okb = (c1 == ' ');
+      break;
+    case HORIZONTAL_TABULATION_CHARACTER:
+      okb = (c1 == '\t');
+      break;
+    case _CARRIAGE_RETURN:
+      okb = (c1 == '\r');
+      break;
+    case _LINE_FEED:
+      okb = (c1 == '\n');
+      break;
+    case VERTICAL_TABULATION_CHARACTER:
+      okb = (c1 == '\v');
+      break;
+    case FORM_FEED:
+      okb = (c1 == '\f');
+      break;
+    default:
+      okb = 0;
+      break;
+    }
+
+    if (okb) {
+      switch (symboli) {
+      case START_COMMENT_SYMBOL:
+      case END_COMMENT_SYMBOL:
+      case _START_OPTION_SYMBOL_1:
+      case _END_OPTION_SYMBOL_1:
+      case _START_REPEAT_SYMBOL_1:
+      case _END_REPEAT_SYMBOL_1:
+        if (lengthl != 2) {
+          /* First time we hit a multiple-characters lexeme: re-initialize alternatives */
+          MARPAEBNF_SYMBOLSET_ZERO(acceptedSetp);
+          lengthl = 2;
+        }
+        break;
+      default:
+        if (lengthl == 2) {
+          okb = 0;
+        }
+        break;
+      }
+    }
+
+    if (okb) {
+      MARPAEBNF_SYMBOLSET_SET(acceptedSetp, symboli);
+      if (lengthl <= 0) {
+        lengthl = 1;
+      }
+    }
+  }
+
+  return lengthl;
+}
+
+/****************************************************************************/
+static size_t _marpaEBNFLexerBench_stopl(char *inputs, size_t offsetl, size_t inputl, char delimiter1, char delimiter2, short gapb, short scalarb, short utf8b)
+/****************************************************************************/
+/* The run of a comment, a terminal string or a special sequence, as the    */
+/* tokenizer goes over it                                                   */
+/****************************************************************************/
+{
+  size_t nextl;
+
+  while (1) {
+    offsetl = scalarb ? _marpaEBNF_scanStopScalarl(inputs, offsetl, inputl, delimiter1, delimiter2, gapb) : _marpaEBNF_scanStopl(inputs, offsetl, inputl, delimiter1, delimiter2, gapb);
+    if ((! utf8b) || (offsetl >= inputl) || ((unsigned char) inputs[offsetl] < 0x80)) {
+      break;
+    }
+    nextl = scalarb ? _marpaEBNF_scanUtf8EndScalarl(inputs, offsetl, inputl) : _marpaEBNF_scanUtf8Endl(inputs, offsetl, inputl);
+    if (nextl <= offsetl) {
+      break;
+    }
+    offsetl = nextl;
+  }
+
+  return offsetl;
+}
+
+/****************************************************************************/
+static size_t _marpaEBNFLexerBench_scanl(char *inputs, size_t inputl, short scalarb, short utf8b)
+/****************************************************************************/
+/* Walks the input like the tokenizer does, jumping over gap separators,    */
+/* comments, terminal strings and special sequences. Returns a checksum of  */
+/* the positions where each run stopped.                                    */
+/****************************************************************************/
+{
+  size_t checksuml = 0;
+  size_t offsetl   = 0;
+  char   c;
+
+  while (offsetl < inputl) {
+    c = inputs[offsetl];
+    if (MARPAEBNF_SCAN_IS_GAP((unsigned char) c)) {
+      offsetl = scalarb ? _marpaEBNF_scanGapEndScalarl(inputs, offsetl, inputl) : _marpaEBNF_scanGapEndl(inputs, offsetl, inputl);
+    } else if ((c == '(') && (inputs[offsetl + 1] == '*')) {
+      offsetl = _marpaEBNFLexerBench_stopl(inputs, offsetl + 2, inputl, '(', '*', 1, scalarb, utf8b);
+    } else if ((c == '\'') || (c == '"') || (c == '?')) {
+      offsetl = _marpaEBNFLexerBench_stopl(inputs, offsetl + 1, inputl, c, c, c == '?', scalarb, utf8b);
+      offsetl++;
+    } else {
+      offsetl++;
+    }
+    checksuml += offsetl;
+  }
+
+  return checksuml;
+}
+
+/****************************************************************************/
+static char *_marpaEBNFLexerBench_reads(char *filenames, size_t *lengthlp)
+/****************************************************************************/
+{
+  FILE   *fp;
+  char   *bufs = NULL;
+  long    sizel;
+
+  fp = fopen(filenames, "rb");
+  if (fp == NULL) {
+    perror(filenames);
+    return NULL;
+  }
+  if ((fseek(fp, 0, SEEK_END) != 0) || ((sizel = ftell(fp)) < 0) || (fseek(fp, 0, SEEK_SET) != 0)) {
+    perror(filenames);
+    fclose(fp);
+    return NULL;
+  }
+  bufs = (char *) malloc((size_t) sizel + 1);
+  if (bufs == NULL) {
+    perror("malloc");
+    fclose(fp);
+    return NULL;
+  }
+  if (fread(bufs, 1, (size_t) sizel, fp) != (size_t) sizel) {
+    perror(filenames);
+    free(bufs);
+    fclose(fp);
+    return NULL;
+  }
+  bufs[sizel] = '\0';
+  fclose(fp);
+
+  *lengthlp = (size_t) sizel;
+  return bufs;
+}
+
+int main(int argc, char **argv) {
+  int                   rci        = 0;
+  int                   iterationi = 2000;
+  char                 *inputs     = samples;
+  size_t                inputl     = strlen(samples);
+  int                  *allSymbolip;
+  size_t                nAllSymboll;
+  int                  *expectedSymbolipp[3];
+  size_t                nExpectedSymbollp[3];
+  marpaEBNFSymbolSet_t  expectedSetp[3];
+  marpaEBNFSymbolSet_t  switchSet;
+  marpaEBNFSymbolSet_t  tableSet;
+  marpaEBNFByteClass_t *byteClassp;
+  size_t                switchLengthl;
+  size_t                tableLengthl;
+  size_t                checksuml[2] = { 0, 0 };
+  size_t                scanChecksuml[2] = { 0, 0 };
+  size_t                utf8Checksuml[3] = { 0, 0, 0 };
+  clock_t               startl;
+  double                secondsp[2];
+  double                scanSecondsp[2];
+  double                utf8Secondsp[3];
+  char                 *utf8s;
+  size_t                utf8Samplel = strlen(utf8Samples);
+  double                megaBytesd;
+  size_t                i;
+  size_t                j;
+  int                   iteri;
+  int                   methodi;
+
+  if (argc > 1) {
+    inputs = _marpaEBNFLexerBench_reads(argv[1], &inputl);
+    if (inputs == NULL) {
+      return 1;
+    }
+  }
+  if (argc > 2) {
+    iterationi = atoi(argv[2]);
+  }
+
+  byteClassp = (marpaEBNFByteClass_t *) malloc(sizeof(marpaEBNFByteClass_t));
+  nAllSymboll = sizeof(marpaEBNFLexemeArray) / sizeof(marpaEBNFLexemeArray[0]);
+  allSymbolip = (int *) malloc(nAllSymboll * sizeof(int));
+  if ((byteClassp == NULL) || (allSymbolip == NULL)) {
+    perror("malloc");
+    return 1;
+  }
+  _marpaEBNF_byteClassInitv(byteClassp);
+  for (i = 0; i < nAllSymboll; i++) {
+    allSymbolip[i] = marpaEBNFLexemeArray[i].symboli;
+  }
+
+  expectedSymbolipp[0] = allSymbolip;        nExpectedSymbollp[0] = nAllSymboll;
+  expectedSymbolipp[1] = gapSymbolip;        nExpectedSymbollp[1] = sizeof(gapSymbolip) / sizeof(gapSymbolip[0]);
+  expectedSymbolipp[2] = identifierSymbolip; nExpectedSymbollp[2] = sizeof(identifierSymbolip) / sizeof(identifierSymbolip[0]);
+  for (j = 0; j < 3; j++) {
+    MARPAEBNF_SYMBOLSET_ZERO(&(expectedSetp[j]));
+    for (i = 0; i < nExpectedSymbollp[j]; i++) {
+      MARPAEBNF_SYMBOLSET_SET(&(expectedSetp[j]), expectedSymbolipp[j][i]);
+    }
+  }
+
+  /* Both lexers must agree on every byte */
+  for (i = 0; i < inputl; i++) {
+    for (j = 0; j < 3; j++) {
+      switchLengthl = _marpaEBNFLexerBench_switchl(expectedSymbolipp[j], nExpectedSymbollp[j], inputs[i], inputs[i + 1], &switchSet);
+      tableLengthl  = _marpaEBNF_byteClassLexl(byteClassp, &(expectedSetp[j]), 1, (unsigned char) inputs[i], (unsigned char) inputs[i + 1], &tableSet);
+      if ((switchLengthl != tableLengthl) || ((tableLengthl > 0) && (memcmp(&switchSet, &tableSet, sizeof(marpaEBNFSymbolSet_t)) != 0))) {
+        fprintf(stderr, "Mismatch at offset %ld, expected set %d: switch length %d, table length %d\n", (long) i, (int) j, (int) switchLengthl, (int) tableLengthl);
+        rci = 1;
+      }
+    }
+  }
+
+  for (methodi = 0; methodi < 2; methodi++) {
+    startl = clock();
+    for (iteri = 0; iteri < iterationi; iteri++) {
+      for (i = 0; i < inputl; i++) {
+        j = i % 3;
+        if (methodi == 0) {
+          checksuml[methodi] += _marpaEBNFLexerBench_switchl(expectedSymbolipp[j], nExpectedSymbollp[j], inputs[i], inputs[i + 1], &switchSet);
+          checksuml[methodi] += switchSet.wordp[0] & 1;
+        } else {
+          /* The table lexer is given the expected set as an array, like the switch is */
+          MARPAEBNF_SYMBOLSET_ZERO(&tableSet);
+          for (j = 0; j < nExpectedSymbollp[i % 3]; j++) {
+            MARPAEBNF_SYMBOLSET_SET(&tableSet, expectedSymbolipp[i % 3][j]);
+          }
+          checksuml[methodi] += _marpaEBNF_byteClassLexl(byteClassp, &tableSet, 1, (unsigned char) inputs[i], (unsigned char) inputs[i + 1], &switchSet);
+          checksuml[methodi] += switchSet.wordp[0] & 1;
+        }
+      }
+    }
+    secondsp[methodi] = (double) (clock() - startl) / (double) CLOCKS_PER_SEC;
+  }
+
+  /* Bulk scan: scalar first, then the vectorized version if the build has one */
+  for (methodi = 0; methodi < 2; methodi++) {
+    startl = clock();
+    for (iteri = 0; iteri < iterationi; iteri++) {
+      scanChecksuml[methodi] += _marpaEBNFLexerBench_scanl(inputs, inputl, (short) (methodi == 0), 0);
+    }
+    scanSecondsp[methodi] = (double) (clock() - startl) / (double) CLOCKS_PER_SEC;
+  }
+
+  /* The same input with utf8b, that must not be slower, then as many bytes of */
+  /* UTF-8 samples with the scalar and the vectorized validators               */
+  utf8s = (char *) malloc(inputl + 1);
+  if (utf8s == NULL) {
+    perror("malloc");
+    return 1;
+  }
+  for (i = 0; i < inputl; i += j) {
+    j = ((inputl - i) < utf8Samplel) ? (inputl - i) : utf8Samplel;
+    memcpy(utf8s + i, utf8Samples, j);
+  }
+  utf8s[inputl] = '\0';
+  for (methodi = 0; methodi < 3; methodi++) {
+    startl = clock();
+    for (iteri = 0; iteri < iterationi; iteri++) {
+      utf8Checksuml[methodi] += _marpaEBNFLexerBench_scanl((methodi == 0) ? inputs : utf8s, inputl, (short) (methodi == 1), 1);
+    }
+    utf8Secondsp[methodi] = (double) (clock() - startl) / (double) CLOCKS_PER_SEC;
+  }
+
+  megaBytesd = ((double) inputl * (double) iterationi) / (1024. * 1024.);
+  fprintf(stdout, "input: %ld bytes x %d iterations\n", (long) inputl, iterationi);
+  fprintf(stdout, "switch: %10.3f s, %10.2f MB/s\n", secondsp[0], (secondsp[0] > 0.) ? megaBytesd / secondsp[0] : 0.);
+  fprintf(stdout, "table:  %10.3f s, %10.2f MB/s\n", secondsp[1], (secondsp[1] > 0.) ? megaBytesd / secondsp[1] : 0.);
+  fprintf(stdout, "scan scalar: %10.3f s, %10.2f MB/s\n", scanSecondsp[0], (scanSecondsp[0] > 0.) ? megaBytesd / scanSecondsp[0] : 0.);
+#if defined(MARPAEBNF_SCAN_AVX2)
+  fprintf(stdout, "scan AVX2:   %10.3f s, %10.2f MB/s\n", scanSecondsp[1], (scanSecondsp[1] > 0.) ? megaBytesd / scanSecondsp[1] : 0.);
+#elif defined(MARPAEBNF_SCAN_SSE2)
+  fprintf(stdout, "scan SSE2:   %10.3f s, %10.2f MB/s\n", scanSecondsp[1], (scanSecondsp[1] > 0.) ? megaBytesd / scanSecondsp[1] : 0.);
+#endif
+  fprintf(stdout, "scan utf8b:  %10.3f s, %10.2f MB/s\n", utf8Secondsp[0], (utf8Secondsp[0] > 0.) ? megaBytesd / utf8Secondsp[0] : 0.);
+  fprintf(stdout, "UTF-8 scalar: %10.3f s, %10.2f MB/s\n", utf8Secondsp[1], (utf8Secondsp[1] > 0.) ? megaBytesd / utf8Secondsp[1] : 0.);
+#if defined(MARPAEBNF_SCAN_AVX2)
+  fprintf(stdout, "UTF-8 AVX2:   %10.3f s, %10.2f MB/s\n", utf8Secondsp[2], (utf8Secondsp[2] > 0.) ? megaBytesd / utf8Secondsp[2] : 0.);
+#elif defined(MARPAEBNF_SCAN_DISPATCH)
+  /* The version the CPU supports */
+  fprintf(stdout, "UTF-8 %-7s %10.3f s, %10.2f MB/s\n", __builtin_cpu_supports("avx2") ? "AVX2:" : (MARPAEBNF_SCAN_CPU_SSSE3 ? "SSSE3:" : "scalar:"), utf8Secondsp[2], (utf8Secondsp[2] > 0.) ? megaBytesd / utf8Secondsp[2] : 0.);
+#elif defined(MARPAEBNF_SCAN_SSSE3)
+  fprintf(stdout, "UTF-8 SSSE3:  %10.3f s, %10.2f MB/s\n", utf8Secondsp[2], (utf8Secondsp[2] > 0.) ? megaBytesd / utf8Secondsp[2] : 0.);
+#endif
+  if (checksuml[0] != checksuml[1]) {
+    fprintf(stderr, "Checksum mismatch: %ld != %ld\n", (long) checksuml[0], (long) checksuml[1]);
+    rci = 1;
+  }
+  if (scanChecksuml[0] != scanChecksuml[1]) {
+    fprintf(stderr, "Scan checksum mismatch: %ld != %ld\n", (long) scanChecksuml[0], (long) scanChecksuml[1]);
+    rci = 1;
+  }
+  /* ASCII runs stop at the same places with utf8b */
+  if (utf8Checksuml[0] != scanChecksuml[1]) {
+    fprintf(stderr, "utf8b scan checksum mismatch: %ld != %ld\n", (long) utf8Checksuml[0], (long) scanChecksuml[1]);
+    rci = 1;
+  }
+  if (utf8Checksuml[1] != utf8Checksuml[2]) {
+    fprintf(stderr, "UTF-8 checksum mismatch: %ld != %ld\n", (long) utf8Checksuml[1], (long) utf8Checksuml[2]);
+    rci = 1;
+  }
+
+  free(utf8s);
+  free(allSymbolip);
+  free(byteClassp);
+  if (inputs != samples) {
+    free(inputs);
+  }
+
+  return rci;
+}
@@ -1,3 +1,11 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 #include "marpaEBNF.h"
 #include "genericLogger.h"
 
@@ -231,32 +239,1256 @@ static char *ebnfs =
 "end group symbol;" "\n"
   ;
 
+#define MARPAEBNFTESTER_CHUNK_SIZE 7
+#define MARPAEBNFTESTER_INSTANCE_SIZE 1024
+
+static char nuls[] = "a = 'b';\0c = 'd';";
+
+/* A grammar compiled by the token-level mode, and inputs against it */
+static char *lists =
+"list = number, {',', number};" "\n"
+"number = ['-'], non zero digit, {digit} | '0';" "\n"
+"non zero digit = digit - '0';" "\n"
+"digit = '0' | '1' | '2' | '3' | '4' | '5' | '6' | '7' | '8' | '9';" "\n"
+  ;
+static char *validListsp[]   = { "0", "-12,3,450", "7,0,-9" };
+static char *invalidListsp[] = { "012", "1,,2", "-0", "", "12," };
+
+/* ISO/IEC 14977 4.14: a definition may be empty */
+static char *empties =
+"number = sign, digit, empty sequence;" "\n"
+"sign = '-' | empty sequence;" "\n"
+"digit = '0' | '1';" "\n"
+"(* see 4.14 *) empty sequence = ;" "\n"
+  ;
+static char *validEmptiesp[]   = { "0", "-1" };
+static char *invalidEmptiesp[] = { "", "-", "01" };
+
+/* ISO/IEC 14977 4.7: exceptions of finite languages, one of them long, and */
+/* one of an infinite factor that is not supported.                        */
+static char *exceptions =
+"code = 3 * ('0' | '1') - ('000' | '111');" "\n"
+"long = 40000 * 'ab' - 'ba';" "\n"
+  ;
+static char *validExceptionsp[]   = { "001", "110", "010" };
+static char *invalidExceptionsp[] = { "000", "111", "01", "0101" };
+static char *infiniteExceptions = "word = {'a'} - 'aa';\n";
+
+/* Allocator hooks that count the blocks they hand out: none must be left */
+/* once the instance is freed.                                             */
+typedef struct marpaEBNFTesterAllocator {
+  size_t blockl;     /* Live blocks */
+  size_t calll;      /* Calls to the malloc and realloc hooks */
+} marpaEBNFTesterAllocator_t;
+
+/* Stress test: contexts on their own threads parse concurrently with one grammar */
+#define MARPAEBNFTESTER_NTHREAD 8
+#define MARPAEBNFTESTER_NPARSE  4
+
+/* Batch: copies of ebnfs, then nuls that must fail */
+#define MARPAEBNFTESTER_NBATCH  32
+static marpaEBNFBatchItem_t batchItemArray[MARPAEBNFTESTER_NBATCH + 1];
+
+/* Parallel parse of a generated grammar, with terminators in strings, comments */
+/* and special sequences that must not be taken as cuts                         */
+#define MARPAEBNFTESTER_NRULE     2000
+#define MARPAEBNFTESTER_BAD_RULE  1500
+#define MARPAEBNFTESTER_NPARALLEL 4
+#define MARPAEBNFTESTER_ERROR_SIZE 1024
+
+/* Edits of the generated grammar with the error, in order, each at the end of */
+/* the first occurrence of its context. The fix of the error and the edit      */
+/* after a failure parse everything again, the others only what they touch.    */
+typedef struct marpaEBNFTesterEdit {
+  char  *contexts;
+  size_t removedl;
+  char  *inserteds;
+  short  okb;
+  short  incrementalb;
+} marpaEBNFTesterEdit_t;
+
+static marpaEBNFTesterEdit_t editArray[] = {
+  { "r1500 = ",                                             2, "",              1, 0 },
+  { "r1000 = '",                                            1, "w",             1, 1 },
+  { "r1000 = 'w;' , r1001 | \"y.\" | ? special; ? ;\n",     0, "extra = 'e';\n", 1, 1 },
+  { "(* rule 1200; (* nested. *) *)\n",                     0, "(*",            0, 0 },
+  { "(* rule 1200; (* nested. *) *)\n",                     2, "",              1, 0 }
+};
+
+/* Every syntax rule in error is reported in one pass, the last one by the end */
+/* of the grammar that is missing its terminator symbol.                      */
+static char *recoverGrammars = "a = 'x' 'y';\nb = @;\nc = 'z';\nd = e\n";
+
+typedef struct marpaEBNFTesterDiagnostic {
+  size_t offsetl;
+  size_t linel;
+  size_t columnl;
+} marpaEBNFTesterDiagnostic_t;
+
+static marpaEBNFTesterDiagnostic_t diagnosticArray[] = {
+  {  8, 1, 9 },
+  { 17, 2, 5 },
+  { 35, 5, 1 }
+};
+
+/* UTF-8 in a comment long enough for the vectorized validator, a terminal */
+/* string and a special sequence; ill-formed sequences that stay refused.   */
+#define MARPAEBNFTESTER_UTF8_RUN "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe6\x96\x87\xe6\xb3\x95"
+static char *utf8Grammars = "(* " MARPAEBNFTESTER_UTF8_RUN MARPAEBNFTESTER_UTF8_RUN MARPAEBNFTESTER_UTF8_RUN MARPAEBNFTESTER_UTF8_RUN " *)\n"
+                            "word = 'caf\xc3\xa9' | ? \xce\xb1 ? ;\n";
+static char *utf8Invalidsp[] = {
+  "a = '\xc0\xaf';",           /* Overlong */
+  "a = '\xed\xa0\x80';",       /* Surrogate */
+  "a = '\xf4\x90\x80\x80';",   /* Above U+10FFFF */
+  "a = '\xe6\x97';",           /* Truncated */
+  "a = \xc3\xa9;"              /* Outside of a terminal string */
+};
+
+/* C source of compiled grammars. The build may generate the one of         */
+/* MARPAEBNFTESTER_GENERATED_GRAMMAR in MARPAEBNFTESTER_GENERATED_SOURCE with  */
+/* marpaEBNFGenerate, and link it in: this is the same grammar without its   */
+/* text, that must give the same source again and accept the same inputs.  */
+#define MARPAEBNFTESTER_GENERATE_FILE "marpaEBNFTesterGenerated.c"
+#ifdef MARPAEBNFTESTER_GENERATED_GRAMMAR
+marpaEBNF_t *marpaEBNFTesterPascal_newp(marpaEBNFOption_t *marpaEBNFOptionp);
+typedef struct marpaEBNFTesterInput {
+  char  *inputs;
+  short  okb;
+} marpaEBNFTesterInput_t;
+
+/* The grammar has no whitespace: programs are written without */
+static marpaEBNFTesterInput_t generatedInputArray[] = {
+  { "programp;beginend.", 1 },
+  { "programp(input,output);vari:integer;begini:=i+1;writeln(i)end.", 1 },
+  { "programp;constn=10;typet=array[1..n]ofinteger;vara:t;beginfori:=1tondoa[i]:=i*2end.", 1 },
+  { "programp;procedureq(x:integer);beginifx>0thenq(x-1)elsewriteln('done')end;beginq(3)end.", 1 },
+  { "programp;begin", 0 },
+  { "programp;beginx:=end.", 0 },
+  { "a", 0 },
+  { "", 0 }
+};
+#endif
+
+typedef struct marpaEBNFTesterThread {
+  marpaEBNFGrammar_t *marpaEBNFGrammarp;
+  unsigned long       checksuml;         /* Of every parse, must be the same */
+  short               okb;
+} marpaEBNFTesterThread_t;
+
+static void         *marpaEBNFTester_mallocp(void *userDatavp, size_t sizel);
+static void         *marpaEBNFTester_reallocp(void *userDatavp, void *p, size_t sizel);
+static void          marpaEBNFTester_freev(void *userDatavp, void *p);
+static unsigned long marpaEBNFTester_checksuml(marpaEBNF_t *marpaEBNFp);
+static short         marpaEBNFTester_parseb(marpaEBNFGrammar_t *marpaEBNFGrammarp, unsigned long *checksumlp);
+static char         *marpaEBNFTester_generates(size_t badRulel, size_t *lengthlp);
+static char         *marpaEBNFTester_reads(char *filenames, size_t *lengthlp);
+static void          marpaEBNFTester_errorLoggerv(void *userDatavp, genericLoggerLevel_t logLeveli, const char *msgs);
+static void          marpaEBNFTester_countLoggerv(void *userDatavp, genericLoggerLevel_t logLeveli, const char *msgs);
+static short         marpaEBNFTester_sameErrorb(char *errors, char *otherErrors);
+#ifdef _WIN32
+static DWORD WINAPI  marpaEBNFTester_threadRun(LPVOID threadp);
+#else
+static void         *marpaEBNFTester_threadRun(void *threadp);
+#endif
+
 int main(int argc, char **argv) {
   int rci = 0;
   genericLogger_t  *genericLoggerp = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_INFO);
-  marpaEBNFOption_t marpaEBNFOption = { genericLoggerp };
-  marpaEBNF_t *marpaEBNFp;
+  marpaEBNFOption_t marpaEBNFOption;
+  marpaEBNF_t *marpaEBNFp = NULL;
+  marpaEBNFStats_t marpaEBNFStats;
+  marpaEBNFMemory_t marpaEBNFMemory;
+  marpaEBNFAst_t *marpaEBNFAstp;
+  size_t firstChildl;
+  size_t childl;
+  size_t nodel;
+  size_t textl;
+  short scannerlessb;
+  char *chunks;
+  char *maxChunks;
+  size_t chunkl;
+  size_t i;
+  marpaEBNFGrammar_t *marpaEBNFGrammarp = NULL;
+  marpaEBNFTesterThread_t threadArray[MARPAEBNFTESTER_NTHREAD];
+  unsigned long checksuml;
+  int threadi;
+  marpaEBNFBatchStats_t marpaEBNFBatchStats;
+  size_t threadl;
+  char *generateds = NULL;
+  size_t generatedl;
+  unsigned long parallelChecksuml;
+  genericLogger_t *errorLoggerp = NULL;
+  genericLogger_t *countLoggerp = NULL;
+  size_t messagel;
+  char errors[MARPAEBNFTESTER_ERROR_SIZE];
+  char sequentialErrors[MARPAEBNFTESTER_ERROR_SIZE];
+  marpaEBNFEvent_t eventArray[16];
+  size_t eventl;
+  size_t drainedl;
+  char events[256];
+  marpaEBNFCacheOption_t marpaEBNFCacheOption;
+  marpaEBNFCacheStats_t marpaEBNFCacheStats;
+  marpaEBNFCache_t *marpaEBNFCachep = NULL;
+  unsigned long cachedChecksuml;
+  char *contexts;
+  size_t offsetl;
+  size_t insertedl;
+  marpaEBNF_t *otherp;
+  short editb;
+  marpaEBNFDiagnostic_t *marpaEBNFDiagnosticp;
+  size_t diagnosticl;
+  size_t expectedl;
+  marpaEBNFGenerated_t marpaEBNFGenerated;
+  char *sources = NULL;
+  size_t sourcel;
+  marpaEBNFTesterAllocator_t marpaEBNFTesterAllocator;
+#ifdef MARPAEBNFTESTER_GENERATED_GRAMMAR
+  char *otherSources = NULL;
+  size_t otherSourcel;
+#endif
+#ifdef _WIN32
+  HANDLE threadHandleArray[MARPAEBNFTESTER_NTHREAD];
+#else
+  pthread_t threadIdArray[MARPAEBNFTESTER_NTHREAD];
+#endif
+
+  /* Use EBNF to parse itself, with the token-level and the character-level internal grammars */
+  for (scannerlessb = 0; scannerlessb <= 1; scannerlessb++) {
+    marpaEBNFOption.genericLoggerp      = genericLoggerp;
+    marpaEBNFOption.scannerlessb        = scannerlessb;
+    marpaEBNFOption.mallocp             = NULL;
+    marpaEBNFOption.reallocp            = NULL;
+    marpaEBNFOption.freep               = NULL;
+    marpaEBNFOption.allocatorUserDatavp = NULL;
+    marpaEBNFOption.cachep              = NULL;
+    marpaEBNFOption.recoverb            = 0;
+    marpaEBNFOption.utf8b               = 0;
+
+    marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+    if (marpaEBNFp == NULL) {
+      rci = 1;
+      goto end;
+    }
+    /* The internal grammar is shared: a new instance is small */
+    if (marpaEBNF_memoryb(marpaEBNFp, &marpaEBNFMemory) == 0) {
+      rci = 1;
+      goto end;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "New instance: %ld bytes", (long) marpaEBNFMemory.liveBytel);
+    if (marpaEBNFMemory.liveBytel > MARPAEBNFTESTER_INSTANCE_SIZE) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "New instance is above %d bytes", MARPAEBNFTESTER_INSTANCE_SIZE);
+      rci = 1;
+      goto end;
+    }
+
+    GENERICLOGGER_INFOF(genericLoggerp, "Parsing EBNF grammar using EBNF itself, %s mode", scannerlessb ? "scannerless" : "token");
+    GENERICLOGGER_INFOF(genericLoggerp, "%s", ebnfs);
+    if (marpaEBNF_grammarb(marpaEBNFp, ebnfs) == 0) {
+      rci = 1;
+      goto end;
+    }
+    /* Same grammar, length-explicit */
+    if (marpaEBNF_grammarBufferb(marpaEBNFp, ebnfs, strlen(ebnfs)) == 0) {
+      rci = 1;
+      goto end;
+    }
+    /* An embedded NUL byte is an error, not the end of the grammar */
+    GENERICLOGGER_INFO(genericLoggerp, "Parsing a grammar with an embedded NUL byte: an error is expected");
+    if (marpaEBNF_grammarBufferb(marpaEBNFp, nuls, sizeof(nuls) - 1) != 0) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Embedded NUL byte is not reported");
+      rci = 1;
+      goto end;
+    }
+
+    /* Same grammar, streamed in chunks small enough to split lexemes and two-characters symbols */
+    GENERICLOGGER_INFOF(genericLoggerp, "Parsing EBNF grammar using EBNF itself, %s mode, by chunks of %d bytes", scannerlessb ? "scannerless" : "token", MARPAEBNFTESTER_CHUNK_SIZE);
+    if (marpaEBNF_beginb(marpaEBNFp) == 0) {
+      rci = 1;
+      goto end;
+    }
+    for (chunks = ebnfs, maxChunks = ebnfs + strlen(ebnfs); chunks < maxChunks; chunks += chunkl) {
+      chunkl = ((maxChunks - chunks) < MARPAEBNFTESTER_CHUNK_SIZE) ? (size_t) (maxChunks - chunks) : MARPAEBNFTESTER_CHUNK_SIZE;
+      if (marpaEBNF_feedb(marpaEBNFp, chunks, chunkl) == 0) {
+        rci = 1;
+        goto end;
+      }
+    }
+    if (marpaEBNF_endb(marpaEBNFp) == 0) {
+      rci = 1;
+      goto end;
+    }
+    /* Only the token-level grammar produces an AST: a syntax of syntax rules, each starting with its meta identifier */
+    marpaEBNFAstp = marpaEBNF_astp(marpaEBNFp);
+    if (! scannerlessb) {
+      if ((marpaEBNFAstp == NULL) || (marpaEBNFAst_kindi(marpaEBNFAstp, 0) != MARPAEBNF_AST_SYNTAX) || (marpaEBNFAst_childrenb(marpaEBNFAstp, 0, &firstChildl, &childl) == 0)) {
+        GENERICLOGGER_ERROR(genericLoggerp, "No AST");
+        rci = 1;
+        goto end;
+      }
+      for (nodel = firstChildl; nodel < firstChildl + childl; nodel++) {
+        size_t ruleFirstChildl;
+        size_t ruleChildl;
+
+        if ((marpaEBNFAst_kindi(marpaEBNFAstp, nodel) != MARPAEBNF_AST_SYNTAX_RULE)
+            || (marpaEBNFAst_childrenb(marpaEBNFAstp, nodel, &ruleFirstChildl, &ruleChildl) == 0)
+            || (ruleChildl != 2)
+            || (marpaEBNFAst_kindi(marpaEBNFAstp, ruleFirstChildl) != MARPAEBNF_AST_META_IDENTIFIER)
+            || (marpaEBNFAst_kindi(marpaEBNFAstp, ruleFirstChildl + 1) != MARPAEBNF_AST_DEFINITIONS_LIST)) {
+          GENERICLOGGER_ERRORF(genericLoggerp, "AST node %ld is not a syntax rule", (long) nodel);
+          rci = 1;
+          goto end;
+        }
+      }
+      GENERICLOGGER_INFOF(genericLoggerp, "AST: %ld nodes, %ld syntax rules, first rule defines \"%s\"", (long) marpaEBNFAst_nodel(marpaEBNFAstp), (long) childl, marpaEBNFAst_texts(marpaEBNFAstp, firstChildl + childl, &textl));
+    } else if (marpaEBNFAstp != NULL) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Unexpected AST in scannerless mode");
+      rci = 1;
+      goto end;
+    }
+
+    if (marpaEBNF_statsb(marpaEBNFp, &marpaEBNFStats) == 0) {
+      rci = 1;
+      goto end;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Expected terminals cache: %ld hits, %ld misses", (long) marpaEBNFStats.expectedCacheHitl, (long) marpaEBNFStats.expectedCacheMissl);
+    GENERICLOGGER_INFOF(genericLoggerp, "Earley sets: %ld", (long) marpaEBNFStats.earleySetl);
+    GENERICLOGGER_INFOF(genericLoggerp, "Characters: %ld scanned, %ld discarded", (long) marpaEBNFStats.characterScannedl, (long) marpaEBNFStats.characterDiscardedl);
+    GENERICLOGGER_INFOF(genericLoggerp, "Tokens: %ld, %ld alternatives, %ld ambiguous positions", (long) marpaEBNFStats.tokenl, (long) marpaEBNFStats.alternativel, (long) marpaEBNFStats.ambiguousPositionl);
+    GENERICLOGGER_INFOF(genericLoggerp, "ASF nodes visited: %ld, symbols rejected: %ld", (long) marpaEBNFStats.asfNodeVisitedl, (long) marpaEBNFStats.symbolRejectedl);
+    if ((marpaEBNFStats.characterScannedl != strlen(ebnfs))
+        || (marpaEBNFStats.characterDiscardedl >= marpaEBNFStats.characterScannedl)
+        || (marpaEBNFStats.tokenl != marpaEBNFStats.earleySetl)
+        || (marpaEBNFStats.alternativel < marpaEBNFStats.tokenl)) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Inconsistent parse statistics");
+      rci = 1;
+      goto end;
+    }
+    /* One event per rejected symbol, and per alternative at an ambiguous position */
+    drainedl = 0;
+    while ((eventl = marpaEBNF_eventsl(marpaEBNFp, eventArray, sizeof(eventArray) / sizeof(eventArray[0]))) > 0) {
+      for (i = 0; i < eventl; i++) {
+        if ((drainedl + i) < 4) {
+          GENERICLOGGER_INFOF(genericLoggerp, "Event: %s", marpaEBNF_eventFormats(marpaEBNFp, &(eventArray[i]), events, sizeof(events)));
+        }
+      }
+      drainedl += eventl;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Events: %ld drained, %ld lost", (long) drainedl, (long) marpaEBNFStats.eventLostl);
+    if (drainedl + marpaEBNFStats.eventLostl != marpaEBNFStats.symbolRejectedl + (marpaEBNFStats.alternativel - marpaEBNFStats.tokenl) + marpaEBNFStats.ambiguousPositionl) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Events do not match the parse statistics");
+      rci = 1;
+      goto end;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Valuation: %ld single trees, %ld ASFs", (long) marpaEBNFStats.singleTreel, (long) marpaEBNFStats.asfl);
+    /* EBNF is not ambiguous at the token level; only the character level needs the ASF */
+    if ((scannerlessb ? marpaEBNFStats.asfl : marpaEBNFStats.singleTreel) <= 0) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Unexpected valuation path in %s mode", scannerlessb ? "scannerless" : "token");
+      rci = 1;
+      goto end;
+    }
+    if (marpaEBNF_memoryb(marpaEBNFp, &marpaEBNFMemory) == 0) {
+      rci = 1;
+      goto end;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Memory: %ld live bytes, %ld peak bytes, %ld total bytes in %ld allocations", (long) marpaEBNFMemory.liveBytel, (long) marpaEBNFMemory.peakBytel, (long) marpaEBNFMemory.totalBytel, (long) marpaEBNFMemory.allocationl);
+
+    /* Inputs are parsed against the grammar compiled by the token-level mode only */
+    GENERICLOGGER_INFOF(genericLoggerp, "Parsing inputs against a compiled grammar, %s mode", scannerlessb ? "scannerless" : "token");
+    if (marpaEBNF_grammarb(marpaEBNFp, lists) == 0) {
+      rci = 1;
+      goto end;
+    }
+    if (! scannerlessb) {
+      for (i = 0; i < sizeof(validListsp) / sizeof(validListsp[0]); i++) {
+        if (marpaEBNF_parseb(marpaEBNFp, validListsp[i], strlen(validListsp[i])) == 0) {
+          GENERICLOGGER_ERRORF(genericLoggerp, "Input \"%s\" is rejected", validListsp[i]);
+          rci = 1;
+          goto end;
+        }
+      }
+      GENERICLOGGER_INFO(genericLoggerp, "Parsing invalid inputs: errors are expected");
+      for (i = 0; i < sizeof(invalidListsp) / sizeof(invalidListsp[0]); i++) {
+        if (marpaEBNF_parseb(marpaEBNFp, invalidListsp[i], strlen(invalidListsp[i])) != 0) {
+          GENERICLOGGER_ERRORF(genericLoggerp, "Input \"%s\" is accepted", invalidListsp[i]);
+          rci = 1;
+          goto end;
+        }
+      }
+      if (marpaEBNF_grammarb(marpaEBNFp, empties) == 0) {
+        rci = 1;
+        goto end;
+      }
+      for (i = 0; i < sizeof(validEmptiesp) / sizeof(validEmptiesp[0]); i++) {
+        if (marpaEBNF_parseb(marpaEBNFp, validEmptiesp[i], strlen(validEmptiesp[i])) == 0) {
+          GENERICLOGGER_ERRORF(genericLoggerp, "Input \"%s\" is rejected", validEmptiesp[i]);
+          rci = 1;
+          goto end;
+        }
+      }
+      for (i = 0; i < sizeof(invalidEmptiesp) / sizeof(invalidEmptiesp[0]); i++) {
+        if (marpaEBNF_parseb(marpaEBNFp, invalidEmptiesp[i], strlen(invalidEmptiesp[i])) != 0) {
+          GENERICLOGGER_ERRORF(genericLoggerp, "Input \"%s\" is accepted", invalidEmptiesp[i]);
+          rci = 1;
+          goto end;
+        }
+      }
+      if (marpaEBNF_grammarb(marpaEBNFp, exceptions) == 0) {
+        rci = 1;
+        goto end;
+      }
+      for (i = 0; i < sizeof(validExceptionsp) / sizeof(validExceptionsp[0]); i++) {
+        if (marpaEBNF_parseb(marpaEBNFp, validExceptionsp[i], strlen(validExceptionsp[i])) == 0) {
+          GENERICLOGGER_ERRORF(genericLoggerp, "Input \"%s\" is rejected", validExceptionsp[i]);
+          rci = 1;
+          goto end;
+        }
+      }
+      for (i = 0; i < sizeof(invalidExceptionsp) / sizeof(invalidExceptionsp[0]); i++) {
+        if (marpaEBNF_parseb(marpaEBNFp, invalidExceptionsp[i], strlen(invalidExceptionsp[i])) != 0) {
+          GENERICLOGGER_ERRORF(genericLoggerp, "Input \"%s\" is accepted", invalidExceptionsp[i]);
+          rci = 1;
+          goto end;
+        }
+      }
+      GENERICLOGGER_INFO(genericLoggerp, "Exception of an infinite factor: an error is expected");
+      if (marpaEBNF_grammarb(marpaEBNFp, infiniteExceptions) != 0) {
+        GENERICLOGGER_ERROR(genericLoggerp, "An exception of an infinite factor is compiled");
+        rci = 1;
+        goto end;
+      }
+    } else if (marpaEBNF_parseb(marpaEBNFp, validListsp[0], strlen(validListsp[0])) != 0) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Input is accepted without a compiled grammar");
+      rci = 1;
+      goto end;
+    }
+
+    marpaEBNF_freev(marpaEBNFp);
+    marpaEBNFp = NULL;
+  }
+
+  /* Everything goes through the allocator hooks, and is given back */
+  for (scannerlessb = 0; scannerlessb <= 1; scannerlessb++) {
+    marpaEBNFTesterAllocator.blockl     = 0;
+    marpaEBNFTesterAllocator.calll      = 0;
+    marpaEBNFOption.scannerlessb        = scannerlessb;
+    marpaEBNFOption.mallocp             = marpaEBNFTester_mallocp;
+    marpaEBNFOption.reallocp            = marpaEBNFTester_reallocp;
+    marpaEBNFOption.freep               = marpaEBNFTester_freev;
+    marpaEBNFOption.allocatorUserDatavp = &marpaEBNFTesterAllocator;
+    marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+    marpaEBNFOption.mallocp             = NULL;
+    marpaEBNFOption.reallocp            = NULL;
+    marpaEBNFOption.freep               = NULL;
+    marpaEBNFOption.allocatorUserDatavp = NULL;
+    if (marpaEBNFp == NULL) {
+      rci = 1;
+      goto end;
+    }
+    if ((marpaEBNF_grammarb(marpaEBNFp, ebnfs) == 0) || (marpaEBNF_grammarb(marpaEBNFp, lists) == 0)) {
+      rci = 1;
+      goto end;
+    }
+    if ((! scannerlessb) && (marpaEBNF_parseb(marpaEBNFp, validListsp[1], strlen(validListsp[1])) == 0)) {
+      rci = 1;
+      goto end;
+    }
+    if (marpaEBNF_memoryb(marpaEBNFp, &marpaEBNFMemory) == 0) {
+      rci = 1;
+      goto end;
+    }
+    marpaEBNF_freev(marpaEBNFp);
+    marpaEBNFp = NULL;
+    /* The private grammar of the instance is accounted for apart */
+    GENERICLOGGER_INFOF(genericLoggerp, "Allocator hooks, %s mode: %ld calls, %ld of them by the instance, %ld blocks left", scannerlessb ? "scannerless" : "token", (long) marpaEBNFTesterAllocator.calll, (long) marpaEBNFMemory.allocationl, (long) marpaEBNFTesterAllocator.blockl);
+    if ((marpaEBNFMemory.allocationl <= 0) || (marpaEBNFTesterAllocator.calll < marpaEBNFMemory.allocationl) || (marpaEBNFTesterAllocator.blockl != 0)) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Allocator hooks are not used for every allocation, or not given back everything");
+      rci = 1;
+      goto end;
+    }
+  }
+
+  /* One grammar per mode, parsed with concurrently by contexts on their own threads */
+  for (scannerlessb = 0; scannerlessb <= 1; scannerlessb++) {
+    marpaEBNFOption.scannerlessb = scannerlessb;
+    marpaEBNFGrammarp = marpaEBNFGrammar_newp(&marpaEBNFOption);
+    if (marpaEBNFGrammarp == NULL) {
+      rci = 1;
+      goto end;
+    }
+    /* Reference result, single-threaded */
+    if (marpaEBNFTester_parseb(marpaEBNFGrammarp, &checksuml) == 0) {
+      rci = 1;
+      goto end;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Parsing EBNF grammar using EBNF itself, %s mode, %d threads x %d parses on the same grammar", scannerlessb ? "scannerless" : "token", MARPAEBNFTESTER_NTHREAD, MARPAEBNFTESTER_NPARSE);
+    for (threadi = 0; threadi < MARPAEBNFTESTER_NTHREAD; threadi++) {
+      threadArray[threadi].marpaEBNFGrammarp = marpaEBNFGrammarp;
+      threadArray[threadi].checksuml         = 0;
+      threadArray[threadi].okb               = 0;
+#ifdef _WIN32
+      threadHandleArray[threadi] = CreateThread(NULL, 0, marpaEBNFTester_threadRun, &(threadArray[threadi]), 0, NULL);
+      if (threadHandleArray[threadi] == NULL) {
+#else
+      if (pthread_create(&(threadIdArray[threadi]), NULL, marpaEBNFTester_threadRun, &(threadArray[threadi])) != 0) {
+#endif
+        GENERICLOGGER_ERROR(genericLoggerp, "Thread creation failure");
+        rci = 1;
+        break;
+      }
+    }
+    while (threadi-- > 0) {
+#ifdef _WIN32
+      WaitForSingleObject(threadHandleArray[threadi], INFINITE);
+      CloseHandle(threadHandleArray[threadi]);
+#else
+      pthread_join(threadIdArray[threadi], NULL);
+#endif
+      if ((! threadArray[threadi].okb) || (threadArray[threadi].checksuml != checksuml)) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Thread %d: checksum 0x%lx instead of 0x%lx", threadi, threadArray[threadi].checksuml, checksuml);
+        rci = 1;
+      }
+    }
+    marpaEBNFGrammar_freev(marpaEBNFGrammarp);
+    marpaEBNFGrammarp = NULL;
+    if (rci != 0) {
+      goto end;
+    }
+  }
+
+  /* Batch on one worker, then on one worker per processor */
+  marpaEBNFOption.scannerlessb = 0;
+  marpaEBNFGrammarp = marpaEBNFGrammar_newp(&marpaEBNFOption);
+  if (marpaEBNFGrammarp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  for (i = 0; i < MARPAEBNFTESTER_NBATCH; i++) {
+    batchItemArray[i].grammars = ebnfs;
+    batchItemArray[i].grammarl = strlen(ebnfs);
+  }
+  batchItemArray[MARPAEBNFTESTER_NBATCH].grammars = nuls;
+  batchItemArray[MARPAEBNFTESTER_NBATCH].grammarl = sizeof(nuls) - 1;
+  for (threadl = 1; ; threadl = 0) {
+    if (marpaEBNFGrammar_batchb(marpaEBNFGrammarp, batchItemArray, MARPAEBNFTESTER_NBATCH + 1, threadl, &marpaEBNFBatchStats) == 0) {
+      rci = 1;
+      goto end;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Batch of %ld items on %ld workers: %ld ok, %ld stolen, %.3f s, %.2f MB/s, %.1f items/s",
+                        (long) marpaEBNFBatchStats.iteml,
+                        (long) marpaEBNFBatchStats.threadl,
+                        (long) marpaEBNFBatchStats.okl,
+                        (long) marpaEBNFBatchStats.stolenl,
+                        marpaEBNFBatchStats.secondsd,
+                        (marpaEBNFBatchStats.secondsd > 0) ? (double) marpaEBNFBatchStats.bytel / marpaEBNFBatchStats.secondsd / 1e6 : 0.,
+                        (marpaEBNFBatchStats.secondsd > 0) ? (double) marpaEBNFBatchStats.iteml / marpaEBNFBatchStats.secondsd : 0.);
+    if (marpaEBNFBatchStats.okl != MARPAEBNFTESTER_NBATCH) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Batch: %ld items ok instead of %d", (long) marpaEBNFBatchStats.okl, MARPAEBNFTESTER_NBATCH);
+      rci = 1;
+      goto end;
+    }
+    if (batchItemArray[MARPAEBNFTESTER_NBATCH].okb || (batchItemArray[MARPAEBNFTESTER_NBATCH].diagnostics[0] == '\0')) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Batch: NUL byte item must fail with diagnostics");
+      rci = 1;
+      goto end;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Batch: NUL byte item diagnostics:\n%s", batchItemArray[MARPAEBNFTESTER_NBATCH].diagnostics);
+    if (threadl == 0) {
+      break;
+    }
+  }
+  marpaEBNFGrammar_freev(marpaEBNFGrammarp);
+  marpaEBNFGrammarp = NULL;
+
+  /* A large grammar parsed in pieces gives the same AST as in one go */
+  generateds = marpaEBNFTester_generates(MARPAEBNFTESTER_NRULE, &generatedl);
+  if (generateds == NULL) {
+    rci = 1;
+    goto end;
+  }
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  if ((marpaEBNF_grammarBufferb(marpaEBNFp, generateds, generatedl) == 0) || (marpaEBNF_parseb(marpaEBNFp, "y.", 2) == 0)) {
+    rci = 1;
+    goto end;
+  }
+  checksuml = marpaEBNFTester_checksuml(marpaEBNFp);
+  if ((marpaEBNF_grammarParallelb(marpaEBNFp, generateds, generatedl, MARPAEBNFTESTER_NPARALLEL) == 0) || (marpaEBNF_parseb(marpaEBNFp, "y.", 2) == 0)) {
+    rci = 1;
+    goto end;
+  }
+  parallelChecksuml = marpaEBNFTester_checksuml(marpaEBNFp);
+  GENERICLOGGER_INFOF(genericLoggerp, "Generated grammar of %ld bytes: checksum 0x%lx in one go, 0x%lx in pieces on %d threads", (long) generatedl, checksuml, parallelChecksuml, MARPAEBNFTESTER_NPARALLEL);
+  if (parallelChecksuml != checksuml) {
+    rci = 1;
+    goto end;
+  }
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFp = NULL;
+  free(generateds);
+
+  /* An error is reported at the same position */
+  generateds = marpaEBNFTester_generates(MARPAEBNFTESTER_BAD_RULE, &generatedl);
+  if (generateds == NULL) {
+    rci = 1;
+    goto end;
+  }
+  errorLoggerp = GENERICLOGGER_CUSTOM(marpaEBNFTester_errorLoggerv, errors, GENERICLOGGER_LOGLEVEL_ERROR);
+  marpaEBNFOption.genericLoggerp = errorLoggerp;
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  marpaEBNFOption.genericLoggerp = genericLoggerp;
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  errors[0] = '\0';
+  if (marpaEBNF_grammarBufferb(marpaEBNFp, generateds, generatedl) != 0) {
+    rci = 1;
+    goto end;
+  }
+  strcpy(sequentialErrors, errors);
+  errors[0] = '\0';
+  if (marpaEBNF_grammarParallelb(marpaEBNFp, generateds, generatedl, MARPAEBNFTESTER_NPARALLEL) != 0) {
+    rci = 1;
+    goto end;
+  }
+  GENERICLOGGER_INFOF(genericLoggerp, "Error in one go: %s", sequentialErrors);
+  GENERICLOGGER_INFOF(genericLoggerp, "Error in pieces: %s", errors);
+  if (! marpaEBNFTester_sameErrorb(errors, sequentialErrors)) {
+    GENERICLOGGER_ERROR(genericLoggerp, "Errors are not at the same position");
+    rci = 1;
+    goto end;
+  }
+
+  /* An edited grammar gives the same AST as the result of the edit parsed in one go */
+  for (i = 0; i < sizeof(editArray) / sizeof(editArray[0]); i++) {
+    contexts = strstr(generateds, editArray[i].contexts);
+    if (contexts == NULL) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Edit %ld: no context", (long) i);
+      rci = 1;
+      goto end;
+    }
+    offsetl   = (contexts - generateds) + strlen(editArray[i].contexts);
+    insertedl = strlen(editArray[i].inserteds);
+    memmove(generateds + offsetl + insertedl, generateds + offsetl + editArray[i].removedl, generatedl - offsetl - editArray[i].removedl + 1);
+    memcpy(generateds + offsetl, editArray[i].inserteds, insertedl);
+    generatedl = generatedl - editArray[i].removedl + insertedl;
+    editb = marpaEBNF_editb(marpaEBNFp, offsetl, editArray[i].removedl, editArray[i].inserteds, insertedl);
+    if ((editb != editArray[i].okb) || (marpaEBNF_statsb(marpaEBNFp, &marpaEBNFStats) == 0)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Edit %ld: %s instead of %s", (long) i, editb ? "success" : "failure", editArray[i].okb ? "success" : "failure");
+      rci = 1;
+      goto end;
+    }
+    if (! editb) {
+      continue;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Edit %ld: %ld of %ld bytes parsed again", (long) i, (long) marpaEBNFStats.characterScannedl, (long) generatedl);
+    if ((marpaEBNFStats.characterScannedl < generatedl / 100) != editArray[i].incrementalb) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Edit %ld: the grammar was %s parsed again", (long) i, editArray[i].incrementalb ? "entirely" : "not");
+      rci = 1;
+      goto end;
+    }
+    otherp = marpaEBNF_newp(&marpaEBNFOption);
+    if (otherp == NULL) {
+      rci = 1;
+      goto end;
+    }
+    if (marpaEBNF_grammarBufferb(otherp, generateds, generatedl) == 0) {
+      marpaEBNF_freev(otherp);
+      rci = 1;
+      goto end;
+    }
+    checksuml = marpaEBNFTester_checksuml(otherp);
+    marpaEBNF_freev(otherp);
+    if (marpaEBNFTester_checksuml(marpaEBNFp) != checksuml) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Edit %ld: checksum 0x%lx instead of 0x%lx", (long) i, marpaEBNFTester_checksuml(marpaEBNFp), checksuml);
+      rci = 1;
+      goto end;
+    }
+    if (marpaEBNF_parseb(marpaEBNFp, "y.", 2) == 0) {
+      rci = 1;
+      goto end;
+    }
+  }
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFp = NULL;
+
+  /* A compile error of an edit is logged once, by the parse of the whole   */
+  /* grammar, and a warning of an edit parsed alone is logged as well.      */
+  countLoggerp = GENERICLOGGER_CUSTOM(marpaEBNFTester_countLoggerv, &messagel, GENERICLOGGER_LOGLEVEL_WARNING);
+  marpaEBNFOption.genericLoggerp = countLoggerp;
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  marpaEBNFOption.genericLoggerp = genericLoggerp;
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  if (marpaEBNF_grammarb(marpaEBNFp, "a = 'x';\nb = 'y';\n") == 0) {
+    rci = 1;
+    goto end;
+  }
+  messagel = 0;
+  if ((marpaEBNF_editb(marpaEBNFp, 9, 0, "c = 70000 * 'x';\n", 17) != 0) || (messagel != 1)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "Failed edit: %ld messages instead of 1", (long) messagel);
+    rci = 1;
+    goto end;
+  }
+  if (marpaEBNF_editb(marpaEBNFp, 9, 17, "", 0) == 0) {
+    rci = 1;
+    goto end;
+  }
+  messagel = 0;
+  if ((marpaEBNF_editb(marpaEBNFp, 9, 0, "c = d;\n", 7) == 0) || (marpaEBNF_statsb(marpaEBNFp, &marpaEBNFStats) == 0) || (messagel != 1)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "Edit with a warning: %ld messages instead of 1", (long) messagel);
+    rci = 1;
+    goto end;
+  }
+  GENERICLOGGER_INFOF(genericLoggerp, "Edit with a warning: %ld of 25 bytes parsed again", (long) marpaEBNFStats.characterScannedl);
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFp = NULL;
+
+  /* Syntax errors are all reported, with what was expected at each of them */
+  marpaEBNFOption.genericLoggerp = errorLoggerp;
+  marpaEBNFOption.recoverb       = 1;
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  marpaEBNFOption.genericLoggerp = genericLoggerp;
+  marpaEBNFOption.recoverb       = 0;
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  if (marpaEBNF_grammarBufferb(marpaEBNFp, recoverGrammars, strlen(recoverGrammars)) != 0) {
+    rci = 1;
+    goto end;
+  }
+  diagnosticl = marpaEBNF_diagnosticsl(marpaEBNFp, &marpaEBNFDiagnosticp);
+  for (i = 0; i < diagnosticl; i++) {
+    GENERICLOGGER_INFOF(genericLoggerp, "Diagnostic %ld: offset %ld, line %ld, column %ld, %ld expected", (long) i, (long) marpaEBNFDiagnosticp[i].offsetl, (long) marpaEBNFDiagnosticp[i].linel, (long) marpaEBNFDiagnosticp[i].columnl, (long) marpaEBNFDiagnosticp[i].expectedl);
+  }
+  if (diagnosticl != sizeof(diagnosticArray) / sizeof(diagnosticArray[0])) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%ld diagnostics instead of %ld", (long) diagnosticl, (long) (sizeof(diagnosticArray) / sizeof(diagnosticArray[0])));
+    rci = 1;
+    goto end;
+  }
+  for (i = 0; i < diagnosticl; i++) {
+    if ((marpaEBNFDiagnosticp[i].offsetl != diagnosticArray[i].offsetl) ||
+        (marpaEBNFDiagnosticp[i].linel   != diagnosticArray[i].linel) ||
+        (marpaEBNFDiagnosticp[i].columnl != diagnosticArray[i].columnl)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Diagnostic %ld is not at offset %ld, line %ld, column %ld", (long) i, (long) diagnosticArray[i].offsetl, (long) diagnosticArray[i].linel, (long) diagnosticArray[i].columnl);
+      rci = 1;
+      goto end;
+    }
+  }
+  for (expectedl = 0; expectedl < marpaEBNFDiagnosticp[0].expectedl; expectedl++) {
+    if (strcmp(marpaEBNFDiagnosticp[0].expectedsp[expectedl], "<concatenate symbol>") == 0) {
+      break;
+    }
+  }
+  if (expectedl >= marpaEBNFDiagnosticp[0].expectedl) {
+    GENERICLOGGER_ERROR(genericLoggerp, "A concatenate symbol was not expected");
+    rci = 1;
+    goto end;
+  }
+  /* Diagnostics belong to the last parse */
+  if ((marpaEBNF_grammarBufferb(marpaEBNFp, "a = 'x', 'y';\n", 14) == 0) || (marpaEBNF_diagnosticsl(marpaEBNFp, &marpaEBNFDiagnosticp) != 0)) {
+    GENERICLOGGER_ERROR(genericLoggerp, "A valid grammar has diagnostics");
+    rci = 1;
+    goto end;
+  }
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFp = NULL;
+
+  /* UTF-8 is refused by default. With utf8b it is accepted in one go and byte */
+  /* per byte, and a column is a character.                                   */
+  marpaEBNFOption.genericLoggerp = errorLoggerp;
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  marpaEBNFOption.genericLoggerp = genericLoggerp;
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  if (marpaEBNF_grammarb(marpaEBNFp, utf8Grammars) != 0) {
+    GENERICLOGGER_ERROR(genericLoggerp, "UTF-8 is accepted without the utf8b option");
+    rci = 1;
+    goto end;
+  }
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFOption.genericLoggerp = errorLoggerp;
+  marpaEBNFOption.utf8b          = 1;
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  for (i = 0; i < sizeof(utf8Invalidsp) / sizeof(utf8Invalidsp[0]); i++) {
+    if (marpaEBNF_grammarb(marpaEBNFp, utf8Invalidsp[i]) != 0) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Ill-formed UTF-8 %ld is accepted", (long) i);
+      rci = 1;
+      goto end;
+    }
+  }
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFOption.recoverb = 1;
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  marpaEBNFOption.genericLoggerp = genericLoggerp;
+  marpaEBNFOption.recoverb       = 0;
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  if ((marpaEBNF_grammarb(marpaEBNFp, "a = 'caf\xc3\xa9' 'x';") != 0) ||
+      (marpaEBNF_diagnosticsl(marpaEBNFp, &marpaEBNFDiagnosticp) != 1) ||
+      (marpaEBNFDiagnosticp[0].offsetl != 12) ||
+      (marpaEBNFDiagnosticp[0].columnl != 12)) {
+    GENERICLOGGER_ERROR(genericLoggerp, "The UTF-8 error is not at offset 12, column 12");
+    rci = 1;
+    goto end;
+  }
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  marpaEBNFOption.utf8b = 0;
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  if ((marpaEBNF_grammarb(marpaEBNFp, utf8Grammars) == 0) || (marpaEBNF_parseb(marpaEBNFp, "caf\xc3\xa9", 5) == 0)) {
+    rci = 1;
+    goto end;
+  }
+  checksuml = marpaEBNFTester_checksuml(marpaEBNFp);
+  if (marpaEBNF_beginb(marpaEBNFp) == 0) {
+    rci = 1;
+    goto end;
+  }
+  for (chunks = utf8Grammars, maxChunks = utf8Grammars + strlen(utf8Grammars); chunks < maxChunks; chunks++) {
+    if (marpaEBNF_feedb(marpaEBNFp, chunks, 1) == 0) {
+      rci = 1;
+      goto end;
+    }
+  }
+  if (marpaEBNF_endb(marpaEBNFp) == 0) {
+    rci = 1;
+    goto end;
+  }
+  if (marpaEBNFTester_checksuml(marpaEBNFp) != checksuml) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "UTF-8 byte per byte: checksum 0x%lx instead of 0x%lx", marpaEBNFTester_checksuml(marpaEBNFp), checksuml);
+    rci = 1;
+    goto end;
+  }
+  GENERICLOGGER_INFOF(genericLoggerp, "UTF-8 grammar: checksum 0x%lx in one go and byte per byte", checksuml);
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFp = NULL;
 
+  /* A cached grammar gives the same AST without being parsed: from memory, then */
+  /* from the directory with a new cache, as after a restart. The second grammar */
+  /* evicts the first from memory.                                               */
+  for (i = 0; i < 2; i++) {
+    marpaEBNFCacheOption.genericLoggerp = genericLoggerp;
+    marpaEBNFCacheOption.maxEntryl      = 1;
+    marpaEBNFCacheOption.maxBytel       = 0;
+    marpaEBNFCacheOption.directorys     = ".";
+    marpaEBNFCachep = marpaEBNFCache_newp(&marpaEBNFCacheOption);
+    if (marpaEBNFCachep == NULL) {
+      rci = 1;
+      goto end;
+    }
+    /* Files of an interrupted run would be disk hits */
+    if ((i == 0) && ((marpaEBNFCache_removeb(marpaEBNFCachep, ebnfs, strlen(ebnfs)) == 0) || (marpaEBNFCache_removeb(marpaEBNFCachep, lists, strlen(lists)) == 0))) {
+      rci = 1;
+      goto end;
+    }
+    marpaEBNFOption.cachep = marpaEBNFCachep;
+    marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+    marpaEBNFOption.cachep = NULL;
+    if (marpaEBNFp == NULL) {
+      rci = 1;
+      goto end;
+    }
+    if (marpaEBNF_grammarb(marpaEBNFp, ebnfs) == 0) {
+      rci = 1;
+      goto end;
+    }
+    checksuml = marpaEBNFTester_checksuml(marpaEBNFp);
+    if ((marpaEBNF_grammarb(marpaEBNFp, ebnfs) == 0) || (marpaEBNF_statsb(marpaEBNFp, &marpaEBNFStats) == 0)) {
+      rci = 1;
+      goto end;
+    }
+    cachedChecksuml = marpaEBNFTester_checksuml(marpaEBNFp);
+    if ((marpaEBNF_grammarb(marpaEBNFp, lists) == 0) || (marpaEBNFCache_statsb(marpaEBNFCachep, &marpaEBNFCacheStats) == 0)) {
+      rci = 1;
+      goto end;
+    }
+    GENERICLOGGER_INFOF(genericLoggerp, "Cache: %ld hits, %ld disk hits, %ld misses, %ld evictions, %ld disk writes, %ld disk errors",
+                        (long) marpaEBNFCacheStats.hitl, (long) marpaEBNFCacheStats.diskHitl, (long) marpaEBNFCacheStats.missl,
+                        (long) marpaEBNFCacheStats.evictionl, (long) marpaEBNFCacheStats.diskWritel, (long) marpaEBNFCacheStats.diskErrorl);
+    if ((marpaEBNFStats.cacheHitl != 1) || (marpaEBNFStats.earleySetl != 0)) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Cache: the grammar was parsed again");
+      rci = 1;
+    }
+    if (cachedChecksuml != checksuml) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Cache: checksum 0x%lx instead of 0x%lx", cachedChecksuml, checksuml);
+      rci = 1;
+    }
+    if ((marpaEBNFCacheStats.hitl != 1) || (marpaEBNFCacheStats.evictionl != 1) || (marpaEBNFCacheStats.entryl != 1)
+        || (marpaEBNFCacheStats.diskHitl != i + i) || (marpaEBNFCacheStats.missl != 2 - i - i) || (marpaEBNFCacheStats.diskErrorl != 0)) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Cache: unexpected statistics");
+      rci = 1;
+    }
+    marpaEBNF_freev(marpaEBNFp);
+    marpaEBNFp = NULL;
+    if ((i == 1) && ((marpaEBNFCache_removeb(marpaEBNFCachep, ebnfs, strlen(ebnfs)) == 0) || (marpaEBNFCache_removeb(marpaEBNFCachep, lists, strlen(lists)) == 0))) {
+      rci = 1;
+    }
+    marpaEBNFCache_freev(marpaEBNFCachep);
+    marpaEBNFCachep = NULL;
+    if (rci != 0) {
+      goto end;
+    }
+  }
+
+  /* A grammar from the cache has no diagnostics, whatever the previous parse had */
+  marpaEBNFCacheOption.genericLoggerp = genericLoggerp;
+  marpaEBNFCacheOption.maxEntryl      = 1;
+  marpaEBNFCacheOption.maxBytel       = 0;
+  marpaEBNFCacheOption.directorys     = NULL;
+  marpaEBNFCachep = marpaEBNFCache_newp(&marpaEBNFCacheOption);
+  if (marpaEBNFCachep == NULL) {
+    rci = 1;
+    goto end;
+  }
+  marpaEBNFOption.genericLoggerp = errorLoggerp;
+  marpaEBNFOption.cachep         = marpaEBNFCachep;
+  marpaEBNFOption.recoverb       = 1;
   marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  marpaEBNFOption.genericLoggerp = genericLoggerp;
+  marpaEBNFOption.cachep         = NULL;
+  marpaEBNFOption.recoverb       = 0;
   if (marpaEBNFp == NULL) {
     rci = 1;
     goto end;
   }
+  if ((marpaEBNF_grammarb(marpaEBNFp, lists) == 0)
+      || (marpaEBNF_grammarBufferb(marpaEBNFp, recoverGrammars, strlen(recoverGrammars)) != 0)
+      || (marpaEBNF_diagnosticsl(marpaEBNFp, &marpaEBNFDiagnosticp) <= 0)
+      || (marpaEBNF_grammarb(marpaEBNFp, lists) == 0)
+      || (marpaEBNF_statsb(marpaEBNFp, &marpaEBNFStats) == 0)) {
+    rci = 1;
+    goto end;
+  }
+  if ((marpaEBNFStats.cacheHitl != 1) || (marpaEBNF_diagnosticsl(marpaEBNFp, &marpaEBNFDiagnosticp) != 0)) {
+    GENERICLOGGER_ERROR(genericLoggerp, "Cache: a grammar from the cache has the diagnostics of the previous parse");
+    rci = 1;
+    goto end;
+  }
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFp = NULL;
+  marpaEBNFCache_freev(marpaEBNFCachep);
+  marpaEBNFCachep = NULL;
 
-  GENERICLOGGER_INFO(genericLoggerp, "Parsing EBNF grammar using EBNF itself");
-  GENERICLOGGER_INFOF(genericLoggerp, "%s", ebnfs);
-  /* Use EBNF to parse itself */
-  if (marpaEBNF_grammarb(marpaEBNFp, ebnfs) == 0) {
+  /* The C source of a compiled grammar, and loading it */
+  marpaEBNFp = marpaEBNF_newp(&marpaEBNFOption);
+  if (marpaEBNFp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  if ((marpaEBNF_grammarb(marpaEBNFp, lists) == 0) || (marpaEBNF_generateb(marpaEBNFp, "marpaEBNFTesterLists", MARPAEBNFTESTER_GENERATE_FILE) == 0)) {
     rci = 1;
     goto end;
   }
+  sources = marpaEBNFTester_reads(MARPAEBNFTESTER_GENERATE_FILE, &sourcel);
+  remove(MARPAEBNFTESTER_GENERATE_FILE);
+  if ((sources == NULL) || (strstr(sources, "marpaEBNF_t *marpaEBNFTesterLists_newp(marpaEBNFOption_t *marpaEBNFOptionp)\n/*") == NULL)) {
+    GENERICLOGGER_ERROR(genericLoggerp, "Generated source has no constructor");
+    rci = 1;
+    goto end;
+  }
+  free(sources);
+  sources = NULL;
+  GENERICLOGGER_INFO(genericLoggerp, "Generating with a name that is not a C identifier, and loading tables of another version: errors are expected");
+  memset(&marpaEBNFGenerated, 0, sizeof(marpaEBNFGenerated));
+  marpaEBNFGenerated.versioni = MARPAEBNF_GENERATED_VERSION + 1;
+  if ((marpaEBNF_generateb(marpaEBNFp, "9lists", MARPAEBNFTESTER_GENERATE_FILE) != 0) || (marpaEBNF_generatedb(marpaEBNFp, &marpaEBNFGenerated) != 0)) {
+    rci = 1;
+    goto end;
+  }
+  /* A failed load keeps the grammar */
+  if (marpaEBNF_parseb(marpaEBNFp, validListsp[0], strlen(validListsp[0])) == 0) {
+    rci = 1;
+    goto end;
+  }
+#ifdef MARPAEBNFTESTER_GENERATED_GRAMMAR
+  otherp = marpaEBNFTesterPascal_newp(&marpaEBNFOption);
+  if (otherp == NULL) {
+    rci = 1;
+    goto end;
+  }
+  otherSources = marpaEBNFTester_reads(MARPAEBNFTESTER_GENERATED_SOURCE, &otherSourcel);
+  for (i = 0; i < 2; i++) {
+    /* The text compiled, then the generated tables */
+    if (((i == 0) && (marpaEBNF_grammarFileb(marpaEBNFp, MARPAEBNFTESTER_GENERATED_GRAMMAR) == 0))
+        || (marpaEBNF_generateb((i == 0) ? marpaEBNFp : otherp, "marpaEBNFTesterPascal", MARPAEBNFTESTER_GENERATE_FILE) == 0)) {
+      rci = 1;
+      break;
+    }
+    sources = marpaEBNFTester_reads(MARPAEBNFTESTER_GENERATE_FILE, &sourcel);
+    remove(MARPAEBNFTESTER_GENERATE_FILE);
+    if ((sources == NULL) || (otherSources == NULL) || (sourcel != otherSourcel) || (memcmp(sources, otherSources, sourcel) != 0)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Source generated from the %s differs from %s", (i == 0) ? "text" : "tables", MARPAEBNFTESTER_GENERATED_SOURCE);
+      rci = 1;
+      break;
+    }
+    free(sources);
+    sources = NULL;
+  }
+  for (i = 0; (rci == 0) && (i < sizeof(generatedInputArray) / sizeof(generatedInputArray[0])); i++) {
+    if ((marpaEBNF_parseb(marpaEBNFp, generatedInputArray[i].inputs, strlen(generatedInputArray[i].inputs)) != generatedInputArray[i].okb)
+        || (marpaEBNF_parseb(otherp, generatedInputArray[i].inputs, strlen(generatedInputArray[i].inputs)) != generatedInputArray[i].okb)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Input \"%s\" is not %s by both the parsed and the generated grammar", generatedInputArray[i].inputs, generatedInputArray[i].okb ? "accepted" : "rejected");
+      rci = 1;
+    }
+  }
+  marpaEBNF_freev(otherp);
+  if (rci != 0) {
+    goto end;
+  }
+  GENERICLOGGER_INFOF(genericLoggerp, "Generated grammar: %ld bytes of source, the same from the text and from the tables", (long) otherSourcel);
+#endif
+  marpaEBNF_freev(marpaEBNFp);
+  marpaEBNFp = NULL;
 
  end:
+  if (sources != NULL) {
+    free(sources);
+  }
+#ifdef MARPAEBNFTESTER_GENERATED_GRAMMAR
+  if (otherSources != NULL) {
+    free(otherSources);
+  }
+#endif
+  if (generateds != NULL) {
+    free(generateds);
+  }
   if (marpaEBNFp != NULL) {
     marpaEBNF_freev(marpaEBNFp);
   }
+  if (marpaEBNFGrammarp != NULL) {
+    marpaEBNFGrammar_freev(marpaEBNFGrammarp);
+  }
+  /* After the instances that use it */
+  if (marpaEBNFCachep != NULL) {
+    marpaEBNFCache_freev(marpaEBNFCachep);
+  }
+  /* Nothing is left to leak-checkers */
+  marpaEBNF_shutdownv();
 
+  if (errorLoggerp != NULL) {
+    GENERICLOGGER_FREE(errorLoggerp);
+  }
+  if (countLoggerp != NULL) {
+    GENERICLOGGER_FREE(countLoggerp);
+  }
   GENERICLOGGER_FREE(genericLoggerp);
 
   return(rci);
 }
+
+/* Checksum of a parse: the AST when there is one, else the statistics */
+static void *marpaEBNFTester_mallocp(void *userDatavp, size_t sizel) {
+  marpaEBNFTesterAllocator_t *marpaEBNFTesterAllocatorp = (marpaEBNFTesterAllocator_t *) userDatavp;
+  void                       *p                         = malloc(sizel);
+
+  marpaEBNFTesterAllocatorp->calll++;
+  if (p != NULL) {
+    marpaEBNFTesterAllocatorp->blockl++;
+  }
+
+  return p;
+}
+
+static void *marpaEBNFTester_reallocp(void *userDatavp, void *p, size_t sizel) {
+  marpaEBNFTesterAllocator_t *marpaEBNFTesterAllocatorp = (marpaEBNFTesterAllocator_t *) userDatavp;
+  void                       *newp                      = realloc(p, sizel);
+
+  marpaEBNFTesterAllocatorp->calll++;
+  if ((p == NULL) && (newp != NULL)) {
+    marpaEBNFTesterAllocatorp->blockl++;
+  }
+
+  return newp;
+}
+
+static void marpaEBNFTester_freev(void *userDatavp, void *p) {
+  marpaEBNFTesterAllocator_t *marpaEBNFTesterAllocatorp = (marpaEBNFTesterAllocator_t *) userDatavp;
+
+  if (p != NULL) {
+    marpaEBNFTesterAllocatorp->blockl--;
+    free(p);
+  }
+}
+
+static unsigned long marpaEBNFTester_checksuml(marpaEBNF_t *marpaEBNFp) {
+  unsigned long     checksuml = 2166136261UL; /* FNV-1a */
+  marpaEBNFAst_t   *marpaEBNFAstp = marpaEBNF_astp(marpaEBNFp);
+  marpaEBNFStats_t  marpaEBNFStats;
+  size_t            nodel;
+  size_t            offsetl;
+  size_t            lengthl;
+  size_t            firstChildl;
+  size_t            childl;
+
+  if (marpaEBNFAstp != NULL) {
+    for (nodel = 0; nodel < marpaEBNFAst_nodel(marpaEBNFAstp); nodel++) {
+      marpaEBNFAst_spanb(marpaEBNFAstp, nodel, &offsetl, &lengthl);
+      marpaEBNFAst_childrenb(marpaEBNFAstp, nodel, &firstChildl, &childl);
+      checksuml = ((checksuml ^ (unsigned long) marpaEBNFAst_kindi(marpaEBNFAstp, nodel)) * 16777619UL) & 0xFFFFFFFFUL;
+      checksuml = ((checksuml ^ (unsigned long) offsetl) * 16777619UL) & 0xFFFFFFFFUL;
+      checksuml = ((checksuml ^ (unsigned long) lengthl) * 16777619UL) & 0xFFFFFFFFUL;
+      checksuml = ((checksuml ^ (unsigned long) firstChildl) * 16777619UL) & 0xFFFFFFFFUL;
+      checksuml = ((checksuml ^ (unsigned long) childl) * 16777619UL) & 0xFFFFFFFFUL;
+    }
+  } else if (marpaEBNF_statsb(marpaEBNFp, &marpaEBNFStats) != 0) {
+    checksuml = ((checksuml ^ (unsigned long) marpaEBNFStats.earleySetl) * 16777619UL) & 0xFFFFFFFFUL;
+  }
+
+  return checksuml;
+}
+
+/* Parses ebnfs with a new context on the grammar */
+static short marpaEBNFTester_parseb(marpaEBNFGrammar_t *marpaEBNFGrammarp, unsigned long *checksumlp) {
+  marpaEBNF_t *marpaEBNFp = marpaEBNF_contextNewp(marpaEBNFGrammarp);
+  short        rcb;
+
+  if (marpaEBNFp == NULL) {
+    return 0;
+  }
+  rcb = marpaEBNF_grammarb(marpaEBNFp, ebnfs);
+  if (rcb) {
+    *checksumlp = marpaEBNFTester_checksuml(marpaEBNFp);
+  }
+  marpaEBNF_freev(marpaEBNFp);
+
+  return rcb;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI marpaEBNFTester_threadRun(LPVOID threadp)
+#else
+static void *marpaEBNFTester_threadRun(void *threadp)
+#endif
+{
+  marpaEBNFTesterThread_t *marpaEBNFTesterThreadp = (marpaEBNFTesterThread_t *) threadp;
+  marpaEBNF_t             *marpaEBNFp;
+  unsigned long            checksuml;
+  int                      parsei;
+
+  /* One context for all the parses of the thread, so that it is reused */
+  marpaEBNFp = marpaEBNF_contextNewp(marpaEBNFTesterThreadp->marpaEBNFGrammarp);
+  if (marpaEBNFp != NULL) {
+    marpaEBNFTesterThreadp->okb = 1;
+    for (parsei = 0; parsei < MARPAEBNFTESTER_NPARSE; parsei++) {
+      if (marpaEBNF_grammarb(marpaEBNFp, ebnfs) == 0) {
+        marpaEBNFTesterThreadp->okb = 0;
+        break;
+      }
+      checksuml = marpaEBNFTester_checksuml(marpaEBNFp);
+      if ((parsei > 0) && (checksuml != marpaEBNFTesterThreadp->checksuml)) {
+        marpaEBNFTesterThreadp->okb = 0;
+        break;
+      }
+      marpaEBNFTesterThreadp->checksuml = checksuml;
+    }
+    marpaEBNF_freev(marpaEBNFp);
+  }
+
+#ifdef _WIN32
+  return 0;
+#else
+  return NULL;
+#endif
+}
+
+/* Rule i is a chain to rule i + 1, the last one ends it. Rule badRulel, if */
+/* any, has a syntax error.                                                 */
+static char *marpaEBNFTester_generates(size_t badRulel, size_t *lengthlp) {
+  size_t sizel = MARPAEBNFTESTER_NRULE * 128;
+  char  *generateds = (char *) malloc(sizel);
+  size_t lengthl = 0;
+  size_t rulel;
+
+  if (generateds == NULL) {
+    return NULL;
+  }
+  for (rulel = 0; rulel < MARPAEBNFTESTER_NRULE; rulel++) {
+    lengthl += sprintf(generateds + lengthl,
+                       "(* rule %ld; (* nested. *) *)\n"
+                       "r%ld %s 'x;' , r%ld | \"y.\" | ? special; ? ;\n",
+                       (long) rulel, (long) rulel, (rulel == badRulel) ? "= =" : "=", (long) (rulel + 1));
+  }
+  lengthl += sprintf(generateds + lengthl, "r%ld = 'z' .\n", (long) rulel);
+
+  *lengthlp = lengthl;
+  return generateds;
+}
+
+/* Whole content of a file, NUL terminated */
+static char *marpaEBNFTester_reads(char *filenames, size_t *lengthlp) {
+  FILE *fp;
+  char *inputs = NULL;
+  long  sizel;
+
+  fp = fopen(filenames, "rb");
+  if (fp == NULL) {
+    perror(filenames);
+    return NULL;
+  }
+  if ((fseek(fp, 0, SEEK_END) != 0) || ((sizel = ftell(fp)) < 0) || (fseek(fp, 0, SEEK_SET) != 0)) {
+    perror(filenames);
+  } else if ((inputs = (char *) malloc((size_t) sizel + 1)) == NULL) {
+    perror("malloc");
+  } else if (fread(inputs, 1, (size_t) sizel, fp) != (size_t) sizel) {
+    perror(filenames);
+    free(inputs);
+    inputs = NULL;
+  } else {
+    inputs[sizel] = '\0';
+    *lengthlp = (size_t) sizel;
+  }
+  fclose(fp);
+
+  return inputs;
+}
+
+/* Keeps the first error */
+static void marpaEBNFTester_errorLoggerv(void *userDatavp, genericLoggerLevel_t logLeveli, const char *msgs) {
+  char *errors = (char *) userDatavp;
+
+  if (errors[0] == '\0') {
+    strncpy(errors, msgs, MARPAEBNFTESTER_ERROR_SIZE - 1);
+    errors[MARPAEBNFTESTER_ERROR_SIZE - 1] = '\0';
+  }
+}
+
+static void marpaEBNFTester_countLoggerv(void *userDatavp, genericLoggerLevel_t logLeveli, const char *msgs) {
+  size_t *messagelp = (size_t *) userDatavp;
+
+  (*messagelp)++;
+}
+
+/* "[offset/end] line l column c: ..." where end is the end of the buffer */
+/* being read: only the offset and what follows the brackets must match  */
+static short marpaEBNFTester_sameErrorb(char *errors, char *otherErrors) {
+  char *slashs      = strchr(errors, '/');
+  char *otherSlashs = strchr(otherErrors, '/');
+  char *brackets;
+  char *otherBrackets;
+
+  if ((slashs == NULL) || (otherSlashs == NULL) || ((slashs - errors) != (otherSlashs - otherErrors)) || (strncmp(errors, otherErrors, slashs - errors) != 0)) {
+    return 0;
+  }
+  brackets      = strchr(slashs, ']');
+  otherBrackets = strchr(otherSlashs, ']');
+
+  return ((brackets != NULL) && (otherBrackets != NULL) && (strcmp(brackets, otherBrackets) == 0)) ? 1 : 0;
+}